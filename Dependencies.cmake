@@ -76,6 +76,28 @@ link_directories(${PYKEP_LIBRARY_DIR})
 
 find_package(Threads)
 
+# -------------------------------
+
+# Compressed TLE catalogs are supported if zlib (gzip) and/or liblzma (xz) can be found. These
+# libraries are optional and are not downloaded.
+find_package(ZLIB)
+
+if(ZLIB_FOUND)
+  include_directories(SYSTEM AFTER "${ZLIB_INCLUDE_DIRS}")
+  add_definitions(-DD2D_HAVE_ZLIB)
+else(ZLIB_FOUND)
+  message(STATUS "zlib not found: gzip-compressed catalogs will not be supported")
+endif(ZLIB_FOUND)
+
+find_package(LibLZMA)
+
+if(LIBLZMA_FOUND)
+  include_directories(SYSTEM AFTER "${LIBLZMA_INCLUDE_DIRS}")
+  add_definitions(-DD2D_HAVE_LZMA)
+else(LIBLZMA_FOUND)
+  message(STATUS "liblzma not found: xz-compressed catalogs will not be supported")
+endif(LIBLZMA_FOUND)
+
 if(NOT BUILD_DEPENDENCIES)
   find_package(sqlite3)
 endif(NOT BUILD_DEPENDENCIES)
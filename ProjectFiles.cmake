@@ -11,11 +11,19 @@ set(MAIN_SRC
 set(SRC
  "${SRC_PATH}/atomScanner.cpp"
  "${SRC_PATH}/catalogPruner.cpp"
+ "${SRC_PATH}/columnStore.cpp"
+ "${SRC_PATH}/database.cpp"
+ "${SRC_PATH}/ephemeris.cpp"
  "${SRC_PATH}/lambertFetch.cpp"
+ "${SRC_PATH}/lambertMerge.cpp"
  "${SRC_PATH}/lambertScanner.cpp"
+ "${SRC_PATH}/lambertSweep.cpp"
+ "${SRC_PATH}/lambertTargeter.cpp"
  "${SRC_PATH}/lambertTransfer.cpp"
+ "${SRC_PATH}/resultSink.cpp"
  "${SRC_PATH}/sgp4Scanner.cpp"
  "${SRC_PATH}/j2Analysis.cpp"
+ "${SRC_PATH}/tleCatalog.cpp"
  "${SRC_PATH}/tools.cpp"
 )
 
@@ -24,5 +32,17 @@ set(TEST_SRC
   "${TEST_SRC_PATH}/testD2D.cpp"
   "${TEST_SRC_PATH}/testTools.cpp"
   "${TEST_SRC_PATH}/testCatalogPruner.cpp"
+  "${TEST_SRC_PATH}/testColumnStore.cpp"
+  "${TEST_SRC_PATH}/testDatabase.cpp"
+  "${TEST_SRC_PATH}/testEphemeris.cpp"
+  "${TEST_SRC_PATH}/testLambertMerge.cpp"
+  "${TEST_SRC_PATH}/testLambertScannerDatabase.cpp"
+  "${TEST_SRC_PATH}/testLambertScannerGrid.cpp"
+  "${TEST_SRC_PATH}/testLambertScannerRun.cpp"
+  "${TEST_SRC_PATH}/testLambertSweep.cpp"
+  "${TEST_SRC_PATH}/testLambertTargeter.cpp"
+  "${TEST_SRC_PATH}/testResultSink.cpp"
+  "${TEST_SRC_PATH}/testShortlist.cpp"
+  "${TEST_SRC_PATH}/testTleCatalog.cpp"
   "${TEST_SRC_PATH}/testTypedefs.cpp"
 )
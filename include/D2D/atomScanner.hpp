@@ -8,6 +8,7 @@
 #define D2D_ATOM_SCANNER_HPP
 
 #include <string>
+#include <vector>
 
 #include <libsgp4/DateTime.h>
 
@@ -17,6 +18,10 @@
 
 #include <keplerian_toolbox.h>
 
+#include "D2D/database.hpp"
+#include "D2D/resultSink.hpp"
+#include "D2D/shortlist.hpp"
+
 namespace d2d
 {
 
@@ -61,19 +66,25 @@ public:
      * @param[in] aMaximumOfIterations    Maximum number of iterations for the Atom solver
      * @param[in] aShortlistLength        Number of transfers to include in shortlist
      * @param[in] aShortlistPath          Path to shortlist file
+     * @param[in] someResultSinkSettings  Result sink that results are written to
+     * @param[in] someDatabaseSettings    Bulk-load settings for SQLite database
      */
     AtomScannerInput( const double       aRelativeTolerance,
                       const double       anAbsoluteTolerance,
                       const std::string& aDatabasePath,
                       const int          aMaximumOfIterations,
                       const int          aShortlistLength,
-                      const std::string& aShortlistPath )
+                      const std::string& aShortlistPath,
+                      const ResultSinkSettings& someResultSinkSettings,
+                      const DatabaseSettings& someDatabaseSettings )
         : relativeTolerance( aRelativeTolerance ),
           absoluteTolerance( anAbsoluteTolerance ),
           maxIterations( aMaximumOfIterations ),
           databasePath( aDatabasePath ),
           shortlistLength( aShortlistLength ),
-          shortlistPath( aShortlistPath )
+          shortlistPath( aShortlistPath ),
+          resultSinkSettings( someResultSinkSettings ),
+          databaseSettings( someDatabaseSettings )
     { }
 
     //! Relative tolerance for the atom solver and the Cartesian-to-TLE conversion function.
@@ -94,6 +105,12 @@ public:
     //! Path to shortlist file.
     const std::string shortlistPath;
 
+    //! Result sink that results are written to.
+    const ResultSinkSettings resultSinkSettings;
+
+    //! Bulk-load settings for SQLite database.
+    const DatabaseSettings databaseSettings;
+
 protected:
 
 private:
@@ -122,20 +139,109 @@ AtomScannerInput checkAtomScannerInput( const rapidjson::Document& config );
  */
 void createAtomScannerTable( SQLite::Database& database );
 
+//! Create atom_scanner table indices.
+/*!
+ * Creates indices on "atom_scanner_results" table in SQLite database. The indices are created once
+ * all results have been inserted, which is cheaper than updating them for every insert.
+ *
+ * @sa executeAtomScanner, createAtomScannerTable
+ * @param[in] database SQLite database handle
+ */
+void createAtomScannerTableIndices( SQLite::Database& database );
+
+//! Get atom_scanner result fields.
+/*!
+ * Returns fields of the records written by atom_scanner to the result sink, in the order of the
+ * columns of the atom_scanner_results table (excluding the transfer_id column).
+ *
+ * @sa executeAtomScanner, createAtomScannerTable, ResultSink
+ * @return Result fields
+ */
+ResultFields getAtomScannerResultFields( );
+
+//! Entry in atom_scanner shortlist.
+/*!
+ * Data struct containing a record written by atom_scanner to the result sink and its ID, such that
+ * the shortlist can be retained while the Atom transfers are computed, instead of being sorted out
+ * of the atom_scanner_results table afterwards.
+ *
+ * @sa AtomScannerShortlist, executeAtomScanner, writeAtomTransferShortlist
+ */
+struct AtomScannerShortlistEntry
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs shortlist entry for Atom transfer.
+     *
+     * @param[in] aTransferId          ID of record in result sink (transfer_id)
+     * @param[in] anAtomTransferDeltaV Atom transfer \f$\Delta V\f$
+     * @param[in] aRecord              Record written to result sink
+     */
+    AtomScannerShortlistEntry( const long long aTransferId,
+                               const double anAtomTransferDeltaV,
+                               const ResultRecord& aRecord )
+        : transferId( aTransferId ),
+          atomTransferDeltaV( anAtomTransferDeltaV ),
+          record( aRecord )
+    { }
+
+    //! Compare shortlist entries.
+    /*!
+     * Compares shortlist entries by Atom transfer \f$\Delta V\f$, followed by transfer_id.
+     *
+     * @param[in] entry Shortlist entry to compare to
+     * @return          True if this entry is better than the given entry
+     */
+    bool operator<( const AtomScannerShortlistEntry& entry ) const
+    {
+        if ( atomTransferDeltaV != entry.atomTransferDeltaV )
+        {
+            return atomTransferDeltaV < entry.atomTransferDeltaV;
+        }
+
+        return transferId < entry.transferId;
+    }
+
+    //! ID of record in result sink (transfer_id).
+    long long transferId;
+
+    //! Atom transfer \f$\Delta V\f$.
+    double atomTransferDeltaV;
+
+    //! Record written to result sink, containing values of atom_scanner result fields.
+    ResultRecord record;
+
+protected:
+
+private:
+};
+
+//! Get shortlist key of atom_scanner shortlist entry (Atom transfer \f$\Delta V\f$).
+inline double getShortlistKey( const AtomScannerShortlistEntry& entry )
+{
+    return entry.atomTransferDeltaV;
+}
+
+//! Bounded shortlist of atom_scanner records with lowest Atom transfer \f$\Delta V\f$.
+typedef Shortlist< AtomScannerShortlistEntry > AtomScannerShortlist;
+
+//! List of atom_scanner shortlist entries.
+typedef std::vector< AtomScannerShortlistEntry > AtomScannerShortlistEntries;
+
 //! Write transfer shortlist to file.
 /*!
  * Writes shortlist of debris-to-debris Atom transfers to file. The shortlist is based on the
- * requested number of transfers with the lowest transfer \f$\Delta V\f$, retrieved by sorting the
- * transfers in the SQLite database.
+ * requested number of transfers with the lowest transfer \f$\Delta V\f$, retained while the
+ * Atom transfers are computed.
  *
- * @sa executeAtomScanner, createAtomScannerTable
- * @param[in] database        SQLite database handle
- * @param[in] shortlistNumber Number of entries to include in shortlist (if it exceeds number of
- *                            entries in database table, the whole table is written to file)
- * @param[in] shortlistPath   Path to shortlist file
+ * @sa executeAtomScanner, AtomScannerShortlist
+ * @param[in] shortlistEntries Shortlist entries, sorted by Atom transfer \f$\Delta V\f$
+ *                             (ascending)
+ * @param[in] shortlistPath    Path to shortlist file
  */
-void writeAtomTransferShortlist( SQLite::Database& database,
-                                 const int shortlistNumber,
+void writeAtomTransferShortlist( const AtomScannerShortlistEntries& shortlistEntries,
                                  const std::string& shortlistPath );
 
 } // namespace d2d
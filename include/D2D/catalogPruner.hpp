@@ -8,9 +8,12 @@
 #define D2D_CATALOG_PRUNER_HPP
 
 #include <string>
+#include <vector>
 
 #include <rapidjson/document.h>
 
+#include "D2D/tleCatalog.hpp"
+
 namespace d2d
 {
 
@@ -25,11 +28,26 @@ namespace d2d
  *  - eccentricity                              [-]
  *  - line-0 regex (performs regex match on line-0 of TLE; only works for 3-line TLE )
  *
+ * The TLE objects are constructed from the catalog in parallel (set by the "threads" option; see
+ * TleCatalog::getTleObjects()).
+ *
+ * The orbital elements of all objects are computed once and stored as a structure-of-arrays (see
+ * CatalogPrunerElements), such that the range filters are evaluated for all objects in a single
+ * branch-free pass (see computeCatalogPrunerMask()). The name regex is compiled once and only
+ * matched against the objects that pass the range filters, after which the pruned catalog is
+ * written in a single streaming pass.
+ *
+ * The config can also contain a list of filter sets ("filter_sets"), each of which overrides the
+ * filters and pruned catalog of the shared config (see checkCatalogPrunerFilterSets()). In that
+ * case, the catalog is parsed once, the range filters of each filter set are evaluated over the
+ * same orbital elements, and all pruned catalogs are written in a single pass over the catalog.
+ *
  * @todo      Add filters for other orbital elements
  * @todo      Add filters that cross-reference fields in SATCAT (e.g., size from RCS)
  *            (Kelso, 2014)
  * @todo      Add filters for other TLE fields, e.g., launch year.
  *
+ * @sa        checkCatalogPrunerFilterSets
  * @param[in] config User-defined configuration options (extracted from JSON input file)
  */
 void executeCatalogPruner( const rapidjson::Document& config );
@@ -60,6 +78,7 @@ public:
      * @param[in] aNameRegex              Regex filter for TLE object name
      * @param[in] aCatalogCutoff          Cutoff that sets maximum objects
      * @param[in] aPrunedCatalogPath      Path to pruned TLE catalog
+     * @param[in] someThreads             Number of threads used to parse catalog
      */
     CatalogPrunerInput( const std::string& aCatalogPath,
                         const double aSemiMajorAxisMinimum,
@@ -70,7 +89,8 @@ public:
                         const double anInclinationMaximum,
                         const std::string& aNameRegex,
                         const int aCatalogCutoff,
-                        const std::string& aPrunedCatalogPath )
+                        const std::string& aPrunedCatalogPath,
+                        const int someThreads )
         : catalogPath( aCatalogPath ),
           semiMajorAxisMinimum( aSemiMajorAxisMinimum ),
           semiMajorAxisMaximum( aSemiMajorAxisMaximum ),
@@ -80,7 +100,8 @@ public:
           inclinationMaximum( anInclinationMaximum ),
           nameRegex( aNameRegex ),
           catalogCutoff( aCatalogCutoff ),
-          prunedCatalogPath( aPrunedCatalogPath )
+          prunedCatalogPath( aPrunedCatalogPath ),
+          threads( someThreads )
     { }
 
     //! Path to TLE catalog.
@@ -113,6 +134,9 @@ public:
     //! Pruned catalog path.
     const std::string prunedCatalogPath;
 
+    //! Number of threads used to construct TLE objects from catalog.
+    const int threads;
+
 protected:
 
 private:
@@ -132,6 +156,101 @@ private:
  */
 CatalogPrunerInput checkCatalogPrunerInput( const rapidjson::Document& config );
 
+//! Get catalog_pruner filter set configuration.
+/*!
+ * Merges the shared catalog_pruner options with the options of a filter set (see
+ * overrideConfig()); the "filter_sets" array is removed. An error is thrown if the filter set is
+ * not an object or if it overrides the "mode", "catalog" or "threads" options, which are common
+ * to all filter sets.
+ *
+ * @sa checkCatalogPrunerFilterSets
+ * @param[in]  config          User-defined configuration options (extracted from JSON input file)
+ * @param[in]  filterSet       Options of filter set (element of "filter_sets" array)
+ * @param[out] filterSetConfig Configuration options of filter set
+ */
+void getCatalogPrunerFilterSetConfig( const rapidjson::Document& config,
+                                      const rapidjson::Value& filterSet,
+                                      rapidjson::Document& filterSetConfig );
+
+//! Check catalog_pruner filter sets.
+/*!
+ * Checks the inputs of all filter sets for the catalog_pruner application mode (see
+ * checkCatalogPrunerInput()). If the config contains no "filter_sets" array, the config itself is
+ * the only filter set. An error is thrown if the array is empty, or if a filter set does not set
+ * its own "catalog_pruned" or shares it with another filter set.
+ *
+ * @sa executeCatalogPruner, getCatalogPrunerFilterSetConfig, CatalogPrunerInput
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           Structs containing all valid input, per filter set
+ */
+std::vector< CatalogPrunerInput > checkCatalogPrunerFilterSets( const rapidjson::Document& config );
+
+//! Orbital elements for catalog_pruner.
+/*!
+ * Data struct containing the orbital elements that the catalog_pruner range filters are applied
+ * to, for all objects in a TLE catalog. The elements are stored as a structure-of-arrays: one
+ * contiguous array per element, indexed by the position of the object in the catalog.
+ *
+ * @sa computeCatalogPrunerElements, computeCatalogPrunerMask
+ */
+struct CatalogPrunerElements
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with element arrays for given number of objects.
+     *
+     * @param[in] numberOfObjects Number of objects in catalog
+     */
+    CatalogPrunerElements( const unsigned int numberOfObjects )
+        : semiMajorAxis( numberOfObjects ),
+          eccentricity( numberOfObjects ),
+          inclination( numberOfObjects )
+    { }
+
+    //! Semi-major axis [km].
+    std::vector< double > semiMajorAxis;
+
+    //! Eccentricity [-].
+    std::vector< double > eccentricity;
+
+    //! Inclination [deg].
+    std::vector< double > inclination;
+
+protected:
+
+private:
+};
+
+//! Compute orbital elements for catalog_pruner.
+/*!
+ * Computes the orbital elements that the catalog_pruner range filters are applied to, for all
+ * given TLE objects. The semi-major axis is recovered from the mean motion using SGP4's orbital
+ * elements.
+ *
+ * @sa CatalogPrunerElements
+ * @param[in] tleObjects List of TLE objects parsed from catalog
+ * @return               Orbital elements of all objects
+ */
+CatalogPrunerElements computeCatalogPrunerElements( const TleObjects& tleObjects );
+
+//! Compute catalog_pruner filter mask.
+/*!
+ * Evaluates the semi-major axis, eccentricity and inclination range filters for all objects. The
+ * filters are evaluated without branches over the element arrays, such that the loop can be
+ * vectorized by the compiler. Objects on the boundary of a range pass the filter. The name regex
+ * filter is not evaluated.
+ *
+ * @sa CatalogPrunerElements, executeCatalogPruner
+ * @param[in]  input    Verified input parameters for catalog_pruner
+ * @param[in]  elements Orbital elements of all objects
+ * @param[out] mask     Flag per object, set to 1 if object passes all range filters, 0 otherwise
+ */
+void computeCatalogPrunerMask( const CatalogPrunerInput& input,
+                               const CatalogPrunerElements& elements,
+                               std::vector< unsigned char >& mask );
+
 } // namespace d2d
 
 /*!
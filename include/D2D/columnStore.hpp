@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_COLUMN_STORE_HPP
+#define D2D_COLUMN_STORE_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace d2d
+{
+
+//! Writer for columnar binary result store.
+/*!
+ * Writes a table of double-precision values to a column store: a directory containing one
+ * fixed-width binary file per column ("<column>.f64", values in native byte order) and a small
+ * JSON header ("header.json") listing the number of rows, the column names and user-defined
+ * metadata (e.g., the grid used to compute the results). Rows are buffered and appended to the
+ * column files in chunks.
+ *
+ * The header is written when the store is closed, such that an incomplete store is not read.
+ *
+ * @sa ColumnStore
+ */
+class ColumnStoreWriter
+{
+public:
+
+    //! Construct writer.
+    /*!
+     * Constructs writer for column store in given directory. The directory is created if it does
+     * not exist; existing column files and header are overwritten. An error is thrown if the
+     * directory or column files cannot be created.
+     *
+     * @param[in] aDirectory      Path to column store directory
+     * @param[in] someColumnNames Names of columns, in order of values in each row
+     */
+    ColumnStoreWriter( const std::string& aDirectory,
+                       const std::vector< std::string >& someColumnNames );
+
+    //! Destruct writer.
+    /*!
+     * Closes column files. The header is not written if close() has not been called.
+     */
+    ~ColumnStoreWriter( );
+
+    //! Append row to column store.
+    /*!
+     * Appends row of values to the column store. An error is thrown if the number of values
+     * does not match the number of columns.
+     *
+     * @param[in] row Row of values, in column order
+     */
+    void appendRow( const std::vector< double >& row );
+
+    //! Get number of rows.
+    /*!
+     * Returns number of rows appended to the column store.
+     *
+     * @return Number of rows
+     */
+    long long getNumberOfRows( ) const { return numberOfRows; }
+
+    //! Close column store.
+    /*!
+     * Flushes buffered rows, closes column files and writes header containing the number of rows,
+     * the column names and the given metadata.
+     *
+     * @param[in] metadata Metadata stored in header, indexed by name
+     */
+    void close( const std::map< std::string, double >& metadata );
+
+protected:
+
+private:
+
+    //! Flush buffered rows to column files.
+    void flush( );
+
+    //! Copying is disabled, since the writer owns the column file handles.
+    ColumnStoreWriter( const ColumnStoreWriter& );
+    ColumnStoreWriter& operator=( const ColumnStoreWriter& );
+
+    //! Path to column store directory.
+    const std::string directory;
+
+    //! Names of columns.
+    const std::vector< std::string > columnNames;
+
+    //! Column file handles.
+    std::vector< std::FILE* > columnFiles;
+
+    //! Buffered values per column.
+    std::vector< std::vector< double > > columnBuffers;
+
+    //! Number of rows appended.
+    long long numberOfRows;
+};
+
+//! Reader for columnar binary result store.
+/*!
+ * Provides zero-copy, read-only access to a column store written by ColumnStoreWriter. The
+ * column files are memory-mapped, such that each column can be accessed as a contiguous array of
+ * doubles, e.g., to filter rows on a single column without reading the other columns.
+ *
+ * @sa ColumnStoreWriter
+ */
+class ColumnStore
+{
+public:
+
+    //! Construct reader.
+    /*!
+     * Constructs reader for column store in given directory. The header is parsed and all column
+     * files are memory-mapped. An error is thrown if the header cannot be parsed or if the size of
+     * a column file does not match the number of rows.
+     *
+     * @param[in] aDirectory Path to column store directory
+     */
+    explicit ColumnStore( const std::string& aDirectory );
+
+    //! Destruct reader.
+    /*!
+     * Unmaps column files.
+     */
+    ~ColumnStore( );
+
+    //! Get number of rows.
+    /*!
+     * Returns number of rows in column store.
+     *
+     * @return Number of rows
+     */
+    long long getNumberOfRows( ) const { return numberOfRows; }
+
+    //! Check if column exists.
+    /*!
+     * Checks if column with given name exists in column store.
+     *
+     * @param[in] columnName Name of column
+     * @return               True if column exists
+     */
+    bool hasColumn( const std::string& columnName ) const;
+
+    //! Get column.
+    /*!
+     * Returns pointer to contiguous array of values in column with given name. The array contains
+     * getNumberOfRows() values and remains valid for the lifetime of the reader. An error is
+     * thrown if the column does not exist.
+     *
+     * @param[in] columnName Name of column
+     * @return               Pointer to first value in column (null if column store is empty)
+     */
+    const double* getColumn( const std::string& columnName ) const;
+
+    //! Get metadata.
+    /*!
+     * Returns metadata value with given name, stored in header. An error is thrown if the
+     * metadata value does not exist.
+     *
+     * @param[in] name Name of metadata value
+     * @return         Metadata value
+     */
+    double getMetadata( const std::string& name ) const;
+
+protected:
+
+private:
+
+    //! Unmap column files.
+    void unmap( );
+
+    //! Copying is disabled, since the reader owns the memory mappings.
+    ColumnStore( const ColumnStore& );
+    ColumnStore& operator=( const ColumnStore& );
+
+    //! Path to column store directory.
+    const std::string directory;
+
+    //! Number of rows.
+    long long numberOfRows;
+
+    //! Memory-mapped columns, indexed by column name.
+    std::map< std::string, const double* > columns;
+
+    //! Metadata stored in header, indexed by name.
+    std::map< std::string, double > metadata;
+
+    //! Memory mappings (address and length), unmapped on destruction.
+    std::vector< std::pair< void*, std::size_t > > mappings;
+};
+
+} // namespace d2d
+
+#endif // D2D_COLUMN_STORE_HPP
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_DATABASE_HPP
+#define D2D_DATABASE_HPP
+
+#include <string>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+namespace d2d
+{
+
+//! Bulk-load settings for SQLite database.
+/*!
+ * Data struct containing the SQLite pragmas applied to a database connection before the results of
+ * an application mode are inserted. Empty strings and zero values indicate that the corresponding
+ * pragma is not set, in which case the SQLite default is used.
+ *
+ * @sa checkDatabaseSettings, applyDatabaseSettings
+ */
+struct DatabaseSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkDatabaseSettings
+     * @param[in] aJournalMode Journal mode (DELETE, TRUNCATE, PERSIST, MEMORY, WAL or OFF)
+     * @param[in] aSynchronous Synchronous flag (OFF, NORMAL, FULL or EXTRA)
+     * @param[in] aPageSize    Page size [bytes]
+     * @param[in] aCacheSize   Cache size [pages if positive, KiB if negative]
+     * @param[in] aMmapSize    Maximum size of memory-mapped I/O [bytes]
+     */
+    DatabaseSettings( const std::string& aJournalMode,
+                      const std::string& aSynchronous,
+                      const int          aPageSize,
+                      const int          aCacheSize,
+                      const long long    aMmapSize )
+        : journalMode( aJournalMode ),
+          synchronous( aSynchronous ),
+          pageSize( aPageSize ),
+          cacheSize( aCacheSize ),
+          mmapSize( aMmapSize )
+    { }
+
+    //! Journal mode.
+    const std::string journalMode;
+
+    //! Synchronous flag.
+    const std::string synchronous;
+
+    //! Page size [bytes].
+    const int pageSize;
+
+    //! Cache size [pages if positive, KiB if negative].
+    const int cacheSize;
+
+    //! Maximum size of memory-mapped I/O [bytes].
+    const long long mmapSize;
+
+protected:
+
+private:
+};
+
+//! Check bulk-load settings for SQLite database.
+/*!
+ * Checks the optional "bulk_load" object in the config file, which can contain the keys
+ * "journal_mode", "synchronous", "page_size", "cache_size" and "mmap_size". Keys that are not
+ * specified (or a missing "bulk_load" object) leave the corresponding SQLite default unchanged.
+ * If a setting is invalid, an error is thrown with a short description of the problem.
+ *
+ * @sa DatabaseSettings, applyDatabaseSettings
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           Struct containing verified bulk-load settings
+ */
+DatabaseSettings checkDatabaseSettings( const rapidjson::Document& config );
+
+//! Apply bulk-load settings to SQLite database.
+/*!
+ * Applies bulk-load settings to database connection by executing the corresponding pragmas. This
+ * function must be called before a transaction is started. The page size only takes effect if the
+ * database file is newly created.
+ *
+ * @sa DatabaseSettings, checkDatabaseSettings
+ * @param[in] database SQLite database handle
+ * @param[in] settings Bulk-load settings
+ */
+void applyDatabaseSettings( SQLite::Database& database, const DatabaseSettings& settings );
+
+} // namespace d2d
+
+#endif // D2D_DATABASE_HPP
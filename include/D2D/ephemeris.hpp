@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_EPHEMERIS_HPP
+#define D2D_EPHEMERIS_HPP
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+#include "D2D/tleCatalog.hpp"
+#include "D2D/typedefs.hpp"
+
+namespace d2d
+{
+
+//! Table of precomputed SGP4 ephemerides.
+/*!
+ * Table containing the Cartesian states and Keplerian elements of a list of TLE objects,
+ * propagated with SGP4 to a common list of epochs. Each object is propagated and converted to
+ * Keplerian elements exactly once per epoch when the table is constructed, after which states are
+ * looked up by (object index, epoch index).
+ *
+ * The states are stored as a structure-of-arrays: one contiguous array per state element, in
+ * which the states of an object are stored consecutively for all epochs (object-major order).
+ *
+ * @sa getStateVector
+ */
+class EphemerisTable
+{
+public:
+
+    //! Construct ephemeris table.
+    /*!
+     * Constructs ephemeris table by propagating all TLE objects to all epochs using SGP4 and
+     * converting the Cartesian states to Keplerian elements. The objects are distributed across
+     * the given number of threads. If SGP4 propagation fails for any object, the error is rethrown
+     * once all threads have completed.
+     *
+     * @param[in] tleObjects             List of TLE objects
+     * @param[in] someEpochs             List of epochs to propagate objects to
+     * @param[in] gravitationalParameter Gravitational parameter used to compute Keplerian
+     *                                   elements [km^3 s^-2]
+     * @param[in] numberOfThreads        Number of threads used to propagate objects (default = 1)
+     */
+    EphemerisTable( const TleObjects& tleObjects,
+                    const std::vector< DateTime >& someEpochs,
+                    const double gravitationalParameter,
+                    const int numberOfThreads = 1 );
+
+    //! Construct ephemeris table from cache.
+    /*!
+     * Constructs ephemeris table by reading a cache file written by writeCache(), such that the
+     * TLE objects do not need to be initialized and propagated with SGP4 again. An error is thrown
+     * if the file cannot be read or if it was not written for the given catalog, number of
+     * objects, epochs and gravitational parameter.
+     *
+     * @sa writeCache, computeEphemerisTable
+     * @param[in] cachePath              Path to cache file
+     * @param[in] catalogHash            Hash of catalog that objects were parsed from
+     * @param[in] aNumberOfObjects       Number of objects
+     * @param[in] someEpochs             List of epochs that objects were propagated to
+     * @param[in] gravitationalParameter Gravitational parameter used to compute Keplerian
+     *                                   elements [km^3 s^-2]
+     */
+    EphemerisTable( const std::string& cachePath,
+                    const unsigned long long catalogHash,
+                    const unsigned int aNumberOfObjects,
+                    const std::vector< DateTime >& someEpochs,
+                    const double gravitationalParameter );
+
+    //! Get Cartesian state.
+    /*!
+     * Returns Cartesian state of object at epoch.
+     *
+     * @param[in] objectIndex Index of object in list of TLE objects
+     * @param[in] epochIndex  Index of epoch in list of epochs
+     * @return                Cartesian state [km; km/s]
+     */
+    Vector6 getState( const unsigned int objectIndex, const unsigned int epochIndex ) const
+    {
+        const std::size_t index = static_cast< std::size_t >( objectIndex ) * epochs.size( )
+                                  + epochIndex;
+        Vector6 state;
+        state[ 0 ] = positionX[ index ];
+        state[ 1 ] = positionY[ index ];
+        state[ 2 ] = positionZ[ index ];
+        state[ 3 ] = velocityX[ index ];
+        state[ 4 ] = velocityY[ index ];
+        state[ 5 ] = velocityZ[ index ];
+        return state;
+    }
+
+    //! Get Keplerian elements.
+    /*!
+     * Returns Keplerian elements of object at epoch.
+     *
+     * @param[in] objectIndex Index of object in list of TLE objects
+     * @param[in] epochIndex  Index of epoch in list of epochs
+     * @return                Keplerian elements [km; -; rad; rad; rad; rad]
+     */
+    Vector6 getStateKepler( const unsigned int objectIndex, const unsigned int epochIndex ) const
+    {
+        const std::size_t index = static_cast< std::size_t >( objectIndex ) * epochs.size( )
+                                  + epochIndex;
+        Vector6 stateKepler;
+        stateKepler[ 0 ] = semiMajorAxis[ index ];
+        stateKepler[ 1 ] = eccentricity[ index ];
+        stateKepler[ 2 ] = inclination[ index ];
+        stateKepler[ 3 ] = argumentOfPeriapsis[ index ];
+        stateKepler[ 4 ] = longitudeOfAscendingNode[ index ];
+        stateKepler[ 5 ] = trueAnomaly[ index ];
+        return stateKepler;
+    }
+
+    //! Get number of objects.
+    /*!
+     * Returns number of objects in ephemeris table.
+     *
+     * @return Number of objects
+     */
+    unsigned int getNumberOfObjects( ) const { return numberOfObjects; }
+
+    //! Get epochs.
+    /*!
+     * Returns list of epochs in ephemeris table.
+     *
+     * @return List of epochs
+     */
+    const std::vector< DateTime >& getEpochs( ) const { return epochs; }
+
+    //! Write cache file.
+    /*!
+     * Writes ephemeris table to a binary cache file: a header containing the catalog hash, the
+     * number of objects, the epochs and the gravitational parameter, followed by the state arrays
+     * (in native byte order). The table is written to a uniquely named temporary file that is
+     * renamed to the cache file, such that processes sharing a cache directory do not interfere.
+     * An error is thrown if the file cannot be written.
+     *
+     * @sa computeEphemerisTable
+     * @param[in] cachePath   Path to cache file
+     * @param[in] catalogHash Hash of catalog that objects were parsed from
+     */
+    void writeCache( const std::string& cachePath, const unsigned long long catalogHash ) const;
+
+protected:
+
+private:
+
+    //! Propagate objects.
+    /*!
+     * Propagates every stride-th object, starting from the given object, to all epochs and stores
+     * the Cartesian states and Keplerian elements in the table. Errors are stored, rather than thrown.
+     *
+     * @param[in]  tleObjects  List of TLE objects
+     * @param[in]  firstObject Index of first object to propagate
+     * @param[in]  stride      Stride between objects to propagate
+     * @param[out] error       Pointer to exception thrown during propagation (null if none)
+     */
+    void propagateObjects( const TleObjects& tleObjects,
+                           const unsigned int firstObject,
+                           const unsigned int stride,
+                           std::exception_ptr& error );
+
+    //! Get state arrays.
+    /*!
+     * Returns pointers to the state arrays, in the order in which they are stored in cache files.
+     *
+     * @return Pointers to state arrays
+     */
+    std::vector< std::vector< double >* > getStateArrays( );
+
+    //! Get state arrays.
+    /*!
+     * Returns pointers to the state arrays, in the order in which they are stored in cache files.
+     *
+     * @return Pointers to state arrays
+     */
+    std::vector< const std::vector< double >* > getStateArrays( ) const;
+
+    //! List of epochs.
+    const std::vector< DateTime > epochs;
+
+    //! Gravitational parameter used to compute Keplerian elements [km^3 s^-2].
+    const double gravitationalParameter;
+
+    //! Number of objects.
+    const unsigned int numberOfObjects;
+
+    //! x-component of position [km].
+    std::vector< double > positionX;
+
+    //! y-component of position [km].
+    std::vector< double > positionY;
+
+    //! z-component of position [km].
+    std::vector< double > positionZ;
+
+    //! x-component of velocity [km/s].
+    std::vector< double > velocityX;
+
+    //! y-component of velocity [km/s].
+    std::vector< double > velocityY;
+
+    //! z-component of velocity [km/s].
+    std::vector< double > velocityZ;
+
+    //! Semi-major axis [km].
+    std::vector< double > semiMajorAxis;
+
+    //! Eccentricity [-].
+    std::vector< double > eccentricity;
+
+    //! Inclination [rad].
+    std::vector< double > inclination;
+
+    //! Argument of periapsis [rad].
+    std::vector< double > argumentOfPeriapsis;
+
+    //! Longitude of ascending node [rad].
+    std::vector< double > longitudeOfAscendingNode;
+
+    //! True anomaly [rad].
+    std::vector< double > trueAnomaly;
+};
+
+//! Get path to ephemeris cache file.
+/*!
+ * Returns path to the ephemeris cache file in the given directory for the given catalog, epochs
+ * and gravitational parameter. The file name is a hash of these inputs, such that ephemerides for
+ * different catalogs and epoch grids are cached side by side.
+ *
+ * @sa computeEphemerisTable
+ * @param[in] cacheDirectory         Path to cache directory
+ * @param[in] catalogHash            Hash of catalog (see TleCatalog::computeHash())
+ * @param[in] epochs                 List of epochs
+ * @param[in] gravitationalParameter Gravitational parameter [km^3 s^-2]
+ * @return                           Path to cache file
+ */
+std::string getEphemerisCachePath( const std::string& cacheDirectory,
+                                   const unsigned long long catalogHash,
+                                   const std::vector< DateTime >& epochs,
+                                   const double gravitationalParameter );
+
+//! Compute ephemeris table.
+/*!
+ * Returns ephemeris table for the given objects and epochs. If a cache directory is given and it
+ * contains a valid cache file for the catalog and epochs (see getEphemerisCachePath()), the table
+ * is read from the cache. Otherwise, the objects are propagated with SGP4 and, if a cache
+ * directory is given, the table is written to the cache for subsequent runs. If the cache cannot
+ * be written, a warning is printed and the table computed in memory is returned, or the table in
+ * a valid cache file written by another process in the meantime.
+ *
+ * @sa EphemerisTable, getEphemerisCachePath
+ * @param[in] tleObjects             List of TLE objects
+ * @param[in] catalogHash            Hash of catalog that objects were parsed from
+ * @param[in] epochs                 List of epochs to propagate objects to
+ * @param[in] gravitationalParameter Gravitational parameter used to compute Keplerian
+ *                                   elements [km^3 s^-2]
+ * @param[in] numberOfThreads        Number of threads used to propagate objects
+ * @param[in] cacheDirectory         Path to cache directory (empty: no cache is used)
+ * @return                           Ephemeris table
+ */
+std::unique_ptr< const EphemerisTable > computeEphemerisTable(
+    const TleObjects& tleObjects,
+    const unsigned long long catalogHash,
+    const std::vector< DateTime >& epochs,
+    const double gravitationalParameter,
+    const int numberOfThreads,
+    const std::string& cacheDirectory );
+
+} // namespace d2d
+
+#endif // D2D_EPHEMERIS_HPP
@@ -9,11 +9,16 @@
 #define D2D_J2_ANALYSIS_HPP
 
 #include <string>
+#include <vector>
 
 #include <rapidjson/document.h>
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "D2D/database.hpp"
+#include "D2D/resultSink.hpp"
+#include "D2D/shortlist.hpp"
+
 namespace d2d
 {
 
@@ -57,13 +62,19 @@ public:
      * @param[in] aDatabasePath           Path to SQLite database
      * @param[in] aShortlistLength        Number of transfers to include in shortlist
      * @param[in] aShortlistPath          Path to shortlist file
+     * @param[in] someResultSinkSettings  Result sink that results are written to
+     * @param[in] someDatabaseSettings    Bulk-load settings for SQLite database
      */
     J2AnalysisInput( const std::string& aDatabasePath,
                      const int          aShortlistLength,
-                     const std::string& aShortlistPath )
+                     const std::string& aShortlistPath,
+                     const ResultSinkSettings& someResultSinkSettings,
+                     const DatabaseSettings& someDatabaseSettings )
         : databasePath( aDatabasePath ),
           shortlistLength( aShortlistLength ),
-          shortlistPath( aShortlistPath )
+          shortlistPath( aShortlistPath ),
+          resultSinkSettings( someResultSinkSettings ),
+          databaseSettings( someDatabaseSettings )
     { }
 
     //! Path to SQLite database to store output.
@@ -75,6 +86,12 @@ public:
     //! Path to shortlist file.
     const std::string shortlistPath;
 
+    //! Result sink that results are written to.
+    const ResultSinkSettings resultSinkSettings;
+
+    //! Bulk-load settings for SQLite database.
+    const DatabaseSettings databaseSettings;
+
 protected:
 
 private:
@@ -103,21 +120,123 @@ J2AnalysisInput checkJ2AnalysisInput( const rapidjson::Document& config );
  */
 void createJ2AnalysisTable( SQLite::Database& database );
 
+//! Get j2_analysis result fields.
+/*!
+ * Returns fields of the records written by j2_analysis to the result sink, in the order of the
+ * columns of the j2_analysis_results table (excluding the transfer_id column).
+ *
+ * @sa executeJ2Analysis, createJ2AnalysisTable, ResultSink
+ * @return Result fields
+ */
+ResultFields getJ2AnalysisResultFields( );
+
+//! Create j2_analysis_results table indices.
+/*!
+ * Creates indices on j2_analysis_results table in SQLite database. The indices are created once
+ * all results have been inserted, which is cheaper than updating them for every insert.
+ *
+ * @sa executeJ2Analysis, createJ2AnalysisTable
+ * @param[in] database SQLite database handle
+ */
+void createJ2AnalysisTableIndices( SQLite::Database& database );
+
+//! Entry in j2_analysis shortlist.
+/*!
+ * Data struct containing a j2_analysis result record, together with the transfer \f$\Delta V\f$
+ * and object IDs of the Lambert transfer that it was computed for. The shortlist is filled during
+ * the analysis, since the lambert_scanner_results table cannot be joined if the Lambert transfers
+ * are stored in a column store.
+ *
+ * @sa J2AnalysisShortlist, executeJ2Analysis, writeJ2TransferShortlist
+ */
+struct J2AnalysisShortlistEntry
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs shortlist entry for analysed Lambert transfer.
+     *
+     * @param[in] aTransferId            ID of record in result sink (transfer_id)
+     * @param[in] aLambertTransferDeltaV Lambert transfer \f$\Delta V\f$
+     * @param[in] aDepartureObjectId     Departure object ID of Lambert transfer
+     * @param[in] anArrivalObjectId      Arrival object ID of Lambert transfer
+     * @param[in] aRecord                Record written to result sink
+     */
+    J2AnalysisShortlistEntry( const long long aTransferId,
+                              const double aLambertTransferDeltaV,
+                              const int aDepartureObjectId,
+                              const int anArrivalObjectId,
+                              const ResultRecord& aRecord )
+        : transferId( aTransferId ),
+          lambertTransferDeltaV( aLambertTransferDeltaV ),
+          departureObjectId( aDepartureObjectId ),
+          arrivalObjectId( anArrivalObjectId ),
+          record( aRecord )
+    { }
+
+    //! Compare shortlist entries.
+    /*!
+     * Compares shortlist entries by Lambert transfer \f$\Delta V\f$, followed by transfer_id
+     * (i.e., order of insertion in result sink).
+     *
+     * @param[in] entry Shortlist entry to compare to
+     * @return          True if this entry is better than the given entry
+     */
+    bool operator<( const J2AnalysisShortlistEntry& entry ) const
+    {
+        if ( lambertTransferDeltaV != entry.lambertTransferDeltaV )
+        {
+            return lambertTransferDeltaV < entry.lambertTransferDeltaV;
+        }
+
+        return transferId < entry.transferId;
+    }
+
+    //! ID of record in result sink (transfer_id).
+    long long transferId;
+
+    //! Lambert transfer \f$\Delta V\f$.
+    double lambertTransferDeltaV;
+
+    //! Departure object ID of Lambert transfer.
+    int departureObjectId;
+
+    //! Arrival object ID of Lambert transfer.
+    int arrivalObjectId;
+
+    //! Record written to result sink, containing values of j2_analysis result fields.
+    ResultRecord record;
+
+protected:
+
+private:
+};
+
+//! Get shortlist key of j2_analysis shortlist entry (Lambert transfer \f$\Delta V\f$).
+inline double getShortlistKey( const J2AnalysisShortlistEntry& entry )
+{
+    return entry.lambertTransferDeltaV;
+}
+
+//! Bounded shortlist of j2_analysis records with lowest Lambert transfer \f$\Delta V\f$.
+typedef Shortlist< J2AnalysisShortlistEntry > J2AnalysisShortlist;
+
+//! List of j2_analysis shortlist entries.
+typedef std::vector< J2AnalysisShortlistEntry > J2AnalysisShortlistEntries;
+
 //! Write transfer shortlist to file.
 /*!
  * Writes shortlist of the J2 perturbation analysis on Lambert transfer orbits to file. The
  * shortlist is based on the requested number of transfers with the lowest
- * Lambert transfer \f$\Delta V\f$, retrieved by sorting the transfers in the
- * "lambert_Scanner_results" table in the SQLite database.
+ * Lambert transfer \f$\Delta V\f$, retained while the J2 analysis is executed.
  *
- * @sa executeJ2Analysis, createJ2AnalysisTable
- * @param[in] database        SQLite database handle
- * @param[in] shortlistNumber Number of entries to include in shortlist (if it exceeds number of
- *                            entries in database table, the whole table is written to file)
- * @param[in] shortlistPath   Path to shortlist file
+ * @sa executeJ2Analysis, J2AnalysisShortlist
+ * @param[in] shortlistEntries Shortlist entries, sorted by Lambert transfer \f$\Delta V\f$
+ *                             (ascending)
+ * @param[in] shortlistPath    Path to shortlist file
  */
-void writeJ2TransferShortlist( SQLite::Database& database,
-                               const int shortlistNumber,
+void writeJ2TransferShortlist( const J2AnalysisShortlistEntries& shortlistEntries,
                                const std::string& shortlistPath );
 
 } // namespace d2d
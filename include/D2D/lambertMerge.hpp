@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_LAMBERT_MERGE_HPP
+#define D2D_LAMBERT_MERGE_HPP
+
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "D2D/database.hpp"
+
+namespace d2d
+{
+
+//! Merge lambert_scanner shard databases.
+/*!
+ * Merges the databases written by lambert_scanner processes that each processed a shard of the
+ * departure objects (see executeLambertScanner()) into a single database. The transfers are
+ * copied shard by shard in the order given and are assigned new transfer IDs, such that the
+ * merged "lambert_scanner_results" table is identical to the table written by a single
+ * lambert_scanner run. The departure objects recorded in the "lambert_scanner_progress" tables
+ * are merged as well. An error is thrown if the shards store different TLE catalogs or if a
+ * shard did not complete its slice of the departure objects. If the shards store their run
+ * parameters, these must match apart from the shard index; the merged database stores them as the
+ * parameters of a single unsharded run, such that it can be updated incrementally.
+ *
+ * The table indices are created once all shards have been merged. Optionally, a shortlist of the
+ * transfers with the lowest transfer \f$\Delta V\f$ is written to file.
+ *
+ * This function is executed if the user provides "lambert_merge" as the application mode.
+ *
+ * @sa executeLambertScanner, mergeLambertScannerShard
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ */
+void executeLambertMerge( const rapidjson::Document& config );
+
+//! Input for lambert_merge application mode.
+/*!
+ * Data struct containing all valid lambert_merge input parameters. This struct is populated by
+ * the checkLambertMergeInput() function and can be used to execute the lambert_merge application
+ * mode.
+ *
+ * @sa checkLambertMergeInput, executeLambertMerge
+ */
+struct LambertMergeInput
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkLambertMergeInput, executeLambertMerge
+     * @param[in] someShardDatabasePaths Paths to SQLite shard databases, in shard order
+     * @param[in] aDatabasePath          Path to merged SQLite database
+     * @param[in] aShortlistLength       Number of transfers to include in shortlist
+     * @param[in] aShortlistPath         Path to shortlist file
+     * @param[in] someDatabaseSettings   Bulk-load settings for merged SQLite database
+     */
+    LambertMergeInput( const std::vector< std::string >& someShardDatabasePaths,
+                       const std::string&                aDatabasePath,
+                       const int                         aShortlistLength,
+                       const std::string&                aShortlistPath,
+                       const DatabaseSettings&           someDatabaseSettings )
+        : shardDatabasePaths( someShardDatabasePaths ),
+          databasePath( aDatabasePath ),
+          shortlistLength( aShortlistLength ),
+          shortlistPath( aShortlistPath ),
+          databaseSettings( someDatabaseSettings )
+    { }
+
+    //! Paths to SQLite shard databases, in shard order.
+    const std::vector< std::string > shardDatabasePaths;
+
+    //! Path to merged SQLite database.
+    const std::string databasePath;
+
+    //! Number of entries (lowest transfer \f$\Delta V\f$) to include in shortlist.
+    const int shortlistLength;
+
+    //! Path to shortlist file.
+    const std::string shortlistPath;
+
+    //! Bulk-load settings for merged SQLite database.
+    const DatabaseSettings databaseSettings;
+
+protected:
+
+private:
+};
+
+//! Check lambert_merge input parameters.
+/*!
+ * Checks that all inputs for the lambert_merge application mode are valid. If not, an error is
+ * thrown with a short description of the problem. If all inputs are valid, a data struct
+ * containing all the inputs is returned.
+ *
+ * @sa executeLambertMerge, LambertMergeInput
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           Struct containing all valid input to execute lambert_merge
+ */
+LambertMergeInput checkLambertMergeInput( const rapidjson::Document& config );
+
+//! Merge lambert_scanner shard database.
+/*!
+ * Appends the transfers and progress stored in a lambert_scanner shard database to the tables in
+ * the merged database. The transfers are appended in order of their transfer ID in the shard and
+ * are assigned new transfer IDs. The shard is merged in a single transaction.
+ *
+ * Before merging, the shard is checked: an error is thrown if the shard index and number of
+ * shards stored in its run parameters (if any) do not match the given shard position, if its
+ * catalog or run parameters (apart from the shard index and number of shards) differ from those
+ * of the shards merged so far, or if its progress does not cover exactly its slice of the
+ * departure objects, i.e., objects [size*k/n, size*(k+1)/n) for shard k of n and catalog size
+ * "size".
+ *
+ * The merged database must contain a run parameters table if and only if the shard stores its
+ * run parameters (see createLambertScannerParametersTable()). If the table is empty, the run
+ * parameters of the shard are stored as those of an unsharded run (shard 0 of 1).
+ *
+ * @sa executeLambertMerge
+ * @param[in] database          Merged SQLite database handle
+ * @param[in] shardDatabasePath Path to SQLite shard database
+ * @param[in] shardIndex        Index of shard, i.e., position of shard in merge order
+ * @param[in] numberOfShards    Number of shards
+ * @return                      Number of transfers merged
+ */
+long long mergeLambertScannerShard( SQLite::Database& database,
+                                    const std::string& shardDatabasePath,
+                                    const int shardIndex,
+                                    const int numberOfShards );
+
+} // namespace d2d
+
+#endif // D2D_LAMBERT_MERGE_HPP
@@ -7,16 +7,35 @@
 #ifndef D2D_LAMBERT_SCANNER_HPP
 #define D2D_LAMBERT_SCANNER_HPP
 
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/array.hpp>
 
 #include <keplerian_toolbox.h>
 
 #include <libsgp4/DateTime.h>
+#include <libsgp4/SGP4.h>
+#include <libsgp4/Tle.h>
 
 #include <rapidjson/document.h>
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "D2D/columnStore.hpp"
+#include "D2D/database.hpp"
+#include "D2D/ephemeris.hpp"
+#include "D2D/lambertTargeter.hpp"
+#include "D2D/resultSink.hpp"
+#include "D2D/shortlist.hpp"
+#include "D2D/typedefs.hpp"
+
 namespace d2d
 {
 
@@ -24,12 +43,72 @@ namespace d2d
 /*!
  * Executes lambert_scanner application mode that performs a grid search to compute \f$\Delta V\f$
  * for debris-to-debris transfers. The transfers are modelled as conic sections. The Lambert
- * targeter employed is based on Izzo (2014), implemented in PyKEP (Izzo, 2012).
+ * targeter employed is based on Izzo (2014), following the implementation in PyKEP (Izzo, 2012)
+ * (see LambertBatchTargeter). The Lambert problems along the time-of-flight grid are solved as a
+ * batch. By default, the problems are cold-started and iterated in lock-step; if the "warm_start"
+ * option is set, the iterations for each grid point are warm-started from the solutions at the
+ * previous grid points instead, which takes fewer iterations, but iterates the problems one after
+ * the other.
  *
  * The results obtained from the grid search are stored in a SQLite database, containing the
  * following table:
  *
  *	- "lambert_scanner_results": contains all Lambert transfers computed during grid search
+ *	- "lambert_scanner_progress": contains all departure objects for which all transfers have
+ *	  been stored
+ *	- "lambert_scanner_catalog": contains the TLE catalog used to compute the transfers
+ *
+ * The "lambert_scanner_results" table optionally uses a compact schema (set by the "schema"
+ * option), which omits the state vectors and Keplerian elements of the departure, arrival and
+ * transfer orbits. These are recomputed from the stored catalog when needed (see
+ * LambertScannerTransferReader).
+ *
+ * The transaction is optionally committed at departure object boundaries (set by the
+ * "checkpoint_interval" option), such that an interrupted run can be resumed (set by the "resume"
+ * option). A resumed run skips the departure objects recorded in the progress table and appends
+ * to the existing tables; it must be executed with the same catalog and input parameters (see
+ * checkLambertScannerResume()).
+ *
+ * A database can optionally be updated incrementally for a new catalog (set by the "incremental"
+ * option), e.g., a daily catalog update. The new catalog is compared with the catalog stored by the
+ * previous run (see compareLambertScannerCatalog()): objects are matched by NORAD ID, which must be
+ * unique in the catalog (see checkLambertScannerCatalog()), and an object is changed if its TLE
+ * lines (i.e., its epoch, elements or checksum) differ. The transfers of changed and removed
+ * objects are deleted (see deleteLambertScannerTransfers()) and only the object pairs that include
+ * a changed or new object are recomputed, such that the cost of an update scales with the number of
+ * changed objects. An incremental update must be executed with the same input parameters as the
+ * previous run, which are stored in the parameters table when the database is created (see
+ * checkLambertScannerParameters()), and is committed in a single transaction.
+ *
+ * The departure objects can optionally be split in contiguous shards (set by the "shard" option),
+ * which are processed by independent processes that each write their own database. The shard
+ * databases are combined using the lambert_merge application mode (see executeLambertMerge()).
+ *
+ * Transfers can optionally be rejected if their \f$\Delta V\f$ exceeds a cut-off or if the
+ * periapsis of the transfer orbit is below a minimum altitude. Rejected transfers are counted, but
+ * not stored in the database.
+ *
+ * Object pairs can optionally be pre-screened using an analytic estimate of the transfer
+ * \f$\Delta V\f$ (see estimateTransferDeltaV()). Pairs for which the estimate exceeds the
+ * screening cut-off at all departure epochs are skipped without executing the Lambert targeter.
+ *
+ * Prograde and retrograde transfers can optionally be computed in a single run (set by the
+ * "direction" option), such that the catalog is parsed and the objects are propagated once for
+ * both directions. The transfers of both directions are stored, distinguished by the "prograde"
+ * column.
+ *
+ * The grids can optionally be refined adaptively (set by the "grid_refinement" option). The
+ * departure epoch and time-of-flight grids then act as a coarse grid per object pair: only the
+ * local \f$\Delta V\f$ minima on the coarse grid are refined, down to the given resolution,
+ * and only the refined optima are stored (see refineLambertScannerGridMinimum()).
+ *
+ * The departure objects are grouped in blocks, which are distributed across a pool of worker
+ * threads (set by the "threads" option). Each worker fills its own buffer with the transfers
+ * computed for a departure block. Within a block, the arrival objects are processed in blocks that
+ * are sized such that their ephemerides remain in cache while they are paired with all departure
+ * objects in the block (set by the "tile_size" option or tuned automatically). The calling thread
+ * is the only thread that writes to the database: it drains the buffers in departure object order,
+ * so that the output is independent of the number of threads and tile size used.
  *
  * @param[in] config User-defined configuration options (extracted from JSON input file)
  */
@@ -63,9 +142,42 @@ public:
      * @param[in] aTimeOfFlightStepSize    Time-of-flight step size (derived parameter) [s]
      * @param[in] progradeFlag             Flag indicating if prograde transfer should be computed
      *                                     (false = retrograde)
+     * @param[in] bidirectionalFlag        Flag indicating if both prograde and retrograde
+     *                                     transfers are computed (requires progradeFlag = true)
      * @param[in] aRevolutionsMaximum      Maximum number of revolutions
+     * @param[in] warmStartFlag            Flag indicating if Lambert iterations along the
+     *                                     time-of-flight grid are warm-started
+     * @param[in] aTransferDeltaVCutoff    Transfer \f$\Delta V\f$ cut-off (0 = no cut-off) [km/s]
+     * @param[in] aTransferPeriapsisRadiusMinimum
+     *                                     Minimum periapsis radius of transfer orbit
+     *                                     (0 = no minimum) [km]
+     * @param[in] aPairScreeningCutoff     Cut-off for estimated transfer \f$\Delta V\f$ used to
+     *                                     pre-screen object pairs (0 = no screening) [km/s]
+     * @param[in] aDepartureEpochResolution
+     *                                     Departure epoch resolution of adaptive grid refinement
+     *                                     (0 = no refinement) [s]
+     * @param[in] aTimeOfFlightResolution  Time-of-flight resolution of adaptive grid refinement
+     *                                     (0 = no refinement) [s]
      * @param[in] aShortlistLength         Number of transfers to include in shortlist
      * @param[in] aShortlistPath           Path to shortlist file
+     * @param[in] numberOfThreads          Number of worker threads used to compute transfers
+     * @param[in] aDepartureBlockSize      Number of departure objects per tile (0 = automatic)
+     * @param[in] anArrivalBlockSize       Number of arrival objects per tile (0 = automatic)
+     * @param[in] aCheckpointInterval      Number of departure objects between commits
+     *                                     (0 = commit once all transfers are stored)
+     * @param[in] resumeFlag               Flag indicating if an interrupted run is resumed
+     * @param[in] incrementalFlag          Flag indicating if the database of a previous run is
+     *                                     updated incrementally for a new catalog
+     * @param[in] aShardIndex              Index of shard of departure objects to process
+     * @param[in] someShards               Number of shards that departure objects are split in
+     * @param[in] compactFlag              Flag indicating if compact schema is used for
+     *                                     "lambert_scanner_results" table
+     * @param[in] aColumnStorePath         Path to column store directory that transfers are
+     *                                     written to instead of the "lambert_scanner_results"
+     *                                     table (empty = SQLite table)
+     * @param[in] someResultSinkSettings   Result sink that transfers are written to
+     * @param[in] someDatabaseSettings     Bulk-load settings for SQLite database
+     * @param[in] anEphemerisCachePath     Path to ephemeris cache directory (empty = no cache)
      */
     LambertScannerInput( const std::string& aCatalogPath,
                          const std::string& aDatabasePath,
@@ -77,9 +189,29 @@ public:
                          const double       someTimeOfFlightSteps,
                          const double       aTimeOfFlightStepSize,
                          const bool         progradeFlag,
+                         const bool         bidirectionalFlag,
                          const int          aRevolutionsMaximum,
+                         const bool         warmStartFlag,
+                         const double       aTransferDeltaVCutoff,
+                         const double       aTransferPeriapsisRadiusMinimum,
+                         const double       aPairScreeningCutoff,
+                         const double       aDepartureEpochResolution,
+                         const double       aTimeOfFlightResolution,
                          const int          aShortlistLength,
-                         const std::string& aShortlistPath )
+                         const std::string& aShortlistPath,
+                         const int          numberOfThreads,
+                         const int          aDepartureBlockSize,
+                         const int          anArrivalBlockSize,
+                         const int          aCheckpointInterval,
+                         const bool         resumeFlag,
+                         const bool         incrementalFlag,
+                         const int          aShardIndex,
+                         const int          someShards,
+                         const bool         compactFlag,
+                         const std::string& aColumnStorePath,
+                         const ResultSinkSettings& someResultSinkSettings,
+                         const DatabaseSettings& someDatabaseSettings,
+                         const std::string& anEphemerisCachePath )
         : catalogPath( aCatalogPath ),
           databasePath( aDatabasePath ),
           departureEpochInitial( aDepartureEpochInitial ),
@@ -90,9 +222,29 @@ public:
           timeOfFlightSteps( someTimeOfFlightSteps ),
           timeOfFlightStepSize( aTimeOfFlightStepSize ),
           isPrograde( progradeFlag ),
+          isBidirectional( bidirectionalFlag ),
           revolutionsMaximum( aRevolutionsMaximum ),
+          isWarmStarted( warmStartFlag ),
+          transferDeltaVCutoff( aTransferDeltaVCutoff ),
+          transferPeriapsisRadiusMinimum( aTransferPeriapsisRadiusMinimum ),
+          pairScreeningCutoff( aPairScreeningCutoff ),
+          departureEpochResolution( aDepartureEpochResolution ),
+          timeOfFlightResolution( aTimeOfFlightResolution ),
           shortlistLength( aShortlistLength ),
-          shortlistPath( aShortlistPath )
+          shortlistPath( aShortlistPath ),
+          threads( numberOfThreads ),
+          departureBlockSize( aDepartureBlockSize ),
+          arrivalBlockSize( anArrivalBlockSize ),
+          checkpointInterval( aCheckpointInterval ),
+          isResumed( resumeFlag ),
+          isIncremental( incrementalFlag ),
+          shardIndex( aShardIndex ),
+          numberOfShards( someShards ),
+          isCompact( compactFlag ),
+          columnStorePath( aColumnStorePath ),
+          resultSinkSettings( someResultSinkSettings ),
+          databaseSettings( someDatabaseSettings ),
+          ephemerisCachePath( anEphemerisCachePath )
     { }
 
     //! Path to TLE catalog.
@@ -125,20 +277,562 @@ public:
     //! Flag indicating if transfers are prograde. False indicates retrograde.
     const bool isPrograde;
 
+    //! Flag indicating if retrograde transfers are computed in addition to prograde transfers.
+    const bool isBidirectional;
+
+    //! Get number of transfer directions.
+    /*!
+     * Returns number of transfer directions computed per grid point: two if both prograde and
+     * retrograde transfers are computed, one otherwise.
+     *
+     * @return Number of transfer directions
+     */
+    int getNumberOfDirections( ) const { return isBidirectional ? 2 : 1; }
+
+    //! Check if transfer direction is prograde.
+    /*!
+     * Checks if transfers in given transfer direction are prograde. If both directions are
+     * computed, direction 0 is prograde and direction 1 is retrograde.
+     *
+     * @param[in] directionIndex Index of transfer direction (0 <= index < getNumberOfDirections())
+     * @return                   True if transfers in given direction are prograde
+     */
+    bool isDirectionPrograde( const int directionIndex ) const
+    {
+        return isPrograde && directionIndex == 0;
+    }
+
     //! Maximum number of revolutions (N) for transfer. Number of revolutions is 2*N+1.
     const int revolutionsMaximum;
 
+    //! Flag indicating if Lambert iterations along the time-of-flight grid are warm-started from
+    //! the solutions at the previous grid points (false = cold-started, solved in lock-step).
+    const bool isWarmStarted;
+
+    //! Transfer \f$\Delta V\f$ cut-off; transfers above cut-off are not stored (0 = no cut-off).
+    const double transferDeltaVCutoff;
+
+    //! Minimum periapsis radius of transfer orbit [km] (0 = no minimum).
+    const double transferPeriapsisRadiusMinimum;
+
+    //! Cut-off for estimated transfer \f$\Delta V\f$ used to pre-screen object pairs [km/s]
+    //! (0 = no screening).
+    const double pairScreeningCutoff;
+
+    //! Departure epoch resolution of adaptive grid refinement [s] (0 = no refinement).
+    const double departureEpochResolution;
+
+    //! Time-of-flight resolution of adaptive grid refinement [s] (0 = no refinement).
+    const double timeOfFlightResolution;
+
+    //! Check if grid is refined adaptively.
+    /*!
+     * Checks if the departure epoch and time-of-flight grids are refined adaptively around the
+     * local \f$\Delta V\f$ minima.
+     *
+     * @return True if grid is refined adaptively
+     */
+    bool isGridRefined( ) const { return departureEpochResolution > 0.0; }
+
     //! Number of entries (lowest transfer \f$\Delta V\f$) to include in shortlist.
     const int shortlistLength;
 
     //! Path to shortlist file.
     const std::string shortlistPath;
 
+    //! Number of worker threads used to compute transfers.
+    const int threads;
+
+    //! Number of departure objects per tile (0 = automatic).
+    const int departureBlockSize;
+
+    //! Number of arrival objects per tile (0 = automatic).
+    const int arrivalBlockSize;
+
+    //! Number of departure objects between commits (0 = commit once all transfers are stored).
+    const int checkpointInterval;
+
+    //! Flag indicating if an interrupted run is resumed.
+    const bool isResumed;
+
+    //! Flag indicating if the database of a previous run is updated incrementally.
+    const bool isIncremental;
+
+    //! Index of shard of departure objects to process (0 <= shardIndex < numberOfShards).
+    const int shardIndex;
+
+    //! Number of shards that departure objects are split in.
+    const int numberOfShards;
+
+    //! Flag indicating if compact schema is used for "lambert_scanner_results" table.
+    const bool isCompact;
+
+    //! Path to column store directory (empty = transfers are stored in SQLite table).
+    const std::string columnStorePath;
+
+    //! Result sink that transfers are written to.
+    const ResultSinkSettings resultSinkSettings;
+
+    //! Bulk-load settings for SQLite database.
+    const DatabaseSettings databaseSettings;
+
+    //! Path to ephemeris cache directory (empty = ephemerides are not cached).
+    const std::string ephemerisCachePath;
+
+protected:
+
+private:
+};
+
+//! Lambert transfer computed by lambert_scanner.
+/*!
+ * Data struct containing a single Lambert transfer computed by lambert_scanner. The members map
+ * one-to-one onto the columns of the "lambert_scanner_results" table.
+ *
+ * @sa computeLambertScannerTransfers, getLambertScannerTransferRow
+ */
+struct LambertScannerTransfer
+{
+public:
+
+    //! Departure object ID (NORAD number).
+    int departureObjectId;
+
+    //! Arrival object ID (NORAD number).
+    int arrivalObjectId;
+
+    //! Departure epoch [Julian date].
+    double departureEpoch;
+
+    //! Time-of-flight [s].
+    double timeOfFlight;
+
+    //! Number of revolutions for the lowest \f$\Delta V\f$ solution.
+    int revolutions;
+
+    //! Flag indicating if transfer is prograde.
+    bool isPrograde;
+
+    //! Cartesian state of departure object at departure epoch [km; km/s].
+    Vector6 departureState;
+
+    //! Keplerian elements of departure object at departure epoch.
+    Vector6 departureStateKepler;
+
+    //! Cartesian state of arrival object at arrival epoch [km; km/s].
+    Vector6 arrivalState;
+
+    //! Keplerian elements of arrival object at arrival epoch.
+    Vector6 arrivalStateKepler;
+
+    //! Keplerian elements of transfer orbit at departure epoch.
+    Vector6 transferStateKepler;
+
+    //! Departure \f$\Delta V\f$ vector [km/s].
+    Vector3 departureDeltaV;
+
+    //! Arrival \f$\Delta V\f$ vector [km/s].
+    Vector3 arrivalDeltaV;
+
+    //! Total transfer \f$\Delta V\f$ [km/s].
+    double transferDeltaV;
+
 protected:
 
 private:
 };
 
+//! Buffer of Lambert transfers.
+typedef std::vector< LambertScannerTransfer > LambertScannerTransfers;
+
+//! Statistics for lambert_scanner.
+/*!
+ * Data struct containing counters of the transfers computed and rejected during the grid search.
+ * Each worker thread keeps its own counters, which are summed once all workers have completed.
+ *
+ * @sa executeLambertScannerWorker, computeLambertScannerTransfers
+ */
+struct LambertScannerStatistics
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with all counters set to zero.
+     */
+    LambertScannerStatistics( )
+        : pairsScreened( 0 ),
+          transfersComputed( 0 ),
+          lambertIterations( 0 ),
+          gridMinimaRefined( 0 ),
+          transfersRejectedDeltaV( 0 ),
+          transfersRejectedPeriapsis( 0 )
+    { }
+
+    //! Add statistics.
+    /*!
+     * Adds counters of given statistics to counters of this data struct.
+     *
+     * @param[in] statistics Statistics to add
+     * @return               Reference to this data struct
+     */
+    LambertScannerStatistics& operator+=( const LambertScannerStatistics& statistics )
+    {
+        pairsScreened               += statistics.pairsScreened;
+        transfersComputed           += statistics.transfersComputed;
+        lambertIterations           += statistics.lambertIterations;
+        gridMinimaRefined           += statistics.gridMinimaRefined;
+        transfersRejectedDeltaV     += statistics.transfersRejectedDeltaV;
+        transfersRejectedPeriapsis  += statistics.transfersRejectedPeriapsis;
+        return *this;
+    }
+
+    //! Number of object pairs skipped by pre-screening.
+    long long pairsScreened;
+
+    //! Number of transfers computed (grid points, including points evaluated by adaptive grid
+    //! refinement, for which Lambert targeter was executed).
+    long long transfersComputed;
+
+    //! Number of Householder iterations executed by Lambert targeter.
+    long long lambertIterations;
+
+    //! Number of local \f$\Delta V\f$ minima refined by adaptive grid refinement.
+    long long gridMinimaRefined;
+
+    //! Number of transfers rejected because transfer \f$\Delta V\f$ exceeds cut-off.
+    long long transfersRejectedDeltaV;
+
+    //! Number of transfers rejected because no solution satisfies minimum periapsis radius.
+    long long transfersRejectedPeriapsis;
+
+protected:
+
+private:
+};
+
+//! Workspace for lambert_scanner.
+/*!
+ * Data struct containing the batched Lambert targeter, the batch of Lambert problems along the
+ * time-of-flight grid and the buffers of \f$\Delta V\f$ per solution used for each grid point.
+ * For adaptive grid refinement, it also contains the lowest \f$\Delta V\f$ per grid point of
+ * the coarse grid and a second Lambert targeter for the points evaluated around each local
+ * minimum. The storage is sized from the grids and the maximum number of revolutions when the
+ * workspace is constructed and reused across grid points, such that the grid search does not
+ * allocate memory on the heap. Each worker thread keeps its own workspace.
+ *
+ * @sa executeLambertScannerWorker, computeLambertScannerTransfers, LambertBatchTargeter,
+ *     refineLambertScannerGridMinimum
+ */
+struct LambertScannerWorkspace
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs workspace for batches of Lambert problems along the time-of-flight grid, with up
+     * to the given maximum number of revolutions.
+     *
+     * @param[in] departureEpochSteps Number of steps in departure epoch grid
+     * @param[in] timeOfFlightSteps   Number of steps in time-of-flight grid (batch size)
+     * @param[in] revolutionsMaximum  Maximum number of revolutions
+     */
+    LambertScannerWorkspace( const int departureEpochSteps,
+                             const int timeOfFlightSteps,
+                             const int revolutionsMaximum )
+        : targeter( timeOfFlightSteps, revolutionsMaximum ),
+          departurePositions( timeOfFlightSteps ),
+          arrivalPositions( timeOfFlightSteps ),
+          timesOfFlight( timeOfFlightSteps ),
+          departureDeltaVs( 2 * revolutionsMaximum + 1 ),
+          arrivalDeltaVs( 2 * revolutionsMaximum + 1 ),
+          transferDeltaVs( 2 * revolutionsMaximum + 1 ),
+          refinementTargeter( 8, revolutionsMaximum )
+    {
+        gridDeltaVs[ 0 ].resize( departureEpochSteps * timeOfFlightSteps );
+        gridDeltaVs[ 1 ].resize( departureEpochSteps * timeOfFlightSteps );
+        gridMinimumIndices.reserve( gridDeltaVs[ 0 ].size( ) );
+        refinedGridPoints.reserve( gridDeltaVs[ 0 ].size( ) );
+        refinementDepartureEpochOffsets.reserve( 8 );
+        refinementTimesOfFlight.reserve( 8 );
+        refinementDeparturePositions.reserve( 8 );
+        refinementArrivalPositions.reserve( 8 );
+        refinementDepartureStates.reserve( 8 );
+        refinementArrivalStates.reserve( 8 );
+        refinementDeltaVs.reserve( 8 );
+        refinementSolutionIndices.reserve( 8 );
+    }
+
+    //! Batched Lambert targeter.
+    LambertBatchTargeter targeter;
+
+    //! Departure position per time-of-flight grid point [km].
+    std::vector< Vector3 > departurePositions;
+
+    //! Arrival position per time-of-flight grid point [km].
+    std::vector< Vector3 > arrivalPositions;
+
+    //! Time-of-flight per time-of-flight grid point [s].
+    std::vector< double > timesOfFlight;
+
+    //! Departure \f$\Delta V\f$ vector per solution [km/s].
+    std::vector< Vector3 > departureDeltaVs;
+
+    //! Arrival \f$\Delta V\f$ vector per solution [km/s].
+    std::vector< Vector3 > arrivalDeltaVs;
+
+    //! Total transfer \f$\Delta V\f$ per solution [km/s].
+    std::vector< double > transferDeltaVs;
+
+    //! Lowest transfer \f$\Delta V\f$ per coarse grid point [km/s] per transfer direction,
+    //! indexed by departureEpochIndex * timeOfFlightSteps + timeOfFlightIndex.
+    boost::array< std::vector< double >, 2 > gridDeltaVs;
+
+    //! Indices of local \f$\Delta V\f$ minima on coarse grid.
+    std::vector< int > gridMinimumIndices;
+
+    //! Refined grid points (departure epoch offset [s], time-of-flight [s]) of current pair.
+    std::vector< std::pair< double, double > > refinedGridPoints;
+
+    //! Batched Lambert targeter used for adaptive grid refinement.
+    LambertBatchTargeter refinementTargeter;
+
+    //! Departure epoch offset from initial departure epoch per refinement point [s].
+    std::vector< double > refinementDepartureEpochOffsets;
+
+    //! Time-of-flight per refinement point [s].
+    std::vector< double > refinementTimesOfFlight;
+
+    //! Departure position per refinement point [km].
+    std::vector< Vector3 > refinementDeparturePositions;
+
+    //! Arrival position per refinement point [km].
+    std::vector< Vector3 > refinementArrivalPositions;
+
+    //! Cartesian state of departure object per refinement point [km; km/s].
+    std::vector< Vector6 > refinementDepartureStates;
+
+    //! Cartesian state of arrival object per refinement point [km; km/s].
+    std::vector< Vector6 > refinementArrivalStates;
+
+    //! Lowest transfer \f$\Delta V\f$ per refinement point [km/s].
+    std::vector< double > refinementDeltaVs;
+
+    //! Index of solution with lowest transfer \f$\Delta V\f$ per refinement point.
+    std::vector< int > refinementSolutionIndices;
+
+protected:
+
+private:
+};
+
+//! Entry in lambert_scanner shortlist.
+/*!
+ * Data struct containing a Lambert transfer retained in the lambert_scanner shortlist, together
+ * with its position in the work queue and in the buffer of transfers for its departure block.
+ * The position is used to recover the transfer_id assigned by the database writer and to break
+ * ties between transfers with equal \f$\Delta V\f$ deterministically. Entries for transfers
+ * stored by a previous run (resumed or incremental runs) already have a transfer_id, which is
+ * used to break ties instead.
+ *
+ * @sa LambertScannerShortlist, executeLambertScannerWorker
+ */
+struct LambertScannerShortlistEntry
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs shortlist entry for Lambert transfer.
+     *
+     * @param[in] aTransfer      Lambert transfer
+     * @param[in] aQueuePosition Position of buffer of transfers in work queue
+     * @param[in] aBufferIndex   Index of transfer in buffer of transfers
+     */
+    LambertScannerShortlistEntry( const LambertScannerTransfer& aTransfer,
+                                  const unsigned int aQueuePosition,
+                                  const unsigned int aBufferIndex )
+        : transfer( aTransfer ),
+          queuePosition( aQueuePosition ),
+          bufferIndex( aBufferIndex ),
+          transferId( 0 )
+    { }
+
+    //! Compare shortlist entries.
+    /*!
+     * Compares shortlist entries by transfer \f$\Delta V\f$, followed by order of insertion in
+     * database: transfers stored by a previous run precede transfers in the work queue and are
+     * ordered by transfer_id; transfers in the work queue are ordered by position in work queue
+     * and buffer of transfers.
+     *
+     * @param[in] entry Shortlist entry to compare to
+     * @return          True if this entry is better than the given entry
+     */
+    bool operator<( const LambertScannerShortlistEntry& entry ) const
+    {
+        if ( transfer.transferDeltaV != entry.transfer.transferDeltaV )
+        {
+            return transfer.transferDeltaV < entry.transfer.transferDeltaV;
+        }
+
+        if ( ( transferId != 0 ) != ( entry.transferId != 0 ) )
+        {
+            return transferId != 0;
+        }
+
+        if ( transferId != 0 )
+        {
+            return transferId < entry.transferId;
+        }
+
+        if ( queuePosition != entry.queuePosition )
+        {
+            return queuePosition < entry.queuePosition;
+        }
+
+        return bufferIndex < entry.bufferIndex;
+    }
+
+    //! Lambert transfer.
+    LambertScannerTransfer transfer;
+
+    //! Position of buffer of transfers in work queue.
+    unsigned int queuePosition;
+
+    //! Index of transfer in buffer of transfers.
+    unsigned int bufferIndex;
+
+    //! transfer_id assigned to transfer in lambert_scanner_results table.
+    long long transferId;
+
+protected:
+
+private:
+};
+
+//! Get shortlist key of lambert_scanner shortlist entry (transfer \f$\Delta V\f$).
+inline double getShortlistKey( const LambertScannerShortlistEntry& entry )
+{
+    return entry.transfer.transferDeltaV;
+}
+
+//! Bounded shortlist of Lambert transfers with lowest transfer \f$\Delta V\f$.
+typedef Shortlist< LambertScannerShortlistEntry > LambertScannerShortlist;
+
+//! List of lambert_scanner shortlist entries.
+typedef std::vector< LambertScannerShortlistEntry > LambertScannerShortlistEntries;
+
+//! Work queue shared by lambert_scanner worker threads and database writer.
+/*!
+ * Hands out blocks of departure objects to worker threads and collects the buffers of transfers
+ * computed for each departure block. Buffers are retrieved by the database writer in the order in
+ * which the departure blocks are listed, irrespective of the order in which workers complete
+ * them.
+ *
+ * The number of departure blocks claimed, but not yet retrieved by the writer, is bounded.
+ * Workers block when this bound is reached, which limits the memory used by buffers waiting to be
+ * written if the database writer falls behind.
+ *
+ * @sa executeLambertScanner, computeLambertScannerTransfers
+ */
+class LambertScannerWorkQueue
+{
+public:
+
+    //! Construct work queue.
+    /*!
+     * Constructs work queue for a list of departure blocks.
+     *
+     * @param[in] someDepartureBlockIndices Indices of departure blocks to process, in the order in
+     *                                      which they are written
+     * @param[in] aMaximumBuffersInFlight   Maximum number of departure blocks claimed by workers
+     *                                      that have not yet been retrieved by the writer
+     */
+    LambertScannerWorkQueue( const std::vector< unsigned int >& someDepartureBlockIndices,
+                             const unsigned int aMaximumBuffersInFlight );
+
+    //! Claim next departure block.
+    /*!
+     * Claims the next departure block to process. Blocks if the maximum number of buffers in
+     * flight has been reached.
+     *
+     * @param[out] departureBlockIndex Index of departure block
+     * @param[out] queuePosition       Position of departure block in work queue
+     * @return                         False if there are no departure blocks left to process or
+     *                                 the queue has been aborted; true otherwise
+     */
+    bool claim( unsigned int& departureBlockIndex, unsigned int& queuePosition );
+
+    //! Submit buffer of transfers.
+    /*!
+     * Submits buffer of transfers computed for the departure block at the given position in the
+     * work queue. The contents of the buffer are moved into the queue.
+     *
+     * @param[in]     queuePosition Position of departure block in work queue
+     * @param[in,out] transfers     Buffer of transfers (empty on return)
+     */
+    void submit( const unsigned int queuePosition, LambertScannerTransfers& transfers );
+
+    //! Retrieve next buffer of transfers.
+    /*!
+     * Retrieves buffer of transfers for the next departure block in the work queue. Blocks until
+     * this buffer has been submitted. If a worker has reported an error, the error is rethrown.
+     *
+     * @param[out] transfers Buffer of transfers
+     * @return               False if all buffers have been retrieved; true otherwise
+     */
+    bool retrieve( LambertScannerTransfers& transfers );
+
+    //! Report error from worker thread.
+    /*!
+     * Stores error thrown in a worker thread, so that it is rethrown by retrieve(), and aborts
+     * the queue.
+     *
+     * @param[in] error Pointer to exception thrown in worker thread
+     */
+    void fail( const std::exception_ptr error );
+
+    //! Abort queue.
+    /*!
+     * Aborts queue, so that claim() returns false for all waiting and future calls.
+     */
+    void abort( );
+
+protected:
+
+private:
+
+    //! Indices of departure blocks to process.
+    const std::vector< unsigned int > departureBlockIndices;
+
+    //! Maximum number of buffers in flight.
+    const unsigned int maximumBuffersInFlight;
+
+    //! Position of next departure block to claim.
+    unsigned int nextClaimPosition;
+
+    //! Position of next buffer to retrieve.
+    unsigned int nextRetrievePosition;
+
+    //! Buffers submitted by workers, but not yet retrieved (key = queue position).
+    std::map< unsigned int, LambertScannerTransfers > submittedBuffers;
+
+    //! Flag indicating if queue has been aborted.
+    bool isAborted;
+
+    //! Error thrown in a worker thread.
+    std::exception_ptr workerError;
+
+    //! Mutex guarding the queue state.
+    std::mutex queueMutex;
+
+    //! Condition variable signalled when a departure block can be claimed.
+    std::condition_variable claimCondition;
+
+    //! Condition variable signalled when a buffer is submitted.
+    std::condition_variable submitCondition;
+};
+
 //! Check lambert_scanner input parameters.
 /*!
  * Checks that all inputs for the lambert_scanner application mode are valid. If not, an error is
@@ -155,27 +849,755 @@ LambertScannerInput checkLambertScannerInput( const rapidjson::Document& config
 //! Create lambert_scanner table.
 /*!
  * Creates lambert_scanner table in SQLite database used to store results obtaned from running
- * the lambert_scanner application mode.
+ * the lambert_scanner application mode. The compact schema omits the state vectors and Keplerian
+ * elements of the departure, arrival and transfer orbits.
+ *
+ * @sa executeLambertScanner, LambertScannerTransferReader
+ * @param[in] database  SQLite database handle
+ * @param[in] isCompact Flag indicating if compact schema is used
+ */
+void createLambertScannerTable( SQLite::Database& database, const bool isCompact );
+
+//! Create lambert_scanner table indices.
+/*!
+ * Creates indices on lambert_scanner table in SQLite database. The indices are created once all
+ * transfers have been inserted, which is cheaper than updating them for every insert.
+ *
+ * @sa executeLambertScanner, createLambertScannerTable
+ * @param[in] database SQLite database handle
+ */
+void createLambertScannerTableIndices( SQLite::Database& database );
+
+//! Create lambert_scanner catalog table.
+/*!
+ * Creates table in SQLite database used to store the TLE catalog used by lambert_scanner, such
+ * that the fields omitted in the compact schema can be recomputed.
+ *
+ * @sa executeLambertScanner, storeLambertScannerCatalog, LambertScannerTransferReader
+ * @param[in] database SQLite database handle
+ */
+void createLambertScannerCatalogTable( SQLite::Database& database );
+
+//! Check lambert_scanner catalog.
+/*!
+ * Checks that the NORAD ID of each TLE object is unique, since transfers and stored catalogs
+ * identify objects by NORAD ID. An error is thrown if a NORAD ID occurs more than once, e.g., for a
+ * catalog containing several epochs of the same object.
+ *
+ * @sa executeLambertScanner, storeLambertScannerCatalog, compareLambertScannerCatalog
+ * @param[in] tleObjects List of TLE objects parsed from catalog
+ */
+void checkLambertScannerCatalog( const TleObjects& tleObjects );
+
+//! Store lambert_scanner catalog.
+/*!
+ * Stores TLE objects in the lambert_scanner catalog table. The query is executed in the current
+ * transaction, if any. An error is thrown if the NORAD IDs of the objects are not unique (see
+ * checkLambertScannerCatalog()).
+ *
+ * @sa executeLambertScanner, createLambertScannerCatalogTable
+ * @param[in] database   SQLite database handle
+ * @param[in] tleObjects List of TLE objects parsed from catalog
+ */
+void storeLambertScannerCatalog( SQLite::Database& database, const TleObjects& tleObjects );
+
+//! Check if lambert_scanner table uses compact schema.
+/*!
+ * Checks if the "lambert_scanner_results" table in the SQLite database uses the compact schema.
+ * If the transfers are stored in a column store, the columns of the store are checked instead.
+ *
+ * @sa createLambertScannerTable, createLambertScannerColumnStoreTable
+ * @param[in] database SQLite database handle
+ * @return             True if the compact schema is used
+ */
+bool isLambertScannerTableCompact( SQLite::Database& database );
+
+//! Create lambert_scanner column store table.
+/*!
+ * Creates table in SQLite database that records the path to the column store that the
+ * lambert_scanner transfers are written to, such that the application modes that read the
+ * transfers (see LambertScannerTransferReader) use the column store instead of the
+ * "lambert_scanner_results" table. The "lambert_scanner_results" table is dropped.
+ *
+ * @sa executeLambertScanner, ColumnStore
+ * @param[in] database        SQLite database handle
+ * @param[in] columnStorePath Path to column store directory
+ */
+void createLambertScannerColumnStoreTable( SQLite::Database& database,
+                                           const std::string& columnStorePath );
+
+//! Get lambert_scanner column names.
+/*!
+ * Returns names of the columns of the "lambert_scanner_results" table, in table order, excluding
+ * the "transfer_id" column. These are also the columns of the lambert_scanner column store.
+ *
+ * @sa createLambertScannerTable, getLambertScannerTransferRow
+ * @param[in] isCompact Flag indicating if compact schema is used
+ * @return              Column names
+ */
+std::vector< std::string > getLambertScannerColumnNames( const bool isCompact );
+
+//! Get lambert_scanner result fields.
+/*!
+ * Returns fields of the records written by lambert_scanner to the result sink, i.e., the columns
+ * returned by getLambertScannerColumnNames() with their types.
+ *
+ * @sa getLambertScannerColumnNames, ResultSink
+ * @param[in] isCompact Flag indicating if compact schema is used
+ * @return              Result fields
+ */
+ResultFields getLambertScannerResultFields( const bool isCompact );
+
+//! Create lambert_scanner progress table.
+/*!
+ * Creates table in SQLite database used to record the departure objects for which all transfers
+ * have been stored by lambert_scanner. Progress is recorded in the same transaction as the
+ * transfers, so that the table is consistent with the "lambert_scanner_results" table.
+ *
+ * @sa executeLambertScanner, fetchLambertScannerProgress
+ * @param[in] database SQLite database handle
+ */
+void createLambertScannerProgressTable( SQLite::Database& database );
+
+//! Fetch lambert_scanner progress.
+/*!
+ * Fetches the departure objects recorded in the lambert_scanner progress table, in order to
+ * resume an interrupted run. An error is thrown if the tables do not exist, or if the recorded
+ * departure objects do not match the TLE object list.
+ *
+ * @sa executeLambertScanner, createLambertScannerProgressTable
+ * @param[in] database   SQLite database handle
+ * @param[in] tleObjects List of TLE objects parsed from catalog
+ * @return               Flags indicating if departure object has been completed, per TLE object
+ */
+std::vector< bool > fetchLambertScannerProgress( SQLite::Database& database,
+                                                 const TleObjects& tleObjects );
+
+//! Compare TLE catalog with lambert_scanner catalog.
+/*!
+ * Compares the TLE objects with the catalog stored in the lambert_scanner catalog table by a
+ * previous run, in order to update the database incrementally. Objects are matched by NORAD ID;
+ * an object is changed if it is not in the stored catalog, or if its TLE lines differ from the
+ * stored lines. An error is thrown if the tables of a previous run do not exist, or if the NORAD
+ * IDs of the objects are not unique (see checkLambertScannerCatalog()).
+ *
+ * @sa executeLambertScanner, deleteLambertScannerTransfers, storeLambertScannerCatalog
+ * @param[in]  database         SQLite database handle
+ * @param[in]  tleObjects       List of TLE objects parsed from catalog
+ * @param[out] removedObjectIds NORAD IDs of objects in stored catalog that are not in list of
+ *                              TLE objects
+ * @return                      Flags indicating if object is changed or new, per TLE object
+ */
+std::vector< bool > compareLambertScannerCatalog( SQLite::Database& database,
+                                                  const TleObjects& tleObjects,
+                                                  std::vector< int >& removedObjectIds );
+
+//! Delete lambert_scanner transfers.
+/*!
+ * Deletes all transfers from the lambert_scanner table for which the departure or arrival object
+ * is one of the given objects.
+ *
+ * @sa executeLambertScanner, compareLambertScannerCatalog
+ * @param[in] database  SQLite database handle
+ * @param[in] objectIds NORAD IDs of objects
+ * @return              Number of transfers deleted
+ */
+int deleteLambertScannerTransfers( SQLite::Database& database,
+                                   const std::vector< int >& objectIds );
+
+//! Get lambert_scanner run parameters.
+/*!
+ * Returns the input parameters that determine which transfers are stored by lambert_scanner,
+ * by name: the departure epoch and time-of-flight grids, the maximum number of revolutions, the
+ * transfer direction, the cut-offs used to reject transfers and screen object pairs, the grid
+ * refinement resolutions and the shard.
+ *
+ * @sa storeLambertScannerParameters, checkLambertScannerParameters
+ * @param[in] input lambert_scanner input parameters
+ * @return          Run parameters, by name
+ */
+std::map< std::string, double > getLambertScannerParameters( const LambertScannerInput& input );
+
+//! Create lambert_scanner parameters table.
+/*!
+ * Creates table in SQLite database used to record the run parameters (see
+ * getLambertScannerParameters()), by name. If the table already exists, it is dropped.
+ *
+ * @sa storeLambertScannerParameters, executeLambertMerge
+ * @param[in] database SQLite database handle
+ */
+void createLambertScannerParametersTable( SQLite::Database& database );
+
+//! Store lambert_scanner run parameters.
+/*!
+ * Creates table in SQLite database used to record the run parameters (see
+ * getLambertScannerParameters()) with which the lambert_scanner table is created (see
+ * createLambertScannerParametersTable()), and stores the parameters of the given input.
  *
- * @sa executeLambertScanner
+ * @sa executeLambertScanner, checkLambertScannerParameters
  * @param[in] database SQLite database handle
+ * @param[in] input    lambert_scanner input parameters
+ */
+void storeLambertScannerParameters( SQLite::Database& database, const LambertScannerInput& input );
+
+//! Check lambert_scanner run parameters.
+/*!
+ * Checks that the run parameters stored in the parameters table by the run that created the
+ * database match the given input, such that the run can be resumed or the database can be updated
+ * incrementally. An error
+ * is thrown if the table does not exist or if any parameter differs, since the stored transfers
+ * then do not match the input and a full rerun is needed.
+ *
+ * @sa executeLambertScanner, storeLambertScannerParameters
+ * @param[in] database SQLite database handle
+ * @param[in] input    lambert_scanner input parameters
+ */
+void checkLambertScannerParameters( SQLite::Database& database, const LambertScannerInput& input );
+
+//! Check resume of lambert_scanner run.
+/*!
+ * Checks that an interrupted run stored in the database can be resumed with the given input and
+ * TLE objects: the schema of the lambert_scanner table and the run parameters (see
+ * checkLambertScannerParameters()) must match the input, and the TLE lines of all objects must
+ * match the catalog stored by the interrupted run (see compareLambertScannerCatalog()). An error
+ * is thrown otherwise, since the resumed run would append transfers that do not match the stored
+ * transfers.
+ *
+ * @sa executeLambertScanner, fetchLambertScannerProgress
+ * @param[in] database   SQLite database handle
+ * @param[in] input      lambert_scanner input parameters
+ * @param[in] tleObjects List of TLE objects parsed from catalog
+ */
+void checkLambertScannerResume( SQLite::Database& database,
+                                const LambertScannerInput& input,
+                                const TleObjects& tleObjects );
+
+//! Epoch grid for lambert_scanner.
+/*!
+ * Data struct containing the distinct epochs spanned by the departure epoch and time-of-flight
+ * grids, together with the index of the epoch corresponding to each grid point. Departure and
+ * arrival epochs that coincide share an entry, so that each object only needs to be propagated
+ * once per distinct epoch.
+ *
+ * @sa computeLambertScannerEpochGrid, EphemerisTable
+ */
+struct LambertScannerEpochGrid
+{
+public:
+
+    //! Distinct epochs, in chronological order.
+    std::vector< DateTime > epochs;
+
+    //! Index of epoch for each departure epoch grid point [m].
+    std::vector< unsigned int > departureEpochIndices;
+
+    //! Index of epoch for each arrival grid point [m * timeOfFlightSteps + k].
+    std::vector< unsigned int > arrivalEpochIndices;
+
+protected:
+
+private:
+};
+
+//! Compute epoch grid for lambert_scanner.
+/*!
+ * Computes the distinct epochs spanned by the departure epoch and time-of-flight grids. Epochs are
+ * computed in the same way as in the grid search and are considered equal if they map to the same
+ * DateTime tick.
+ *
+ * @sa LambertScannerEpochGrid, executeLambertScanner
+ * @param[in] input Verified input parameters for lambert_scanner
+ * @return          Epoch grid
  */
-void createLambertScannerTable( SQLite::Database& database );
+LambertScannerEpochGrid computeLambertScannerEpochGrid( const LambertScannerInput& input );
+
+//! Compute shared epoch grids for lambert_scanner.
+/*!
+ * Computes the epoch grids of several lambert_scanner inputs (e.g., the variants of a
+ * lambert_sweep) over a common list of epochs: the union of the distinct epochs spanned by all
+ * departure epoch and time-of-flight grids. All returned grids contain the same epochs, such that
+ * a single ephemeris table, computed for these epochs, can be shared by all inputs.
+ *
+ * @sa computeLambertScannerEpochGrid, executeLambertSweep
+ * @param[in] inputs Verified input parameters for lambert_scanner
+ * @return           Epoch grid per input, in the order given
+ */
+std::vector< LambertScannerEpochGrid > computeLambertScannerEpochGrids(
+    const std::vector< LambertScannerInput >& inputs );
+
+//! Run lambert_scanner.
+/*!
+ * Runs lambert_scanner for a catalog that has already been parsed and propagated: sets up the
+ * database and result sink, computes all transfers over the departure epoch and time-of-flight
+ * grids and writes the results and, optionally, the shortlist (see executeLambertScanner()).
+ *
+ * @sa executeLambertScanner, executeLambertSweep
+ * @param[in] input       Verified input parameters for lambert_scanner
+ * @param[in] tleObjects  List of TLE objects parsed from catalog
+ * @param[in] epochGrid   Epoch grid, indexing into the epochs of the ephemeris table
+ * @param[in] ephemerides Ephemeris table containing all objects at all epochs of the epoch grid
+ */
+void runLambertScanner( const LambertScannerInput& input,
+                        const TleObjects& tleObjects,
+                        const LambertScannerEpochGrid& epochGrid,
+                        const EphemerisTable& ephemerides );
+
+//! Tiling of lambert_scanner departure-arrival iteration space.
+/*!
+ * Data struct containing the size of the tiles in which the (departure object, arrival object)
+ * iteration space is processed.
+ *
+ * @sa computeLambertScannerTiling, executeLambertScannerWorker
+ */
+struct LambertScannerTiling
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on tile size.
+     *
+     * @param[in] aDepartureBlockSize Number of departure objects per tile
+     * @param[in] anArrivalBlockSize  Number of arrival objects per tile
+     */
+    LambertScannerTiling( const unsigned int aDepartureBlockSize,
+                          const unsigned int anArrivalBlockSize )
+        : departureBlockSize( aDepartureBlockSize ),
+          arrivalBlockSize( anArrivalBlockSize )
+    { }
+
+    //! Number of departure objects per tile.
+    const unsigned int departureBlockSize;
+
+    //! Number of arrival objects per tile.
+    const unsigned int arrivalBlockSize;
+
+protected:
+
+private:
+};
+
+//! Compute tiling of lambert_scanner departure-arrival iteration space.
+/*!
+ * Computes the tile size used to process the (departure object, arrival object) iteration space.
+ * Block sizes specified by the user are used as given. Otherwise, the arrival block size is set
+ * such that the ephemerides of an arrival block fit in half of the L2 cache (detected at runtime,
+ * if available), and the departure block size is set such that each worker thread has at least
+ * four departure blocks to process, up to a maximum of four departure objects per block.
+ *
+ * @sa LambertScannerTiling, executeLambertScanner
+ * @param[in] input           Verified input parameters for lambert_scanner
+ * @param[in] numberOfObjects Number of objects in TLE object list
+ * @param[in] numberOfEpochs  Number of epochs in ephemeris table
+ * @return                    Tiling of iteration space
+ */
+LambertScannerTiling computeLambertScannerTiling( const LambertScannerInput& input,
+                                                  const unsigned int numberOfObjects,
+                                                  const unsigned int numberOfEpochs );
+
+//! Tile of lambert_scanner departure-arrival iteration space.
+/*!
+ * Data struct containing the ranges of departure and arrival objects (indices in the TLE object
+ * list) that make up a tile of the (departure object, arrival object) iteration space.
+ *
+ * @sa computeLambertScannerTiles, executeLambertScannerWorker
+ */
+struct LambertScannerTile
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on ranges of departure and arrival objects.
+     *
+     * @param[in] aDepartureObjectIndexBegin Index of first departure object
+     * @param[in] aDepartureObjectIndexEnd   Index past last departure object
+     * @param[in] anArrivalObjectIndexBegin  Index of first arrival object
+     * @param[in] anArrivalObjectIndexEnd    Index past last arrival object
+     */
+    LambertScannerTile( const unsigned int aDepartureObjectIndexBegin,
+                        const unsigned int aDepartureObjectIndexEnd,
+                        const unsigned int anArrivalObjectIndexBegin,
+                        const unsigned int anArrivalObjectIndexEnd )
+        : departureObjectIndexBegin( aDepartureObjectIndexBegin ),
+          departureObjectIndexEnd( aDepartureObjectIndexEnd ),
+          arrivalObjectIndexBegin( anArrivalObjectIndexBegin ),
+          arrivalObjectIndexEnd( anArrivalObjectIndexEnd )
+    { }
+
+    //! Index of first departure object.
+    unsigned int departureObjectIndexBegin;
+
+    //! Index past last departure object.
+    unsigned int departureObjectIndexEnd;
+
+    //! Index of first arrival object.
+    unsigned int arrivalObjectIndexBegin;
+
+    //! Index past last arrival object.
+    unsigned int arrivalObjectIndexEnd;
+
+protected:
+
+private:
+};
+
+//! Typedef for list of lambert_scanner tiles.
+typedef std::vector< LambertScannerTile > LambertScannerTiles;
+
+//! Compute tiles of lambert_scanner departure block.
+/*!
+ * Computes the tiles that a departure block is processed in: the departure objects in the block
+ * paired with each arrival block, in increasing order of arrival object. Since every departure
+ * object visits the arrival objects in increasing order, the transfers computed for a departure
+ * object do not depend on the tile size.
+ *
+ * @sa LambertScannerTiling, executeLambertScannerWorker
+ * @param[in] tiling              Tiling of iteration space
+ * @param[in] departureBlockIndex Index of departure block
+ * @param[in] numberOfObjects     Number of objects in TLE object list
+ * @return                        Tiles of departure block, in processing order
+ */
+LambertScannerTiles computeLambertScannerTiles( const LambertScannerTiling& tiling,
+                                                const unsigned int departureBlockIndex,
+                                                const unsigned int numberOfObjects );
+
+//! Compute Lambert transfers for departure object.
+/*!
+ * Computes Lambert transfers from a given departure object to a range of arrival objects in the
+ * TLE object list that pass pre-screening, across the departure epoch and time-of-flight grids.
+ * For each grid point, the solution with the lowest transfer \f$\Delta V\f$ is appended to the
+ * buffer of transfers, unless it is rejected by the transfer \f$\Delta V\f$ cut-off or none of
+ * the solutions satisfies the minimum periapsis radius. The departure and arrival states are
+ * looked up in the precomputed ephemeris table. For each departure epoch, the Lambert problems
+ * along the time-of-flight grid are solved as a single batch in the given workspace, such that no
+ * memory is allocated on the heap per grid point.
+ *
+ * If both prograde and retrograde transfers are computed, the Lambert problems of each grid point
+ * are solved for both directions from the same ephemerides, and the transfers of both directions
+ * are appended to the buffer of transfers.
+ *
+ * If the grid is refined adaptively, the grid points only serve to locate the local
+ * \f$\Delta V\f$ minima per object pair and direction (see findLambertScannerGridMinima()). Each
+ * local minimum is refined (see refineLambertScannerGridMinimum()) and only the refined transfers
+ * are appended to the buffer of transfers, subject to the same cut-offs.
+ *
+ * @sa executeLambertScanner, LambertScannerTransfer, EphemerisTable, LambertScannerWorkspace
+ * @param[in]     input                   Verified input parameters for lambert_scanner
+ * @param[in]     tleObjects              List of TLE objects parsed from catalog
+ * @param[in]     epochGrid               Epoch grid spanned by departure epoch and time-of-flight
+ *                                        grids
+ * @param[in]     ephemerides             Ephemeris table of TLE objects at epochs in epoch grid
+ * @param[in]     propagators             SGP4 propagator per TLE object, used to refine the grid
+ *                                        (empty if the grid is not refined)
+ * @param[in]     departureObjectIndex    Index of departure object in TLE object list
+ * @param[in]     arrivalObjectIndexBegin Index of first arrival object in TLE object list
+ * @param[in]     arrivalObjectIndexEnd   Index past last arrival object in TLE object list
+ * @param[in,out] workspace               Workspace containing Lambert targeter and buffers
+ * @param[in,out] transfers               Buffer of transfers (transfers are appended)
+ * @param[in,out] statistics              Counters of transfers computed and rejected
+ */
+void computeLambertScannerTransfers( const LambertScannerInput& input,
+                                     const TleObjects& tleObjects,
+                                     const LambertScannerEpochGrid& epochGrid,
+                                     const EphemerisTable& ephemerides,
+                                     const std::vector< SGP4 >& propagators,
+                                     const unsigned int departureObjectIndex,
+                                     const unsigned int arrivalObjectIndexBegin,
+                                     const unsigned int arrivalObjectIndexEnd,
+                                     LambertScannerWorkspace& workspace,
+                                     LambertScannerTransfers& transfers,
+                                     LambertScannerStatistics& statistics );
+
+//! Select lowest \f$\Delta V\f$ solution of Lambert problem.
+/*!
+ * Computes the departure, arrival and total transfer \f$\Delta V\f$ of all solutions of given
+ * Lambert problem in the buffers of the workspace and returns the index of the solution with the
+ * lowest total transfer \f$\Delta V\f$. Solutions for which the transfer orbit dips below the
+ * minimum periapsis radius are discarded by setting their \f$\Delta V\f$ to infinity; if all
+ * solutions are discarded, the total transfer \f$\Delta V\f$ of the returned solution is
+ * infinite.
+ *
+ * @sa computeLambertScannerTransfers, LambertScannerWorkspace
+ * @param[in]     input          Verified input parameters for lambert_scanner
+ * @param[in]     targeter       Lambert targeter that problem was solved with
+ * @param[in]     problemIndex   Index of problem in last batch solved by Lambert targeter
+ * @param[in]     departureState Cartesian state of departure object [km; km/s]
+ * @param[in]     arrivalState   Cartesian state of arrival object [km; km/s]
+ * @param[in,out] workspace      Workspace containing buffers of \f$\Delta V\f$ per solution
+ * @return                       Index of solution with lowest transfer \f$\Delta V\f$
+ */
+int selectLambertScannerSolution( const LambertScannerInput& input,
+                                  const LambertBatchTargeter& targeter,
+                                  const int problemIndex,
+                                  const Vector6& departureState,
+                                  const Vector6& arrivalState,
+                                  LambertScannerWorkspace& workspace );
+
+//! Find local minima of lambert_scanner grid.
+/*!
+ * Finds the local minima of the lowest transfer \f$\Delta V\f$ per grid point of a departure
+ * epoch and time-of-flight grid. A grid point is a local minimum if its \f$\Delta V\f$ is finite
+ * and does not exceed the \f$\Delta V\f$ of any of its (up to eight) neighbours. For a plateau
+ * of equal values, only the first grid point (in row-major order) is returned.
+ *
+ * @sa refineLambertScannerGridMinimum
+ * @param[in]  gridDeltaVs         Lowest transfer \f$\Delta V\f$ per grid point, indexed by
+ *                                 departureEpochIndex * timeOfFlightSteps + timeOfFlightIndex
+ * @param[in]  departureEpochSteps Number of steps in departure epoch grid
+ * @param[in]  timeOfFlightSteps   Number of steps in time-of-flight grid
+ * @param[out] minimumIndices      Indices of local minima, in ascending order
+ */
+void findLambertScannerGridMinima( const std::vector< double >& gridDeltaVs,
+                                   const int departureEpochSteps,
+                                   const int timeOfFlightSteps,
+                                   std::vector< int >& minimumIndices );
+
+//! Compute lowest \f$\Delta V\f$ at lambert_scanner refinement points.
+/*!
+ * Propagates departure and arrival objects to the refinement points listed in the workspace
+ * (departure epoch offset and time-of-flight) using SGP4, solves the Lambert problems as a single
+ * batch with the refinement targeter of the workspace and stores the states, lowest transfer
+ * \f$\Delta V\f$ and index of the corresponding solution per refinement point.
+ *
+ * @sa refineLambertScannerGridMinimum, selectLambertScannerSolution
+ * @param[in]     input         Verified input parameters for lambert_scanner
+ * @param[in]     isPrograde    Flag indicating if transfers are prograde (false = retrograde)
+ * @param[in]     departureSgp4 SGP4 propagator of departure object
+ * @param[in]     arrivalSgp4   SGP4 propagator of arrival object
+ * @param[in,out] workspace     Workspace containing refinement points and buffers
+ * @param[in,out] statistics    Counters of transfers computed
+ */
+void computeLambertScannerRefinementDeltaVs( const LambertScannerInput& input,
+                                             const bool isPrograde,
+                                             const SGP4& departureSgp4,
+                                             const SGP4& arrivalSgp4,
+                                             LambertScannerWorkspace& workspace,
+                                             LambertScannerStatistics& statistics );
+
+//! Refine local minimum of lambert_scanner grid.
+/*!
+ * Refines a local \f$\Delta V\f$ minimum of the coarse departure epoch and time-of-flight grid.
+ * At each level, the step sizes are halved (down to the resolution set in the input) and the
+ * eight points surrounding the current optimum at these step sizes are evaluated; the optimum
+ * moves to the point with the lowest \f$\Delta V\f$. Points outside the departure epoch range
+ * and time-of-flight range of the grid are skipped. The refinement stops once both step sizes
+ * have reached the resolution, such that the optimum is found with the quality of a dense grid
+ * at that resolution, using at most eight Lambert solves per level instead of solving the dense
+ * grid.
+ *
+ * On return, the refined optimum is the only refinement point in the workspace, evaluated by
+ * computeLambertScannerRefinementDeltaVs(); the buffers of \f$\Delta V\f$ per solution of the
+ * workspace contain the solutions of the refined optimum.
+ *
+ * @sa findLambertScannerGridMinima, computeLambertScannerRefinementDeltaVs
+ * @param[in]     input                Verified input parameters for lambert_scanner
+ * @param[in]     isPrograde           Flag indicating if transfers are prograde
+ *                                     (false = retrograde)
+ * @param[in]     departureSgp4        SGP4 propagator of departure object
+ * @param[in]     arrivalSgp4          SGP4 propagator of arrival object
+ * @param[in,out] departureEpochOffset Departure epoch offset from initial departure epoch of
+ *                                     local minimum (coarse on input, refined on output) [s]
+ * @param[in,out] timeOfFlight         Time-of-flight of local minimum (coarse on input, refined
+ *                                     on output) [s]
+ * @param[in,out] transferDeltaV       Lowest transfer \f$\Delta V\f$ of local minimum (coarse on
+ *                                     input, refined on output) [km/s]
+ * @param[in,out] workspace            Workspace containing refinement targeter and buffers
+ * @param[in,out] statistics           Counters of transfers computed
+ */
+void refineLambertScannerGridMinimum( const LambertScannerInput& input,
+                                      const bool isPrograde,
+                                      const SGP4& departureSgp4,
+                                      const SGP4& arrivalSgp4,
+                                      double& departureEpochOffset,
+                                      double& timeOfFlight,
+                                      double& transferDeltaV,
+                                      LambertScannerWorkspace& workspace,
+                                      LambertScannerStatistics& statistics );
+
+//! Execute lambert_scanner worker.
+/*!
+ * Executes lambert_scanner worker thread. The worker claims departure blocks from the work
+ * queue, computes all transfers for each departure block tile by tile and submits the buffer of
+ * transfers (ordered by departure object) to the queue, until there are no departure blocks left.
+ * The transfers with the lowest \f$\Delta V\f$ computed by the worker are retained in its own
+ * shortlist. Errors are reported to the work queue.
+ *
+ * @sa executeLambertScanner, LambertScannerWorkQueue, computeLambertScannerTransfers
+ * @param[in]     input       Verified input parameters for lambert_scanner
+ * @param[in]     tleObjects  List of TLE objects parsed from catalog
+ * @param[in]     epochGrid   Epoch grid spanned by departure epoch and time-of-flight grids
+ * @param[in]     ephemerides Ephemeris table of TLE objects at epochs in epoch grid
+ * @param[in]     propagators SGP4 propagator per TLE object, used to refine the grid (empty if
+ *                            the grid is not refined)
+ * @param[in]     tiling      Tiling of departure-arrival iteration space
+ * @param[in]     isDepartureObjectSkipped
+ *                            Flags indicating if departure object is skipped, i.e., it has been
+ *                            completed in a previous run or is outside the shard, per TLE object
+ * @param[in]     isObjectChanged
+ *                            Flags indicating if object is changed, per TLE object, if the
+ *                            database is updated incrementally: transfers are only computed for
+ *                            pairs that include a changed object (empty if all pairs are computed)
+ * @param[in,out] workQueue   Work queue shared by worker threads and database writer
+ * @param[in,out] shortlist   Shortlist of transfers computed by worker
+ * @param[in,out] statistics  Counters of transfers computed and rejected by worker
+ */
+void executeLambertScannerWorker( const LambertScannerInput& input,
+                                  const TleObjects& tleObjects,
+                                  const LambertScannerEpochGrid& epochGrid,
+                                  const EphemerisTable& ephemerides,
+                                  const std::vector< SGP4 >& propagators,
+                                  const LambertScannerTiling& tiling,
+                                  const std::vector< bool >& isDepartureObjectSkipped,
+                                  const std::vector< bool >& isObjectChanged,
+                                  LambertScannerWorkQueue& workQueue,
+                                  LambertScannerShortlist& shortlist,
+                                  LambertScannerStatistics& statistics );
+
+//! Get row of values of Lambert transfer.
+/*!
+ * Fills row with the values of a Lambert transfer, in the order of the columns returned by
+ * getLambertScannerColumnNames(). This is the record written to the result sink.
+ *
+ * @sa executeLambertScanner, getLambertScannerColumnNames, getLambertScannerResultFields
+ * @param[in]  transfer  Lambert transfer
+ * @param[in]  isCompact Flag indicating if compact schema is used (state vectors and Keplerian
+ *                       elements are omitted)
+ * @param[out] row       Row of values
+ */
+void getLambertScannerTransferRow( const LambertScannerTransfer& transfer,
+                                   const bool isCompact,
+                                   std::vector< double >& row );
+
+//! Reader for lambert_scanner table.
+/*!
+ * Reads Lambert transfers from rows of the "lambert_scanner_results" table, for both the full and
+ * the compact schema. For the compact schema, the state vectors of the departure and arrival
+ * objects are recomputed by propagating the TLE objects stored in the "lambert_scanner_catalog"
+ * table using SGP4, and the Keplerian elements are recomputed from the state vectors. The
+ * recomputed states match those computed by lambert_scanner up to the precision of the stored
+ * departure epoch (Julian date).
+ *
+ * If lambert_scanner wrote the transfers to a column store (see
+ * createLambertScannerColumnStoreTable), the column store is memory-mapped and transfers are read
+ * by transfer ID, which is the row index in the column store plus one.
+ *
+ * @sa executeLambertScanner, LambertScannerTransfer, createLambertScannerTable, ColumnStore
+ */
+class LambertScannerTransferReader
+{
+public:
+
+    //! Construct reader.
+    /*!
+     * Constructs reader for "lambert_scanner_results" table in SQLite database, or for the column
+     * store recorded in the database. The schema of the table is detected and, for the compact
+     * schema, the catalog is loaded. An error is thrown if the compact schema is used and the
+     * "lambert_scanner_catalog" table does not exist or contains a NORAD ID more than once.
+     *
+     * @param[in] aDatabase SQLite database handle
+     */
+    explicit LambertScannerTransferReader( SQLite::Database& aDatabase );
+
+    //! Read Lambert transfer.
+    /*!
+     * Reads Lambert transfer from current row of query. The query must select all columns of the
+     * "lambert_scanner_results" table, in table order, starting at the given column.
+     *
+     * @param[in] query       Select query on "lambert_scanner_results" table
+     * @param[in] firstColumn Index of "transfer_id" column in query
+     * @return                Lambert transfer
+     */
+    LambertScannerTransfer read( SQLite::Statement& query, const int firstColumn = 0 ) const;
+
+    //! Read Lambert transfer from column store.
+    /*!
+     * Reads Lambert transfer with given transfer ID from column store. An error is thrown if the
+     * transfer ID is out of range.
+     *
+     * @param[in] transferId Transfer ID (row index in column store plus one)
+     * @return               Lambert transfer
+     */
+    LambertScannerTransfer read( const long long transferId ) const;
+
+    //! Get number of transfers.
+    /*!
+     * Returns number of transfers stored in "lambert_scanner_results" table or column store.
+     *
+     * @return Number of transfers
+     */
+    long long getNumberOfTransfers( ) const;
+
+    //! Get transfer Delta-V column.
+    /*!
+     * Returns pointer to contiguous array of transfer \f$\Delta V\f$ values stored in the column
+     * store, indexed by transfer ID minus one, such that transfers can be filtered without reading
+     * them. An error is thrown if the transfers are not stored in a column store.
+     *
+     * @return Pointer to first transfer \f$\Delta V\f$ in column store
+     */
+    const double* getTransferDeltaVs( ) const;
+
+    //! Flag indicating if transfers are stored in a column store.
+    const bool isColumnStore;
+
+    //! Flag indicating if table uses compact schema.
+    const bool isCompact;
+
+protected:
+
+private:
+
+    //! Recompute fields omitted in compact schema.
+    /*!
+     * Recomputes state vectors and Keplerian elements of Lambert transfer read from compact
+     * schema, by propagating departure and arrival objects to the departure and arrival epochs.
+     *
+     * @param[in,out] transfer Lambert transfer
+     */
+    void recomputeTransfer( LambertScannerTransfer& transfer ) const;
+
+    //! SQLite database handle.
+    SQLite::Database& database;
+
+    //! Column store (null if transfers are stored in "lambert_scanner_results" table).
+    std::unique_ptr< ColumnStore > columnStore;
+
+    //! Memory-mapped columns of column store, in order of getLambertScannerColumnNames().
+    std::vector< const double* > columns;
+
+    //! SGP4 propagator per TLE object stored in catalog table, indexed by object ID (NORAD
+    //! number). Propagators are initialized once, rather than once per transfer read.
+    std::map< int, SGP4 > propagators;
+};
+
+//! Fetch Lambert transfer shortlist from database.
+/*!
+ * Fetches the transfers with the lowest transfer \f$\Delta V\f$ stored in the
+ * "lambert_scanner_results" table. This is used to seed the shortlist when an interrupted run is
+ * resumed, since the transfers stored by the previous run are not recomputed.
+ *
+ * @sa executeLambertScanner, LambertScannerShortlistEntry
+ * @param[in] database         SQLite database handle
+ * @param[in] shortlistLength  Number of transfers to fetch
+ * @return                     Shortlist entries (with transfer_id set), sorted by transfer
+ *                             \f$\Delta V\f$ (ascending)
+ */
+LambertScannerShortlistEntries fetchLambertScannerShortlist( SQLite::Database& database,
+                                                             const int shortlistLength );
 
 //! Write transfer shortlist to file.
 /*!
  * Writes shortlist of debris-to-debris Lambert transfers to file. The shortlist is based on the
- * requested number of transfers with the lowest transfer \f$\Delta V\f$, retrieved by sorting the
- * transfers in the SQLite database.
+ * requested number of transfers with the lowest transfer \f$\Delta V\f$, retained in bounded
+ * shortlists while the grid search is executed, such that the database does not have to be
+ * sorted.
  *
- * @sa executeLambertScanner, createLambertScannerTable
- * @param[in] database        SQLite database handle
- * @param[in] shortlistNumber Number of entries to include in shortlist (if it exceeds number of
- *                            entries in database table, the whole table is written to file)
- * @param[in] shortlistPath   Path to shortlist file
+ * @sa executeLambertScanner, LambertScannerShortlist
+ * @param[in] shortlistEntries Shortlist entries, sorted by transfer \f$\Delta V\f$ (ascending)
+ * @param[in] shortlistPath    Path to shortlist file
  */
-void writeTransferShortlist( SQLite::Database& database,
-                             const int shortlistNumber,
+void writeTransferShortlist( const LambertScannerShortlistEntries& shortlistEntries,
                              const std::string& shortlistPath );
 
 } // namespace d2d
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_LAMBERT_SWEEP_HPP
+#define D2D_LAMBERT_SWEEP_HPP
+
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "D2D/lambertScanner.hpp"
+
+namespace d2d
+{
+
+//! Execute lambert_sweep.
+/*!
+ * Executes lambert_scanner for a list of parameter sets (variants) over a single TLE catalog. The
+ * config file contains the lambert_scanner options shared by all variants, together with a
+ * "variants" array. Each variant is an object containing lambert_scanner options that override
+ * (or add to) the shared options; every variant must set its own "database", so that the results
+ * of each variant are written to a separate database.
+ *
+ * The catalog is parsed once and all objects are propagated once to the union of the epochs
+ * spanned by the departure epoch and time-of-flight grids of all variants. The variants are then
+ * executed one after the other over this shared ephemeris table (see runLambertScanner()), which
+ * produces the same databases as separate lambert_scanner runs with the variant configurations.
+ *
+ * This function is executed if the user provides "lambert_sweep" as the application mode.
+ *
+ * @sa executeLambertScanner, checkLambertSweepInput, computeLambertScannerEpochGrids
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ */
+void executeLambertSweep( const rapidjson::Document& config );
+
+//! Get lambert_sweep variant configuration.
+/*!
+ * Merges the shared lambert_scanner options with the options of a variant: the "variants" array
+ * is removed and each option of the variant replaces the shared option with the same name, or is
+ * added if there is none. An error is thrown if the variant is not an object or if it overrides
+ * the "mode", "catalog" or "ephemeris_cache" options, which are common to all variants.
+ *
+ * @sa executeLambertSweep, checkLambertSweepInput
+ * @param[in]  config        User-defined configuration options (extracted from JSON input file)
+ * @param[in]  variant       Options of variant (element of "variants" array)
+ * @param[out] variantConfig Configuration options of variant
+ */
+void getLambertSweepVariantConfig( const rapidjson::Document& config,
+                                   const rapidjson::Value& variant,
+                                   rapidjson::Document& variantConfig );
+
+//! Check lambert_sweep input parameters.
+/*!
+ * Checks that the inputs of all variants for the lambert_sweep application mode are valid (see
+ * checkLambertScannerInput()). If not, an error is thrown with a short description of the
+ * problem. An error is also thrown if no variants are specified, or if a variant does not set its
+ * own "database" or shares it with another variant.
+ *
+ * @sa executeLambertSweep, getLambertSweepVariantConfig, LambertScannerInput
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           Structs containing all valid input to execute lambert_scanner, per variant
+ */
+std::vector< LambertScannerInput > checkLambertSweepInput( const rapidjson::Document& config );
+
+} // namespace d2d
+
+#endif // D2D_LAMBERT_SWEEP_HPP
@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_LAMBERT_TARGETER_HPP
+#define D2D_LAMBERT_TARGETER_HPP
+
+#include <vector>
+
+#include <boost/array.hpp>
+
+#include "D2D/typedefs.hpp"
+
+namespace d2d
+{
+
+//! Compute non-dimensional Lambert time-of-flight.
+/*!
+ * Computes non-dimensional time-of-flight for given value of the free parameter x of Izzo's
+ * formulation of Lambert's problem (Izzo, 2014), using Battin's series for |x - 1| < 0.01,
+ * Lagrange's expression for 0.01 < |x - 1| < 0.2 and Lancaster's expression elsewhere.
+ *
+ * @sa LambertBatchTargeter
+ * @param[in] lambda      Non-dimensional transfer geometry parameter
+ * @param[in] x           Free parameter
+ * @param[in] revolutions Number of revolutions
+ * @return                Non-dimensional time-of-flight
+ */
+double computeLambertTimeOfFlight( const double lambda, const double x, const int revolutions );
+
+//! Compute non-dimensional Lambert time-of-flight using Lagrange's expression.
+/*!
+ * Computes non-dimensional time-of-flight for given value of the free parameter x of Izzo's
+ * formulation of Lambert's problem (Izzo, 2014), using Lagrange's expression.
+ *
+ * @sa computeLambertTimeOfFlight
+ * @param[in] lambda      Non-dimensional transfer geometry parameter
+ * @param[in] x           Free parameter
+ * @param[in] revolutions Number of revolutions
+ * @return                Non-dimensional time-of-flight
+ */
+double computeLambertTimeOfFlightLagrange( const double lambda,
+                                           const double x,
+                                           const int revolutions );
+
+//! Compute derivatives of non-dimensional Lambert time-of-flight.
+/*!
+ * Computes first, second and third derivatives of non-dimensional time-of-flight with respect to
+ * the free parameter x of Izzo's formulation of Lambert's problem (Izzo, 2014).
+ *
+ * @sa computeLambertTimeOfFlight
+ * @param[in]  lambda           Non-dimensional transfer geometry parameter
+ * @param[in]  x                Free parameter
+ * @param[in]  timeOfFlight     Non-dimensional time-of-flight at x
+ * @param[out] firstDerivative  First derivative of time-of-flight
+ * @param[out] secondDerivative Second derivative of time-of-flight
+ * @param[out] thirdDerivative  Third derivative of time-of-flight
+ */
+void computeLambertTimeOfFlightDerivatives( const double lambda,
+                                            const double x,
+                                            const double timeOfFlight,
+                                            double& firstDerivative,
+                                            double& secondDerivative,
+                                            double& thirdDerivative );
+
+//! Batched Lambert targeter.
+/*!
+ * Lambert targeter based on Izzo (2014), following the implementation of lambert_problem in PyKEP
+ * (Izzo, 2012), that solves a batch of Lambert problems together. The problems are stored in
+ * structure-of-arrays form and each step of the algorithm (transfer geometry, maximum number of
+ * revolutions, initial guesses, Householder iterations and velocity reconstruction) is executed
+ * for all problems in the batch before moving on to the next step. The iterations are executed in
+ * lock-step; problems that have converged are masked out. The inner loops run over contiguous
+ * arrays without dependencies between problems, such that the compiler can vectorize them for the
+ * target instruction set (see the BUILD_NATIVE option).
+ *
+ * The targeter is a workspace with fixed-capacity storage for the batch, sized when it is
+ * constructed, such that it can be reused without heap allocation. A targeter is not thread-safe;
+ * each thread should use its own targeter.
+ *
+ * The solutions of each problem are stored in the same order as by lambert_problem: the
+ * zero-revolution solution, followed by the left and right branch solutions for each number of
+ * revolutions, such that the number of revolutions of solution i is floor( ( i + 1 ) / 2 ). Each
+ * problem is solved with exactly the same sequence of operations as by LambertTargeter.
+ *
+ * If the problems in a batch are ordered along a grid (e.g., increasing time-of-flight for fixed
+ * departure and arrival), the iterations can be warm-started: each problem is then solved
+ * starting from the converged free parameter of the previous problem in the batch for the same
+ * solution, which typically needs considerably fewer iterations than the default initial guess.
+ *
+ * Izzo, D. (2014) Revisiting Lambert's problem, http://arxiv.org/abs/1403.2705.
+ * Izzo, D. (2012) PyGMO and PyKEP: open source tools for massively parallel optimization in
+ *  astrodynamics (the case of interplanetary trajectory optimization). Proceed. Fifth
+ *  International Conf. Astrodynam. Tools and Techniques, ESA/ESTEC, The Netherlands.
+ *
+ * @sa LambertTargeter
+ */
+class LambertBatchTargeter
+{
+public:
+
+    //! Construct targeter.
+    /*!
+     * Constructs targeter and allocates storage for batches of up to the given number of Lambert
+     * problems, with up to the given maximum number of revolutions.
+     *
+     * @param[in] aBatchSizeMaximum   Maximum number of Lambert problems per batch
+     * @param[in] aRevolutionsMaximum Maximum number of revolutions
+     */
+    LambertBatchTargeter( const int aBatchSizeMaximum, const int aRevolutionsMaximum );
+
+    //! Solve batch of Lambert problems.
+    /*!
+     * Solves batch of Lambert problems for the transfers between the given departure and arrival
+     * positions in the given times-of-flight, for all numbers of revolutions up to the maximum
+     * number of revolutions for which a solution exists. The solutions replace the solutions of
+     * the previous batch. An error is thrown if the sizes of the lists do not match or exceed the
+     * maximum batch size, if a time-of-flight or the gravitational parameter is not positive, or
+     * if the transfer plane of a problem cannot be determined.
+     *
+     * If the iterations are warm-started, the problems are iterated one after the other, using
+     * the converged free parameter of the previous problem as initial guess for each solution
+     * that the previous problem also has (i.e., for the same number of revolutions); if the two
+     * previous problems have the solution, the initial guess is extrapolated linearly. The default
+     * initial guess is used for the first problem, if the previous problem does not have the
+     * solution, or if the warm-started iterations fail to converge to a valid solution.
+     *
+     * @param[in] departurePositions     List of departure positions [km]
+     * @param[in] arrivalPositions       List of arrival positions [km]
+     * @param[in] timesOfFlight          List of times-of-flight [s]
+     * @param[in] gravitationalParameter Gravitational parameter [km^3 s^-2]
+     * @param[in] isRetrograde           Flag indicating if transfers are retrograde
+     * @param[in] isWarmStarted          Flag indicating if iterations are warm-started from the
+     *                                   solutions of the previous problem in the batch
+     */
+    void solve( const std::vector< Vector3 >& departurePositions,
+                const std::vector< Vector3 >& arrivalPositions,
+                const std::vector< double >& timesOfFlight,
+                const double gravitationalParameter,
+                const bool isRetrograde,
+                const bool isWarmStarted = false );
+
+    //! Get number of problems.
+    /*!
+     * Returns number of Lambert problems in last batch solved.
+     *
+     * @return Number of problems
+     */
+    int getNumberOfProblems( ) const { return numberOfProblems; }
+
+    //! Get number of iterations.
+    /*!
+     * Returns total number of Householder iterations executed for all solutions of all problems
+     * in last batch solved.
+     *
+     * @return Number of iterations
+     */
+    long long getNumberOfIterations( ) const { return numberOfIterations; }
+
+    //! Get number of solutions.
+    /*!
+     * Returns number of solutions of given problem in last batch solved.
+     *
+     * @param[in] problemIndex Index of problem in batch
+     * @return                 Number of solutions
+     */
+    int getNumberOfSolutions( const int problemIndex ) const
+    {
+        return numberOfSolutions[ problemIndex ];
+    }
+
+    //! Get departure velocity.
+    /*!
+     * Returns departure velocity of given solution of given problem in last batch solved.
+     *
+     * @param[in] problemIndex  Index of problem in batch
+     * @param[in] solutionIndex Index of solution (0 <= solutionIndex < getNumberOfSolutions())
+     * @return                  Departure velocity [km/s]
+     */
+    Vector3 getDepartureVelocity( const int problemIndex, const int solutionIndex ) const
+    {
+        const int index = solutionIndex * batchSizeMaximum + problemIndex;
+        Vector3 velocity;
+        velocity[ 0 ] = departureVelocities[ 0 ][ index ];
+        velocity[ 1 ] = departureVelocities[ 1 ][ index ];
+        velocity[ 2 ] = departureVelocities[ 2 ][ index ];
+        return velocity;
+    }
+
+    //! Get arrival velocity.
+    /*!
+     * Returns arrival velocity of given solution of given problem in last batch solved.
+     *
+     * @param[in] problemIndex  Index of problem in batch
+     * @param[in] solutionIndex Index of solution (0 <= solutionIndex < getNumberOfSolutions())
+     * @return                  Arrival velocity [km/s]
+     */
+    Vector3 getArrivalVelocity( const int problemIndex, const int solutionIndex ) const
+    {
+        const int index = solutionIndex * batchSizeMaximum + problemIndex;
+        Vector3 velocity;
+        velocity[ 0 ] = arrivalVelocities[ 0 ][ index ];
+        velocity[ 1 ] = arrivalVelocities[ 1 ][ index ];
+        velocity[ 2 ] = arrivalVelocities[ 2 ][ index ];
+        return velocity;
+    }
+
+protected:
+
+private:
+
+    //! Compute transfer geometry.
+    /*!
+     * Computes non-dimensional transfer geometry parameter, non-dimensional time-of-flight and
+     * radial and tangential unit vectors for given problem.
+     *
+     * @param[in] problemIndex           Index of problem in batch
+     * @param[in] departurePosition      Departure position [km]
+     * @param[in] arrivalPosition        Arrival position [km]
+     * @param[in] timeOfFlight           Time-of-flight [s]
+     * @param[in] gravitationalParameter Gravitational parameter [km^3 s^-2]
+     * @param[in] isRetrograde           Flag indicating if transfer is retrograde
+     */
+    void computeGeometry( const int problemIndex,
+                          const Vector3& departurePosition,
+                          const Vector3& arrivalPosition,
+                          const double timeOfFlight,
+                          const double gravitationalParameter,
+                          const bool isRetrograde );
+
+    //! Compute maximum number of revolutions.
+    /*!
+     * Computes maximum number of revolutions for which a solution exists, for all problems in
+     * batch, using Halley iterations to find the minimum time-of-flight for the maximum number of
+     * revolutions where needed. The number of revolutions is capped at the maximum number of
+     * revolutions of the targeter.
+     */
+    void computeRevolutions( );
+
+    //! Compute initial guess for free parameter.
+    /*!
+     * Computes default initial guess for the free parameter x of given solution of given problem,
+     * based on the time-of-flight regime for the zero-revolution solution and on the number of
+     * revolutions for the left and right branch solutions.
+     *
+     * @param[in] problemIndex  Index of problem in batch
+     * @param[in] solutionIndex Index of solution
+     * @return                  Initial guess for free parameter
+     */
+    double computeInitialGuess( const int problemIndex, const int solutionIndex ) const;
+
+    //! Compute Householder iteration step.
+    /*!
+     * Computes updated value of the free parameter x for given problem, using a single
+     * Householder iteration.
+     *
+     * @param[in] problemIndex        Index of problem in batch
+     * @param[in] solutionRevolutions Number of revolutions of solution
+     * @param[in] x                   Current value of free parameter
+     * @return                        Updated value of free parameter
+     */
+    double computeHouseholderStep( const int problemIndex,
+                                   const int solutionRevolutions,
+                                   const double x ) const;
+
+    //! Solve for free parameter using Householder iterations.
+    /*!
+     * Solves for value of the free parameter x of given solution, for all problems in batch that
+     * have the solution, using Householder iterations starting from the default initial guess.
+     * The iterations are executed in lock-step for all problems.
+     *
+     * @param[in] solutionIndex     Index of solution
+     * @param[in] tolerance         Tolerance on change of x between iterations
+     * @param[in] iterationsMaximum Maximum number of iterations
+     */
+    void solveHouseholder( const int solutionIndex,
+                           const double tolerance,
+                           const int iterationsMaximum );
+
+    //! Solve for free parameter using warm-started Householder iterations.
+    /*!
+     * Solves for value of the free parameter x of given solution, for all problems in batch that
+     * have the solution, using Householder iterations starting from the solution of the previous
+     * problem (extrapolated linearly from the two previous problems where possible). The problems
+     * are iterated one after the other. The default initial guess is used
+     * if the previous problem does not have the solution, or if the iterations do not converge to
+     * a valid solution (for the right branch, a solution that differs from the left branch).
+     *
+     * @param[in] solutionIndex     Index of solution
+     * @param[in] tolerance         Tolerance on change of x between iterations
+     * @param[in] iterationsMaximum Maximum number of iterations
+     */
+    void solveHouseholderWarmStarted( const int solutionIndex,
+                                      const double tolerance,
+                                      const int iterationsMaximum );
+
+    //! Execute Householder iterations for single problem.
+    /*!
+     * Executes Householder iterations for the free parameter x of given solution of given
+     * problem, starting from the given value, until the change of x between iterations is within
+     * the tolerance or the maximum number of iterations is reached.
+     *
+     * @param[in]     problemIndex      Index of problem in batch
+     * @param[in]     solutionIndex     Index of solution
+     * @param[in]     tolerance         Tolerance on change of x between iterations
+     * @param[in]     iterationsMaximum Maximum number of iterations
+     * @param[in,out] x                 Free parameter (initial guess on input, solution on output)
+     * @return                          True if iterations converged to a valid solution
+     */
+    bool iterateHouseholder( const int problemIndex,
+                             const int solutionIndex,
+                             const double tolerance,
+                             const int iterationsMaximum,
+                             double& x );
+
+    //! Maximum number of Lambert problems per batch.
+    const int batchSizeMaximum;
+
+    //! Maximum number of revolutions.
+    const int revolutionsMaximum;
+
+    //! Number of Lambert problems in current batch.
+    int numberOfProblems;
+
+    //! Total number of Householder iterations executed for current batch.
+    long long numberOfIterations;
+
+    //! Non-dimensional transfer geometry parameter lambda per problem.
+    std::vector< double > lambdas;
+
+    //! Non-dimensional time-of-flight per problem.
+    std::vector< double > nonDimensionalTimesOfFlight;
+
+    //! Non-dimensional time-of-flight for x = 0 and zero revolutions per problem.
+    std::vector< double > timesOfFlightZero;
+
+    //! Non-dimensional time-of-flight for parabolic transfer per problem.
+    std::vector< double > timesOfFlightParabolic;
+
+    //! Velocity scaling factor gamma per problem.
+    std::vector< double > gammas;
+
+    //! Radius ratio parameter rho per problem.
+    std::vector< double > rhos;
+
+    //! Radius ratio parameter sigma per problem.
+    std::vector< double > sigmas;
+
+    //! Departure radius per problem [km].
+    std::vector< double > departureRadii;
+
+    //! Arrival radius per problem [km].
+    std::vector< double > arrivalRadii;
+
+    //! Components of departure radial unit vector per problem.
+    boost::array< std::vector< double >, 3 > departureRadialUnitVectors;
+
+    //! Components of arrival radial unit vector per problem.
+    boost::array< std::vector< double >, 3 > arrivalRadialUnitVectors;
+
+    //! Components of departure tangential unit vector per problem.
+    boost::array< std::vector< double >, 3 > departureTangentialUnitVectors;
+
+    //! Components of arrival tangential unit vector per problem.
+    boost::array< std::vector< double >, 3 > arrivalTangentialUnitVectors;
+
+    //! Maximum number of revolutions for which a solution exists per problem.
+    std::vector< int > revolutions;
+
+    //! Number of solutions per problem.
+    std::vector< int > numberOfSolutions;
+
+    //! Free parameter per problem that iterations are executed for.
+    std::vector< double > iterationX;
+
+    //! Non-dimensional time-of-flight per problem that iterations are executed for.
+    std::vector< double > iterationTimesOfFlight;
+
+    //! Updated free parameter per problem in last iteration.
+    std::vector< double > iterationXNew;
+
+    //! Flag per problem indicating if iterations are still executed (0 = converged).
+    std::vector< int > isIterating;
+
+    //! Free parameter x per solution and problem [solutionIndex * batchSizeMaximum + problem].
+    std::vector< double > xSolutions;
+
+    //! Components of departure velocity per solution and problem [km/s].
+    boost::array< std::vector< double >, 3 > departureVelocities;
+
+    //! Components of arrival velocity per solution and problem [km/s].
+    boost::array< std::vector< double >, 3 > arrivalVelocities;
+};
+
+//! Reusable Lambert targeter.
+/*!
+ * Lambert targeter that solves a single Lambert problem at a time, using a LambertBatchTargeter
+ * with a batch size of one. In contrast to lambert_problem in PyKEP (Izzo, 2012), which allocates
+ * its solution vectors every time it is constructed, the targeter is a workspace with
+ * fixed-capacity storage for the solutions, sized from the maximum number of revolutions when it
+ * is constructed. The targeter can be reused to solve any number of Lambert problems without heap
+ * allocation. A targeter is not thread-safe; each thread should use its own targeter.
+ *
+ * The solutions are stored in the same order as by lambert_problem: the zero-revolution solution,
+ * followed by the left and right branch solutions for each number of revolutions, such that the
+ * number of revolutions of solution i is floor( ( i + 1 ) / 2 ).
+ *
+ * @sa LambertBatchTargeter
+ */
+class LambertTargeter
+{
+public:
+
+    //! Construct targeter.
+    /*!
+     * Constructs targeter and allocates storage for the solutions of Lambert problems with up to
+     * the given maximum number of revolutions.
+     *
+     * @param[in] aRevolutionsMaximum Maximum number of revolutions
+     */
+    explicit LambertTargeter( const int aRevolutionsMaximum );
+
+    //! Solve Lambert problem.
+    /*!
+     * Solves Lambert problem for the transfer between the given departure and arrival positions
+     * in the given time-of-flight, for all numbers of revolutions up to the maximum number of
+     * revolutions for which a solution exists. The solutions replace the solutions of the
+     * previous Lambert problem. An error is thrown if the time-of-flight or gravitational
+     * parameter is not positive, or if the transfer plane cannot be determined.
+     *
+     * @param[in] departurePosition      Departure position [km]
+     * @param[in] arrivalPosition        Arrival position [km]
+     * @param[in] timeOfFlight           Time-of-flight [s]
+     * @param[in] gravitationalParameter Gravitational parameter [km^3 s^-2]
+     * @param[in] isRetrograde           Flag indicating if transfer is retrograde
+     * @return                           Number of solutions
+     */
+    int solve( const Vector3& departurePosition,
+               const Vector3& arrivalPosition,
+               const double timeOfFlight,
+               const double gravitationalParameter,
+               const bool isRetrograde );
+
+    //! Get number of solutions.
+    /*!
+     * Returns number of solutions of last Lambert problem solved.
+     *
+     * @return Number of solutions
+     */
+    int getNumberOfSolutions( ) const { return numberOfSolutions; }
+
+    //! Get capacity.
+    /*!
+     * Returns maximum number of solutions that can be stored by targeter.
+     *
+     * @return Maximum number of solutions
+     */
+    int getCapacity( ) const { return departureVelocities.size( ); }
+
+    //! Get departure velocity.
+    /*!
+     * Returns departure velocity of given solution of last Lambert problem solved.
+     *
+     * @param[in] solutionIndex Index of solution (0 <= solutionIndex < getNumberOfSolutions())
+     * @return                  Departure velocity [km/s]
+     */
+    const Vector3& getDepartureVelocity( const int solutionIndex ) const
+    {
+        return departureVelocities[ solutionIndex ];
+    }
+
+    //! Get arrival velocity.
+    /*!
+     * Returns arrival velocity of given solution of last Lambert problem solved.
+     *
+     * @param[in] solutionIndex Index of solution (0 <= solutionIndex < getNumberOfSolutions())
+     * @return                  Arrival velocity [km/s]
+     */
+    const Vector3& getArrivalVelocity( const int solutionIndex ) const
+    {
+        return arrivalVelocities[ solutionIndex ];
+    }
+
+protected:
+
+private:
+
+    //! Batched targeter with batch size of one.
+    LambertBatchTargeter batchTargeter;
+
+    //! Departure position of Lambert problem (batch of one) [km].
+    std::vector< Vector3 > departurePositions;
+
+    //! Arrival position of Lambert problem (batch of one) [km].
+    std::vector< Vector3 > arrivalPositions;
+
+    //! Time-of-flight of Lambert problem (batch of one) [s].
+    std::vector< double > timesOfFlight;
+
+    //! Number of solutions of current Lambert problem.
+    int numberOfSolutions;
+
+    //! Departure velocity per solution [km/s].
+    std::vector< Vector3 > departureVelocities;
+
+    //! Arrival velocity per solution [km/s].
+    std::vector< Vector3 > arrivalVelocities;
+};
+
+} // namespace d2d
+
+#endif // D2D_LAMBERT_TARGETER_HPP
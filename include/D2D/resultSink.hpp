@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_RESULT_SINK_HPP
+#define D2D_RESULT_SINK_HPP
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "D2D/columnStore.hpp"
+
+namespace d2d
+{
+
+//! Field of result record.
+/*!
+ * Data struct containing the name and type of a field of the records emitted by the application
+ * modes. Integer fields (e.g., object and transfer IDs) are stored as integers by the result
+ * sinks; all other fields are stored as doubles.
+ *
+ * @sa ResultSink
+ */
+struct ResultField
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct for field of result record.
+     *
+     * @param[in] aName       Name of field (column name)
+     * @param[in] integerFlag Flag indicating if field is an integer
+     */
+    ResultField( const std::string& aName, const bool integerFlag = false )
+        : name( aName ),
+          isInteger( integerFlag )
+    { }
+
+    //! Name of field (column name).
+    const std::string name;
+
+    //! Flag indicating if field is an integer.
+    const bool isInteger;
+
+protected:
+
+private:
+};
+
+//! Typedef for list of result fields.
+typedef std::vector< ResultField > ResultFields;
+
+//! Typedef for result record, containing the values of the result fields in order.
+typedef std::vector< double > ResultRecord;
+
+//! Result sink settings.
+/*!
+ * Data struct containing the type of result sink that an application mode writes its results to
+ * and, for file-based sinks, the path to the output file.
+ *
+ * @sa checkResultSinkSettings, createResultSink
+ */
+struct ResultSinkSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkResultSinkSettings
+     * @param[in] aType Type of result sink ("sqlite", "csv" or "null")
+     * @param[in] aPath Path to output file (only used for "csv")
+     */
+    ResultSinkSettings( const std::string& aType, const std::string& aPath )
+        : type( aType ),
+          path( aPath )
+    { }
+
+    //! Type of result sink ("sqlite", "csv" or "null").
+    const std::string type;
+
+    //! Path to output file (only used for "csv").
+    const std::string path;
+
+    //! Check if results are stored in the SQLite database.
+    /*!
+     * Checks if the SQLite result sink is used. Results that are not stored in the database cannot
+     * be read by subsequent application modes or used to write shortlists.
+     *
+     * @return True if the SQLite result sink is used
+     */
+    bool isSQLite( ) const { return type == "sqlite"; }
+
+protected:
+
+private:
+};
+
+//! Check result sink settings.
+/*!
+ * Checks the optional "sink" object in the config file, which contains the keys "type" ("sqlite",
+ * "csv" or "null") and, for the CSV sink, "path". If the "sink" object is not specified, the
+ * SQLite sink is used. If a setting is invalid, an error is thrown with a short description of the
+ * problem.
+ *
+ * @sa ResultSinkSettings, createResultSink
+ * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * @return           Struct containing verified result sink settings
+ */
+ResultSinkSettings checkResultSinkSettings( const rapidjson::Document& config );
+
+//! Get names of result fields.
+/*!
+ * Returns names of result fields, in order.
+ *
+ * @param[in] fields Result fields
+ * @return           Names of result fields
+ */
+std::vector< std::string > getResultFieldNames( const ResultFields& fields );
+
+//! Get insert query for result sink table.
+/*!
+ * Returns SQL command to insert a record into the given table, with positional parameters for the
+ * result fields, in order. The record ID (integer primary key) is assigned by SQLite.
+ *
+ * @sa SQLiteResultSink
+ * @param[in] tableName Name of table
+ * @param[in] fields    Result fields
+ * @return              SQL insert command
+ */
+std::string getResultSinkInsertQuery( const std::string& tableName, const ResultFields& fields );
+
+//! Result sink.
+/*!
+ * Interface for back ends that the application modes emit their result records to, such that the
+ * numerical loops do not depend on how (or if) the results are stored. Records are written in
+ * order and each record is assigned an ID, which is used to refer to the record (e.g., from a
+ * shortlist).
+ *
+ * @sa SQLiteResultSink, CSVResultSink, NullResultSink, ColumnStoreResultSink, createResultSink
+ */
+class ResultSink
+{
+public:
+
+    //! Destruct result sink.
+    virtual ~ResultSink( ) { }
+
+    //! Write record.
+    /*!
+     * Writes record to result sink.
+     *
+     * @param[in] record Record containing values of result fields, in order
+     * @return           ID of record
+     */
+    virtual long long write( const ResultRecord& record ) = 0;
+
+    //! Close result sink.
+    /*!
+     * Flushes records that are buffered by the result sink. No records can be written once the
+     * result sink is closed.
+     */
+    virtual void close( ) = 0;
+
+    //! Get number of records.
+    /*!
+     * Returns number of records written to result sink.
+     *
+     * @return Number of records
+     */
+    long long getNumberOfRecords( ) const { return numberOfRecords; }
+
+protected:
+
+    //! Construct result sink.
+    ResultSink( ) : numberOfRecords( 0 ) { }
+
+    //! Number of records written to result sink.
+    long long numberOfRecords;
+
+private:
+};
+
+//! SQLite result sink.
+/*!
+ * Result sink that inserts records into a table in an SQLite database. The table must exist and
+ * must contain an integer primary key (the record ID, assigned by SQLite), followed by the result
+ * fields. Records are inserted using a single prepared statement; transactions are managed by the
+ * caller.
+ *
+ * @sa ResultSink
+ */
+class SQLiteResultSink : public ResultSink
+{
+public:
+
+    //! Construct result sink.
+    /*!
+     * Constructs result sink and prepares insert query for given table.
+     *
+     * @param[in] database   SQLite database handle
+     * @param[in] tableName  Name of table
+     * @param[in] someFields Result fields (column names)
+     */
+    SQLiteResultSink( SQLite::Database& database,
+                      const std::string& tableName,
+                      const ResultFields& someFields );
+
+    //! Write record.
+    long long write( const ResultRecord& record );
+
+    //! Close result sink.
+    void close( );
+
+protected:
+
+private:
+
+    //! SQLite database handle.
+    SQLite::Database& database;
+
+    //! Result fields.
+    const ResultFields fields;
+
+    //! Insert query.
+    SQLite::Statement query;
+};
+
+//! CSV result sink.
+/*!
+ * Result sink that writes records to a CSV file, with a header line containing the field names.
+ * Record IDs are assigned consecutively, starting at 1.
+ *
+ * @sa ResultSink
+ */
+class CSVResultSink : public ResultSink
+{
+public:
+
+    //! Construct result sink.
+    /*!
+     * Constructs result sink and writes header line to file. An error is thrown if the file
+     * cannot be created.
+     *
+     * @param[in] path       Path to CSV file
+     * @param[in] someFields Result fields (column names)
+     */
+    CSVResultSink( const std::string& path, const ResultFields& someFields );
+
+    //! Write record.
+    long long write( const ResultRecord& record );
+
+    //! Close result sink.
+    void close( );
+
+protected:
+
+private:
+
+    //! Result fields.
+    const ResultFields fields;
+
+    //! Output file stream.
+    std::ofstream file;
+};
+
+//! Null result sink.
+/*!
+ * Result sink that discards records, such that the throughput of the numerical loops can be
+ * measured without I/O. Record IDs are assigned consecutively, starting at 1.
+ *
+ * @sa ResultSink
+ */
+class NullResultSink : public ResultSink
+{
+public:
+
+    //! Write record.
+    long long write( const ResultRecord& record );
+
+    //! Close result sink.
+    void close( ) { }
+
+protected:
+
+private:
+};
+
+//! Column store result sink.
+/*!
+ * Result sink that appends records to a column store (see ColumnStoreWriter). Record IDs are the
+ * row indices in the column store plus one. The header, including the given metadata, is written
+ * when the result sink is closed.
+ *
+ * @sa ResultSink, ColumnStoreWriter
+ */
+class ColumnStoreResultSink : public ResultSink
+{
+public:
+
+    //! Construct result sink.
+    /*!
+     * Constructs result sink for column store in given directory.
+     *
+     * @param[in] directory    Path to column store directory
+     * @param[in] someFields   Result fields (column names)
+     * @param[in] someMetadata Metadata stored in column store header, indexed by name
+     */
+    ColumnStoreResultSink( const std::string& directory,
+                           const ResultFields& someFields,
+                           const std::map< std::string, double >& someMetadata );
+
+    //! Write record.
+    long long write( const ResultRecord& record );
+
+    //! Close result sink.
+    void close( );
+
+protected:
+
+private:
+
+    //! Column store writer.
+    ColumnStoreWriter writer;
+
+    //! Metadata stored in column store header.
+    const std::map< std::string, double > metadata;
+};
+
+//! Create result sink.
+/*!
+ * Creates result sink based on the given settings. For the SQLite sink, the table must already
+ * exist in the database.
+ *
+ * @sa ResultSinkSettings, ResultSink
+ * @param[in] settings  Result sink settings
+ * @param[in] database  SQLite database handle (only used for SQLite sink)
+ * @param[in] tableName Name of table (only used for SQLite sink)
+ * @param[in] fields    Result fields
+ * @return              Result sink
+ */
+std::unique_ptr< ResultSink > createResultSink( const ResultSinkSettings& settings,
+                                                SQLite::Database& database,
+                                                const std::string& tableName,
+                                                const ResultFields& fields );
+
+} // namespace d2d
+
+#endif // D2D_RESULT_SINK_HPP
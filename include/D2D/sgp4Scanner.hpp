@@ -9,11 +9,16 @@
 #define D2D_SGP4_SCANNER_HPP
 
 #include <string>
+#include <vector>
 
 #include <rapidjson/document.h>
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "D2D/database.hpp"
+#include "D2D/resultSink.hpp"
+#include "D2D/shortlist.hpp"
+
 namespace d2d
 {
 
@@ -57,19 +62,25 @@ public:
      * @param[in] aDatabasePath           Path to SQLite database
      * @param[in] aShortlistLength        Number of transfers to include in shortlist
      * @param[in] aShortlistPath          Path to shortlist file
+     * @param[in] someResultSinkSettings  Result sink that results are written to
+     * @param[in] someDatabaseSettings    Bulk-load settings for SQLite database
      */
     sgp4ScannerInput( const double       aTransferDeltaVCutoff,
                       const double       aRelativeTolerance,
                       const double       aAbsoluteTolerance,
                       const std::string& aDatabasePath,
                       const int          aShortlistLength,
-                      const std::string& aShortlistPath )
+                      const std::string& aShortlistPath,
+                      const ResultSinkSettings& someResultSinkSettings,
+                      const DatabaseSettings& someDatabaseSettings )
         : transferDeltaVCutoff( aTransferDeltaVCutoff ),
           relativeTolerance( aRelativeTolerance ),
           absoluteTolerance( aAbsoluteTolerance ),
           databasePath( aDatabasePath ),
           shortlistLength( aShortlistLength ),
-          shortlistPath( aShortlistPath )
+          shortlistPath( aShortlistPath ),
+          resultSinkSettings( someResultSinkSettings ),
+          databaseSettings( someDatabaseSettings )
     { }
 
     //! Transfer \f$\Delta V\f$ cut-off used by sgp4_scanner.
@@ -90,6 +101,12 @@ public:
     //! Path to shortlist file.
     const std::string shortlistPath;
 
+    //! Result sink that results are written to.
+    const ResultSinkSettings resultSinkSettings;
+
+    //! Bulk-load settings for SQLite database.
+    const DatabaseSettings databaseSettings;
+
 protected:
 
 private:
@@ -118,31 +135,126 @@ sgp4ScannerInput checkSGP4ScannerInput( const rapidjson::Document& config );
  */
 void createSGP4ScannerTable( SQLite::Database& database );
 
-//! Bind zeroes into sgp4_scanner_results table.
+//! Create sgp4_scanner_results table indices.
 /*!
- * Bind zeroes into sgp4_scanner_results table in SQLite database when the total Lambert transfer
- * \f$\Delta V\f$ is above a user specified cut-off, the convergence test for the
- * virtual TLE fails, or the SGP4 propagation of the virtual TLE to the arrival epoch fails.
+ * Creates indices on sgp4_scanner_results table in SQLite database. The indices are created once
+ * all results have been inserted, which is cheaper than updating them for every insert.
  *
- * @sa executeSGP4Scanner
- * @param[in] lambertTransferId transfer_id in the lambert_scanner_results table
+ * @sa executeSGP4Scanner, createSGP4ScannerTable
+ * @param[in] database SQLite database handle
  */
-std::string bindZeroesSGP4ScannerTable( const int lambertTransferId );
+void createSGP4ScannerTableIndices( SQLite::Database& database );
+
+//! Get sgp4_scanner result fields.
+/*!
+ * Returns fields of the records written by sgp4_scanner to the result sink, in the order of the
+ * columns of the sgp4_scanner_results table (excluding the transfer_id column). If the convergence
+ * test for the virtual TLE or the SGP4 propagation to the arrival epoch fails, a record containing
+ * zeroes (except for the lambert_transfer_id field) is written.
+ *
+ * @sa executeSGP4Scanner, createSGP4ScannerTable, ResultSink
+ * @return Result fields
+ */
+ResultFields getSGP4ScannerResultFields( );
+
+//! Entry in sgp4_scanner shortlist.
+/*!
+ * Data struct containing a record written by sgp4_scanner to the result sink, together with the
+ * fields of the Lambert transfer that the shortlist is sorted by and reports. Entries are retained
+ * in a bounded shortlist while the transfers are propagated, such that the sgp4_scanner_results
+ * and lambert_scanner_results tables do not have to be joined and sorted afterwards.
+ *
+ * @sa SGP4ScannerShortlist, executeSGP4Scanner, writeSGP4TransferShortlist
+ */
+struct SGP4ScannerShortlistEntry
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs shortlist entry for propagated Lambert transfer.
+     *
+     * @param[in] aTransferId            ID of record in result sink (transfer_id)
+     * @param[in] aLambertTransferDeltaV Lambert transfer \f$\Delta V\f$
+     * @param[in] aDepartureObjectId     Departure object ID of Lambert transfer
+     * @param[in] anArrivalObjectId      Arrival object ID of Lambert transfer
+     * @param[in] aRecord                Record written to result sink
+     */
+    SGP4ScannerShortlistEntry( const long long aTransferId,
+                               const double aLambertTransferDeltaV,
+                               const int aDepartureObjectId,
+                               const int anArrivalObjectId,
+                               const ResultRecord& aRecord )
+        : transferId( aTransferId ),
+          lambertTransferDeltaV( aLambertTransferDeltaV ),
+          departureObjectId( aDepartureObjectId ),
+          arrivalObjectId( anArrivalObjectId ),
+          record( aRecord )
+    { }
+
+    //! Compare shortlist entries.
+    /*!
+     * Compares shortlist entries by Lambert transfer \f$\Delta V\f$, followed by transfer_id
+     * (i.e., order of insertion in result sink).
+     *
+     * @param[in] entry Shortlist entry to compare to
+     * @return          True if this entry is better than the given entry
+     */
+    bool operator<( const SGP4ScannerShortlistEntry& entry ) const
+    {
+        if ( lambertTransferDeltaV != entry.lambertTransferDeltaV )
+        {
+            return lambertTransferDeltaV < entry.lambertTransferDeltaV;
+        }
+
+        return transferId < entry.transferId;
+    }
+
+    //! ID of record in result sink (transfer_id).
+    long long transferId;
+
+    //! Lambert transfer \f$\Delta V\f$.
+    double lambertTransferDeltaV;
+
+    //! Departure object ID of Lambert transfer.
+    int departureObjectId;
+
+    //! Arrival object ID of Lambert transfer.
+    int arrivalObjectId;
+
+    //! Record written to result sink, containing values of sgp4_scanner result fields.
+    ResultRecord record;
+
+protected:
+
+private:
+};
+
+//! Get shortlist key of sgp4_scanner shortlist entry (Lambert transfer \f$\Delta V\f$).
+inline double getShortlistKey( const SGP4ScannerShortlistEntry& entry )
+{
+    return entry.lambertTransferDeltaV;
+}
+
+//! Bounded shortlist of sgp4_scanner records with lowest Lambert transfer \f$\Delta V\f$.
+typedef Shortlist< SGP4ScannerShortlistEntry > SGP4ScannerShortlist;
+
+//! List of sgp4_scanner shortlist entries.
+typedef std::vector< SGP4ScannerShortlistEntry > SGP4ScannerShortlistEntries;
 
 //! Write transfer shortlist to file.
 /*!
  * Writes shortlist of debris-to-debris transfers from the SGP4 scanner to file. The shortlist is
  * based on the requested number of transfers with the lowest Lambert transfer \f$\Delta V\f$,
- * retrieved by sorting the transfers in the SQLite database.
+ * retained in a bounded shortlist while the transfers are propagated, such that it does not
+ * depend on the result sink or on where the Lambert transfers are stored.
  *
- * @sa executeSGP4Scanner, createSGP4ScannerTable
- * @param[in] database        SQLite database handle
- * @param[in] shortlistNumber Number of entries to include in shortlist (if it exceeds number of
- *                            entries in database table, the whole table is written to file)
- * @param[in] shortlistPath   Path to shortlist file
+ * @sa executeSGP4Scanner, SGP4ScannerShortlist
+ * @param[in] shortlistEntries Shortlist entries, sorted by Lambert transfer \f$\Delta V\f$
+ *                             (ascending)
+ * @param[in] shortlistPath    Path to shortlist file
  */
-void writeSGP4TransferShortlist( SQLite::Database& database,
-                                 const int shortlistNumber,
+void writeSGP4TransferShortlist( const SGP4ScannerShortlistEntries& shortlistEntries,
                                  const std::string& shortlistPath );
 
 } // namespace d2d
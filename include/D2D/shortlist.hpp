@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_SHORTLIST_HPP
+#define D2D_SHORTLIST_HPP
+
+#include <algorithm>
+#include <vector>
+
+namespace d2d
+{
+
+//! Get shortlist key of entry.
+/*!
+ * Returns the key by which shortlist entries are primarily ordered (e.g., transfer
+ * \f$\Delta V\f$). Overloads are provided for each type of shortlist entry (see, e.g.,
+ * SGP4ScannerShortlistEntry), and are found by argument-dependent lookup.
+ *
+ * @sa Shortlist::isImprovedBy
+ * @param[in] entry Shortlist entry
+ * @return          Key of entry
+ */
+inline double getShortlistKey( const double entry ) { return entry; }
+
+//! Bounded shortlist.
+/*!
+ * Shortlist that retains the best entries (smallest according to operator<) out of a stream of
+ * entries, up to a fixed capacity. The entries are stored in a max-heap, such that the worst
+ * retained entry is available in constant time and each insertion takes logarithmic time in the
+ * capacity.
+ *
+ * Shortlists can be filled independently (e.g., one per thread) and merged afterwards.
+ *
+ * @tparam Entry Type of shortlist entry; must be copyable and provide operator<
+ */
+template< typename Entry >
+class Shortlist
+{
+public:
+
+    //! Construct shortlist.
+    /*!
+     * Constructs empty shortlist with given capacity.
+     *
+     * @param[in] aCapacity Maximum number of entries retained
+     */
+    explicit Shortlist( const unsigned int aCapacity = 0 )
+        : capacity( aCapacity )
+    {
+        entries.reserve( capacity );
+    }
+
+    //! Check if shortlist is full.
+    /*!
+     * Checks if the number of entries retained is equal to the capacity of the shortlist.
+     *
+     * @return True if shortlist is full
+     */
+    bool isFull( ) const { return entries.size( ) >= capacity; }
+
+    //! Get worst entry.
+    /*!
+     * Returns worst entry retained in shortlist. The shortlist must not be empty.
+     *
+     * @return Worst entry retained
+     */
+    const Entry& getWorst( ) const { return entries.front( ); }
+
+    //! Check if entry with given key would be retained.
+    /*!
+     * Checks if an entry with the given key (see getShortlistKey()) would be retained if it were
+     * inserted, such that entries that would be discarded need not be constructed. This assumes
+     * that entries are inserted in increasing order of their tie-breaker (e.g., transfer_id), so
+     * that an entry with the same key as the worst entry of a full shortlist loses the tie and is
+     * discarded.
+     *
+     * @param[in] key Key of entry
+     * @return        True if shortlist has capacity left or key is lower than key of worst entry
+     */
+    bool isImprovedBy( const double key ) const
+    {
+        if ( capacity == 0 )
+        {
+            return false;
+        }
+
+        return !isFull( ) || key < getShortlistKey( getWorst( ) );
+    }
+
+    //! Insert entry.
+    /*!
+     * Inserts entry in shortlist. If the shortlist is full, the entry replaces the worst entry
+     * retained if it is better; otherwise it is discarded.
+     *
+     * @param[in] entry Entry to insert
+     */
+    void insert( const Entry& entry )
+    {
+        if ( capacity == 0 )
+        {
+            return;
+        }
+
+        if ( entries.size( ) < capacity )
+        {
+            entries.push_back( entry );
+            std::push_heap( entries.begin( ), entries.end( ) );
+        }
+        else if ( entry < entries.front( ) )
+        {
+            std::pop_heap( entries.begin( ), entries.end( ) );
+            entries.back( ) = entry;
+            std::push_heap( entries.begin( ), entries.end( ) );
+        }
+    }
+
+    //! Merge shortlist.
+    /*!
+     * Merges entries of another shortlist into this shortlist.
+     *
+     * @param[in] shortlist Shortlist to merge
+     */
+    void merge( const Shortlist< Entry >& shortlist )
+    {
+        for ( unsigned int i = 0; i < shortlist.entries.size( ); i++ )
+        {
+            insert( shortlist.entries[ i ] );
+        }
+    }
+
+    //! Get sorted entries.
+    /*!
+     * Returns entries retained in shortlist, sorted from best to worst.
+     *
+     * @return Sorted entries
+     */
+    std::vector< Entry > getSortedEntries( ) const
+    {
+        std::vector< Entry > sortedEntries( entries );
+        std::sort_heap( sortedEntries.begin( ), sortedEntries.end( ) );
+        return sortedEntries;
+    }
+
+protected:
+
+private:
+
+    //! Maximum number of entries retained.
+    unsigned int capacity;
+
+    //! Entries retained, stored as max-heap.
+    std::vector< Entry > entries;
+};
+
+} // namespace d2d
+
+#endif // D2D_SHORTLIST_HPP
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_TLE_CATALOG_HPP
+#define D2D_TLE_CATALOG_HPP
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libsgp4/Tle.h>
+
+namespace d2d
+{
+
+class DecompressionQueue;
+
+//! List of TLE objects parsed from catalog.
+typedef std::vector< Tle > TleObjects;
+
+//! Memory-mapped TLE catalog.
+/*!
+ * Reader for TLE catalog files in 2-line or 3-line format (see getTleCatalogType()). The catalog
+ * file is memory-mapped and split into lines in place: lines are stored as pointers into the
+ * mapping, such that no line is copied until it is requested. Empty lines are skipped.
+ *
+ * Catalogs compressed with gzip or xz are detected from the file signature and decompressed while
+ * they are read: a separate thread decompresses the catalog into blocks, which are split into
+ * lines as they become available. Decompressed blocks are owned by the reader, and lines are
+ * stored as pointers into them. Decompression requires D2D to be built with zlib (gzip) or
+ * liblzma (xz) respectively. Only line splitting overlaps with decompression: TLE objects are
+ * not constructed while the catalog is read, since callers may only need the lines or some of
+ * the TLEs, and are instead constructed in parallel once the catalog has been read.
+ *
+ * TLE objects can be constructed from the catalog in parallel (see getTleObjects()), since
+ * parsing the TLE elements dominates the cost of reading large catalogs.
+ *
+ * @sa getTleCatalogType
+ */
+class TleCatalog
+{
+public:
+
+    //! Construct reader.
+    /*!
+     * Constructs reader for given catalog file. The file is memory-mapped and split into lines.
+     * Compressed catalogs are decompressed. An error is thrown if the file cannot be mapped or
+     * decompressed, if the catalog type cannot be determined
+     * from the first line, or if the number of lines is not a multiple of the number of lines per
+     * TLE.
+     *
+     * @param[in] catalogPath Path to TLE catalog
+     */
+    explicit TleCatalog( const std::string& catalogPath );
+
+    //! Destruct reader.
+    /*!
+     * Unmaps catalog file.
+     */
+    ~TleCatalog( );
+
+    //! Get number of lines per TLE.
+    /*!
+     * Returns number of lines per TLE in catalog (2 or 3).
+     *
+     * @return Number of lines per TLE
+     */
+    int getNumberOfLinesPerTle( ) const { return linesPerTle; }
+
+    //! Get number of TLEs.
+    /*!
+     * Returns number of TLEs in catalog.
+     *
+     * @return Number of TLEs
+     */
+    unsigned int getNumberOfTles( ) const { return lines.size( ) / linesPerTle; }
+
+    //! Get line of TLE.
+    /*!
+     * Returns copy of given line of TLE in catalog, excluding newline characters. For 3-line
+     * catalogs, line 0 is the name line.
+     *
+     * @param[in] tleIndex  Index of TLE in catalog
+     * @param[in] lineIndex Index of line in TLE (0 to getNumberOfLinesPerTle() - 1)
+     * @return              Line of TLE
+     */
+    std::string getLine( const unsigned int tleIndex, const int lineIndex ) const;
+
+    //! Get raw line of TLE.
+    /*!
+     * Returns copy of given line of TLE in catalog as stored in the catalog file, excluding the
+     * line feed only (i.e., including the carriage return of catalogs with CRLF line endings).
+     *
+     * @param[in] tleIndex  Index of TLE in catalog
+     * @param[in] lineIndex Index of line in TLE (0 to getNumberOfLinesPerTle() - 1)
+     * @return              Line of TLE, as stored in catalog file
+     */
+    std::string getRawLine( const unsigned int tleIndex, const int lineIndex ) const;
+
+    //! Compute hash of catalog.
+    /*!
+     * Computes 64-bit FNV-1a hash of the (decompressed) contents of the catalog file, which
+     * identifies the catalog in caches of derived data (see EphemerisTable::writeCache()). The
+     * hash of a compressed catalog is equal to the hash of the uncompressed catalog.
+     *
+     * @return Hash of catalog file
+     */
+    unsigned long long computeHash( ) const;
+
+    //! Get TLE object.
+    /*!
+     * Constructs TLE object from given TLE in catalog.
+     *
+     * @param[in] tleIndex Index of TLE in catalog
+     * @return             TLE object
+     */
+    Tle getTle( const unsigned int tleIndex ) const;
+
+    //! Get TLE objects.
+    /*!
+     * Constructs TLE objects from all TLEs in catalog. The catalog is split into contiguous
+     * chunks of TLEs that are parsed in parallel; the objects are returned in catalog order.
+     * Errors thrown while parsing are rethrown once all threads have completed.
+     *
+     * @param[in] numberOfThreads Number of threads used to parse TLEs (default: 1)
+     * @return                    List of TLE objects, in catalog order
+     */
+    TleObjects getTleObjects( const int numberOfThreads = 1 ) const;
+
+protected:
+
+private:
+
+    //! Split text into lines.
+    /*!
+     * Splits text into lines, which are appended to the list of lines as pointers into the text.
+     * Empty lines are skipped.
+     *
+     * @param[in] begin Pointer to first character of text
+     * @param[in] end   Pointer past last character of text
+     */
+    void splitLines( const char* begin, const char* end );
+
+    //! Read decompressed blocks.
+    /*!
+     * Splits decompressed blocks into lines as they are popped from the queue, until the queue is
+     * closed. Lines that span several blocks are copied into a block of their own. The hash of
+     * the decompressed catalog is computed along the way.
+     *
+     * @param[in,out] queue Queue of decompressed blocks
+     */
+    void readDecompressedBlocks( DecompressionQueue& queue );
+
+    //! Parse TLEs.
+    /*!
+     * Constructs TLE objects for given range of TLEs in catalog. Errors are stored, rather than
+     * thrown.
+     *
+     * @param[in]  tleIndexBegin Index of first TLE to parse
+     * @param[in]  tleIndexEnd   Index past last TLE to parse
+     * @param[out] tleObjects    List of TLE objects, in catalog order
+     * @param[out] error         Pointer to exception thrown during parsing (null if none)
+     */
+    void parseTles( const unsigned int tleIndexBegin,
+                    const unsigned int tleIndexEnd,
+                    TleObjects& tleObjects,
+                    std::exception_ptr& error ) const;
+
+    //! Copying is disabled, since the reader owns the memory mapping.
+    TleCatalog( const TleCatalog& );
+    TleCatalog& operator=( const TleCatalog& );
+
+    //! Memory-mapped catalog file (null if file is empty or compressed).
+    void* mapping;
+
+    //! Size of memory-mapped catalog file [bytes].
+    std::size_t mappingSize;
+
+    //! Number of lines per TLE (2 or 3).
+    int linesPerTle;
+
+    //! Decompressed blocks of compressed catalog, which the lines point into.
+    std::vector< std::unique_ptr< std::string > > decompressedBlocks;
+
+    //! Hash of decompressed catalog.
+    unsigned long long contentHash;
+
+    //! Non-empty lines in catalog (pointer to first character and length), in order.
+    std::vector< std::pair< const char*, std::size_t > > lines;
+};
+
+} // namespace d2d
+
+#endif // D2D_TLE_CATALOG_HPP
@@ -9,6 +9,7 @@
 #define D2D_TOOLS_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -131,6 +132,48 @@ bool executeVirtualTleConvergenceTest( const Vector6& propagatedCartesianState,
  */
 Vector6 getStateVector( const Eci state );
 
+//! Compute periapsis radius.
+/*!
+ * Computes periapsis radius of the conic section (ellipse, parabola or hyperbola) defined by a
+ * Cartesian position and velocity, from the specific angular momentum and orbital energy. This is
+ * cheaper than a full conversion to Keplerian elements.
+ *
+ * @param[in] position               Cartesian position [km]
+ * @param[in] velocity               Cartesian velocity [km/s]
+ * @param[in] gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @return                           Periapsis radius [km]
+ */
+double computePeriapsisRadius( const Vector3& position,
+                               const Vector3& velocity,
+                               const double gravitationalParameter );
+
+//! Estimate transfer \f$\Delta V\f$ between two orbits.
+/*!
+ * Estimates the \f$\Delta V\f$ required to transfer between two orbits, given a Cartesian state
+ * on each orbit. The estimate is a lower bound on the total \f$\Delta V\f$ of any two-impulse
+ * (Lambert) transfer between the orbits, so that it can be used to discard object pairs without
+ * discarding feasible transfers. The estimate is the larger of two bounds:
+ *
+ *  - In-plane bound: if the radial ranges of the orbits do not overlap, the \f$\Delta V\f$ of the
+ *    coplanar Hohmann transfer between the apoapsis radius of the inner orbit and the periapsis
+ *    radius of the outer orbit, and zero otherwise.
+ *  - Plane-change bound: \f$\min( h_{1} / r_{a,1}, h_{2} / r_{a,2} ) \sin\theta\f$, where
+ *    \f$h\f$ is the specific angular momentum, \f$r_{a}\f$ is the apoapsis radius and
+ *    \f$\theta\f$ is the angle between the orbital planes. This is the smallest horizontal
+ *    speed on either orbit, rotated through the angle between the planes.
+ *
+ * For coplanar circular orbits the estimate is the Hohmann transfer \f$\Delta V\f$. For unbound
+ * orbits the plane-change bound is zero.
+ *
+ * @param[in] departureState         Cartesian state on departure orbit [km; km/s]
+ * @param[in] arrivalState           Cartesian state on arrival orbit [km; km/s]
+ * @param[in] gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @return                           Estimated transfer \f$\Delta V\f$ [km/s]
+ */
+double estimateTransferDeltaV( const Vector6& departureState,
+                               const Vector6& arrivalState,
+                               const double gravitationalParameter );
+
 //! Print value to stream.
 /*!
  * Prints a specified value to stream provided, given a specified width and a filler character.
@@ -210,6 +253,22 @@ void print( std::ostream& stream,
  */
 ConfigIterator find( const rapidjson::Document& config, const std::string& parameterName );
 
+//! Override config parameters.
+/*!
+ * Copies config stored in JSON document and overrides parameters with those stored in another
+ * JSON object: each parameter in the overrides replaces the parameter with the same name in the
+ * copy, or is added if there is none. If both parameters are objects (e.g., "bulk_load"), their
+ * members are overridden in the same way, such that nested parameters that are not overridden are
+ * kept. This is used by application modes that execute several variants of a shared config.
+ *
+ * @param[in]  config           JSON document containing config parameters
+ * @param[in]  overrides        JSON object containing parameters that override config parameters
+ * @param[out] overriddenConfig JSON document containing config with overridden parameters
+ */
+void overrideConfig( const rapidjson::Document& config,
+                     const rapidjson::Value& overrides,
+                     rapidjson::Document& overriddenConfig );
+
 //! Remove newline characters from string.
 /*!
  * Removes newline characters from a string by making use of the STL erase() and remove()
@@ -228,6 +287,21 @@ void removeNewline( std::string& string );
  */
 int getTleCatalogType( const std::string& catalogFirstLine );
 
+//! Compute FNV-1a hash.
+/*!
+ * Computes 64-bit FNV-1a hash of a block of memory. Hashes of several blocks can be chained by
+ * passing the hash of the previous block as the initial hash.
+ *
+ * @param[in] data        Pointer to first byte of block (can be null if size is 0)
+ * @param[in] size        Size of block [bytes]
+ * @param[in] initialHash Initial hash (default: FNV-1a offset basis)
+ * @return                Hash of block
+ */
+unsigned long long computeHashFnv1a( const void* data,
+                                     const std::size_t size,
+                                     const unsigned long long initialHash
+                                        = 14695981039346656037ull );
+
 } // namespace d2d
 
 #endif // D2D_TOOLS_HPP
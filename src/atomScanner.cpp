@@ -12,6 +12,7 @@
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
@@ -32,6 +33,7 @@
 #include <Astro/astro.hpp>
 
 #include "D2D/atomScanner.hpp"
+#include "D2D/lambertScanner.hpp"
 #include "D2D/tools.hpp"
 #include "D2D/typedefs.hpp"
 
@@ -65,13 +67,21 @@ void executeAtomScanner( const rapidjson::Document& config )
 
     // Open database in read/write mode.
     // N.B.: Database must already exist and contain two populated table called
-    //       "lambert_scanner_results" and "sgp4_scanner_results".
+    //       "lambert_scanner_results" (or refer to a lambert_scanner column store) and
+    //       "sgp4_scanner_results".
     SQLite::Database database( input.databasePath.c_str( ), SQLITE_OPEN_READWRITE );
 
-    // Create table called atom_scanner_results in SQLite database.
-    std::cout << "Creating SQLite database table if needed ... " << std::endl;
-    createAtomScannerTable( database );
-    std::cout << "SQLite database set up successfully!" << std::endl;
+    // Apply bulk-load settings to database connection.
+    applyDatabaseSettings( database, input.databaseSettings );
+
+    // Create table called atom_scanner_results in SQLite database, if results are stored in
+    // database.
+    if ( input.resultSinkSettings.isSQLite( ) )
+    {
+        std::cout << "Creating SQLite database table if needed ... " << std::endl;
+        createAtomScannerTable( database );
+        std::cout << "SQLite database set up successfully!" << std::endl;
+    }
 
     // Start SQL transaction.
     SQLite::Transaction transaction( database );
@@ -85,32 +95,39 @@ void executeAtomScanner( const rapidjson::Document& config )
         = database.execAndGet( sgp4ScannerTableSizeSelect.str( ) );
     std::cout << "Cases to process: " << atomScannerTableSize << std::endl;
 
-    // Set up select query to fetch data from lambert and sgp4 scanner tables.
+    // Set up reader for lambert_scanner_results table or column store (recomputes fields omitted
+    // in compact schema).
+    const LambertScannerTransferReader reader( database );
+
+    // Set up select query to fetch data from lambert and sgp4 scanner tables. If the transfers are
+    // stored in a column store, only the sgp4 scanner table is selected and the transfers are
+    // read from the column store.
     std::ostringstream lambertSGP4ScannerTableSelect;
-    lambertSGP4ScannerTableSelect << "SELECT        * "
-                                  << "FROM          sgp4_scanner_results "
-                                  << "INNER JOIN    lambert_scanner_results "
-                                  << "ON            lambert_scanner_results.transfer_id "
-                                  << "              = sgp4_scanner_results.lambert_transfer_id "
-                                  << "WHERE         sgp4_scanner_results.success=1;";
+    if ( reader.isColumnStore )
+    {
+        lambertSGP4ScannerTableSelect << "SELECT * FROM sgp4_scanner_results WHERE success=1;";
+    }
+
+    else
+    {
+        lambertSGP4ScannerTableSelect << "SELECT        * "
+                                      << "FROM          sgp4_scanner_results "
+                                      << "INNER JOIN    lambert_scanner_results "
+                                      << "ON            lambert_scanner_results.transfer_id "
+                                      << "              = sgp4_scanner_results.lambert_transfer_id "
+                                      << "WHERE         sgp4_scanner_results.success=1;";
+    }
 
     SQLite::Statement lambertSGP4Query( database, lambertSGP4ScannerTableSelect.str( ) );
 
-    // Setup insert query.
-    std::ostringstream atomScannerTableInsert;
-    atomScannerTableInsert << "INSERT INTO atom_scanner_results VALUES ("
-                           << "NULL,"
-                           << ":lambert_transfer_id,"
-                           << ":atom_departure_delta_v_x,"
-                           << ":atom_departure_delta_v_y,"
-                           << ":atom_departure_delta_v_z,"
-                           << ":atom_arrival_delta_v_x,"
-                           << ":atom_arrival_delta_v_y,"
-                           << ":atom_arrival_delta_v_z,"
-                           << ":atom_transfer_delta_v"
-                           << ");";
-
-    SQLite::Statement atomQuery( database, atomScannerTableInsert.str( ) );
+    // Set up result sink that results are written to.
+    const ResultFields resultFields = getAtomScannerResultFields( );
+    std::unique_ptr< ResultSink > resultSink = createResultSink(
+        input.resultSinkSettings, database, "atom_scanner_results", resultFields );
+    ResultRecord record;
+
+    // Set up shortlist of records with lowest Atom transfer Delta-V.
+    AtomScannerShortlist shortlist( std::max( input.shortlistLength, 0 ) );
 
     std::cout << "Computing Atom transfers and populating database ... " << std::endl;
     boost::progress_display showProgress( atomScannerTableSize );
@@ -121,26 +138,31 @@ void executeAtomScanner( const rapidjson::Document& config )
     {
         const int      lambertTransferId                    = lambertSGP4Query.getColumn( 1 );
 
-        const double   departureEpochJulian                 = lambertSGP4Query.getColumn( 20 );
-        const double   timeOfFlight                         = lambertSGP4Query.getColumn( 21 );
+        // Columns of lambert_scanner_results follow the 17 columns of sgp4_scanner_results.
+        const LambertScannerTransfer transfer
+            = reader.isColumnStore ? reader.read( lambertTransferId )
+                                   : reader.read( lambertSGP4Query, 17 );
+
+        const double   departureEpochJulian                 = transfer.departureEpoch;
+        const double   timeOfFlight                         = transfer.timeOfFlight;
 
-        const double   departurePositionX                   = lambertSGP4Query.getColumn( 24 );
-        const double   departurePositionY                   = lambertSGP4Query.getColumn( 25 );
-        const double   departurePositionZ                   = lambertSGP4Query.getColumn( 26 );
-        const double   departureVelocityX                   = lambertSGP4Query.getColumn( 27 );
-        const double   departureVelocityY                   = lambertSGP4Query.getColumn( 28 );
-        const double   departureVelocityZ                   = lambertSGP4Query.getColumn( 29 );
+        const double   departurePositionX                   = transfer.departureState[ 0 ];
+        const double   departurePositionY                   = transfer.departureState[ 1 ];
+        const double   departurePositionZ                   = transfer.departureState[ 2 ];
+        const double   departureVelocityX                   = transfer.departureState[ 3 ];
+        const double   departureVelocityY                   = transfer.departureState[ 4 ];
+        const double   departureVelocityZ                   = transfer.departureState[ 5 ];
 
-        const double   arrivalPositionX                     = lambertSGP4Query.getColumn( 36 );
-        const double   arrivalPositionY                     = lambertSGP4Query.getColumn( 37 );
-        const double   arrivalPositionZ                     = lambertSGP4Query.getColumn( 38 );
-        const double   arrivalVelocityX                     = lambertSGP4Query.getColumn( 39 );
-        const double   arrivalVelocityY                     = lambertSGP4Query.getColumn( 40 );
-        const double   arrivalVelocityZ                     = lambertSGP4Query.getColumn( 41 );
+        const double   arrivalPositionX                     = transfer.arrivalState[ 0 ];
+        const double   arrivalPositionY                     = transfer.arrivalState[ 1 ];
+        const double   arrivalPositionZ                     = transfer.arrivalState[ 2 ];
+        const double   arrivalVelocityX                     = transfer.arrivalState[ 3 ];
+        const double   arrivalVelocityY                     = transfer.arrivalState[ 4 ];
+        const double   arrivalVelocityZ                     = transfer.arrivalState[ 5 ];
 
-        const double   departureDeltaVX                     = lambertSGP4Query.getColumn( 54 );
-        const double   departureDeltaVY                     = lambertSGP4Query.getColumn( 55 );
-        const double   departureDeltaVZ                     = lambertSGP4Query.getColumn( 56 );
+        const double   departureDeltaVX                     = transfer.departureDeltaV[ 0 ];
+        const double   departureDeltaVY                     = transfer.departureDeltaV[ 1 ];
+        const double   departureDeltaVZ                     = transfer.departureDeltaV[ 2 ];
 
         // Set up DateTime object for departure epoch using Julian date.
         // Note: The transformation given in the following statement is based on how the DateTime
@@ -201,17 +223,23 @@ void executeAtomScanner( const rapidjson::Document& config )
             const double atomTransferDeltaV = sml::norm< double > ( atomDepartureDeltaV )
                                                 + sml::norm< double > ( atomArrivalDeltaV );
 
-            atomQuery.bind( ":lambert_transfer_id",              lambertTransferId );
-            atomQuery.bind( ":atom_departure_delta_v_x",         atomDepartureDeltaV[ 0 ] );
-            atomQuery.bind( ":atom_departure_delta_v_y",         atomDepartureDeltaV[ 1 ] );
-            atomQuery.bind( ":atom_departure_delta_v_z",         atomDepartureDeltaV[ 2 ] );
-            atomQuery.bind( ":atom_arrival_delta_v_x",           atomArrivalDeltaV[ 0 ] );
-            atomQuery.bind( ":atom_arrival_delta_v_y",           atomArrivalDeltaV[ 1 ] );
-            atomQuery.bind( ":atom_arrival_delta_v_z",           atomArrivalDeltaV[ 2 ] );
-            atomQuery.bind( ":atom_transfer_delta_v",            atomTransferDeltaV );
-
-            atomQuery.executeStep( );
-            atomQuery.reset( );
+            const double result[ ] = { static_cast< double >( lambertTransferId ),
+                                       atomDepartureDeltaV[ 0 ],
+                                       atomDepartureDeltaV[ 1 ],
+                                       atomDepartureDeltaV[ 2 ],
+                                       atomArrivalDeltaV[ 0 ],
+                                       atomArrivalDeltaV[ 1 ],
+                                       atomArrivalDeltaV[ 2 ],
+                                       atomTransferDeltaV };
+            record.assign( result, result + resultFields.size( ) );
+            const long long transferId = resultSink->write( record );
+
+            // Retain record in shortlist.
+            if ( shortlist.isImprovedBy( atomTransferDeltaV ) )
+            {
+                shortlist.insert(
+                    AtomScannerShortlistEntry( transferId, atomTransferDeltaV, record ) );
+            }
         }
         catch( std::exception& atomSolverError )
         {
@@ -220,6 +248,9 @@ void executeAtomScanner( const rapidjson::Document& config )
         ++showProgress;
     }
 
+    // Flush records buffered by result sink.
+    resultSink->close( );
+
     // Commit transaction.
     transaction.commit( );
 
@@ -229,11 +260,20 @@ void executeAtomScanner( const rapidjson::Document& config )
     std::cout << "Database populated successfully!" << std::endl;
     std::cout << std::endl;
 
+    // Create indices once all results have been inserted.
+    if ( input.resultSinkSettings.isSQLite( ) )
+    {
+        std::cout << "Creating SQLite database table indices ... " << std::endl;
+        createAtomScannerTableIndices( database );
+        std::cout << "SQLite database table indices created successfully!" << std::endl;
+        std::cout << std::endl;
+    }
+
     // Check if shortlist file should be created; call function to write output.
     if ( input.shortlistLength > 0 )
     {
         std::cout << "Writing shortlist to file ... " << std::endl;
-        writeAtomTransferShortlist( database, input.shortlistLength, input.shortlistPath );
+        writeAtomTransferShortlist( shortlist.getSortedEntries( ), input.shortlistPath );
         std::cout << "Shortlist file created successfully!" << std::endl;
     }
 }
@@ -263,12 +303,18 @@ AtomScannerInput checkAtomScannerInput( const rapidjson::Document& config )
         std::cout << "Shortlist                       " << shortlistPath << std::endl;
     }
 
+    const ResultSinkSettings resultSinkSettings = checkResultSinkSettings( config );
+
+    const DatabaseSettings databaseSettings = checkDatabaseSettings( config );
+
     return AtomScannerInput( relativeTolerance,
                              absoluteTolerance,
                              databasePath,
                              maxIterations,
                              shortlistLength,
-                             shortlistPath );
+                             shortlistPath,
+                             resultSinkSettings,
+                             databaseSettings );
 }
 
 //! Create atom_scanner table.
@@ -301,23 +347,37 @@ void createAtomScannerTable( SQLite::Database& database )
     }
 }
 
+//! Create atom_scanner table indices.
+void createAtomScannerTableIndices( SQLite::Database& database )
+{
+    // Execute command to create index on Atom transfer Delta-V column.
+    std::ostringstream atomTransferDeltaVIndexCreate;
+    atomTransferDeltaVIndexCreate << "CREATE INDEX IF NOT EXISTS \"atom_transfer_delta_v\" on "
+                                  << "atom_scanner_results (atom_transfer_delta_v ASC);";
+    database.exec( atomTransferDeltaVIndexCreate.str( ).c_str( ) );
+}
+
+//! Get atom_scanner result fields.
+ResultFields getAtomScannerResultFields( )
+{
+    ResultFields fields;
+    fields.push_back( ResultField( "lambert_transfer_id", true ) );
+    fields.push_back( ResultField( "atom_departure_delta_v_x" ) );
+    fields.push_back( ResultField( "atom_departure_delta_v_y" ) );
+    fields.push_back( ResultField( "atom_departure_delta_v_z" ) );
+    fields.push_back( ResultField( "atom_arrival_delta_v_x" ) );
+    fields.push_back( ResultField( "atom_arrival_delta_v_y" ) );
+    fields.push_back( ResultField( "atom_arrival_delta_v_z" ) );
+    fields.push_back( ResultField( "atom_transfer_delta_v" ) );
+
+    return fields;
+}
+
 //! Write transfer shortlist to file.
-void writeAtomTransferShortlist( SQLite::Database& database,
-                                 const int shortlistNumber,
+void writeAtomTransferShortlist( const AtomScannerShortlistEntries& shortlistEntries,
                                  const std::string& shortlistPath )
 {
-    // Fetch transfers to include in shortlist.
-    // Database table is sorted by transfer_delta_v, in ascending order.
-    std::ostringstream shortlistSelect;
-    shortlistSelect << "SELECT      * "
-                    << "FROM        atom_scanner_results "
-                    << "ORDER BY    atom_transfer_delta_v "
-                    << "ASC "
-                    << "LIMIT "
-                    << shortlistNumber << ";";
-    SQLite::Statement query( database, shortlistSelect.str( ) );
-
-    // Write fetch data to file.
+    // Write shortlist entries to file.
     std::ofstream shortlistFile( shortlistPath.c_str( ) );
 
     // Print file header.
@@ -332,18 +392,19 @@ void writeAtomTransferShortlist( SQLite::Database& database,
                   << "atom_transfer_delta_v"
                   << std::endl;
 
-    // Loop through data retrieved from database and write to file.
-    while( query.executeStep( ) )
+    // Loop through shortlist entries and write to file.
+    for ( unsigned int i = 0; i < shortlistEntries.size( ); i++ )
     {
-        const int    atomTransferId                     = query.getColumn( 0 );
-        const int    lambertTransferId                  = query.getColumn( 1 );
-        const double atomDepartureDeltaVX               = query.getColumn( 2 );
-        const double atomDepartureDeltaVY               = query.getColumn( 3 );
-        const double atomDepartureDeltaVZ               = query.getColumn( 4 );
-        const double atomArrivalDeltaVX                 = query.getColumn( 5 );
-        const double atomArrivalDeltaVY                 = query.getColumn( 6 );
-        const double atomArrivalDeltaVZ                 = query.getColumn( 7 );
-        const double atomTransferDeltaV                 = query.getColumn( 8 );
+        const AtomScannerShortlistEntry& entry          = shortlistEntries[ i ];
+        const long long atomTransferId                  = entry.transferId;
+        const int    lambertTransferId                  = static_cast< int >( entry.record[ 0 ] );
+        const double atomDepartureDeltaVX               = entry.record[ 1 ];
+        const double atomDepartureDeltaVY               = entry.record[ 2 ];
+        const double atomDepartureDeltaVZ               = entry.record[ 3 ];
+        const double atomArrivalDeltaVX                 = entry.record[ 4 ];
+        const double atomArrivalDeltaVY                 = entry.record[ 5 ];
+        const double atomArrivalDeltaVZ                 = entry.record[ 6 ];
+        const double atomTransferDeltaV                 = entry.atomTransferDeltaV;
 
         shortlistFile << atomTransferId             << ","
                       << lambertTransferId          << ",";
@@ -7,7 +7,10 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #include <boost/xpressive/xpressive.hpp>
 
@@ -16,6 +19,7 @@
 #include <libsgp4/Tle.h>
 
 #include "D2D/catalogPruner.hpp"
+#include "D2D/tleCatalog.hpp"
 #include "D2D/tools.hpp"
 
 namespace d2d
@@ -25,7 +29,7 @@ namespace d2d
 void executeCatalogPruner( const rapidjson::Document& config )
 {
     // Verify config parameters. Exception is thrown if any of the parameters are missing.
-    const CatalogPrunerInput input = checkCatalogPrunerInput( config );
+    const std::vector< CatalogPrunerInput > inputs = checkCatalogPrunerFilterSets( config );
 
     std::cout << std::endl;
     std::cout << "******************************************************************" << std::endl;
@@ -33,193 +37,170 @@ void executeCatalogPruner( const rapidjson::Document& config )
     std::cout << "******************************************************************" << std::endl;
     std::cout << std::endl;
 
-    // Parse catalog and store TLE objects.
-    std::ifstream catalogFile( input.catalogPath.c_str( ) );
-    std::string catalogLine;
+    // Memory-map catalog and split it into TLEs. The catalog is common to all filter sets.
+    const TleCatalog catalog( inputs[ 0 ].catalogPath );
+    const int tleLines = catalog.getNumberOfLinesPerTle( );
 
-    // Check if catalog is 2-line or 3-line version.
-    std::getline( catalogFile, catalogLine );
-    const int tleLines = getTleCatalogType( catalogLine );
-
-    // Reset file stream to start of file.
-    catalogFile.seekg( 0, std::ios::beg );
-
-    int numberOfPrunedObjects = 0;
-
-    // Loop over file and apply filters to generate pruned catalog.
+    std::vector< boost::xpressive::sregex > line0RegexFilters( inputs.size( ) );
     if ( tleLines == 3 )
     {
         std::cout << "3-line catalog detected ..." << std::endl;
-
-        std::ofstream prunedCatalogFile( input.prunedCatalogPath.c_str( ) );
-
-        while ( std::getline( catalogFile, catalogLine ) )
+        for ( unsigned int k = 0; k < inputs.size( ); k++ )
         {
-            if ( catalogLine.substr( 0, 1 ).compare( "0" ) != 0 )
-            {
-                // TODO: print catalog line in error message.
-                throw std::runtime_error( "ERROR: Catalog malformed!" );
-            }
-            const std::string line0 = catalogLine;
-
-            // Check regex name filter.
-            // If regex can't be match, continue.
-            boost::xpressive::sregex line0RegexFilter
-                = boost::xpressive::sregex::compile( input.nameRegex.c_str( ) );
-            if ( !boost::xpressive::regex_search( line0, line0RegexFilter ) )
-            {
-                std::getline( catalogFile, catalogLine );
-                std::getline( catalogFile, catalogLine );
-                continue;
-            }
-
-            std::getline( catalogFile, catalogLine );
-            if ( catalogLine.substr( 0, 1 ).compare( "1" ) != 0 )
-            {
-                // Print catalog line in error message.
-                throw std::runtime_error( "ERROR: Catalog malformed!" );
-            }
-            removeNewline( catalogLine );
-            const std::string line1 = catalogLine;
-
-            std::getline( catalogFile, catalogLine );
-            if ( catalogLine.substr( 0, 1 ).compare( "2" ) != 0 )
-            {
-                // Print catalog line in error message.
-                throw std::runtime_error( "ERROR: Catalog malformed!" );
-            }
-            removeNewline( catalogLine );
-            const std::string line2 = catalogLine;
-
-            // Create TLE object from catalog lines.
-            const Tle tle( line0, line1, line2 );
-
-            // Apply filters.
-            const OrbitalElements orbitalElements( tle );
-
-            // Apply semi-major axis filter.
-            const double semiMajorAxis = orbitalElements.RecoveredSemiMajorAxis( ) * kXKMPER;
-            if ( ( semiMajorAxis < input.semiMajorAxisMinimum + kXKMPER )
-                 || ( semiMajorAxis > input.semiMajorAxisMaximum + kXKMPER ) )
-            {
-                continue;
-            }
-
-            // Apply eccentricity filter.
-            const double eccentricity = orbitalElements.Eccentricity( );
-            if ( ( eccentricity < input.eccentricityMinimum )
-                 || ( eccentricity > input.eccentricityMaximum ) )
-            {
-                continue;
-            }
-
-            // Apply inclination filter.
-            const double inclination = orbitalElements.Inclination( ) / kPI * 180.0;
-            if ( ( inclination < input.inclinationMinimum )
-                 || ( inclination > input.inclinationMaximum ) )
-            {
-                continue;
-            }
-
-            // Check if the number of objects in the pruned catalog has reached the cutoff set by
-            // the user. If not, increment the counter.
-            if ( input.catalogCutoff != 0 && numberOfPrunedObjects == input.catalogCutoff )
-            {
-                std::cout << "Cutoff reached ..." << std::endl;
-                break;
-            }
-
-            numberOfPrunedObjects++;
-
-            // This point is reached if TLE is not filtered: write catalog lines to pruned catalog.
-            prunedCatalogFile << line0 << std::endl;
-            prunedCatalogFile << line1 << std::endl;
-            prunedCatalogFile << line2 << std::endl;
+            line0RegexFilters[ k ]
+                = boost::xpressive::sregex::compile( inputs[ k ].nameRegex.c_str( ) );
         }
-
-        prunedCatalogFile.close( );
     }
-    else if ( tleLines == 2 )
+    else
     {
         std::cout << "2-line catalog detected ... " << std::endl;
         std::cout << "WARNING: regex name filter will be skipped!" << std::endl;
+    }
 
-        std::ofstream prunedCatalogFile( input.prunedCatalogPath.c_str( ) );
-
-        while ( std::getline( catalogFile, catalogLine ) )
+    // Check that the lines of each TLE start with the line number.
+    for ( unsigned int i = 0; i < catalog.getNumberOfTles( ); i++ )
+    {
+        for ( int j = 0; j < tleLines; j++ )
         {
-            if ( catalogLine.substr( 0, 1 ).compare( "1" ) != 0 )
-            {
-                // Print catalog line in error message.
-                throw std::runtime_error( "ERROR: Catalog malformed!" );
-            }
-            removeNewline( catalogLine );
-            const std::string line1 = catalogLine;
-
-            std::getline( catalogFile, catalogLine );
-            if ( catalogLine.substr( 0, 1 ).compare( "2" ) != 0 )
+            if ( catalog.getRawLine( i, j )[ 0 ] != '0' + j + 3 - tleLines )
             {
-                // Print catalog line in error message.
                 throw std::runtime_error( "ERROR: Catalog malformed!" );
             }
-            removeNewline( catalogLine );
-            const std::string line2 = catalogLine;
-
-            // Create TLE object from catalog lines.
-            const Tle tle( line1, line2 );
+        }
+    }
 
-            // Apply filters.
-            const OrbitalElements orbitalElements( tle );
+    // Compute orbital elements of all objects once and apply range filters of each filter set.
+    const CatalogPrunerElements elements
+        = computeCatalogPrunerElements( catalog.getTleObjects( inputs[ 0 ].threads ) );
+    std::vector< std::vector< unsigned char > > masks( inputs.size( ) );
+    for ( unsigned int k = 0; k < inputs.size( ); k++ )
+    {
+        computeCatalogPrunerMask( inputs[ k ], elements, masks[ k ] );
+    }
 
-            // Apply semi-major axis filter.
-            const double semiMajorAxis = orbitalElements.RecoveredSemiMajorAxis( ) * kXKMPER;
-            if ( ( semiMajorAxis < input.semiMajorAxisMinimum + kXKMPER )
-                 || ( semiMajorAxis > input.semiMajorAxisMaximum + kXKMPER ) )
-            {
-                continue;
-            }
+    // Open pruned catalogs of all filter sets.
+    std::vector< std::unique_ptr< std::ofstream > > prunedCatalogFiles;
+    for ( unsigned int k = 0; k < inputs.size( ); k++ )
+    {
+        prunedCatalogFiles.push_back( std::unique_ptr< std::ofstream >(
+            new std::ofstream( inputs[ k ].prunedCatalogPath.c_str( ) ) ) );
+    }
+    std::vector< int > numberOfPrunedObjects( inputs.size( ), 0 );
+    std::vector< bool > isCutoffReached( inputs.size( ), false );
+    unsigned int numberOfActiveFilterSets = inputs.size( );
+
+    // Apply name regex filters to objects that pass the range filters and write pruned catalogs,
+    // in a single pass over the catalog.
+    for ( unsigned int i = 0;
+          i < elements.semiMajorAxis.size( ) && numberOfActiveFilterSets > 0;
+          i++ )
+    {
+        // The name line is copied to the pruned catalogs as stored in the catalog.
+        std::string line0 = "";
+        bool isLine0Read = false;
 
-            // Apply eccentricity filter.
-            const double eccentricity = orbitalElements.Eccentricity( );
-            if ( ( eccentricity < input.eccentricityMinimum )
-                 || ( eccentricity > input.eccentricityMaximum ) )
+        for ( unsigned int k = 0; k < inputs.size( ); k++ )
+        {
+            if ( isCutoffReached[ k ] || !masks[ k ][ i ] )
             {
                 continue;
             }
 
-            // Apply inclination filter.
-            const double inclination = orbitalElements.Inclination( ) / kPI * 180.0;
-            if ( ( inclination < input.inclinationMinimum )
-                 || ( inclination > input.inclinationMaximum ) )
+            if ( tleLines == 3 )
             {
-                continue;
+                if ( !isLine0Read )
+                {
+                    line0 = catalog.getRawLine( i, 0 );
+                    isLine0Read = true;
+                }
+
+                if ( !boost::xpressive::regex_search( line0, line0RegexFilters[ k ] ) )
+                {
+                    continue;
+                }
             }
 
             // Check if the number of objects in the pruned catalog has reached the cutoff set by
             // the user. If not, increment the counter.
-            if ( input.catalogCutoff != 0 && numberOfPrunedObjects == input.catalogCutoff )
+            if ( inputs[ k ].catalogCutoff != 0
+                 && numberOfPrunedObjects[ k ] == inputs[ k ].catalogCutoff )
             {
-                std::cout << "Cutoff reached ..." << std::endl;
-                break;
+                std::cout << "Cutoff reached for " << inputs[ k ].prunedCatalogPath << " ..."
+                          << std::endl;
+                isCutoffReached[ k ] = true;
+                numberOfActiveFilterSets--;
+                continue;
             }
 
-            numberOfPrunedObjects++;
+            numberOfPrunedObjects[ k ]++;
 
             // This point is reached if TLE is not filtered: write catalog lines to pruned catalog.
-            prunedCatalogFile << line1 << std::endl;
-            prunedCatalogFile << line2 << std::endl;
+            std::ofstream& prunedCatalogFile = *prunedCatalogFiles[ k ];
+            if ( tleLines == 3 )
+            {
+                prunedCatalogFile << line0 << std::endl;
+            }
+            prunedCatalogFile << catalog.getLine( i, tleLines - 2 ) << std::endl;
+            prunedCatalogFile << catalog.getLine( i, tleLines - 1 ) << std::endl;
         }
+    }
 
-        prunedCatalogFile.close( );
+    for ( unsigned int k = 0; k < inputs.size( ); k++ )
+    {
+        prunedCatalogFiles[ k ]->close( );
+        std::cout << "Number of objects in pruned catalog " << inputs[ k ].prunedCatalogPath
+                  << ": " << numberOfPrunedObjects[ k ] << std::endl;
     }
-    else
+}
+
+//! Compute orbital elements for catalog_pruner.
+CatalogPrunerElements computeCatalogPrunerElements( const TleObjects& tleObjects )
+{
+    CatalogPrunerElements elements( tleObjects.size( ) );
+
+    for ( unsigned int i = 0; i < tleObjects.size( ); i++ )
     {
-        throw std::runtime_error( "ERROR: # of lines per TLE must be 2 or 3!" );
+        const OrbitalElements orbitalElements( tleObjects[ i ] );
+        elements.semiMajorAxis[ i ] = orbitalElements.RecoveredSemiMajorAxis( ) * kXKMPER;
+        elements.eccentricity[ i ]  = orbitalElements.Eccentricity( );
+        elements.inclination[ i ]   = orbitalElements.Inclination( ) / kPI * 180.0;
     }
 
-    std::cout << "Number of objects in pruned catalog: " << numberOfPrunedObjects << std::endl;
+    return elements;
+}
 
-    catalogFile.close( );
+//! Compute catalog_pruner filter mask.
+void computeCatalogPrunerMask( const CatalogPrunerInput& input,
+                               const CatalogPrunerElements& elements,
+                               std::vector< unsigned char >& mask )
+{
+    // The semi-major axis filter is specified as altitude.
+    const double semiMajorAxisMinimum = input.semiMajorAxisMinimum + kXKMPER;
+    const double semiMajorAxisMaximum = input.semiMajorAxisMaximum + kXKMPER;
+    const double eccentricityMinimum = input.eccentricityMinimum;
+    const double eccentricityMaximum = input.eccentricityMaximum;
+    const double inclinationMinimum = input.inclinationMinimum;
+    const double inclinationMaximum = input.inclinationMaximum;
+
+    const unsigned int numberOfObjects = elements.semiMajorAxis.size( );
+    mask.resize( numberOfObjects );
+
+    const double* semiMajorAxis = elements.semiMajorAxis.data( );
+    const double* eccentricity = elements.eccentricity.data( );
+    const double* inclination = elements.inclination.data( );
+    unsigned char* isSelected = mask.data( );
+
+    // Filters are combined with bitwise operators, such that the loop contains no branches.
+    for ( unsigned int i = 0; i < numberOfObjects; i++ )
+    {
+        isSelected[ i ] = static_cast< unsigned char >(
+            !( semiMajorAxis[ i ] < semiMajorAxisMinimum )
+            & !( semiMajorAxis[ i ] > semiMajorAxisMaximum )
+            & !( eccentricity[ i ] < eccentricityMinimum )
+            & !( eccentricity[ i ] > eccentricityMaximum )
+            & !( inclination[ i ] < inclinationMinimum )
+            & !( inclination[ i ] > inclinationMaximum ) );
+    }
 }
 
 //! Check catalog_pruner input parameters.
@@ -228,6 +209,19 @@ CatalogPrunerInput checkCatalogPrunerInput( const rapidjson::Document& config )
     const std::string catalogPath = find( config, "catalog" )->value.GetString( );
     std::cout << "Catalog                       " << catalogPath << std::endl;
 
+    // By default, the TLE objects are constructed from the catalog using all hardware threads.
+    int threads = static_cast< int >( std::max( 1u, std::thread::hardware_concurrency( ) ) );
+    if ( config.HasMember( "threads" ) )
+    {
+        threads = find( config, "threads" )->value.GetInt( );
+    }
+    std::cout << "# of threads                  " << threads << std::endl;
+
+    if ( threads < 1 )
+    {
+        throw std::runtime_error( "ERROR: Number of threads must be at least 1!" );
+    }
+
     const double semiMajorAxisMinimum
         = find( config, "semi_major_axis_filter" )->value[ 0 ].GetDouble( );
     std::cout << "Minimum semi-major axis [km]  " << semiMajorAxisMinimum << std::endl;
@@ -295,7 +289,80 @@ CatalogPrunerInput checkCatalogPrunerInput( const rapidjson::Document& config )
                                inclinationMaximum,
                                nameRegex,
                                catalogCutoff,
-                               prunedCatalogPath );
+                               prunedCatalogPath,
+                               threads );
+}
+
+//! Get catalog_pruner filter set configuration.
+void getCatalogPrunerFilterSetConfig( const rapidjson::Document& config,
+                                      const rapidjson::Value& filterSet,
+                                      rapidjson::Document& filterSetConfig )
+{
+    if ( !filterSet.IsObject( ) )
+    {
+        throw std::runtime_error( "ERROR: Each catalog_pruner filter set must be an object!" );
+    }
+
+    if ( filterSet.HasMember( "mode" )
+         || filterSet.HasMember( "catalog" )
+         || filterSet.HasMember( "threads" ) )
+    {
+        throw std::runtime_error( "ERROR: Mode, catalog and threads cannot be overridden by "
+                                  "catalog_pruner filter set!" );
+    }
+
+    overrideConfig( config, filterSet, filterSetConfig );
+    filterSetConfig.RemoveMember( "filter_sets" );
+}
+
+//! Check catalog_pruner filter sets.
+std::vector< CatalogPrunerInput > checkCatalogPrunerFilterSets( const rapidjson::Document& config )
+{
+    std::vector< CatalogPrunerInput > inputs;
+
+    // Without filter sets, the config contains a single set of filters.
+    if ( !config.HasMember( "filter_sets" ) )
+    {
+        inputs.push_back( checkCatalogPrunerInput( config ) );
+        return inputs;
+    }
+
+    const rapidjson::Value& filterSets = find( config, "filter_sets" )->value;
+    if ( !filterSets.IsArray( ) || filterSets.Size( ) == 0 )
+    {
+        throw std::runtime_error(
+            "ERROR: At least one catalog_pruner filter set must be specified!" );
+    }
+    std::cout << "# of filter sets              " << filterSets.Size( ) << std::endl;
+
+    for ( unsigned int i = 0; i < filterSets.Size( ); i++ )
+    {
+        if ( !filterSets[ i ].IsObject( ) || !filterSets[ i ].HasMember( "catalog_pruned" ) )
+        {
+            std::ostringstream error;
+            error << "ERROR: Pruned catalog must be specified for catalog_pruner filter set "
+                  << i + 1 << "!";
+            throw std::runtime_error( error.str( ) );
+        }
+
+        std::cout << std::endl;
+        std::cout << "Filter set                    " << i + 1 << std::endl;
+
+        rapidjson::Document filterSetConfig;
+        getCatalogPrunerFilterSetConfig( config, filterSets[ i ], filterSetConfig );
+        inputs.push_back( checkCatalogPrunerInput( filterSetConfig ) );
+
+        for ( unsigned int j = 0; j < i; j++ )
+        {
+            if ( inputs[ j ].prunedCatalogPath == inputs[ i ].prunedCatalogPath )
+            {
+                throw std::runtime_error(
+                    "ERROR: Each catalog_pruner filter set must write to its own pruned catalog!" );
+            }
+        }
+    }
+
+    return inputs;
 }
 
 } // namespace d2d
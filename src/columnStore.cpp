@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <rapidjson/document.h>
+
+#include "D2D/columnStore.hpp"
+
+namespace d2d
+{
+
+//! Number of rows buffered before they are appended to the column files.
+static const std::size_t columnStoreBufferRows = 4096;
+
+//! Construct writer for column store.
+ColumnStoreWriter::ColumnStoreWriter( const std::string& aDirectory,
+                                      const std::vector< std::string >& someColumnNames )
+    : directory( aDirectory ),
+      columnNames( someColumnNames ),
+      columnFiles( someColumnNames.size( ), NULL ),
+      columnBuffers( someColumnNames.size( ) ),
+      numberOfRows( 0 )
+{
+    if ( mkdir( directory.c_str( ), 0755 ) != 0 && errno != EEXIST )
+    {
+        throw std::runtime_error( "ERROR: Creating column store directory " + directory
+                                  + " failed!" );
+    }
+
+    // Remove header of previous column store, such that it is not read if writing fails.
+    std::remove( ( directory + "/header.json" ).c_str( ) );
+
+    for ( unsigned int i = 0; i < columnNames.size( ); i++ )
+    {
+        const std::string columnPath = directory + "/" + columnNames[ i ] + ".f64";
+        columnFiles[ i ] = std::fopen( columnPath.c_str( ), "wb" );
+        if ( columnFiles[ i ] == NULL )
+        {
+            for ( unsigned int j = 0; j < i; j++ )
+            {
+                std::fclose( columnFiles[ j ] );
+            }
+            throw std::runtime_error( "ERROR: Creating column file " + columnPath + " failed!" );
+        }
+
+        columnBuffers[ i ].reserve( columnStoreBufferRows );
+    }
+}
+
+//! Destruct writer for column store.
+ColumnStoreWriter::~ColumnStoreWriter( )
+{
+    for ( unsigned int i = 0; i < columnFiles.size( ); i++ )
+    {
+        if ( columnFiles[ i ] != NULL )
+        {
+            std::fclose( columnFiles[ i ] );
+        }
+    }
+}
+
+//! Append row to column store.
+void ColumnStoreWriter::appendRow( const std::vector< double >& row )
+{
+    if ( row.size( ) != columnNames.size( ) )
+    {
+        throw std::runtime_error( "ERROR: Row size does not match number of columns in store!" );
+    }
+
+    for ( unsigned int i = 0; i < row.size( ); i++ )
+    {
+        columnBuffers[ i ].push_back( row[ i ] );
+    }
+    ++numberOfRows;
+
+    if ( columnBuffers.empty( ) || columnBuffers[ 0 ].size( ) >= columnStoreBufferRows )
+    {
+        flush( );
+    }
+}
+
+//! Close column store.
+void ColumnStoreWriter::close( const std::map< std::string, double >& metadata )
+{
+    flush( );
+
+    for ( unsigned int i = 0; i < columnFiles.size( ); i++ )
+    {
+        const int status = std::fclose( columnFiles[ i ] );
+        columnFiles[ i ] = NULL;
+        if ( status != 0 )
+        {
+            throw std::runtime_error( "ERROR: Closing column file for " + columnNames[ i ]
+                                      + " failed!" );
+        }
+    }
+
+    // Write header.
+    std::ofstream headerFile( ( directory + "/header.json" ).c_str( ) );
+    headerFile << std::setprecision( std::numeric_limits< double >::digits10 + 2 );
+    headerFile << "{" << std::endl;
+    headerFile << "    \"rows\" : " << numberOfRows << "," << std::endl;
+    headerFile << "    \"columns\" : [";
+    for ( unsigned int i = 0; i < columnNames.size( ); i++ )
+    {
+        headerFile << ( i == 0 ? "" : ", " ) << "\"" << columnNames[ i ] << "\"";
+    }
+    headerFile << "]," << std::endl;
+    headerFile << "    \"metadata\" : {";
+    for ( std::map< std::string, double >::const_iterator iterator = metadata.begin( );
+          iterator != metadata.end( );
+          iterator++ )
+    {
+        headerFile << ( iterator == metadata.begin( ) ? "" : "," ) << std::endl
+                   << "        \"" << iterator->first << "\" : " << iterator->second;
+    }
+    headerFile << std::endl << "    }" << std::endl;
+    headerFile << "}" << std::endl;
+    headerFile.close( );
+
+    if ( !headerFile )
+    {
+        throw std::runtime_error( "ERROR: Writing column store header failed!" );
+    }
+}
+
+//! Flush buffered rows to column files.
+void ColumnStoreWriter::flush( )
+{
+    for ( unsigned int i = 0; i < columnBuffers.size( ); i++ )
+    {
+        if ( std::fwrite( columnBuffers[ i ].data( ),
+                          sizeof( double ),
+                          columnBuffers[ i ].size( ),
+                          columnFiles[ i ] ) != columnBuffers[ i ].size( ) )
+        {
+            throw std::runtime_error( "ERROR: Writing column file for " + columnNames[ i ]
+                                      + " failed!" );
+        }
+        columnBuffers[ i ].clear( );
+    }
+}
+
+//! Construct reader for column store.
+ColumnStore::ColumnStore( const std::string& aDirectory )
+    : directory( aDirectory ),
+      numberOfRows( 0 )
+{
+    // Parse header.
+    std::ifstream headerFile( ( directory + "/header.json" ).c_str( ) );
+    if ( !headerFile )
+    {
+        throw std::runtime_error( "ERROR: Column store header in " + directory
+                                  + " not found!" );
+    }
+    std::stringstream headerBuffer;
+    headerBuffer << headerFile.rdbuf( );
+
+    rapidjson::Document header;
+    header.Parse( headerBuffer.str( ).c_str( ) );
+    if ( header.HasParseError( )
+         || !header.HasMember( "rows" )
+         || !header.HasMember( "columns" )
+         || !header.HasMember( "metadata" ) )
+    {
+        throw std::runtime_error( "ERROR: Column store header in " + directory + " is invalid!" );
+    }
+
+    numberOfRows = header[ "rows" ].GetInt64( );
+
+    const rapidjson::Value& metadataValues = header[ "metadata" ];
+    for ( rapidjson::Value::ConstMemberIterator iterator = metadataValues.MemberBegin( );
+          iterator != metadataValues.MemberEnd( );
+          iterator++ )
+    {
+        metadata[ iterator->name.GetString( ) ] = iterator->value.GetDouble( );
+    }
+
+    // Memory-map column files.
+    const std::size_t columnSize = static_cast< std::size_t >( numberOfRows ) * sizeof( double );
+    const rapidjson::Value& columnNames = header[ "columns" ];
+    for ( unsigned int i = 0; i < columnNames.Size( ); i++ )
+    {
+        const std::string columnName = columnNames[ i ].GetString( );
+        const std::string columnPath = directory + "/" + columnName + ".f64";
+
+        const int fileDescriptor = open( columnPath.c_str( ), O_RDONLY );
+        struct stat fileStatus;
+        if ( fileDescriptor < 0 || fstat( fileDescriptor, &fileStatus ) != 0
+             || static_cast< std::size_t >( fileStatus.st_size ) != columnSize )
+        {
+            if ( fileDescriptor >= 0 )
+            {
+                ::close( fileDescriptor );
+            }
+            unmap( );
+            throw std::runtime_error( "ERROR: Column file " + columnPath
+                                      + " is missing or does not match header!" );
+        }
+
+        // Empty files cannot be mapped.
+        if ( columnSize == 0 )
+        {
+            ::close( fileDescriptor );
+            columns[ columnName ] = NULL;
+            continue;
+        }
+
+        void* mapping = mmap( NULL, columnSize, PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+        ::close( fileDescriptor );
+        if ( mapping == MAP_FAILED )
+        {
+            unmap( );
+            throw std::runtime_error( "ERROR: Memory-mapping column file " + columnPath
+                                      + " failed!" );
+        }
+
+        // Columns are typically scanned front to back.
+        madvise( mapping, columnSize, MADV_SEQUENTIAL );
+
+        mappings.push_back( std::make_pair( mapping, columnSize ) );
+        columns[ columnName ] = static_cast< const double* >( mapping );
+    }
+}
+
+//! Destruct reader for column store.
+ColumnStore::~ColumnStore( )
+{
+    unmap( );
+}
+
+//! Unmap column files.
+void ColumnStore::unmap( )
+{
+    for ( unsigned int i = 0; i < mappings.size( ); i++ )
+    {
+        munmap( mappings[ i ].first, mappings[ i ].second );
+    }
+    mappings.clear( );
+}
+
+//! Check if column exists in column store.
+bool ColumnStore::hasColumn( const std::string& columnName ) const
+{
+    return columns.find( columnName ) != columns.end( );
+}
+
+//! Get column from column store.
+const double* ColumnStore::getColumn( const std::string& columnName ) const
+{
+    const std::map< std::string, const double* >::const_iterator iterator
+        = columns.find( columnName );
+    if ( iterator == columns.end( ) )
+    {
+        throw std::runtime_error( "ERROR: Column " + columnName + " not found in column store "
+                                  + directory + "!" );
+    }
+
+    return iterator->second;
+}
+
+//! Get metadata from column store.
+double ColumnStore::getMetadata( const std::string& name ) const
+{
+    const std::map< std::string, double >::const_iterator iterator = metadata.find( name );
+    if ( iterator == metadata.end( ) )
+    {
+        throw std::runtime_error( "ERROR: Metadata " + name + " not found in column store "
+                                  + directory + "!" );
+    }
+
+    return iterator->second;
+}
+
+} // namespace d2d
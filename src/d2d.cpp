@@ -20,7 +20,9 @@
 #include "D2D/catalogPruner.hpp"
 #include "D2D/j2Analysis.hpp"
 #include "D2D/lambertFetch.hpp"
+#include "D2D/lambertMerge.hpp"
 #include "D2D/lambertScanner.hpp"
+#include "D2D/lambertSweep.hpp"
 #include "D2D/lambertTransfer.hpp"
 #include "D2D/sgp4Scanner.hpp"
 
@@ -110,6 +112,16 @@ int main( const int numberOfInputs, const char* inputArguments[ ] )
         std::cout << "Mode                          " << mode << std::endl;
         d2d::executeLambertScanner( config );
     }
+    else if ( mode.compare( "lambert_merge" ) == 0 )
+    {
+        std::cout << "Mode                          " << mode << std::endl;
+        d2d::executeLambertMerge( config );
+    }
+    else if ( mode.compare( "lambert_sweep" ) == 0 )
+    {
+        std::cout << "Mode                          " << mode << std::endl;
+        d2d::executeLambertSweep( config );
+    }
     else if ( mode.compare( "lambert_fetch" ) == 0 )
     {
         std::cout << "Mode:                         " << mode << std::endl;
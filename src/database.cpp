@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "D2D/database.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+
+//! Check bulk-load settings for SQLite database.
+DatabaseSettings checkDatabaseSettings( const rapidjson::Document& config )
+{
+    std::string journalMode = "";
+    std::string synchronous = "";
+    int pageSize = 0;
+    int cacheSize = 0;
+    long long mmapSize = 0;
+
+    if ( !config.HasMember( "bulk_load" ) )
+    {
+        return DatabaseSettings( journalMode, synchronous, pageSize, cacheSize, mmapSize );
+    }
+
+    const rapidjson::Value& bulkLoad = find( config, "bulk_load" )->value;
+
+    if ( bulkLoad.HasMember( "journal_mode" ) )
+    {
+        journalMode = bulkLoad[ "journal_mode" ].GetString( );
+        std::transform( journalMode.begin( ), journalMode.end( ), journalMode.begin( ), ::toupper );
+        std::cout << "Journal mode                  " << journalMode << std::endl;
+
+        if ( journalMode != "DELETE" && journalMode != "TRUNCATE" && journalMode != "PERSIST"
+             && journalMode != "MEMORY" && journalMode != "WAL" && journalMode != "OFF" )
+        {
+            throw std::runtime_error( "ERROR: Journal mode is invalid!" );
+        }
+    }
+
+    if ( bulkLoad.HasMember( "synchronous" ) )
+    {
+        synchronous = bulkLoad[ "synchronous" ].GetString( );
+        std::transform( synchronous.begin( ), synchronous.end( ), synchronous.begin( ), ::toupper );
+        std::cout << "Synchronous                   " << synchronous << std::endl;
+
+        if ( synchronous != "OFF" && synchronous != "NORMAL" && synchronous != "FULL"
+             && synchronous != "EXTRA" )
+        {
+            throw std::runtime_error( "ERROR: Synchronous flag is invalid!" );
+        }
+    }
+
+    if ( bulkLoad.HasMember( "page_size" ) )
+    {
+        if ( !bulkLoad[ "page_size" ].IsInt( ) )
+        {
+            throw std::runtime_error( "ERROR: Page size must be an integer!" );
+        }
+
+        pageSize = bulkLoad[ "page_size" ].GetInt( );
+        std::cout << "Page size                     " << pageSize << " B" << std::endl;
+
+        // SQLite page size must be a power of two between 512 and 65536 bytes.
+        if ( pageSize < 512 || pageSize > 65536 || ( pageSize & ( pageSize - 1 ) ) != 0 )
+        {
+            throw std::runtime_error(
+                "ERROR: Page size must be a power of two between 512 and 65536!" );
+        }
+    }
+
+    if ( bulkLoad.HasMember( "cache_size" ) )
+    {
+        if ( !bulkLoad[ "cache_size" ].IsInt( ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Cache size must be an integer (pages if positive, KiB if negative)!" );
+        }
+
+        cacheSize = bulkLoad[ "cache_size" ].GetInt( );
+        std::cout << "Cache size                    " << cacheSize << std::endl;
+    }
+
+    if ( bulkLoad.HasMember( "mmap_size" ) )
+    {
+        if ( !bulkLoad[ "mmap_size" ].IsInt64( ) )
+        {
+            throw std::runtime_error( "ERROR: Memory-mapped I/O size must be an integer!" );
+        }
+
+        mmapSize = bulkLoad[ "mmap_size" ].GetInt64( );
+        std::cout << "Memory-mapped I/O size        " << mmapSize << " B" << std::endl;
+
+        if ( mmapSize < 0 )
+        {
+            throw std::runtime_error( "ERROR: Memory-mapped I/O size must be non-negative!" );
+        }
+    }
+
+    return DatabaseSettings( journalMode, synchronous, pageSize, cacheSize, mmapSize );
+}
+
+//! Apply bulk-load settings to SQLite database.
+void applyDatabaseSettings( SQLite::Database& database, const DatabaseSettings& settings )
+{
+    // Page size has to be set before journal mode, since it cannot be changed in WAL mode.
+    if ( settings.pageSize > 0 )
+    {
+        std::ostringstream pragma;
+        pragma << "PRAGMA page_size = " << settings.pageSize << ";";
+        database.exec( pragma.str( ).c_str( ) );
+    }
+
+    if ( !settings.journalMode.empty( ) )
+    {
+        std::ostringstream pragma;
+        pragma << "PRAGMA journal_mode = " << settings.journalMode << ";";
+        database.exec( pragma.str( ).c_str( ) );
+    }
+
+    if ( !settings.synchronous.empty( ) )
+    {
+        std::ostringstream pragma;
+        pragma << "PRAGMA synchronous = " << settings.synchronous << ";";
+        database.exec( pragma.str( ).c_str( ) );
+    }
+
+    if ( settings.cacheSize != 0 )
+    {
+        std::ostringstream pragma;
+        pragma << "PRAGMA cache_size = " << settings.cacheSize << ";";
+        database.exec( pragma.str( ).c_str( ) );
+    }
+
+    if ( settings.mmapSize > 0 )
+    {
+        std::ostringstream pragma;
+        pragma << "PRAGMA mmap_size = " << settings.mmapSize << ";";
+        database.exec( pragma.str( ).c_str( ) );
+    }
+}
+
+} // namespace d2d
@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <libsgp4/Eci.h>
+#include <libsgp4/SGP4.h>
+
+#include <Astro/astro.hpp>
+
+#include "D2D/ephemeris.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+
+//! Identifier at start of ephemeris cache files, including format version.
+static const char ephemerisCacheMagic[ 8 ] = { 'D', '2', 'D', 'E', 'P', 'H', '0', '1' };
+
+//! Construct ephemeris table.
+EphemerisTable::EphemerisTable( const TleObjects& tleObjects,
+                                const std::vector< DateTime >& someEpochs,
+                                const double aGravitationalParameter,
+                                const int numberOfThreads )
+    : epochs( someEpochs ),
+      gravitationalParameter( aGravitationalParameter ),
+      numberOfObjects( tleObjects.size( ) ),
+      positionX( tleObjects.size( ) * someEpochs.size( ) ),
+      positionY( tleObjects.size( ) * someEpochs.size( ) ),
+      positionZ( tleObjects.size( ) * someEpochs.size( ) ),
+      velocityX( tleObjects.size( ) * someEpochs.size( ) ),
+      velocityY( tleObjects.size( ) * someEpochs.size( ) ),
+      velocityZ( tleObjects.size( ) * someEpochs.size( ) ),
+      semiMajorAxis( tleObjects.size( ) * someEpochs.size( ) ),
+      eccentricity( tleObjects.size( ) * someEpochs.size( ) ),
+      inclination( tleObjects.size( ) * someEpochs.size( ) ),
+      argumentOfPeriapsis( tleObjects.size( ) * someEpochs.size( ) ),
+      longitudeOfAscendingNode( tleObjects.size( ) * someEpochs.size( ) ),
+      trueAnomaly( tleObjects.size( ) * someEpochs.size( ) )
+{
+    const unsigned int threads = numberOfThreads > 1 ? numberOfThreads : 1;
+    std::vector< std::exception_ptr > errors( threads );
+
+    // Objects are interleaved across threads; each thread writes to disjoint table entries.
+    std::vector< std::thread > workers;
+    for ( unsigned int i = 1; i < threads; i++ )
+    {
+        workers.push_back( std::thread( &EphemerisTable::propagateObjects,
+                                        this,
+                                        std::cref( tleObjects ),
+                                        i,
+                                        threads,
+                                        std::ref( errors[ i ] ) ) );
+    }
+    propagateObjects( tleObjects, 0, threads, errors[ 0 ] );
+
+    for ( unsigned int i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+
+    for ( unsigned int i = 0; i < errors.size( ); i++ )
+    {
+        if ( errors[ i ] )
+        {
+            std::rethrow_exception( errors[ i ] );
+        }
+    }
+}
+
+//! Construct ephemeris table from cache.
+EphemerisTable::EphemerisTable( const std::string& cachePath,
+                                const unsigned long long catalogHash,
+                                const unsigned int aNumberOfObjects,
+                                const std::vector< DateTime >& someEpochs,
+                                const double aGravitationalParameter )
+    : epochs( someEpochs ),
+      gravitationalParameter( aGravitationalParameter ),
+      numberOfObjects( aNumberOfObjects ),
+      positionX( aNumberOfObjects * someEpochs.size( ) ),
+      positionY( aNumberOfObjects * someEpochs.size( ) ),
+      positionZ( aNumberOfObjects * someEpochs.size( ) ),
+      velocityX( aNumberOfObjects * someEpochs.size( ) ),
+      velocityY( aNumberOfObjects * someEpochs.size( ) ),
+      velocityZ( aNumberOfObjects * someEpochs.size( ) ),
+      semiMajorAxis( aNumberOfObjects * someEpochs.size( ) ),
+      eccentricity( aNumberOfObjects * someEpochs.size( ) ),
+      inclination( aNumberOfObjects * someEpochs.size( ) ),
+      argumentOfPeriapsis( aNumberOfObjects * someEpochs.size( ) ),
+      longitudeOfAscendingNode( aNumberOfObjects * someEpochs.size( ) ),
+      trueAnomaly( aNumberOfObjects * someEpochs.size( ) )
+{
+    std::ifstream cacheFile( cachePath.c_str( ), std::ios::binary );
+
+    // Check header.
+    char magic[ 8 ];
+    unsigned long long cacheCatalogHash = 0;
+    unsigned int cacheNumberOfObjects = 0;
+    unsigned int cacheNumberOfEpochs = 0;
+    double cacheGravitationalParameter = 0.0;
+    cacheFile.read( magic, sizeof( magic ) );
+    cacheFile.read( reinterpret_cast< char* >( &cacheCatalogHash ), sizeof( cacheCatalogHash ) );
+    cacheFile.read( reinterpret_cast< char* >( &cacheNumberOfObjects ),
+                    sizeof( cacheNumberOfObjects ) );
+    cacheFile.read( reinterpret_cast< char* >( &cacheNumberOfEpochs ),
+                    sizeof( cacheNumberOfEpochs ) );
+    cacheFile.read( reinterpret_cast< char* >( &cacheGravitationalParameter ),
+                    sizeof( cacheGravitationalParameter ) );
+
+    bool isValid = cacheFile
+                   && std::memcmp( magic, ephemerisCacheMagic, sizeof( magic ) ) == 0
+                   && cacheCatalogHash == catalogHash
+                   && cacheNumberOfObjects == numberOfObjects
+                   && cacheNumberOfEpochs == epochs.size( )
+                   && cacheGravitationalParameter == gravitationalParameter;
+
+    for ( unsigned int i = 0; isValid && i < epochs.size( ); i++ )
+    {
+        long long ticks = 0;
+        cacheFile.read( reinterpret_cast< char* >( &ticks ), sizeof( ticks ) );
+        isValid = cacheFile && ticks == epochs[ i ].Ticks( );
+    }
+
+    // Read state arrays.
+    const std::vector< std::vector< double >* > stateArrays = getStateArrays( );
+    for ( unsigned int i = 0; isValid && i < stateArrays.size( ); i++ )
+    {
+        cacheFile.read( reinterpret_cast< char* >( stateArrays[ i ]->data( ) ),
+                        stateArrays[ i ]->size( ) * sizeof( double ) );
+        isValid = static_cast< bool >( cacheFile );
+    }
+
+    if ( !isValid || cacheFile.peek( ) != std::ifstream::traits_type::eof( ) )
+    {
+        throw std::runtime_error( "ERROR: Ephemeris cache " + cachePath
+                                  + " does not match catalog and epochs!" );
+    }
+}
+
+//! Write cache file.
+void EphemerisTable::writeCache( const std::string& cachePath,
+                                 const unsigned long long catalogHash ) const
+{
+    // Write to temporary file first, such that an incomplete cache file is never read. The name
+    // of the temporary file is unique, such that processes sharing a cache directory do not write
+    // to the same file.
+    std::vector< char > temporaryPathBuffer( cachePath.begin( ), cachePath.end( ) );
+    const std::string temporaryPathSuffix = ".XXXXXX";
+    temporaryPathBuffer.insert(
+        temporaryPathBuffer.end( ), temporaryPathSuffix.begin( ), temporaryPathSuffix.end( ) );
+    temporaryPathBuffer.push_back( '\0' );
+    const int fileDescriptor = mkstemp( temporaryPathBuffer.data( ) );
+    if ( fileDescriptor < 0 )
+    {
+        throw std::runtime_error( "ERROR: Writing ephemeris cache " + cachePath + " failed!" );
+    }
+
+    // Temporary files are created readable by owner only; cache files are readable by all, such
+    // that the cache is not published if its permissions cannot be set.
+    const std::string temporaryPath( temporaryPathBuffer.data( ) );
+    const bool isChmodFailed = fchmod( fileDescriptor, 0644 ) != 0;
+    const bool isCloseFailed = ::close( fileDescriptor ) != 0;
+    if ( isChmodFailed || isCloseFailed )
+    {
+        std::remove( temporaryPath.c_str( ) );
+        throw std::runtime_error( "ERROR: Writing ephemeris cache " + cachePath + " failed!" );
+    }
+
+    std::ofstream cacheFile( temporaryPath.c_str( ), std::ios::binary );
+
+    const unsigned int numberOfEpochs = epochs.size( );
+    cacheFile.write( ephemerisCacheMagic, sizeof( ephemerisCacheMagic ) );
+    cacheFile.write( reinterpret_cast< const char* >( &catalogHash ), sizeof( catalogHash ) );
+    cacheFile.write( reinterpret_cast< const char* >( &numberOfObjects ),
+                     sizeof( numberOfObjects ) );
+    cacheFile.write( reinterpret_cast< const char* >( &numberOfEpochs ),
+                     sizeof( numberOfEpochs ) );
+    cacheFile.write( reinterpret_cast< const char* >( &gravitationalParameter ),
+                     sizeof( gravitationalParameter ) );
+
+    for ( unsigned int i = 0; i < epochs.size( ); i++ )
+    {
+        const long long ticks = epochs[ i ].Ticks( );
+        cacheFile.write( reinterpret_cast< const char* >( &ticks ), sizeof( ticks ) );
+    }
+
+    const std::vector< const std::vector< double >* > stateArrays = getStateArrays( );
+    for ( unsigned int i = 0; i < stateArrays.size( ); i++ )
+    {
+        cacheFile.write( reinterpret_cast< const char* >( stateArrays[ i ]->data( ) ),
+                         stateArrays[ i ]->size( ) * sizeof( double ) );
+    }
+
+    cacheFile.close( );
+
+    if ( !cacheFile || std::rename( temporaryPath.c_str( ), cachePath.c_str( ) ) != 0 )
+    {
+        std::remove( temporaryPath.c_str( ) );
+        throw std::runtime_error( "ERROR: Writing ephemeris cache " + cachePath + " failed!" );
+    }
+}
+
+//! Get state arrays.
+std::vector< std::vector< double >* > EphemerisTable::getStateArrays( )
+{
+    std::vector< std::vector< double >* > stateArrays;
+    stateArrays.push_back( &positionX );
+    stateArrays.push_back( &positionY );
+    stateArrays.push_back( &positionZ );
+    stateArrays.push_back( &velocityX );
+    stateArrays.push_back( &velocityY );
+    stateArrays.push_back( &velocityZ );
+    stateArrays.push_back( &semiMajorAxis );
+    stateArrays.push_back( &eccentricity );
+    stateArrays.push_back( &inclination );
+    stateArrays.push_back( &argumentOfPeriapsis );
+    stateArrays.push_back( &longitudeOfAscendingNode );
+    stateArrays.push_back( &trueAnomaly );
+    return stateArrays;
+}
+
+//! Get state arrays.
+std::vector< const std::vector< double >* > EphemerisTable::getStateArrays( ) const
+{
+    std::vector< const std::vector< double >* > stateArrays;
+    stateArrays.push_back( &positionX );
+    stateArrays.push_back( &positionY );
+    stateArrays.push_back( &positionZ );
+    stateArrays.push_back( &velocityX );
+    stateArrays.push_back( &velocityY );
+    stateArrays.push_back( &velocityZ );
+    stateArrays.push_back( &semiMajorAxis );
+    stateArrays.push_back( &eccentricity );
+    stateArrays.push_back( &inclination );
+    stateArrays.push_back( &argumentOfPeriapsis );
+    stateArrays.push_back( &longitudeOfAscendingNode );
+    stateArrays.push_back( &trueAnomaly );
+    return stateArrays;
+}
+
+//! Propagate objects.
+void EphemerisTable::propagateObjects( const TleObjects& tleObjects,
+                                       const unsigned int firstObject,
+                                       const unsigned int stride,
+                                       std::exception_ptr& error )
+{
+    try
+    {
+        for ( unsigned int i = firstObject; i < numberOfObjects; i += stride )
+        {
+            const SGP4 sgp4( tleObjects[ i ] );
+
+            for ( unsigned int j = 0; j < epochs.size( ); j++ )
+            {
+                const Vector6 state = getStateVector( sgp4.FindPosition( epochs[ j ] ) );
+                const std::size_t index = static_cast< std::size_t >( i ) * epochs.size( ) + j;
+                positionX[ index ] = state[ 0 ];
+                positionY[ index ] = state[ 1 ];
+                positionZ[ index ] = state[ 2 ];
+                velocityX[ index ] = state[ 3 ];
+                velocityY[ index ] = state[ 4 ];
+                velocityZ[ index ] = state[ 5 ];
+
+                const Vector6 stateKepler
+                    = astro::convertCartesianToKeplerianElements( state, gravitationalParameter );
+                semiMajorAxis[ index ]            = stateKepler[ 0 ];
+                eccentricity[ index ]             = stateKepler[ 1 ];
+                inclination[ index ]              = stateKepler[ 2 ];
+                argumentOfPeriapsis[ index ]      = stateKepler[ 3 ];
+                longitudeOfAscendingNode[ index ] = stateKepler[ 4 ];
+                trueAnomaly[ index ]              = stateKepler[ 5 ];
+            }
+        }
+    }
+    catch( ... )
+    {
+        error = std::current_exception( );
+    }
+}
+
+//! Get path to ephemeris cache file.
+std::string getEphemerisCachePath( const std::string& cacheDirectory,
+                                   const unsigned long long catalogHash,
+                                   const std::vector< DateTime >& epochs,
+                                   const double gravitationalParameter )
+{
+    unsigned long long hash = computeHashFnv1a( &catalogHash, sizeof( catalogHash ) );
+    for ( unsigned int i = 0; i < epochs.size( ); i++ )
+    {
+        const long long ticks = epochs[ i ].Ticks( );
+        hash = computeHashFnv1a( &ticks, sizeof( ticks ), hash );
+    }
+    hash = computeHashFnv1a( &gravitationalParameter, sizeof( gravitationalParameter ), hash );
+
+    std::ostringstream cachePath;
+    cachePath << cacheDirectory << "/" << std::hex << std::setw( 16 ) << std::setfill( '0' )
+              << hash << ".eph";
+    return cachePath.str( );
+}
+
+//! Compute ephemeris table.
+std::unique_ptr< const EphemerisTable > computeEphemerisTable(
+    const TleObjects& tleObjects,
+    const unsigned long long catalogHash,
+    const std::vector< DateTime >& epochs,
+    const double gravitationalParameter,
+    const int numberOfThreads,
+    const std::string& cacheDirectory )
+{
+    std::unique_ptr< const EphemerisTable > ephemerides;
+
+    if ( cacheDirectory.empty( ) )
+    {
+        ephemerides.reset( new EphemerisTable(
+            tleObjects, epochs, gravitationalParameter, numberOfThreads ) );
+        return ephemerides;
+    }
+
+    const std::string cachePath
+        = getEphemerisCachePath( cacheDirectory, catalogHash, epochs, gravitationalParameter );
+
+    std::ifstream cacheFile( cachePath.c_str( ), std::ios::binary );
+    if ( cacheFile )
+    {
+        cacheFile.close( );
+        try
+        {
+            ephemerides.reset( new EphemerisTable(
+                cachePath, catalogHash, tleObjects.size( ), epochs, gravitationalParameter ) );
+            std::cout << "Ephemerides read from cache   " << cachePath << std::endl;
+            return ephemerides;
+        }
+        catch( const std::runtime_error& )
+        {
+            std::cout << "WARNING: Ephemeris cache " << cachePath
+                      << " is invalid and will be overwritten!" << std::endl;
+        }
+    }
+
+    ephemerides.reset( new EphemerisTable(
+        tleObjects, epochs, gravitationalParameter, numberOfThreads ) );
+
+    // The cache is an optimization: if it cannot be written, the scan continues with the table
+    // computed in memory.
+    try
+    {
+        if ( mkdir( cacheDirectory.c_str( ), 0755 ) != 0 && errno != EEXIST )
+        {
+            throw std::runtime_error( "ERROR: Creating ephemeris cache directory "
+                                      + cacheDirectory + " failed!" );
+        }
+        ephemerides->writeCache( cachePath, catalogHash );
+        std::cout << "Ephemerides written to cache  " << cachePath << std::endl;
+    }
+    catch( const std::runtime_error& error )
+    {
+        std::cout << "WARNING: " << error.what( ) << std::endl;
+
+        // Use cache file written by another process sharing the cache directory, if it is valid.
+        try
+        {
+            ephemerides.reset( new EphemerisTable(
+                cachePath, catalogHash, tleObjects.size( ), epochs, gravitationalParameter ) );
+            std::cout << "Ephemerides read from cache   " << cachePath << std::endl;
+        }
+        catch( const std::runtime_error& )
+        {
+            std::cout << "WARNING: Ephemerides are not cached!" << std::endl;
+        }
+    }
+
+    return ephemerides;
+}
+
+} // namespace d2d
@@ -13,6 +13,7 @@
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
@@ -24,6 +25,7 @@
 #include <boost/progress.hpp>
 
 #include "D2D/j2Analysis.hpp"
+#include "D2D/lambertScanner.hpp"
 #include "D2D/tools.hpp"
 #include "D2D/typedefs.hpp"
 
@@ -57,13 +59,20 @@ void executeJ2Analysis( const rapidjson::Document& config )
 
     // Open database in read/write mode.
     // N.B.: Database must already exist and contain populated tables called
-    //       "lambert_scanner_results" and "sgp4_scanner_results".
+    //       "lambert_scanner_results" (or refer to a lambert_scanner column store) and
+    //       "sgp4_scanner_results".
     SQLite::Database database( input.databasePath.c_str( ), SQLITE_OPEN_READWRITE );
 
-    // Create j2_analysis_results table in SQLite database.
-    std::cout << "Creating SQLite database table if needed ... " << std::endl;
-    createJ2AnalysisTable( database );
-    std::cout << "SQLite database set up successfully!" << std::endl;
+    // Apply bulk-load settings to database connection.
+    applyDatabaseSettings( database, input.databaseSettings );
+
+    // Create j2_analysis_results table in SQLite database, if results are stored in database.
+    if ( input.resultSinkSettings.isSQLite( ) )
+    {
+        std::cout << "Creating SQLite database table if needed ... " << std::endl;
+        createJ2AnalysisTable( database );
+        std::cout << "SQLite database set up successfully!" << std::endl;
+    }
 
     // Start SQL transaction.
     SQLite::Transaction transaction( database );
@@ -75,61 +84,43 @@ void executeJ2Analysis( const rapidjson::Document& config )
     std::cout << "# of cases to be considered in J2 analysis = " << sgp4ScannertTableSize;
     std::cout << std::endl;
 
-    // Set up select query to fetch data from lambert_scanner_results table.
+    // Set up reader for lambert_scanner_results table or column store (recomputes fields omitted
+    // in compact schema).
+    const LambertScannerTransferReader reader( database );
+
+    // Set up select query to fetch data from lambert_scanner_results table. If the transfers are
+    // stored in a column store, only the transfer IDs are selected and the transfers are read
+    // from the column store.
     std::ostringstream lambertScannerTableSelect;
-    lambertScannerTableSelect << "SELECT        lambert_scanner_results.transfer_id,"
-                              << "              lambert_scanner_results.time_of_flight,"
-                              << "              lambert_scanner_results.departure_position_x,"
-                              << "              lambert_scanner_results.departure_position_y,"
-                              << "              lambert_scanner_results.departure_position_z,"
-                              << "              lambert_scanner_results.departure_velocity_x,"
-                              << "              lambert_scanner_results.departure_velocity_y,"
-                              << "              lambert_scanner_results.departure_velocity_z,"
-                              << "              lambert_scanner_results.departure_delta_v_x,"
-                              << "              lambert_scanner_results.departure_delta_v_y,"
-                              << "              lambert_scanner_results.departure_delta_v_z,"
-                              << "              lambert_scanner_results.arrival_position_x,"
-                              << "              lambert_scanner_results.arrival_position_y,"
-                              << "              lambert_scanner_results.arrival_position_z,"
-                              << "              lambert_scanner_results.arrival_velocity_x,"
-                              << "              lambert_scanner_results.arrival_velocity_y,"
-                              << "              lambert_scanner_results.arrival_velocity_z,"
-                              << "              lambert_scanner_results.arrival_delta_v_x,"
-                              << "              lambert_scanner_results.arrival_delta_v_y,"
-                              << "              lambert_scanner_results.arrival_delta_v_z "
-                              << "FROM          lambert_scanner_results "
-                              << "INNER JOIN    sgp4_scanner_results "
-                              << "ON            sgp4_scanner_results.success = 1 "
-                              << "AND           sgp4_scanner_results.lambert_transfer_id = "
-                              << "              lambert_scanner_results.transfer_id;";
+    if ( reader.isColumnStore )
+    {
+        lambertScannerTableSelect << "SELECT lambert_transfer_id FROM sgp4_scanner_results "
+                                  << "WHERE success = 1;";
+    }
+
+    else
+    {
+        lambertScannerTableSelect << "SELECT        lambert_scanner_results.* "
+                                  << "FROM          lambert_scanner_results "
+                                  << "INNER JOIN    sgp4_scanner_results "
+                                  << "ON            sgp4_scanner_results.success = 1 "
+                                  << "AND           sgp4_scanner_results.lambert_transfer_id = "
+                                  << "              lambert_scanner_results.transfer_id;";
+    }
 
     SQLite::Statement lambertQuery( database, lambertScannerTableSelect.str( ) );
     std::cout << "Data selection from lambert_scanner_results table successful!" << std::endl;
 
-    // Set up insert query to insert data into j2_analysis_results table.
-    std::ostringstream j2AnalysisTableInsert;
-    j2AnalysisTableInsert << "INSERT INTO j2_analysis_results VALUES ("
-        << "NULL,"
-        << ":lambert_transfer_id,"
-        << ":arrival_position_x,"
-        << ":arrival_position_y,"
-        << ":arrival_position_z,"
-        << ":arrival_velocity_x,"
-        << ":arrival_velocity_y,"
-        << ":arrival_velocity_z,"
-        << ":arrival_position_x_error,"
-        << ":arrival_position_y_error,"
-        << ":arrival_position_z_error,"
-        << ":arrival_position_error,"
-        << ":arrival_velocity_x_error,"
-        << ":arrival_velocity_y_error,"
-        << ":arrival_velocity_z_error,"
-        << ":arrival_velocity_error"
-        << ");";
-
-    SQLite::Statement j2Query( database, j2AnalysisTableInsert.str( ) );
+    // Set up result sink that results are written to.
+    const ResultFields resultFields = getJ2AnalysisResultFields( );
+    std::unique_ptr< ResultSink > resultSink = createResultSink(
+        input.resultSinkSettings, database, "j2_analysis_results", resultFields );
+    ResultRecord record;
     std::cout << "Column headers set up successfully for j2_analysis_results table!" << std::endl;
 
+    // Set up shortlist of records with lowest Lambert transfer deltaV.
+    J2AnalysisShortlist shortlist( std::max( input.shortlistLength, 0 ) );
+
     std::cout << "Performing J2 Analysis on transfer orbits ..." << std::endl << std::endl;
 
     boost::progress_display showProgress( sgp4ScannertTableSize );
@@ -138,27 +129,31 @@ void executeJ2Analysis( const rapidjson::Document& config )
     while ( lambertQuery.executeStep( ) )
     {
         const int      lambertTransferId                    = lambertQuery.getColumn( 0 );
-        const double   timeOfFlight                         = lambertQuery.getColumn( 1 );
-
-        const double   departurePositionX                   = lambertQuery.getColumn( 2 );
-        const double   departurePositionY                   = lambertQuery.getColumn( 3 );
-        const double   departurePositionZ                   = lambertQuery.getColumn( 4 );
-        const double   departureVelocityX                   = lambertQuery.getColumn( 5 );
-        const double   departureVelocityY                   = lambertQuery.getColumn( 6 );
-        const double   departureVelocityZ                   = lambertQuery.getColumn( 7 );
-        const double   departureDeltaVX                     = lambertQuery.getColumn( 8 );
-        const double   departureDeltaVY                     = lambertQuery.getColumn( 9 );
-        const double   departureDeltaVZ                     = lambertQuery.getColumn( 10 );
-
-        const double   lambertArrivalPositionX              = lambertQuery.getColumn( 11 );
-        const double   lambertArrivalPositionY              = lambertQuery.getColumn( 12 );
-        const double   lambertArrivalPositionZ              = lambertQuery.getColumn( 13 );
-        const double   lambertArrivalVelocityX              = lambertQuery.getColumn( 14 );
-        const double   lambertArrivalVelocityY              = lambertQuery.getColumn( 15 );
-        const double   lambertArrivalVelocityZ              = lambertQuery.getColumn( 16 );
-        const double   lambertArrivalDeltaVX                = lambertQuery.getColumn( 17 );
-        const double   lambertArrivalDeltaVY                = lambertQuery.getColumn( 18 );
-        const double   lambertArrivalDeltaVZ                = lambertQuery.getColumn( 19 );
+
+        const LambertScannerTransfer transfer
+            = reader.isColumnStore ? reader.read( lambertTransferId ) : reader.read( lambertQuery );
+
+        const double   timeOfFlight                         = transfer.timeOfFlight;
+
+        const double   departurePositionX                   = transfer.departureState[ 0 ];
+        const double   departurePositionY                   = transfer.departureState[ 1 ];
+        const double   departurePositionZ                   = transfer.departureState[ 2 ];
+        const double   departureVelocityX                   = transfer.departureState[ 3 ];
+        const double   departureVelocityY                   = transfer.departureState[ 4 ];
+        const double   departureVelocityZ                   = transfer.departureState[ 5 ];
+        const double   departureDeltaVX                     = transfer.departureDeltaV[ 0 ];
+        const double   departureDeltaVY                     = transfer.departureDeltaV[ 1 ];
+        const double   departureDeltaVZ                     = transfer.departureDeltaV[ 2 ];
+
+        const double   lambertArrivalPositionX              = transfer.arrivalState[ 0 ];
+        const double   lambertArrivalPositionY              = transfer.arrivalState[ 1 ];
+        const double   lambertArrivalPositionZ              = transfer.arrivalState[ 2 ];
+        const double   lambertArrivalVelocityX              = transfer.arrivalState[ 3 ];
+        const double   lambertArrivalVelocityY              = transfer.arrivalState[ 4 ];
+        const double   lambertArrivalVelocityZ              = transfer.arrivalState[ 5 ];
+        const double   lambertArrivalDeltaVX                = transfer.arrivalDeltaV[ 0 ];
+        const double   lambertArrivalDeltaVY                = transfer.arrivalDeltaV[ 1 ];
+        const double   lambertArrivalDeltaVZ                = transfer.arrivalDeltaV[ 2 ];
 
         // Get departure state for the transfer object ([km] and [km/s]).
         Vector6 transferDepartureState;
@@ -295,34 +290,43 @@ void executeJ2Analysis( const rapidjson::Document& config )
         velocityError[ 2 ] = arrivalVelocityErrorZ;
         double arrivalVelocityErrorNorm = sml::norm< double >( velocityError );
 
-        // Bind computed values to j2Query and execute insertion in database.
-        j2Query.bind( ":lambert_transfer_id",                   lambertTransferId );
-        j2Query.bind( ":arrival_position_x",                    j2ArrivalPositionX );
-        j2Query.bind( ":arrival_position_y",                    j2ArrivalPositionY );
-        j2Query.bind( ":arrival_position_z",                    j2ArrivalPositionZ );
-        j2Query.bind( ":arrival_velocity_x",                    j2ArrivalVelocityX );
-        j2Query.bind( ":arrival_velocity_y",                    j2ArrivalVelocityY );
-        j2Query.bind( ":arrival_velocity_z",                    j2ArrivalVelocityZ );
-        j2Query.bind( ":arrival_position_x_error",              arrivalPositionErrorX );
-        j2Query.bind( ":arrival_position_y_error",              arrivalPositionErrorY );
-        j2Query.bind( ":arrival_position_z_error",              arrivalPositionErrorZ );
-        j2Query.bind( ":arrival_position_error",                arrivalPositionErrorNorm );
-        j2Query.bind( ":arrival_velocity_x_error",              arrivalVelocityErrorX );
-        j2Query.bind( ":arrival_velocity_y_error",              arrivalVelocityErrorY );
-        j2Query.bind( ":arrival_velocity_z_error",              arrivalVelocityErrorZ );
-        j2Query.bind( ":arrival_velocity_error",                arrivalVelocityErrorNorm );
-
-        j2Query.executeStep( );
-        j2Query.reset( );
+        // Write computed values to result sink.
+        const double result[ ] = { static_cast< double >( lambertTransferId ),
+                                   j2ArrivalPositionX,
+                                   j2ArrivalPositionY,
+                                   j2ArrivalPositionZ,
+                                   j2ArrivalVelocityX,
+                                   j2ArrivalVelocityY,
+                                   j2ArrivalVelocityZ,
+                                   arrivalPositionErrorX,
+                                   arrivalPositionErrorY,
+                                   arrivalPositionErrorZ,
+                                   arrivalPositionErrorNorm,
+                                   arrivalVelocityErrorX,
+                                   arrivalVelocityErrorY,
+                                   arrivalVelocityErrorZ,
+                                   arrivalVelocityErrorNorm };
+        record.assign( result, result + resultFields.size( ) );
+        const long long transferId = resultSink->write( record );
+
+        // Retain record in shortlist.
+        if ( shortlist.isImprovedBy( transfer.transferDeltaV ) )
+        {
+            shortlist.insert( J2AnalysisShortlistEntry( transferId,
+                                                        transfer.transferDeltaV,
+                                                        transfer.departureObjectId,
+                                                        transfer.arrivalObjectId,
+                                                        record ) );
+        }
 
         ++showProgress;
     }
 
-    // Fetch number of rows in j2_analysis_results table.
-    std::ostringstream j2AnalysisTableSizeSelect;
-    j2AnalysisTableSizeSelect << "SELECT COUNT(*) FROM j2_analysis_results;";
-    const int j2AnalysistTableSize
-        = database.execAndGet( j2AnalysisTableSizeSelect.str( ) );
+    // Flush records buffered by result sink.
+    resultSink->close( );
+
+    // Fetch number of records written to result sink.
+    const long long j2AnalysistTableSize = resultSink->getNumberOfRecords( );
 
     std::cout << std::endl;
     std::cout << "Total SGP4 (success) cases = " << sgp4ScannertTableSize << std::endl;
@@ -336,11 +340,20 @@ void executeJ2Analysis( const rapidjson::Document& config )
     std::cout << "Database populated successfully!" << std::endl;
     std::cout << std::endl;
 
+    // Create indices once all results have been inserted.
+    if ( input.resultSinkSettings.isSQLite( ) )
+    {
+        std::cout << "Creating SQLite database table indices ... " << std::endl;
+        createJ2AnalysisTableIndices( database );
+        std::cout << "SQLite database table indices created successfully!" << std::endl;
+        std::cout << std::endl;
+    }
+
     // Check if shortlist file should be created; call function to write output.
     if ( input.shortlistLength > 0 )
     {
         std::cout << "Writing shortlist to file ... " << std::endl;
-        writeJ2TransferShortlist( database, input.shortlistLength, input.shortlistPath );
+        writeJ2TransferShortlist( shortlist.getSortedEntries( ), input.shortlistPath );
         std::cout << "Shortlist file created successfully!" << std::endl;
     }
 }
@@ -361,16 +374,23 @@ J2AnalysisInput checkJ2AnalysisInput( const rapidjson::Document& config )
         std::cout << "Shortlist                   " << shortlistPath << std::endl;
     }
 
+    const ResultSinkSettings resultSinkSettings = checkResultSinkSettings( config );
+
+    const DatabaseSettings databaseSettings = checkDatabaseSettings( config );
+
     return J2AnalysisInput( databasePath,
                             shortlistLength,
-                            shortlistPath );
+                            shortlistPath,
+                            resultSinkSettings,
+                            databaseSettings );
 }
 
 //! Create j2_analysis_results table.
 void createJ2AnalysisTable( SQLite::Database& database )
 {
-    // Check that lambert_scanner_results table exists.
-    if ( !database.tableExists( "lambert_scanner_results" ) )
+    // Check that lambert_scanner_results table exists, or that a column store is used.
+    if ( !database.tableExists( "lambert_scanner_results" )
+         && !database.tableExists( "lambert_scanner_column_store" ) )
     {
         throw std::runtime_error(
             "ERROR: \"lambert_scanner_results\" must exist and be populated!" );
@@ -411,6 +431,40 @@ void createJ2AnalysisTable( SQLite::Database& database )
     // Execute command to create table.
     database.exec( j2AnalysisTableCreate.str( ).c_str( ) );
 
+    if ( !database.tableExists( "j2_analysis_results" ) )
+    {
+        std::ostringstream errorMessage;
+        errorMessage << "ERROR: Creating table 'j2_analysis_results' failed in j2Analysis.cpp!";
+        throw std::runtime_error( errorMessage.str( ) );
+    }
+}
+
+//! Get j2_analysis result fields.
+ResultFields getJ2AnalysisResultFields( )
+{
+    ResultFields fields;
+    fields.push_back( ResultField( "lambert_transfer_id", true ) );
+    fields.push_back( ResultField( "arrival_position_x" ) );
+    fields.push_back( ResultField( "arrival_position_y" ) );
+    fields.push_back( ResultField( "arrival_position_z" ) );
+    fields.push_back( ResultField( "arrival_velocity_x" ) );
+    fields.push_back( ResultField( "arrival_velocity_y" ) );
+    fields.push_back( ResultField( "arrival_velocity_z" ) );
+    fields.push_back( ResultField( "arrival_position_x_error" ) );
+    fields.push_back( ResultField( "arrival_position_y_error" ) );
+    fields.push_back( ResultField( "arrival_position_z_error" ) );
+    fields.push_back( ResultField( "arrival_position_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_x_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_y_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_z_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_error" ) );
+
+    return fields;
+}
+
+//! Create j2_analysis_results table indices.
+void createJ2AnalysisTableIndices( SQLite::Database& database )
+{
     // Execute command to create index on transfer arrival_position_error column.
     std::ostringstream arrivalPositionErrorIndexCreate;
     arrivalPositionErrorIndexCreate << "CREATE INDEX IF NOT EXISTS \"arrival_position_error\" on "
@@ -422,53 +476,13 @@ void createJ2AnalysisTable( SQLite::Database& database )
     arrivalVelocityErrorIndexCreate << "CREATE INDEX IF NOT EXISTS \"arrival_velocity_error\" on "
                                     << "j2_analysis_results (arrival_velocity_error ASC);";
     database.exec( arrivalVelocityErrorIndexCreate.str( ).c_str( ) );
-
-    if ( !database.tableExists( "j2_analysis_results" ) )
-    {
-        std::ostringstream errorMessage;
-        errorMessage << "ERROR: Creating table 'j2_analysis_results' failed in j2Analysis.cpp!";
-        throw std::runtime_error( errorMessage.str( ) );
-    }
 }
 
 //! Write transfer shortlist to file.
-void writeJ2TransferShortlist( SQLite::Database& database,
-                               const int shortlistNumber,
+void writeJ2TransferShortlist( const J2AnalysisShortlistEntries& shortlistEntries,
                                const std::string& shortlistPath )
 {
-    // Fetch transfers to include in shortlist.
-    // The j2_analysis_results table is sorted by transfer_delta_v from the lambert_scanner_results
-    // table in ascending order.
-    std::ostringstream shortlistSelect;
-    shortlistSelect << "SELECT      j2_analysis_results.transfer_id, "
-                    << "            j2_analysis_results.lambert_transfer_id, "
-                    << "            lambert_scanner_results.transfer_delta_v, "
-                    << "            lambert_scanner_results.departure_object_id, "
-                    << "            lambert_scanner_results.arrival_object_id, "
-                    << "            j2_analysis_results.arrival_position_x, "
-                    << "            j2_analysis_results.arrival_position_y, "
-                    << "            j2_analysis_results.arrival_position_z, "
-                    << "            j2_analysis_results.arrival_velocity_x, "
-                    << "            j2_analysis_results.arrival_velocity_y, "
-                    << "            j2_analysis_results.arrival_velocity_z, "
-                    << "            j2_analysis_results.arrival_position_x_error, "
-                    << "            j2_analysis_results.arrival_position_y_error, "
-                    << "            j2_analysis_results.arrival_position_z_error, "
-                    << "            j2_analysis_results.arrival_position_error, "
-                    << "            j2_analysis_results.arrival_velocity_x_error, "
-                    << "            j2_analysis_results.arrival_velocity_y_error, "
-                    << "            j2_analysis_results.arrival_velocity_z_error, "
-                    << "            j2_analysis_results.arrival_velocity_error "
-                    << "FROM        j2_analysis_results "
-                    << "INNER JOIN  lambert_scanner_results "
-                    << "ON          lambert_scanner_results.transfer_id = "
-                    << "            j2_analysis_results.lambert_transfer_id "
-                    << "ORDER BY    lambert_scanner_results.transfer_delta_v ASC LIMIT "
-                    << shortlistNumber << ";";
-
-    SQLite::Statement query( database, shortlistSelect.str( ) );
-
-    // Write fetch data to file.
+    // Write shortlist entries to file.
     std::ofstream shortlistFile( shortlistPath.c_str( ) );
 
     // Print file header.
@@ -493,30 +507,31 @@ void writeJ2TransferShortlist( SQLite::Database& database,
                   << "arrival_velocity_error"
                   << std::endl;
 
-    // Loop through data retrieved from database and write to file.
-    while( query.executeStep( ) )
+    // Loop through shortlist entries and write to file.
+    for ( unsigned int i = 0; i < shortlistEntries.size( ); i++ )
     {
-        const int    transferId                         = query.getColumn( 0 );
-        const int    lambertTransferId                  = query.getColumn( 1 );
-        const double lambertTransferDeltaV              = query.getColumn( 2 );
-        const int    departureObjectId                  = query.getColumn( 3 );
-        const int    arrivalObjectId                    = query.getColumn( 4 );
-
-        const double arrivalPositionX                   = query.getColumn( 5 );
-        const double arrivalPositionY                   = query.getColumn( 6 );
-        const double arrivalPositionZ                   = query.getColumn( 7 );
-        const double arrivalVelocityX                   = query.getColumn( 8 );
-        const double arrivalVelocityY                   = query.getColumn( 9 );
-        const double arrivalVelocityZ                   = query.getColumn( 10 );
-
-        const double arrivalPositionErrorX              = query.getColumn( 11 );
-        const double arrivalPositionErrorY              = query.getColumn( 12 );
-        const double arrivalPositionErrorZ              = query.getColumn( 13 );
-        const double arrivalPositionError               = query.getColumn( 14 );
-        const double arrivalVelocityErrorX              = query.getColumn( 15 );
-        const double arrivalVelocityErrorY              = query.getColumn( 16 );
-        const double arrivalVelocityErrorZ              = query.getColumn( 17 );
-        const double arrivalVelocityError               = query.getColumn( 18 );
+        const J2AnalysisShortlistEntry& entry           = shortlistEntries[ i ];
+        const long long transferId                      = entry.transferId;
+        const int    lambertTransferId                  = static_cast< int >( entry.record[ 0 ] );
+        const double lambertTransferDeltaV              = entry.lambertTransferDeltaV;
+        const int    departureObjectId                  = entry.departureObjectId;
+        const int    arrivalObjectId                    = entry.arrivalObjectId;
+
+        const double arrivalPositionX                   = entry.record[ 1 ];
+        const double arrivalPositionY                   = entry.record[ 2 ];
+        const double arrivalPositionZ                   = entry.record[ 3 ];
+        const double arrivalVelocityX                   = entry.record[ 4 ];
+        const double arrivalVelocityY                   = entry.record[ 5 ];
+        const double arrivalVelocityZ                   = entry.record[ 6 ];
+
+        const double arrivalPositionErrorX              = entry.record[ 7 ];
+        const double arrivalPositionErrorY              = entry.record[ 8 ];
+        const double arrivalPositionErrorZ              = entry.record[ 9 ];
+        const double arrivalPositionError               = entry.record[ 10 ];
+        const double arrivalVelocityErrorX              = entry.record[ 11 ];
+        const double arrivalVelocityErrorY              = entry.record[ 12 ];
+        const double arrivalVelocityErrorZ              = entry.record[ 13 ];
+        const double arrivalVelocityError               = entry.record[ 14 ];
 
         shortlistFile << transferId                         << ","
                       << lambertTransferId                  << ",";
@@ -17,6 +17,7 @@
 #include <Astro/astro.hpp>
 
 #include "D2D/lambertFetch.hpp"
+#include "D2D/lambertScanner.hpp"
 #include "D2D/tools.hpp"
 
 namespace d2d
@@ -50,28 +51,31 @@ void fetchLambertTransfer( const rapidjson::Document& config )
     SQLite::Statement query( database, transferSelect.str( ) );
     query.executeStep( );
 
-    const int    departureObjectId                  = query.getColumn( 1 );
-    const int    arrivalObjectId                    = query.getColumn( 2 );
-    const double departureEpoch                     = query.getColumn( 3 );
-    const double timeOfFlight                       = query.getColumn( 4 );
-    const int    revolutions                        = query.getColumn( 5 );
-    const int    prograde                           = query.getColumn( 6 );
-    const double departurePositionX                 = query.getColumn( 7 );
-    const double departurePositionY                 = query.getColumn( 8 );
-    const double departurePositionZ                 = query.getColumn( 9 );
-    const double departureVelocityX                 = query.getColumn( 10 );
-    const double departureVelocityY                 = query.getColumn( 11 );
-    const double departureVelocityZ                 = query.getColumn( 12 );
-    const double arrivalPositionX                   = query.getColumn( 19 );
-    const double arrivalPositionY                   = query.getColumn( 20 );
-    const double arrivalPositionZ                   = query.getColumn( 21 );
-    const double arrivalVelocityX                   = query.getColumn( 22 );
-    const double arrivalVelocityY                   = query.getColumn( 23 );
-    const double arrivalVelocityZ                   = query.getColumn( 24 );
-    const double departureDeltaVX                   = query.getColumn( 37 );
-    const double departureDeltaVY                   = query.getColumn( 38 );
-    const double departureDeltaVZ                   = query.getColumn( 39 );
-    const double transferDeltaV                     = query.getColumn( 43 );
+    const LambertScannerTransferReader reader( database );
+    const LambertScannerTransfer transfer = reader.read( query );
+
+    const int    departureObjectId                  = transfer.departureObjectId;
+    const int    arrivalObjectId                    = transfer.arrivalObjectId;
+    const double departureEpoch                     = transfer.departureEpoch;
+    const double timeOfFlight                       = transfer.timeOfFlight;
+    const int    revolutions                        = transfer.revolutions;
+    const int    prograde                           = transfer.isPrograde;
+    const double departurePositionX                 = transfer.departureState[ 0 ];
+    const double departurePositionY                 = transfer.departureState[ 1 ];
+    const double departurePositionZ                 = transfer.departureState[ 2 ];
+    const double departureVelocityX                 = transfer.departureState[ 3 ];
+    const double departureVelocityY                 = transfer.departureState[ 4 ];
+    const double departureVelocityZ                 = transfer.departureState[ 5 ];
+    const double arrivalPositionX                   = transfer.arrivalState[ 0 ];
+    const double arrivalPositionY                   = transfer.arrivalState[ 1 ];
+    const double arrivalPositionZ                   = transfer.arrivalState[ 2 ];
+    const double arrivalVelocityX                   = transfer.arrivalState[ 3 ];
+    const double arrivalVelocityY                   = transfer.arrivalState[ 4 ];
+    const double arrivalVelocityZ                   = transfer.arrivalState[ 5 ];
+    const double departureDeltaVX                   = transfer.departureDeltaV[ 0 ];
+    const double departureDeltaVY                   = transfer.departureDeltaV[ 1 ];
+    const double departureDeltaVZ                   = transfer.departureDeltaV[ 2 ];
+    const double transferDeltaV                     = transfer.transferDeltaV;
 
     std::cout << "Transfer successfully fetched from database!" << std::endl;
 
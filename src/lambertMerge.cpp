@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <sqlite3.h>
+
+#include "D2D/lambertMerge.hpp"
+#include "D2D/lambertScanner.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+
+//! Merge lambert_scanner shard databases.
+void executeLambertMerge( const rapidjson::Document& config )
+{
+    // Verify config parameters. Exception is thrown if any of the parameters are missing.
+    const LambertMergeInput input = checkLambertMergeInput( config );
+
+    std::cout << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "                       Simulation & Output                        " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << std::endl;
+
+    // Open database in read/write mode.
+    SQLite::Database database( input.databasePath.c_str( ),
+                               SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+
+    // Apply bulk-load settings to database connection.
+    applyDatabaseSettings( database, input.databaseSettings );
+
+    // Create tables for merged Lambert scanner results in SQLite database, using the schema of
+    // the first shard.
+    bool isCompact = false;
+    bool isParametersStored = false;
+    {
+        SQLite::Database shardDatabase( input.shardDatabasePaths[ 0 ].c_str( ),
+                                        SQLITE_OPEN_READONLY );
+        isCompact = isLambertScannerTableCompact( shardDatabase );
+        isParametersStored = shardDatabase.tableExists( "lambert_scanner_parameters" );
+    }
+
+    std::cout << "Creating SQLite database tables ... " << std::endl;
+    createLambertScannerTable( database, isCompact );
+    createLambertScannerProgressTable( database );
+    createLambertScannerCatalogTable( database );
+
+    // Run parameters are stored if the shards store them, such that the merged database can be
+    // updated incrementally.
+    if ( isParametersStored )
+    {
+        createLambertScannerParametersTable( database );
+    }
+
+    else
+    {
+        database.exec( "DROP TABLE IF EXISTS lambert_scanner_parameters;" );
+    }
+    std::cout << "SQLite database set up successfully!" << std::endl;
+
+    std::cout << "Merging shard databases ... " << std::endl;
+
+    long long numberOfTransfers = 0;
+    for ( unsigned int i = 0; i < input.shardDatabasePaths.size( ); i++ )
+    {
+        const long long numberOfShardTransfers
+            = mergeLambertScannerShard( database,
+                                        input.shardDatabasePaths[ i ],
+                                        i,
+                                        input.shardDatabasePaths.size( ) );
+        std::cout << numberOfShardTransfers << " transfers merged from "
+                  << input.shardDatabasePaths[ i ] << std::endl;
+        numberOfTransfers += numberOfShardTransfers;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Total transfers merged = " << numberOfTransfers << std::endl;
+    std::cout << "Database populated successfully!" << std::endl;
+    std::cout << std::endl;
+
+    // Create indices once all shards have been merged.
+    std::cout << "Creating SQLite database table indices ... " << std::endl;
+    createLambertScannerTableIndices( database );
+    std::cout << "SQLite database table indices created successfully!" << std::endl;
+    std::cout << std::endl;
+
+    // Check if shortlist file should be created; call function to write output.
+    if ( input.shortlistLength > 0 )
+    {
+        std::cout << "Writing shortlist to file ... " << std::endl;
+        writeTransferShortlist( fetchLambertScannerShortlist( database, input.shortlistLength ),
+                                input.shortlistPath );
+        std::cout << "Shortlist file created successfully!" << std::endl;
+    }
+}
+
+//! Check lambert_merge input parameters.
+LambertMergeInput checkLambertMergeInput( const rapidjson::Document& config )
+{
+    const rapidjson::Value& shardDatabases = find( config, "shard_databases" )->value;
+
+    std::vector< std::string > shardDatabasePaths;
+    for ( unsigned int i = 0; i < shardDatabases.Size( ); i++ )
+    {
+        shardDatabasePaths.push_back( shardDatabases[ i ].GetString( ) );
+        std::cout << "Shard database                " << shardDatabasePaths[ i ] << std::endl;
+    }
+
+    if ( shardDatabasePaths.empty( ) )
+    {
+        throw std::runtime_error( "ERROR: At least one shard database must be specified!" );
+    }
+
+    const std::string databasePath = find( config, "database" )->value.GetString( );
+    std::cout << "Database                      " << databasePath << std::endl;
+
+    for ( unsigned int i = 0; i < shardDatabasePaths.size( ); i++ )
+    {
+        if ( shardDatabasePaths[ i ] == databasePath )
+        {
+            throw std::runtime_error(
+                "ERROR: Merged database must not be one of the shard databases!" );
+        }
+    }
+
+    const int shortlistLength = find( config, "shortlist" )->value[ 0 ].GetInt( );
+    std::cout << "# of shortlist transfers      " << shortlistLength << std::endl;
+
+    std::string shortlistPath = "";
+    if ( shortlistLength > 0 )
+    {
+        shortlistPath = find( config, "shortlist" )->value[ 1 ].GetString( );
+        std::cout << "Shortlist                     " << shortlistPath << std::endl;
+    }
+
+    const DatabaseSettings databaseSettings = checkDatabaseSettings( config );
+
+    return LambertMergeInput( shardDatabasePaths,
+                              databasePath,
+                              shortlistLength,
+                              shortlistPath,
+                              databaseSettings );
+}
+
+//! Merge lambert_scanner shard database.
+long long mergeLambertScannerShard( SQLite::Database& database,
+                                    const std::string& shardDatabasePath,
+                                    const int shardIndex,
+                                    const int numberOfShards )
+{
+    // Attach shard database; this is not allowed inside a transaction.
+    SQLite::Statement attachQuery( database, "ATTACH DATABASE :path AS shard;" );
+    attachQuery.bind( ":path", shardDatabasePath );
+    attachQuery.exec( );
+
+    long long numberOfTransfers = 0;
+
+    try
+    {
+        const int numberOfShardTables = database.execAndGet(
+            "SELECT COUNT(*) FROM shard.sqlite_master WHERE type = 'table' AND name IN "
+            "('lambert_scanner_results', 'lambert_scanner_progress', 'lambert_scanner_catalog');" );
+        if ( numberOfShardTables != 3 )
+        {
+            throw std::runtime_error( "ERROR: Shard database " + shardDatabasePath
+                                      + " does not contain lambert_scanner tables!" );
+        }
+
+        // Check that the shard was computed as the shard at its position in the merge order, if
+        // the run parameters are stored in the shard.
+        const int numberOfParametersTables = database.execAndGet(
+            "SELECT COUNT(*) FROM shard.sqlite_master WHERE type = 'table' AND name = "
+            "'lambert_scanner_parameters';" );
+        if ( numberOfParametersTables == 1 )
+        {
+            SQLite::Statement parameterQuery(
+                database,
+                "SELECT value FROM shard.lambert_scanner_parameters WHERE name = :name;" );
+
+            parameterQuery.bind( ":name", "shard_index" );
+            const bool isShardIndexStored = parameterQuery.executeStep( );
+            const double storedShardIndex
+                = isShardIndexStored ? parameterQuery.getColumn( 0 ).getDouble( ) : 0.0;
+            parameterQuery.reset( );
+
+            parameterQuery.bind( ":name", "shards" );
+            const bool isNumberOfShardsStored = parameterQuery.executeStep( );
+            const double storedNumberOfShards
+                = isNumberOfShardsStored ? parameterQuery.getColumn( 0 ).getDouble( ) : 1.0;
+
+            if ( storedShardIndex != shardIndex || storedNumberOfShards != numberOfShards )
+            {
+                std::ostringstream errorMessage;
+                errorMessage << "ERROR: Shard database " << shardDatabasePath << " contains shard "
+                             << storedShardIndex << " of " << storedNumberOfShards
+                             << ", expected shard " << shardIndex << " of " << numberOfShards
+                             << "!";
+                throw std::runtime_error( errorMessage.str( ) );
+            }
+        }
+
+        // Check that the shard was computed with the same run parameters as the shards merged so
+        // far, apart from its shard index. The first shard sets the run parameters of the merged
+        // database.
+        const int numberOfMergedParametersTables = database.execAndGet(
+            "SELECT COUNT(*) FROM main.sqlite_master WHERE type = 'table' AND name = "
+            "'lambert_scanner_parameters';" );
+        if ( numberOfParametersTables != numberOfMergedParametersTables )
+        {
+            throw std::runtime_error( "ERROR: Run parameters must be stored in all or none of the "
+                                      "shard databases, including " + shardDatabasePath + "!" );
+        }
+
+        int numberOfMergedParameters = 0;
+        if ( numberOfMergedParametersTables == 1 )
+        {
+            numberOfMergedParameters = database.execAndGet(
+                "SELECT COUNT(*) FROM main.lambert_scanner_parameters;" );
+        }
+
+        if ( numberOfMergedParameters > 0 )
+        {
+            const int numberOfMismatchedParameters = database.execAndGet(
+                "SELECT "
+                "(SELECT COUNT(*) FROM ("
+                "SELECT name, value FROM shard.lambert_scanner_parameters "
+                "WHERE name NOT IN ('shard_index', 'shards') "
+                "EXCEPT SELECT name, value FROM main.lambert_scanner_parameters "
+                "WHERE name NOT IN ('shard_index', 'shards'))) + "
+                "(SELECT COUNT(*) FROM ("
+                "SELECT name, value FROM main.lambert_scanner_parameters "
+                "WHERE name NOT IN ('shard_index', 'shards') "
+                "EXCEPT SELECT name, value FROM shard.lambert_scanner_parameters "
+                "WHERE name NOT IN ('shard_index', 'shards')));" );
+            if ( numberOfMismatchedParameters != 0 )
+            {
+                throw std::runtime_error( "ERROR: Run parameters of shard database "
+                                          + shardDatabasePath + " do not match run parameters "
+                                          + "of previously merged shards!" );
+            }
+        }
+
+        // Check that the shard stores the same catalog as the shards merged so far. The first
+        // shard sets the catalog of the merged database.
+        const int numberOfMergedObjects
+            = database.execAndGet( "SELECT COUNT(*) FROM main.lambert_scanner_catalog;" );
+        const int numberOfShardObjects
+            = database.execAndGet( "SELECT COUNT(*) FROM shard.lambert_scanner_catalog;" );
+        if ( numberOfMergedObjects > 0 )
+        {
+            const int numberOfMismatchedObjects = database.execAndGet(
+                "SELECT COUNT(*) FROM ("
+                "SELECT * FROM shard.lambert_scanner_catalog "
+                "EXCEPT SELECT * FROM main.lambert_scanner_catalog);" );
+            if ( numberOfShardObjects != numberOfMergedObjects || numberOfMismatchedObjects != 0 )
+            {
+                throw std::runtime_error( "ERROR: Catalog of shard database " + shardDatabasePath
+                                          + " does not match catalog of previously merged "
+                                          + "shards!" );
+            }
+        }
+
+        // Check that the progress of the shard covers exactly its slice of the departure objects
+        // (see executeLambertScanner()), i.e., that the shard run completed.
+        const long long shardObjectIndexBegin
+            = static_cast< long long >( numberOfShardObjects ) * shardIndex / numberOfShards;
+        const long long shardObjectIndexEnd
+            = static_cast< long long >( numberOfShardObjects ) * ( shardIndex + 1 )
+                / numberOfShards;
+
+        const long long numberOfCompletedObjects = database.execAndGet(
+            "SELECT COUNT(*) FROM shard.lambert_scanner_progress;" ).getInt64( );
+        SQLite::Statement progressQuery(
+            database,
+            "SELECT COUNT(*) FROM shard.lambert_scanner_progress "
+            "WHERE departure_object_index >= :begin AND departure_object_index < :end;" );
+        progressQuery.bind( ":begin", static_cast< sqlite3_int64 >( shardObjectIndexBegin ) );
+        progressQuery.bind( ":end", static_cast< sqlite3_int64 >( shardObjectIndexEnd ) );
+        progressQuery.executeStep( );
+        const long long numberOfCompletedShardObjects = progressQuery.getColumn( 0 ).getInt64( );
+
+        if ( numberOfCompletedShardObjects != shardObjectIndexEnd - shardObjectIndexBegin
+             || numberOfCompletedObjects != numberOfCompletedShardObjects )
+        {
+            std::ostringstream errorMessage;
+            errorMessage << "ERROR: Progress of shard database " << shardDatabasePath
+                         << " does not cover departure objects " << shardObjectIndexBegin
+                         << " - " << shardObjectIndexEnd - 1 << " of shard " << shardIndex
+                         << " of " << numberOfShards << "!";
+            throw std::runtime_error( errorMessage.str( ) );
+        }
+
+        // List all columns except transfer_id, so that new transfer IDs are assigned in order.
+        std::ostringstream columns;
+        SQLite::Statement columnQuery( database, "PRAGMA table_info(lambert_scanner_results);" );
+        while ( columnQuery.executeStep( ) )
+        {
+            const std::string column = columnQuery.getColumn( 1 );
+            if ( column == "transfer_id" )
+            {
+                continue;
+            }
+
+            if ( !columns.str( ).empty( ) )
+            {
+                columns << ",";
+            }
+            columns << "\"" << column << "\"";
+        }
+
+        std::ostringstream transfersInsert;
+        transfersInsert << "INSERT INTO main.lambert_scanner_results (" << columns.str( ) << ") "
+                        << "SELECT " << columns.str( ) << " FROM shard.lambert_scanner_results "
+                        << "ORDER BY transfer_id ASC;";
+
+        SQLite::Transaction transaction( database );
+
+        numberOfTransfers = database.exec( transfersInsert.str( ) );
+
+        // Departure objects are the primary key of the progress table, so overlapping shards are
+        // rejected.
+        try
+        {
+            database.exec( "INSERT INTO main.lambert_scanner_progress "
+                           "SELECT * FROM shard.lambert_scanner_progress;" );
+        }
+        catch( const SQLite::Exception& )
+        {
+            throw std::runtime_error( "ERROR: Shard database " + shardDatabasePath
+                                      + " overlaps with previously merged shards!" );
+        }
+
+        // All shards store the same catalog, which is copied from the first shard.
+        if ( numberOfMergedObjects == 0 )
+        {
+            database.exec( "INSERT INTO main.lambert_scanner_catalog "
+                           "SELECT * FROM shard.lambert_scanner_catalog;" );
+        }
+
+        // The merged database contains all shards, as if it were written by a single run.
+        if ( numberOfMergedParametersTables == 1 && numberOfMergedParameters == 0 )
+        {
+            database.exec( "INSERT INTO main.lambert_scanner_parameters "
+                           "SELECT name, CASE name WHEN 'shard_index' THEN 0.0 "
+                           "WHEN 'shards' THEN 1.0 ELSE value END "
+                           "FROM shard.lambert_scanner_parameters;" );
+        }
+
+        transaction.commit( );
+    }
+    catch( ... )
+    {
+        database.exec( "DETACH DATABASE shard;" );
+        throw;
+    }
+
+    database.exec( "DETACH DATABASE shard;" );
+
+    return numberOfTransfers;
+}
+
+} // namespace d2d
@@ -9,11 +9,18 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <unistd.h>
+
 #include <boost/progress.hpp>
 
 #include <libsgp4/Eci.h>
@@ -27,6 +34,7 @@
 #include <Astro/astro.hpp>
 
 #include "D2D/lambertScanner.hpp"
+#include "D2D/tleCatalog.hpp"
 #include "D2D/tools.hpp"
 
 namespace d2d
@@ -50,542 +58,2537 @@ void executeLambertScanner( const rapidjson::Document& config )
     std::cout << std::endl;
 
     std::cout << "Parsing TLE catalog ... " << std::endl;
+    const TleCatalog catalog( input.catalogPath );
+    const TleObjects tleObjects = catalog.getTleObjects( input.threads );
+    std::cout << tleObjects.size( ) << " TLE objects parsed from catalog!" << std::endl;
+
+    // Propagate all objects once to all distinct epochs spanned by the departure epoch and
+    // time-of-flight grids, or read the ephemerides from the cache.
+    std::cout << "Computing ephemerides ... " << std::endl;
+    const LambertScannerEpochGrid epochGrid = computeLambertScannerEpochGrid( input );
+    const std::unique_ptr< const EphemerisTable > ephemerides
+        = computeEphemerisTable( tleObjects,
+                                 catalog.computeHash( ),
+                                 epochGrid.epochs,
+                                 earthGravitationalParameter,
+                                 input.threads,
+                                 input.ephemerisCachePath );
+    std::cout << "Ephemerides computed for " << epochGrid.epochs.size( ) << " epochs!"
+              << std::endl;
+
+    runLambertScanner( input, tleObjects, epochGrid, *ephemerides );
+}
 
-    // Parse catalog and store TLE objects.
-    std::ifstream catalogFile( input.catalogPath.c_str( ) );
-    std::string catalogLine;
+//! Run lambert_scanner.
+void runLambertScanner( const LambertScannerInput& input,
+                        const TleObjects& tleObjects,
+                        const LambertScannerEpochGrid& epochGrid,
+                        const EphemerisTable& ephemerides )
+{
+    // Check that objects can be identified by their NORAD ID before the database is modified.
+    checkLambertScannerCatalog( tleObjects );
+
+    // Open database in read/write mode.
+    SQLite::Database database( input.databasePath.c_str( ),
+                               SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
 
-    // Check if catalog is 2-line or 3-line version.
-    std::getline( catalogFile, catalogLine );
-    const int tleLines = getTleCatalogType( catalogLine );
+    // Apply bulk-load settings to database connection.
+    applyDatabaseSettings( database, input.databaseSettings );
 
-    // Reset file stream to start of file.
-    catalogFile.seekg( 0, std::ios::beg );
+    // Flag departure objects to skip: objects completed in a previous run, if the run is resumed,
+    // and objects outside the shard of departure objects assigned to this process.
+    std::vector< bool > isDepartureObjectSkipped( tleObjects.size( ), false );
 
-    typedef std::vector< std::string > TleStrings;
-    typedef std::vector< Tle > TleObjects;
-    TleObjects tleObjects;
+    // Flag objects that are changed or new since the previous run, if the database is updated
+    // incrementally; only pairs that include a changed object are computed.
+    std::vector< bool > isObjectChanged;
+    std::vector< int > removedObjectIds;
 
-    while ( std::getline( catalogFile, catalogLine ) )
+    if ( input.isResumed )
     {
-        TleStrings tleStrings;
-        removeNewline( catalogLine );
-        tleStrings.push_back( catalogLine );
-        std::getline( catalogFile, catalogLine );
-        removeNewline( catalogLine );
-        tleStrings.push_back( catalogLine );
+        std::cout << "Fetching progress from SQLite database ... " << std::endl;
+        isDepartureObjectSkipped = fetchLambertScannerProgress( database, tleObjects );
+        checkLambertScannerResume( database, input, tleObjects );
+
+        std::cout << std::count( isDepartureObjectSkipped.begin( ),
+                                 isDepartureObjectSkipped.end( ),
+                                 true )
+                  << " departure objects completed in previous run!" << std::endl;
+    }
 
-        if ( tleLines == 3 )
+    else if ( input.isIncremental )
+    {
+        std::cout << "Comparing TLE catalog with previous run ... " << std::endl;
+        isObjectChanged = compareLambertScannerCatalog( database, tleObjects, removedObjectIds );
+        if ( isLambertScannerTableCompact( database ) != input.isCompact )
         {
-            std::getline( catalogFile, catalogLine );
-            removeNewline( catalogLine );
-            tleStrings.push_back( catalogLine );
-            tleObjects.push_back( Tle( tleStrings[ 0 ], tleStrings[ 1 ], tleStrings[ 2 ] ) );
+            throw std::runtime_error(
+                "ERROR: Schema of lambert_scanner table in database does not match input!" );
         }
+        checkLambertScannerParameters( database, input );
+
+        const long long numberOfChangedObjects
+            = std::count( isObjectChanged.begin( ), isObjectChanged.end( ), true );
+        std::cout << numberOfChangedObjects << " objects changed or added and "
+                  << removedObjectIds.size( ) << " objects removed since previous run!"
+                  << std::endl;
 
-        else if ( tleLines == 2 )
+        // If no object is changed, there are no transfers to compute.
+        if ( numberOfChangedObjects == 0 )
         {
-            tleObjects.push_back( Tle( tleStrings[ 0 ], tleStrings[ 1 ] ) );
+            std::fill( isDepartureObjectSkipped.begin( ), isDepartureObjectSkipped.end( ), true );
         }
     }
 
-    catalogFile.close( );
-    std::cout << tleObjects.size( ) << " TLE objects parsed from catalog!" << std::endl;
+    else
+    {
+        // Create table for Lambert scanner results in SQLite database.
+        // If a column store is used, its path is recorded in the database instead. Transfers
+        // written to other result sinks are not stored in the database.
+        std::cout << "Creating SQLite database table if needed ... " << std::endl;
+        if ( !input.columnStorePath.empty( ) )
+        {
+            createLambertScannerColumnStoreTable( database, input.columnStorePath );
+        }
+
+        else if ( input.resultSinkSettings.isSQLite( ) )
+        {
+            createLambertScannerTable( database, input.isCompact );
+        }
+
+        else
+        {
+            database.exec( "DROP TABLE IF EXISTS lambert_scanner_results;" );
+            database.exec( "DROP TABLE IF EXISTS lambert_scanner_column_store;" );
+        }
+        createLambertScannerProgressTable( database );
+        createLambertScannerCatalogTable( database );
+        storeLambertScannerParameters( database, input );
+        std::cout << "SQLite database set up successfully!" << std::endl;
+    }
+
+    // Start SQL transaction. The transaction is committed and restarted at each checkpoint.
+    std::unique_ptr< SQLite::Transaction > transaction( new SQLite::Transaction( database ) );
+
+    // Delete transfers of changed and removed objects, and replace progress and catalog of the
+    // previous run.
+    if ( input.isIncremental )
+    {
+        std::vector< int > deletedObjectIds = removedObjectIds;
+        for ( unsigned int i = 0; i < tleObjects.size( ); i++ )
+        {
+            if ( isObjectChanged[ i ] )
+            {
+                deletedObjectIds.push_back( static_cast< int >( tleObjects[ i ].NoradNumber( ) ) );
+            }
+        }
+
+        std::cout << "Deleting transfers of changed and removed objects ... " << std::endl;
+        const int numberOfDeletedTransfers
+            = deleteLambertScannerTransfers( database, deletedObjectIds );
+        std::cout << numberOfDeletedTransfers << " transfers deleted!" << std::endl;
+
+        createLambertScannerProgressTable( database );
+        createLambertScannerCatalogTable( database );
+    }
+
+    // Store catalog, so that the fields omitted in the compact schema can be recomputed.
+    if ( !input.isResumed )
+    {
+        storeLambertScannerCatalog( database, tleObjects );
+    }
+
+    // Set up result sink that transfers are written to: the column store, if specified, or the
+    // sink selected in the input file.
+    const ResultFields resultFields = getLambertScannerResultFields( input.isCompact );
+    std::unique_ptr< ResultSink > resultSink;
+    if ( !input.columnStorePath.empty( ) )
+    {
+        const std::map< std::string, double > gridMetadata
+            = getLambertScannerParameters( input );
+        resultSink.reset(
+            new ColumnStoreResultSink( input.columnStorePath, resultFields, gridMetadata ) );
+    }
+
+    else
+    {
+        resultSink = createResultSink(
+            input.resultSinkSettings, database, "lambert_scanner_results", resultFields );
+    }
+
+    // Setup progress insert query.
+    SQLite::Statement progressQuery(
+        database,
+        "INSERT INTO lambert_scanner_progress VALUES "
+        "(:departure_object_index, :departure_object_id);" );
+
+    std::cout << "Computing Lambert transfers and populating database ... " << std::endl;
+
+    // Skip departure objects outside shard. Shards are contiguous slices of the catalog, so that
+    // merging the shard databases in order reproduces the output of a single run.
+    const long long shardObjectIndexBegin
+        = static_cast< long long >( tleObjects.size( ) ) * input.shardIndex / input.numberOfShards;
+    const long long shardObjectIndexEnd
+        = static_cast< long long >( tleObjects.size( ) ) * ( input.shardIndex + 1 )
+            / input.numberOfShards;
+    for ( long long i = 0; i < static_cast< long long >( tleObjects.size( ) ); i++ )
+    {
+        if ( i < shardObjectIndexBegin || i >= shardObjectIndexEnd )
+        {
+            isDepartureObjectSkipped[ i ] = true;
+        }
+    }
+
+    if ( input.numberOfShards > 1 )
+    {
+        std::cout << "Shard departure objects       " << shardObjectIndexBegin << " - "
+                  << shardObjectIndexEnd - 1 << std::endl;
+    }
+
+    // Initialize one SGP4 propagator per object, shared by the worker threads, to propagate
+    // objects to the epochs between grid points during grid refinement.
+    std::vector< SGP4 > propagators;
+    if ( input.isGridRefined( ) )
+    {
+        propagators.reserve( tleObjects.size( ) );
+        for ( unsigned int i = 0; i < tleObjects.size( ); i++ )
+        {
+            propagators.push_back( SGP4( tleObjects[ i ] ) );
+        }
+    }
+
+    // Set up tiling of departure-arrival iteration space.
+    const LambertScannerTiling tiling = computeLambertScannerTiling(
+        input, tleObjects.size( ), epochGrid.epochs.size( ) );
+    std::cout << "Tile size                     " << tiling.departureBlockSize << " x "
+              << tiling.arrivalBlockSize << std::endl;
+
+    // Set up work queue to distribute departure blocks across worker threads. Blocks in which all
+    // departure objects are skipped are not queued. The number of departure blocks in flight is
+    // bounded to limit memory used by buffers awaiting the writer.
+    std::vector< unsigned int > departureBlockIndices;
+    for ( unsigned int i = 0; i < tleObjects.size( ); i += tiling.departureBlockSize )
+    {
+        const unsigned int departureObjectIndexEnd
+            = std::min( i + tiling.departureBlockSize,
+                        static_cast< unsigned int >( tleObjects.size( ) ) );
+        if ( std::find( isDepartureObjectSkipped.begin( ) + i,
+                        isDepartureObjectSkipped.begin( ) + departureObjectIndexEnd,
+                        false ) != isDepartureObjectSkipped.begin( ) + departureObjectIndexEnd )
+        {
+            departureBlockIndices.push_back( i / tiling.departureBlockSize );
+        }
+    }
+    const unsigned int numberOfDepartureBlocks = departureBlockIndices.size( );
+
+    LambertScannerWorkQueue workQueue( departureBlockIndices, 2 * input.threads );
+
+    // Set up a shortlist per worker thread; these are merged once all workers have completed.
+    std::vector< LambertScannerShortlist > shortlists(
+        input.threads, LambertScannerShortlist( input.shortlistLength ) );
+
+    // Seed shortlist with transfers stored by previous run, if the run is resumed or the database
+    // is updated incrementally.
+    if ( ( input.isResumed || input.isIncremental ) && input.shortlistLength > 0 )
+    {
+        const LambertScannerShortlistEntries storedEntries
+            = fetchLambertScannerShortlist( database, input.shortlistLength );
+        for ( unsigned int i = 0; i < storedEntries.size( ); i++ )
+        {
+            shortlists[ 0 ].insert( storedEntries[ i ] );
+        }
+    }
+    std::vector< LambertScannerStatistics > workerStatistics( input.threads );
+
+    std::vector< std::thread > workers;
+    for ( int i = 0; i < input.threads; i++ )
+    {
+        workers.push_back( std::thread( executeLambertScannerWorker,
+                                        std::cref( input ),
+                                        std::cref( tleObjects ),
+                                        std::cref( epochGrid ),
+                                        std::cref( ephemerides ),
+                                        std::cref( propagators ),
+                                        std::cref( tiling ),
+                                        std::cref( isDepartureObjectSkipped ),
+                                        std::cref( isObjectChanged ),
+                                        std::ref( workQueue ),
+                                        std::ref( shortlists[ i ] ),
+                                        std::ref( workerStatistics[ i ] ) ) );
+    }
+
+    // Loop over buffers of transfers computed for each departure block and populate database.
+    // The calling thread is the only thread that writes to the database.
+    boost::progress_display showProgress( numberOfDepartureBlocks );
+
+    // Store transfer_id of first transfer in each buffer, to recover transfer_id of shortlist
+    // entries.
+    std::vector< long long > firstTransferIds( numberOfDepartureBlocks, 0 );
+
+    try
+    {
+        LambertScannerTransfers transfers;
+        std::vector< double > row;
+        unsigned int queuePosition = 0;
+        int departureObjectsSinceCheckpoint = 0;
+        while ( workQueue.retrieve( transfers ) )
+        {
+            // Transfers in a buffer are written consecutively and so have consecutive IDs.
+            for ( unsigned int i = 0; i < transfers.size( ); i++ )
+            {
+                getLambertScannerTransferRow( transfers[ i ], input.isCompact, row );
+                const long long transferId = resultSink->write( row );
+
+                if ( i == 0 )
+                {
+                    firstTransferIds[ queuePosition ] = transferId;
+                }
+            }
+
+            // Record departure objects in block as completed.
+            const unsigned int departureObjectIndexBegin
+                = departureBlockIndices[ queuePosition ] * tiling.departureBlockSize;
+            const unsigned int departureObjectIndexEnd
+                = std::min( departureObjectIndexBegin + tiling.departureBlockSize,
+                            static_cast< unsigned int >( tleObjects.size( ) ) );
+            for ( unsigned int i = departureObjectIndexBegin;
+                  i < departureObjectIndexEnd && !input.isIncremental;
+                  i++ )
+            {
+                if ( isDepartureObjectSkipped[ i ] )
+                {
+                    continue;
+                }
+
+                progressQuery.bind( ":departure_object_index", static_cast< int >( i ) );
+                progressQuery.bind( ":departure_object_id",
+                                    static_cast< int >( tleObjects[ i ].NoradNumber( ) ) );
+                progressQuery.executeStep( );
+                progressQuery.reset( );
+                ++departureObjectsSinceCheckpoint;
+            }
+
+            // Commit transaction at checkpoint, such that the run can be resumed from here.
+            if ( input.checkpointInterval > 0
+                 && departureObjectsSinceCheckpoint >= input.checkpointInterval )
+            {
+                transaction->commit( );
+                transaction.reset( new SQLite::Transaction( database ) );
+                departureObjectsSinceCheckpoint = 0;
+            }
+
+            ++queuePosition;
+            ++showProgress;
+        }
+    }
+    catch( ... )
+    {
+        // Stop workers before the error is propagated; the transaction is rolled back.
+        workQueue.abort( );
+        for ( unsigned int i = 0; i < workers.size( ); i++ )
+        {
+            workers[ i ].join( );
+        }
+        throw;
+    }
+
+    for ( unsigned int i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+
+    // Once the database is updated incrementally, the transfers of all departure objects in the
+    // shard are up to date.
+    if ( input.isIncremental )
+    {
+        for ( long long i = shardObjectIndexBegin; i < shardObjectIndexEnd; i++ )
+        {
+            progressQuery.bind( ":departure_object_index", static_cast< int >( i ) );
+            progressQuery.bind( ":departure_object_id",
+                                static_cast< int >( tleObjects[ i ].NoradNumber( ) ) );
+            progressQuery.executeStep( );
+            progressQuery.reset( );
+        }
+    }
+
+    // Flush records buffered by result sink, e.g., write column store header.
+    resultSink->close( );
+
+    // Commit transaction.
+    transaction->commit( );
+
+    LambertScannerStatistics statistics;
+    for ( unsigned int i = 0; i < workerStatistics.size( ); i++ )
+    {
+        statistics += workerStatistics[ i ];
+    }
+
+    std::cout << std::endl;
+    std::cout << "Object pairs skipped by pre-screening = " << statistics.pairsScreened
+              << std::endl;
+    std::cout << "Total Lambert transfers computed = " << statistics.transfersComputed
+              << std::endl;
+    std::cout << "Total Lambert iterations executed = " << statistics.lambertIterations
+              << std::endl;
+    if ( input.isGridRefined( ) )
+    {
+        std::cout << "Local deltaV minima refined = " << statistics.gridMinimaRefined
+                  << std::endl;
+    }
+    std::cout << "Transfers rejected by deltaV cut-off = " << statistics.transfersRejectedDeltaV
+              << std::endl;
+    std::cout << "Transfers rejected by periapsis minimum = "
+              << statistics.transfersRejectedPeriapsis << std::endl;
+    std::cout << "Transfers stored = " << resultSink->getNumberOfRecords( ) << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Database populated successfully!" << std::endl;
+    std::cout << std::endl;
+
+    // Create indices once all transfers have been inserted.
+    if ( input.columnStorePath.empty( ) && input.resultSinkSettings.isSQLite( ) )
+    {
+        std::cout << "Creating SQLite database table indices ... " << std::endl;
+        createLambertScannerTableIndices( database );
+        std::cout << "SQLite database table indices created successfully!" << std::endl;
+        std::cout << std::endl;
+    }
+
+    // Check if shortlist file should be created; call function to write output.
+    if ( input.shortlistLength > 0 )
+    {
+        std::cout << "Writing shortlist to file ... " << std::endl;
+        LambertScannerShortlist shortlist( input.shortlistLength );
+        for ( unsigned int i = 0; i < shortlists.size( ); i++ )
+        {
+            shortlist.merge( shortlists[ i ] );
+        }
+
+        LambertScannerShortlistEntries shortlistEntries = shortlist.getSortedEntries( );
+        for ( unsigned int i = 0; i < shortlistEntries.size( ); i++ )
+        {
+            // Entries fetched from the database on resume already have their transfer_id.
+            if ( shortlistEntries[ i ].transferId != 0 )
+            {
+                continue;
+            }
+
+            shortlistEntries[ i ].transferId
+                = firstTransferIds[ shortlistEntries[ i ].queuePosition ]
+                    + shortlistEntries[ i ].bufferIndex;
+        }
+
+        writeTransferShortlist( shortlistEntries, input.shortlistPath );
+        std::cout << "Shortlist file created successfully!" << std::endl;
+    }
+}
+
+//! Compute epoch grid for lambert_scanner.
+LambertScannerEpochGrid computeLambertScannerEpochGrid( const LambertScannerInput& input )
+{
+    return computeLambertScannerEpochGrids( std::vector< LambertScannerInput >( 1, input ) )[ 0 ];
+}
+
+//! Compute shared epoch grids for lambert_scanner.
+std::vector< LambertScannerEpochGrid > computeLambertScannerEpochGrids(
+    const std::vector< LambertScannerInput >& inputs )
+{
+    // Map epochs (in DateTime ticks) to the grid points at which they occur.
+    typedef std::map< long long, DateTime > EpochMap;
+    EpochMap epochMap;
+
+    std::vector< std::vector< DateTime > > departureEpochs( inputs.size( ) );
+    std::vector< std::vector< DateTime > > arrivalEpochs( inputs.size( ) );
+
+    for ( unsigned int i = 0; i < inputs.size( ); i++ )
+    {
+        const LambertScannerInput& input = inputs[ i ];
+        departureEpochs[ i ].resize( input.departureEpochSteps );
+        arrivalEpochs[ i ].resize( input.departureEpochSteps * input.timeOfFlightSteps );
+
+        for ( int m = 0; m < input.departureEpochSteps; ++m )
+        {
+            DateTime departureEpoch = input.departureEpochInitial;
+            departureEpoch = departureEpoch.AddSeconds( input.departureEpochStepSize * m );
+            departureEpochs[ i ][ m ] = departureEpoch;
+            epochMap[ departureEpoch.Ticks( ) ] = departureEpoch;
+
+            for ( int k = 0; k < input.timeOfFlightSteps; k++ )
+            {
+                const double timeOfFlight
+                    = input.timeOfFlightMinimum + k * input.timeOfFlightStepSize;
+                const DateTime arrivalEpoch = departureEpoch.AddSeconds( timeOfFlight );
+                arrivalEpochs[ i ][ m * input.timeOfFlightSteps + k ] = arrivalEpoch;
+                epochMap[ arrivalEpoch.Ticks( ) ] = arrivalEpoch;
+            }
+        }
+    }
+
+    // Assign indices to distinct epochs in chronological order.
+    std::vector< DateTime > epochs;
+    std::map< long long, unsigned int > epochIndices;
+    for ( EpochMap::const_iterator iterator = epochMap.begin( );
+          iterator != epochMap.end( );
+          iterator++ )
+    {
+        epochIndices[ iterator->first ] = epochs.size( );
+        epochs.push_back( iterator->second );
+    }
+
+    std::vector< LambertScannerEpochGrid > epochGrids( inputs.size( ) );
+    for ( unsigned int i = 0; i < inputs.size( ); i++ )
+    {
+        LambertScannerEpochGrid& epochGrid = epochGrids[ i ];
+        epochGrid.epochs = epochs;
+
+        epochGrid.departureEpochIndices.resize( departureEpochs[ i ].size( ) );
+        for ( unsigned int j = 0; j < departureEpochs[ i ].size( ); j++ )
+        {
+            epochGrid.departureEpochIndices[ j ]
+                = epochIndices[ departureEpochs[ i ][ j ].Ticks( ) ];
+        }
+
+        epochGrid.arrivalEpochIndices.resize( arrivalEpochs[ i ].size( ) );
+        for ( unsigned int j = 0; j < arrivalEpochs[ i ].size( ); j++ )
+        {
+            epochGrid.arrivalEpochIndices[ j ]
+                = epochIndices[ arrivalEpochs[ i ][ j ].Ticks( ) ];
+        }
+    }
+
+    return epochGrids;
+}
+
+//! Compute tiling of lambert_scanner departure-arrival iteration space.
+LambertScannerTiling computeLambertScannerTiling( const LambertScannerInput& input,
+                                                  const unsigned int numberOfObjects,
+                                                  const unsigned int numberOfEpochs )
+{
+    unsigned int arrivalBlockSize = input.arrivalBlockSize;
+    if ( arrivalBlockSize == 0 )
+    {
+        // Size arrival blocks such that the state vectors and Keplerian elements (12 doubles per
+        // object and epoch) of an arrival block occupy half of the L2 cache, leaving the other
+        // half for the departure objects and the Lambert targeter.
+        long cacheSize = 0;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        cacheSize = sysconf( _SC_LEVEL2_CACHE_SIZE );
+#endif
+        if ( cacheSize <= 0 )
+        {
+            cacheSize = 256 * 1024;
+        }
+
+        const unsigned long objectSize = 12 * sizeof( double ) * std::max( numberOfEpochs, 1u );
+        arrivalBlockSize = std::max( 1ul, ( cacheSize / 2 ) / objectSize );
+    }
+
+    unsigned int departureBlockSize = input.departureBlockSize;
+    if ( departureBlockSize == 0 )
+    {
+        // Keep at least four departure blocks per worker thread to balance load.
+        departureBlockSize
+            = std::max( 1u, std::min( 4u, numberOfObjects / ( 4 * input.threads ) ) );
+    }
+
+    return LambertScannerTiling( departureBlockSize,
+                                 std::min( arrivalBlockSize, std::max( numberOfObjects, 1u ) ) );
+}
+
+//! Compute tiles of lambert_scanner departure block.
+LambertScannerTiles computeLambertScannerTiles( const LambertScannerTiling& tiling,
+                                                const unsigned int departureBlockIndex,
+                                                const unsigned int numberOfObjects )
+{
+    const unsigned int departureObjectIndexBegin = departureBlockIndex * tiling.departureBlockSize;
+    const unsigned int departureObjectIndexEnd
+        = std::min( departureObjectIndexBegin + tiling.departureBlockSize, numberOfObjects );
+
+    LambertScannerTiles tiles;
+    for ( unsigned int arrivalObjectIndexBegin = 0;
+          arrivalObjectIndexBegin < numberOfObjects;
+          arrivalObjectIndexBegin += tiling.arrivalBlockSize )
+    {
+        tiles.push_back( LambertScannerTile(
+            departureObjectIndexBegin,
+            departureObjectIndexEnd,
+            arrivalObjectIndexBegin,
+            std::min( arrivalObjectIndexBegin + tiling.arrivalBlockSize, numberOfObjects ) ) );
+    }
+
+    return tiles;
+}
+
+//! Compute Lambert transfers for departure object.
+void computeLambertScannerTransfers( const LambertScannerInput& input,
+                                     const TleObjects& tleObjects,
+                                     const LambertScannerEpochGrid& epochGrid,
+                                     const EphemerisTable& ephemerides,
+                                     const std::vector< SGP4 >& propagators,
+                                     const unsigned int departureObjectIndex,
+                                     const unsigned int arrivalObjectIndexBegin,
+                                     const unsigned int arrivalObjectIndexEnd,
+                                     LambertScannerWorkspace& workspace,
+                                     LambertScannerTransfers& transfers,
+                                     LambertScannerStatistics& statistics )
+{
+    // Set gravitational parameter used by Lambert targeter.
+    const double earthGravitationalParameter = kMU;
+
+    const Tle& departureObject = tleObjects[ departureObjectIndex ];
+    const int departureObjectId = static_cast< int >( departureObject.NoradNumber( ) );
+
+    // Loop over arrival objects.
+    for ( unsigned int j = arrivalObjectIndexBegin; j < arrivalObjectIndexEnd; j++ )
+    {
+        // Skip the case of the departure and arrival objects being the same.
+        if ( departureObjectIndex == j )
+        {
+            continue;
+        }
+
+        // Skip pair if estimated transfer Delta-V exceeds screening cut-off at all departure
+        // epochs.
+        if ( input.pairScreeningCutoff > 0.0 )
+        {
+            bool isScreened = true;
+            for ( int m = 0; m < input.departureEpochSteps && isScreened; ++m )
+            {
+                const unsigned int departureEpochIndex = epochGrid.departureEpochIndices[ m ];
+                const double transferDeltaVEstimate = estimateTransferDeltaV(
+                    ephemerides.getState( departureObjectIndex, departureEpochIndex ),
+                    ephemerides.getState( j, departureEpochIndex ),
+                    earthGravitationalParameter );
+                isScreened = transferDeltaVEstimate > input.pairScreeningCutoff;
+            }
+
+            if ( isScreened )
+            {
+                ++statistics.pairsScreened;
+                continue;
+            }
+        }
+
+        const Tle& arrivalObject = tleObjects[ j ];
+        const int arrivalObjectId = static_cast< int >( arrivalObject.NoradNumber( ) );
+
+        // Loop over departure epoch grid.
+        for ( int m = 0; m < input.departureEpochSteps; ++m )
+        {
+            const unsigned int departureEpochIndex = epochGrid.departureEpochIndices[ m ];
+            const DateTime& departureEpoch = epochGrid.epochs[ departureEpochIndex ];
+
+            // Look up departure state and Keplerian elements in ephemeris table.
+            const Vector6 departureState
+                = ephemerides.getState( departureObjectIndex, departureEpochIndex );
+
+            Vector3 departurePosition;
+            std::copy( departureState.begin( ),
+                       departureState.begin( ) + 3,
+                       departurePosition.begin( ) );
+
+            const Vector6 departureStateKepler
+                = ephemerides.getStateKepler( departureObjectIndex, departureEpochIndex );
+
+            // Set up batch of Lambert problems along time-of-flight grid, which share the
+            // departure position.
+            for ( int k = 0; k < input.timeOfFlightSteps; k++ )
+            {
+                const unsigned int arrivalEpochIndex
+                    = epochGrid.arrivalEpochIndices[ m * input.timeOfFlightSteps + k ];
+                const Vector6 arrivalState = ephemerides.getState( j, arrivalEpochIndex );
+
+                workspace.departurePositions[ k ] = departurePosition;
+                std::copy( arrivalState.begin( ),
+                           arrivalState.begin( ) + 3,
+                           workspace.arrivalPositions[ k ].begin( ) );
+                workspace.timesOfFlight[ k ]
+                    = input.timeOfFlightMinimum + k * input.timeOfFlightStepSize;
+            }
+
+            // Solve batch for each transfer direction, using the same ephemerides.
+            for ( int d = 0; d < input.getNumberOfDirections( ); d++ )
+            {
+                const bool isPrograde = input.isDirectionPrograde( d );
+
+                workspace.targeter.solve( workspace.departurePositions,
+                                          workspace.arrivalPositions,
+                                          workspace.timesOfFlight,
+                                          earthGravitationalParameter,
+                                          !isPrograde,
+                                          input.isWarmStarted );
+                statistics.transfersComputed += workspace.targeter.getNumberOfProblems( );
+                statistics.lambertIterations += workspace.targeter.getNumberOfIterations( );
+
+                // Loop over time-of-flight grid.
+                for ( int k = 0; k < input.timeOfFlightSteps; k++ )
+                {
+                    const double timeOfFlight = workspace.timesOfFlight[ k ];
+
+                    // Look up arrival state and Keplerian elements in ephemeris table.
+                    const unsigned int arrivalEpochIndex
+                        = epochGrid.arrivalEpochIndices[ m * input.timeOfFlightSteps + k ];
+                    const Vector6 arrivalState = ephemerides.getState( j, arrivalEpochIndex );
+                    const Vector6 arrivalStateKepler
+                        = ephemerides.getStateKepler( j, arrivalEpochIndex );
+
+                    // Compute Delta-Vs for transfer and determine index of lowest.
+                    const int minimumDeltaVIndex = selectLambertScannerSolution(
+                        input, workspace.targeter, k, departureState, arrivalState, workspace );
+                    const double minimumDeltaV = workspace.transferDeltaVs[ minimumDeltaVIndex ];
+
+                    // If the grid is refined adaptively, the grid point is only used to locate the
+                    // local minima.
+                    if ( input.isGridRefined( ) )
+                    {
+                        workspace.gridDeltaVs[ d ][ m * input.timeOfFlightSteps + k ]
+                            = minimumDeltaV;
+                        continue;
+                    }
+
+                    if ( minimumDeltaV == std::numeric_limits< double >::infinity( ) )
+                    {
+                        ++statistics.transfersRejectedPeriapsis;
+                        continue;
+                    }
+
+                    if ( input.transferDeltaVCutoff > 0.0
+                         && minimumDeltaV > input.transferDeltaVCutoff )
+                    {
+                        ++statistics.transfersRejectedDeltaV;
+                        continue;
+                    }
+
+                    const int revolutions = std::floor( ( minimumDeltaVIndex + 1 ) / 2 );
+
+                    Vector6 transferState;
+                    std::copy( departurePosition.begin( ),
+                               departurePosition.begin( ) + 3,
+                               transferState.begin( ) );
+                    const Vector3 transferDepartureVelocity
+                        = workspace.targeter.getDepartureVelocity( k, minimumDeltaVIndex );
+                    std::copy( transferDepartureVelocity.begin( ),
+                               transferDepartureVelocity.end( ),
+                               transferState.begin( ) + 3 );
+
+                    const Vector6 transferStateKepler
+                        = astro::convertCartesianToKeplerianElements( transferState,
+                                                                      earthGravitationalParameter );
+
+                    // Store transfer in buffer.
+                    LambertScannerTransfer transfer;
+                    transfer.departureObjectId      = departureObjectId;
+                    transfer.arrivalObjectId        = arrivalObjectId;
+                    transfer.departureEpoch         = departureEpoch.ToJulian( );
+                    transfer.timeOfFlight           = timeOfFlight;
+                    transfer.revolutions            = revolutions;
+                    transfer.isPrograde             = isPrograde;
+                    transfer.departureState         = departureState;
+                    transfer.departureStateKepler   = departureStateKepler;
+                    transfer.arrivalState           = arrivalState;
+                    transfer.arrivalStateKepler     = arrivalStateKepler;
+                    transfer.transferStateKepler    = transferStateKepler;
+                    transfer.departureDeltaV
+                        = workspace.departureDeltaVs[ minimumDeltaVIndex ];
+                    transfer.arrivalDeltaV
+                        = workspace.arrivalDeltaVs[ minimumDeltaVIndex ];
+                    transfer.transferDeltaV         = minimumDeltaV;
+                    transfers.push_back( transfer );
+                }
+            }
+        }
+
+        if ( !input.isGridRefined( ) )
+        {
+            continue;
+        }
+
+        // Refine local minima of coarse grid per transfer direction and store refined transfers.
+        const int timeOfFlightSteps = static_cast< int >( std::ceil( input.timeOfFlightSteps ) );
+        const SGP4& departureSgp4 = propagators[ departureObjectIndex ];
+        const SGP4& arrivalSgp4 = propagators[ j ];
+
+        for ( int d = 0; d < input.getNumberOfDirections( ); d++ )
+        {
+            const bool isPrograde = input.isDirectionPrograde( d );
+
+            findLambertScannerGridMinima(
+                workspace.gridDeltaVs[ d ],
+                static_cast< int >( std::ceil( input.departureEpochSteps ) ),
+                timeOfFlightSteps,
+                workspace.gridMinimumIndices );
+            workspace.refinedGridPoints.clear( );
+
+            for ( unsigned int n = 0; n < workspace.gridMinimumIndices.size( ); n++ )
+            {
+                const int gridIndex = workspace.gridMinimumIndices[ n ];
+                const int m = gridIndex / timeOfFlightSteps;
+                const int k = gridIndex % timeOfFlightSteps;
+                double departureEpochOffset = m * input.departureEpochStepSize;
+                double timeOfFlight = input.timeOfFlightMinimum + k * input.timeOfFlightStepSize;
+                double transferDeltaV = workspace.gridDeltaVs[ d ][ gridIndex ];
+
+                refineLambertScannerGridMinimum( input,
+                                                 isPrograde,
+                                                 departureSgp4,
+                                                 arrivalSgp4,
+                                                 departureEpochOffset,
+                                                 timeOfFlight,
+                                                 transferDeltaV,
+                                                 workspace,
+                                                 statistics );
+                ++statistics.gridMinimaRefined;
+
+                // Skip refined optimum if another local minimum converged to the same grid point.
+                const std::pair< double, double > refinedGridPoint( departureEpochOffset,
+                                                                    timeOfFlight );
+                if ( std::find( workspace.refinedGridPoints.begin( ),
+                                workspace.refinedGridPoints.end( ),
+                                refinedGridPoint ) != workspace.refinedGridPoints.end( ) )
+                {
+                    continue;
+                }
+                workspace.refinedGridPoints.push_back( refinedGridPoint );
+
+                const double minimumDeltaV = transferDeltaV;
+                const int minimumDeltaVIndex = workspace.refinementSolutionIndices[ 0 ];
+
+                if ( minimumDeltaV == std::numeric_limits< double >::infinity( ) )
+                {
+                    ++statistics.transfersRejectedPeriapsis;
+                    continue;
+                }
+
+                if ( input.transferDeltaVCutoff > 0.0
+                     && minimumDeltaV > input.transferDeltaVCutoff )
+                {
+                    ++statistics.transfersRejectedDeltaV;
+                    continue;
+                }
+
+                const Vector6& departureState = workspace.refinementDepartureStates[ 0 ];
+                const Vector6& arrivalState = workspace.refinementArrivalStates[ 0 ];
+
+                Vector6 transferState = departureState;
+                const Vector3 transferDepartureVelocity
+                    = workspace.refinementTargeter.getDepartureVelocity( 0, minimumDeltaVIndex );
+                std::copy( transferDepartureVelocity.begin( ),
+                           transferDepartureVelocity.end( ),
+                           transferState.begin( ) + 3 );
+
+                DateTime departureEpoch = input.departureEpochInitial;
+                departureEpoch = departureEpoch.AddSeconds( departureEpochOffset );
+
+                // Store refined transfer in buffer.
+                LambertScannerTransfer transfer;
+                transfer.departureObjectId      = departureObjectId;
+                transfer.arrivalObjectId        = arrivalObjectId;
+                transfer.departureEpoch         = departureEpoch.ToJulian( );
+                transfer.timeOfFlight           = timeOfFlight;
+                transfer.revolutions            = std::floor( ( minimumDeltaVIndex + 1 ) / 2 );
+                transfer.isPrograde             = isPrograde;
+                transfer.departureState         = departureState;
+                transfer.departureStateKepler   = astro::convertCartesianToKeplerianElements(
+                    departureState, earthGravitationalParameter );
+                transfer.arrivalState           = arrivalState;
+                transfer.arrivalStateKepler     = astro::convertCartesianToKeplerianElements(
+                    arrivalState, earthGravitationalParameter );
+                transfer.transferStateKepler    = astro::convertCartesianToKeplerianElements(
+                    transferState, earthGravitationalParameter );
+                transfer.departureDeltaV
+                    = workspace.departureDeltaVs[ minimumDeltaVIndex ];
+                transfer.arrivalDeltaV          = workspace.arrivalDeltaVs[ minimumDeltaVIndex ];
+                transfer.transferDeltaV         = minimumDeltaV;
+                transfers.push_back( transfer );
+            }
+        }
+    }
+}
+
+//! Select lowest Delta-V solution of Lambert problem.
+int selectLambertScannerSolution( const LambertScannerInput& input,
+                                  const LambertBatchTargeter& targeter,
+                                  const int problemIndex,
+                                  const Vector6& departureState,
+                                  const Vector6& arrivalState,
+                                  LambertScannerWorkspace& workspace )
+{
+    // Set gravitational parameter used by Lambert targeter.
+    const double earthGravitationalParameter = kMU;
+
+    Vector3 departurePosition;
+    std::copy( departureState.begin( ), departureState.begin( ) + 3, departurePosition.begin( ) );
+
+    Vector3 departureVelocity;
+    std::copy( departureState.begin( ) + 3, departureState.end( ), departureVelocity.begin( ) );
+
+    Vector3 arrivalVelocity;
+    std::copy( arrivalState.begin( ) + 3, arrivalState.end( ), arrivalVelocity.begin( ) );
+
+    const int numberOfSolutions = targeter.getNumberOfSolutions( problemIndex );
+
+    for ( int i = 0; i < numberOfSolutions; i++ )
+    {
+        // Compute Delta-V for transfer.
+        const Vector3 transferDepartureVelocity
+            = targeter.getDepartureVelocity( problemIndex, i );
+        const Vector3 transferArrivalVelocity = targeter.getArrivalVelocity( problemIndex, i );
+
+        workspace.departureDeltaVs[ i ]
+            = sml::add( transferDepartureVelocity, sml::multiply( departureVelocity, -1.0 ) );
+        workspace.arrivalDeltaVs[ i ]
+            = sml::add( arrivalVelocity, sml::multiply( transferArrivalVelocity, -1.0 ) );
+
+        workspace.transferDeltaVs[ i ]
+            = sml::norm< double >( workspace.departureDeltaVs[ i ] )
+                + sml::norm< double >( workspace.arrivalDeltaVs[ i ] );
+    }
+
+    // Discard solutions for which the transfer orbit dips below the minimum periapsis radius, by
+    // setting their Delta-V to infinity.
+    if ( input.transferPeriapsisRadiusMinimum > 0.0 )
+    {
+        for ( int i = 0; i < numberOfSolutions; i++ )
+        {
+            const double transferPeriapsisRadius
+                = computePeriapsisRadius( departurePosition,
+                                          targeter.getDepartureVelocity( problemIndex, i ),
+                                          earthGravitationalParameter );
+            if ( transferPeriapsisRadius < input.transferPeriapsisRadiusMinimum )
+            {
+                workspace.transferDeltaVs[ i ] = std::numeric_limits< double >::infinity( );
+            }
+        }
+    }
+
+    return std::distance( workspace.transferDeltaVs.begin( ),
+                          std::min_element( workspace.transferDeltaVs.begin( ),
+                                            workspace.transferDeltaVs.begin( )
+                                                + numberOfSolutions ) );
+}
+
+//! Find local minima of lambert_scanner grid.
+void findLambertScannerGridMinima( const std::vector< double >& gridDeltaVs,
+                                   const int departureEpochSteps,
+                                   const int timeOfFlightSteps,
+                                   std::vector< int >& minimumIndices )
+{
+    minimumIndices.clear( );
+
+    for ( int m = 0; m < departureEpochSteps; m++ )
+    {
+        for ( int k = 0; k < timeOfFlightSteps; k++ )
+        {
+            const int index = m * timeOfFlightSteps + k;
+            const double deltaV = gridDeltaVs[ index ];
+            if ( deltaV == std::numeric_limits< double >::infinity( ) )
+            {
+                continue;
+            }
+
+            // Neighbours preceding the grid point in row-major order must be strictly larger,
+            // such that only the first grid point of a plateau is a local minimum.
+            bool isMinimum = true;
+            for ( int p = std::max( m - 1, 0 );
+                  p <= std::min( m + 1, departureEpochSteps - 1 ) && isMinimum;
+                  p++ )
+            {
+                for ( int q = std::max( k - 1, 0 );
+                      q <= std::min( k + 1, timeOfFlightSteps - 1 ) && isMinimum;
+                      q++ )
+                {
+                    const int neighbourIndex = p * timeOfFlightSteps + q;
+                    if ( neighbourIndex < index )
+                    {
+                        isMinimum = gridDeltaVs[ neighbourIndex ] > deltaV;
+                    }
+
+                    else if ( neighbourIndex > index )
+                    {
+                        isMinimum = gridDeltaVs[ neighbourIndex ] >= deltaV;
+                    }
+                }
+            }
+
+            if ( isMinimum )
+            {
+                minimumIndices.push_back( index );
+            }
+        }
+    }
+}
+
+//! Compute lowest Delta-V at lambert_scanner refinement points.
+void computeLambertScannerRefinementDeltaVs( const LambertScannerInput& input,
+                                             const bool isPrograde,
+                                             const SGP4& departureSgp4,
+                                             const SGP4& arrivalSgp4,
+                                             LambertScannerWorkspace& workspace,
+                                             LambertScannerStatistics& statistics )
+{
+    // Set gravitational parameter used by Lambert targeter.
+    const double earthGravitationalParameter = kMU;
+
+    const unsigned int numberOfPoints = workspace.refinementTimesOfFlight.size( );
+    workspace.refinementDeparturePositions.resize( numberOfPoints );
+    workspace.refinementArrivalPositions.resize( numberOfPoints );
+    workspace.refinementDepartureStates.resize( numberOfPoints );
+    workspace.refinementArrivalStates.resize( numberOfPoints );
+    workspace.refinementDeltaVs.resize( numberOfPoints );
+    workspace.refinementSolutionIndices.resize( numberOfPoints );
+
+    // Propagate departure and arrival objects to refinement points.
+    for ( unsigned int i = 0; i < numberOfPoints; i++ )
+    {
+        DateTime departureEpoch = input.departureEpochInitial;
+        departureEpoch
+            = departureEpoch.AddSeconds( workspace.refinementDepartureEpochOffsets[ i ] );
+        const DateTime arrivalEpoch
+            = departureEpoch.AddSeconds( workspace.refinementTimesOfFlight[ i ] );
+
+        workspace.refinementDepartureStates[ i ]
+            = getStateVector( departureSgp4.FindPosition( departureEpoch ) );
+        workspace.refinementArrivalStates[ i ]
+            = getStateVector( arrivalSgp4.FindPosition( arrivalEpoch ) );
+
+        std::copy( workspace.refinementDepartureStates[ i ].begin( ),
+                   workspace.refinementDepartureStates[ i ].begin( ) + 3,
+                   workspace.refinementDeparturePositions[ i ].begin( ) );
+        std::copy( workspace.refinementArrivalStates[ i ].begin( ),
+                   workspace.refinementArrivalStates[ i ].begin( ) + 3,
+                   workspace.refinementArrivalPositions[ i ].begin( ) );
+    }
+
+    workspace.refinementTargeter.solve( workspace.refinementDeparturePositions,
+                                        workspace.refinementArrivalPositions,
+                                        workspace.refinementTimesOfFlight,
+                                        earthGravitationalParameter,
+                                        !isPrograde );
+    statistics.transfersComputed += workspace.refinementTargeter.getNumberOfProblems( );
+    statistics.lambertIterations += workspace.refinementTargeter.getNumberOfIterations( );
+
+    for ( unsigned int i = 0; i < numberOfPoints; i++ )
+    {
+        workspace.refinementSolutionIndices[ i ]
+            = selectLambertScannerSolution( input,
+                                            workspace.refinementTargeter,
+                                            i,
+                                            workspace.refinementDepartureStates[ i ],
+                                            workspace.refinementArrivalStates[ i ],
+                                            workspace );
+        workspace.refinementDeltaVs[ i ]
+            = workspace.transferDeltaVs[ workspace.refinementSolutionIndices[ i ] ];
+    }
+}
+
+//! Refine local minimum of lambert_scanner grid.
+void refineLambertScannerGridMinimum( const LambertScannerInput& input,
+                                      const bool isPrograde,
+                                      const SGP4& departureSgp4,
+                                      const SGP4& arrivalSgp4,
+                                      double& departureEpochOffset,
+                                      double& timeOfFlight,
+                                      double& transferDeltaV,
+                                      LambertScannerWorkspace& workspace,
+                                      LambertScannerStatistics& statistics )
+{
+    const double departureEpochRange = input.departureEpochSteps * input.departureEpochStepSize;
+
+    double departureEpochStepSize = input.departureEpochStepSize;
+    double timeOfFlightStepSize = input.timeOfFlightStepSize;
+
+    while ( departureEpochStepSize > input.departureEpochResolution
+            || timeOfFlightStepSize > input.timeOfFlightResolution )
+    {
+        departureEpochStepSize
+            = std::max( departureEpochStepSize / 2.0, input.departureEpochResolution );
+        timeOfFlightStepSize = std::max( timeOfFlightStepSize / 2.0, input.timeOfFlightResolution );
+
+        // Set up the eight points surrounding the current optimum that lie within the grid.
+        workspace.refinementDepartureEpochOffsets.clear( );
+        workspace.refinementTimesOfFlight.clear( );
+        for ( int p = -1; p <= 1; p++ )
+        {
+            for ( int q = -1; q <= 1; q++ )
+            {
+                const double pointDepartureEpochOffset
+                    = departureEpochOffset + p * departureEpochStepSize;
+                const double pointTimeOfFlight = timeOfFlight + q * timeOfFlightStepSize;
+                if ( ( p == 0 && q == 0 )
+                     || pointDepartureEpochOffset < 0.0
+                     || pointDepartureEpochOffset > departureEpochRange
+                     || pointTimeOfFlight < input.timeOfFlightMinimum
+                     || pointTimeOfFlight > input.timeOfFlightMaximum )
+                {
+                    continue;
+                }
+
+                workspace.refinementDepartureEpochOffsets.push_back( pointDepartureEpochOffset );
+                workspace.refinementTimesOfFlight.push_back( pointTimeOfFlight );
+            }
+        }
+
+        if ( workspace.refinementTimesOfFlight.empty( ) )
+        {
+            continue;
+        }
+
+        computeLambertScannerRefinementDeltaVs(
+            input, isPrograde, departureSgp4, arrivalSgp4, workspace, statistics );
+
+        // The optimum is only moved if a surrounding point is strictly better.
+        for ( unsigned int i = 0; i < workspace.refinementDeltaVs.size( ); i++ )
+        {
+            if ( workspace.refinementDeltaVs[ i ] < transferDeltaV )
+            {
+                transferDeltaV = workspace.refinementDeltaVs[ i ];
+                departureEpochOffset = workspace.refinementDepartureEpochOffsets[ i ];
+                timeOfFlight = workspace.refinementTimesOfFlight[ i ];
+            }
+        }
+    }
+
+    // Evaluate refined optimum, such that its solutions are available in the workspace.
+    workspace.refinementDepartureEpochOffsets.assign( 1, departureEpochOffset );
+    workspace.refinementTimesOfFlight.assign( 1, timeOfFlight );
+    computeLambertScannerRefinementDeltaVs(
+        input, isPrograde, departureSgp4, arrivalSgp4, workspace, statistics );
+    transferDeltaV = workspace.refinementDeltaVs[ 0 ];
+}
+
+//! Execute lambert_scanner worker.
+void executeLambertScannerWorker( const LambertScannerInput& input,
+                                  const TleObjects& tleObjects,
+                                  const LambertScannerEpochGrid& epochGrid,
+                                  const EphemerisTable& ephemerides,
+                                  const std::vector< SGP4 >& propagators,
+                                  const LambertScannerTiling& tiling,
+                                  const std::vector< bool >& isDepartureObjectSkipped,
+                                  const std::vector< bool >& isObjectChanged,
+                                  LambertScannerWorkQueue& workQueue,
+                                  LambertScannerShortlist& shortlist,
+                                  LambertScannerStatistics& statistics )
+{
+    try
+    {
+        const unsigned int numberOfObjects = tleObjects.size( );
+
+        // Workspace that Lambert problems are solved in, reused across all grid points.
+        LambertScannerWorkspace workspace(
+            static_cast< int >( std::ceil( input.departureEpochSteps ) ),
+            static_cast< int >( std::ceil( input.timeOfFlightSteps ) ),
+            input.revolutionsMaximum );
+
+        LambertScannerTransfers transfers;
+        std::vector< LambertScannerTransfers > departureObjectTransfers(
+            tiling.departureBlockSize );
+        unsigned int departureBlockIndex = 0;
+        unsigned int queuePosition = 0;
+
+        while ( workQueue.claim( departureBlockIndex, queuePosition ) )
+        {
+            for ( unsigned int i = 0; i < departureObjectTransfers.size( ); i++ )
+            {
+                departureObjectTransfers[ i ].clear( );
+            }
+
+            // Loop over tiles: each arrival block is paired with all departure objects in the
+            // departure block while its ephemerides are in cache.
+            const LambertScannerTiles tiles
+                = computeLambertScannerTiles( tiling, departureBlockIndex, numberOfObjects );
+            for ( unsigned int k = 0; k < tiles.size( ); k++ )
+            {
+                const LambertScannerTile& tile = tiles[ k ];
+
+                for ( unsigned int i = tile.departureObjectIndexBegin;
+                      i < tile.departureObjectIndexEnd;
+                      i++ )
+                {
+                    if ( isDepartureObjectSkipped[ i ] )
+                    {
+                        continue;
+                    }
+
+                    if ( isObjectChanged.empty( ) || isObjectChanged[ i ] )
+                    {
+                        computeLambertScannerTransfers(
+                            input,
+                            tleObjects,
+                            epochGrid,
+                            ephemerides,
+                            propagators,
+                            i,
+                            tile.arrivalObjectIndexBegin,
+                            tile.arrivalObjectIndexEnd,
+                            workspace,
+                            departureObjectTransfers[ i - tile.departureObjectIndexBegin ],
+                            statistics );
+                        continue;
+                    }
+
+                    // The transfers of an unchanged departure object are only recomputed for
+                    // changed arrival objects.
+                    for ( unsigned int j = tile.arrivalObjectIndexBegin;
+                          j < tile.arrivalObjectIndexEnd;
+                          j++ )
+                    {
+                        if ( !isObjectChanged[ j ] )
+                        {
+                            continue;
+                        }
+
+                        computeLambertScannerTransfers(
+                            input,
+                            tleObjects,
+                            epochGrid,
+                            ephemerides,
+                            propagators,
+                            i,
+                            j,
+                            j + 1,
+                            workspace,
+                            departureObjectTransfers[ i - tile.departureObjectIndexBegin ],
+                            statistics );
+                    }
+                }
+            }
+
+            // Concatenate transfers in departure object order, so that the order of the output
+            // does not depend on the tile size.
+            for ( unsigned int i = 0; i < departureObjectTransfers.size( ); i++ )
+            {
+                transfers.insert( transfers.end( ),
+                                  departureObjectTransfers[ i ].begin( ),
+                                  departureObjectTransfers[ i ].end( ) );
+            }
+
+            // Retain transfers with lowest Delta-V in shortlist. Transfers are visited in
+            // increasing queue position and buffer index.
+            for ( unsigned int i = 0; i < transfers.size( ); i++ )
+            {
+                if ( shortlist.isImprovedBy( transfers[ i ].transferDeltaV ) )
+                {
+                    shortlist.insert(
+                        LambertScannerShortlistEntry( transfers[ i ], queuePosition, i ) );
+                }
+            }
+            workQueue.submit( queuePosition, transfers );
+        }
+    }
+    catch( ... )
+    {
+        workQueue.fail( std::current_exception( ) );
+    }
+}
+
+//! Get row of values of Lambert transfer.
+void getLambertScannerTransferRow( const LambertScannerTransfer& transfer,
+                                   const bool isCompact,
+                                   std::vector< double >& row )
+{
+    row.clear( );
+    row.push_back( transfer.departureObjectId );
+    row.push_back( transfer.arrivalObjectId );
+    row.push_back( transfer.departureEpoch );
+    row.push_back( transfer.timeOfFlight );
+    row.push_back( transfer.revolutions );
+    row.push_back( transfer.isPrograde ? 1.0 : 0.0 );
+
+    // State vectors and Keplerian elements are omitted in the compact schema.
+    if ( !isCompact )
+    {
+        row.insert( row.end( ), transfer.departureState.begin( ), transfer.departureState.end( ) );
+        row.insert( row.end( ),
+                    transfer.departureStateKepler.begin( ),
+                    transfer.departureStateKepler.end( ) );
+        row.insert( row.end( ), transfer.arrivalState.begin( ), transfer.arrivalState.end( ) );
+        row.insert( row.end( ),
+                    transfer.arrivalStateKepler.begin( ),
+                    transfer.arrivalStateKepler.end( ) );
+        row.insert( row.end( ),
+                    transfer.transferStateKepler.begin( ),
+                    transfer.transferStateKepler.end( ) );
+    }
+
+    row.insert( row.end( ), transfer.departureDeltaV.begin( ), transfer.departureDeltaV.end( ) );
+    row.insert( row.end( ), transfer.arrivalDeltaV.begin( ), transfer.arrivalDeltaV.end( ) );
+    row.push_back( transfer.transferDeltaV );
+}
+
+//! Construct work queue.
+LambertScannerWorkQueue::LambertScannerWorkQueue(
+    const std::vector< unsigned int >& someDepartureBlockIndices,
+    const unsigned int aMaximumBuffersInFlight )
+    : departureBlockIndices( someDepartureBlockIndices ),
+      maximumBuffersInFlight( aMaximumBuffersInFlight ),
+      nextClaimPosition( 0 ),
+      nextRetrievePosition( 0 ),
+      isAborted( false )
+{ }
+
+//! Claim next departure block.
+bool LambertScannerWorkQueue::claim( unsigned int& departureBlockIndex,
+                                     unsigned int& queuePosition )
+{
+    std::unique_lock< std::mutex > lock( queueMutex );
+
+    // Wait until the writer has caught up, so that the number of buffers in flight is bounded.
+    // The buffer the writer is waiting for has always been claimed already, so this can't block
+    // the writer.
+    while ( !isAborted
+            && nextClaimPosition < departureBlockIndices.size( )
+            && nextClaimPosition - nextRetrievePosition >= maximumBuffersInFlight )
+    {
+        claimCondition.wait( lock );
+    }
+
+    if ( isAborted || nextClaimPosition >= departureBlockIndices.size( ) )
+    {
+        return false;
+    }
+
+    queuePosition = nextClaimPosition;
+    departureBlockIndex = departureBlockIndices[ nextClaimPosition ];
+    nextClaimPosition++;
+    return true;
+}
+
+//! Submit buffer of transfers.
+void LambertScannerWorkQueue::submit( const unsigned int queuePosition,
+                                      LambertScannerTransfers& transfers )
+{
+    {
+        std::lock_guard< std::mutex > lock( queueMutex );
+        submittedBuffers[ queuePosition ].swap( transfers );
+    }
+    transfers.clear( );
+    submitCondition.notify_all( );
+}
+
+//! Retrieve next buffer of transfers.
+bool LambertScannerWorkQueue::retrieve( LambertScannerTransfers& transfers )
+{
+    std::unique_lock< std::mutex > lock( queueMutex );
+
+    if ( nextRetrievePosition >= departureBlockIndices.size( ) )
+    {
+        return false;
+    }
+
+    std::map< unsigned int, LambertScannerTransfers >::iterator buffer
+        = submittedBuffers.find( nextRetrievePosition );
+    while ( !workerError && buffer == submittedBuffers.end( ) )
+    {
+        submitCondition.wait( lock );
+        buffer = submittedBuffers.find( nextRetrievePosition );
+    }
+
+    if ( workerError )
+    {
+        std::rethrow_exception( workerError );
+    }
+
+    transfers.swap( buffer->second );
+    submittedBuffers.erase( buffer );
+    nextRetrievePosition++;
+
+    lock.unlock( );
+    claimCondition.notify_all( );
+    return true;
+}
+
+//! Report error from worker thread.
+void LambertScannerWorkQueue::fail( const std::exception_ptr error )
+{
+    {
+        std::lock_guard< std::mutex > lock( queueMutex );
+        if ( !workerError )
+        {
+            workerError = error;
+        }
+        isAborted = true;
+    }
+    claimCondition.notify_all( );
+    submitCondition.notify_all( );
+}
+
+//! Abort queue.
+void LambertScannerWorkQueue::abort( )
+{
+    {
+        std::lock_guard< std::mutex > lock( queueMutex );
+        isAborted = true;
+    }
+    claimCondition.notify_all( );
+}
+
+//! Check lambert_scanner input parameters.
+LambertScannerInput checkLambertScannerInput( const rapidjson::Document& config )
+{
+    const std::string catalogPath = find( config, "catalog" )->value.GetString( );
+    std::cout << "Catalog                       " << catalogPath << std::endl;
+
+    const std::string databasePath = find( config, "database" )->value.GetString( );
+    std::cout << "Database                      " << databasePath << std::endl;
+
+    const ConfigIterator departureEpochIterator = find( config, "departure_epoch" );
+    std::map< std::string, int > departureEpochElements;
+    if ( departureEpochIterator->value.Size( ) == 0 )
+    {
+        DateTime dummyEpoch;
+        departureEpochElements[ "year" ]    = dummyEpoch.Year( );
+        departureEpochElements[ "month" ]   = dummyEpoch.Month( );
+        departureEpochElements[ "day" ]     = dummyEpoch.Day( );
+        departureEpochElements[ "hours" ]   = dummyEpoch.Hour( );
+        departureEpochElements[ "minutes" ] = dummyEpoch.Minute( );
+        departureEpochElements[ "seconds" ] = dummyEpoch.Second( );
+    }
+
+    else
+    {
+        departureEpochElements[ "year" ]    = departureEpochIterator->value[ 0 ].GetInt( );
+        departureEpochElements[ "month" ]   = departureEpochIterator->value[ 1 ].GetInt( );
+        departureEpochElements[ "day" ]     = departureEpochIterator->value[ 2 ].GetInt( );
+
+        if ( departureEpochIterator->value.Size( ) > 3 )
+        {
+            departureEpochElements[ "hours" ] = departureEpochIterator->value[ 3 ].GetInt( );
+
+            if ( departureEpochIterator->value.Size( ) > 4 )
+            {
+                departureEpochElements[ "minutes" ] = departureEpochIterator->value[ 4 ].GetInt( );
+
+                if ( departureEpochIterator->value.Size( ) > 5 )
+                {
+                    departureEpochElements[ "seconds" ]
+                        = departureEpochIterator->value[ 5 ].GetInt( );
+                }
+            }
+        }
+    }
+
+    const DateTime departureEpoch( departureEpochElements[ "year" ],
+                                   departureEpochElements[ "month" ],
+                                   departureEpochElements[ "day" ],
+                                   departureEpochElements[ "hours" ],
+                                   departureEpochElements[ "minutes" ],
+                                   departureEpochElements[ "seconds" ] );
+
+    if ( departureEpochIterator->value.Size( ) == 0 )
+    {
+        std::cout << "Departure epoch               TLE epoch" << std::endl;
+    }
+
+    else
+    {
+        std::cout << "Departure epoch               " << departureEpoch << std::endl;
+    }
+
+    const rapidjson::Value& departureEpochGrid = find( config, "departure_epoch_grid" )->value;
+    if ( !departureEpochGrid.IsArray( )
+         || departureEpochGrid.Size( ) != 2
+         || !departureEpochGrid[ 0 ].IsNumber( )
+         || !departureEpochGrid[ 1 ].IsNumber( ) )
+    {
+        throw std::runtime_error( "ERROR: Departure epoch grid must be given as [range (s), "
+                                  "# of steps]!" );
+    }
+
+    const double departureEpochRange
+        = find( config, "departure_epoch_grid" )->value[ 0 ].GetDouble( );
+    std::cout << "Departure epoch grid range    " << departureEpochRange << std::endl;
+    const double departureGridSteps
+        = find( config, "departure_epoch_grid" )->value[ 1 ].GetDouble( );
+    std::cout << "Departure epoch grid steps    " << departureGridSteps << std::endl;
+
+    if ( departureGridSteps < 1 )
+    {
+        throw std::runtime_error(
+            "ERROR: Number of departure epoch grid steps must be at least 1!" );
+    }
+
+    const rapidjson::Value& timeOfFlightGrid = find( config, "time_of_flight_grid" )->value;
+    if ( !timeOfFlightGrid.IsArray( )
+         || timeOfFlightGrid.Size( ) != 3
+         || !timeOfFlightGrid[ 0 ].IsNumber( )
+         || !timeOfFlightGrid[ 1 ].IsNumber( )
+         || !timeOfFlightGrid[ 2 ].IsNumber( ) )
+    {
+        throw std::runtime_error( "ERROR: Time-of-flight grid must be given as [min (s), max (s), "
+                                  "# of steps]!" );
+    }
+
+    const double timeOfFlightMinimum
+        = find( config, "time_of_flight_grid" )->value[ 0 ].GetDouble( );
+    std::cout << "Minimum Time-of-Flight        " << timeOfFlightMinimum << std::endl;
+    const double timeOfFlightMaximum
+        = find( config, "time_of_flight_grid" )->value[ 1 ].GetDouble( );
+    std::cout << "Maximum Time-of-Flight        " << timeOfFlightMaximum << std::endl;
+
+    if ( timeOfFlightMinimum > timeOfFlightMaximum )
+    {
+        throw std::runtime_error( "ERROR: Maximum time-of-flight must be larger than minimum!" );
+    }
+
+    const double timeOfFlightSteps
+        = find( config, "time_of_flight_grid" )->value[ 2 ].GetDouble( );
+    std::cout << "# Time-of-Flight steps        " << timeOfFlightSteps << std::endl;
+
+    if ( timeOfFlightSteps < 1 )
+    {
+        throw std::runtime_error( "ERROR: Number of time-of-flight steps must be at least 1!" );
+    }
+
+    // The transfer direction is set by "direction", if specified, or by "is_prograde" otherwise.
+    bool isPrograde = true;
+    bool isBidirectional = false;
+    if ( config.HasMember( "direction" ) )
+    {
+        const std::string direction = find( config, "direction" )->value.GetString( );
+        std::cout << "Transfer direction            " << direction << std::endl;
+
+        if ( direction == "retrograde" )
+        {
+            isPrograde = false;
+        }
+
+        else if ( direction == "both" )
+        {
+            isBidirectional = true;
+        }
+
+        else if ( direction != "prograde" )
+        {
+            throw std::runtime_error(
+                "ERROR: Direction must be \"prograde\", \"retrograde\" or \"both\"!" );
+        }
+    }
+
+    else
+    {
+        isPrograde = find( config, "is_prograde" )->value.GetBool( );
+        if ( isPrograde )
+        {
+            std::cout << "Prograde transfer?            true" << std::endl;
+        }
+        else
+        {
+            std::cout << "Prograde transfer?            false" << std::endl;
+        }
+    }
+
+    const int revolutionsMaximum = find( config, "revolutions_maximum" )->value.GetInt( );
+    std::cout << "Maximum revolutions           " << revolutionsMaximum << std::endl;
+
+    bool isWarmStarted = false;
+    if ( config.HasMember( "warm_start" ) )
+    {
+        isWarmStarted = find( config, "warm_start" )->value.GetBool( );
+        std::cout << "Warm start                    " << isWarmStarted << std::endl;
+    }
+
+    double transferDeltaVCutoff = 0.0;
+    if ( config.HasMember( "transfer_deltav_cutoff" ) )
+    {
+        transferDeltaVCutoff = find( config, "transfer_deltav_cutoff" )->value.GetDouble( );
+        std::cout << "Transfer deltaV cut-off       " << transferDeltaVCutoff << " km/s"
+                  << std::endl;
+
+        if ( transferDeltaVCutoff <= 0.0 )
+        {
+            throw std::runtime_error( "ERROR: Transfer deltaV cut-off must be positive!" );
+        }
+    }
+
+    double transferPeriapsisRadiusMinimum = 0.0;
+    if ( config.HasMember( "transfer_periapsis_altitude_minimum" ) )
+    {
+        const double transferPeriapsisAltitudeMinimum
+            = find( config, "transfer_periapsis_altitude_minimum" )->value.GetDouble( );
+        std::cout << "Minimum periapsis altitude    " << transferPeriapsisAltitudeMinimum
+                  << " km" << std::endl;
+        transferPeriapsisRadiusMinimum = kXKMPER + transferPeriapsisAltitudeMinimum;
+    }
+
+    double pairScreeningCutoff = 0.0;
+    if ( config.HasMember( "pair_screening_deltav_cutoff" ) )
+    {
+        pairScreeningCutoff = find( config, "pair_screening_deltav_cutoff" )->value.GetDouble( );
+        std::cout << "Pair screening deltaV cut-off " << pairScreeningCutoff << " km/s"
+                  << std::endl;
+
+        if ( pairScreeningCutoff <= 0.0 )
+        {
+            throw std::runtime_error( "ERROR: Pair screening deltaV cut-off must be positive!" );
+        }
+    }
+
+    double departureEpochResolution = 0.0;
+    double timeOfFlightResolution = 0.0;
+    if ( config.HasMember( "grid_refinement" ) )
+    {
+        departureEpochResolution = find( config, "grid_refinement" )->value[ 0 ].GetDouble( );
+        timeOfFlightResolution = find( config, "grid_refinement" )->value[ 1 ].GetDouble( );
+        std::cout << "Departure epoch resolution    " << departureEpochResolution << std::endl;
+        std::cout << "Time-of-Flight resolution     " << timeOfFlightResolution << std::endl;
+
+        if ( departureEpochResolution <= 0.0 || timeOfFlightResolution <= 0.0 )
+        {
+            throw std::runtime_error( "ERROR: Grid refinement resolution must be positive!" );
+        }
+    }
+
+    const int shortlistLength = find( config, "shortlist" )->value[ 0 ].GetInt( );
+    std::cout << "# of shortlist transfers      " << shortlistLength << std::endl;
+
+    std::string shortlistPath = "";
+    if ( shortlistLength > 0 )
+    {
+        shortlistPath = find( config, "shortlist" )->value[ 1 ].GetString( );
+        std::cout << "Shortlist                     " << shortlistPath << std::endl;
+    }
+
+    int threads = 1;
+    if ( config.HasMember( "threads" ) )
+    {
+        threads = find( config, "threads" )->value.GetInt( );
+    }
+    std::cout << "# of threads                  " << threads << std::endl;
+
+    if ( threads < 1 )
+    {
+        throw std::runtime_error( "ERROR: Number of threads must be at least 1!" );
+    }
+
+    int departureBlockSize = 0;
+    int arrivalBlockSize = 0;
+    if ( config.HasMember( "tile_size" ) )
+    {
+        departureBlockSize = find( config, "tile_size" )->value[ 0 ].GetInt( );
+        arrivalBlockSize = find( config, "tile_size" )->value[ 1 ].GetInt( );
+        std::cout << "Tile size (departure)         " << departureBlockSize << std::endl;
+        std::cout << "Tile size (arrival)           " << arrivalBlockSize << std::endl;
+
+        if ( departureBlockSize < 0 || arrivalBlockSize < 0 )
+        {
+            throw std::runtime_error( "ERROR: Tile size must be non-negative!" );
+        }
+    }
+
+    int checkpointInterval = 0;
+    if ( config.HasMember( "checkpoint_interval" ) )
+    {
+        checkpointInterval = find( config, "checkpoint_interval" )->value.GetInt( );
+        std::cout << "Checkpoint interval           " << checkpointInterval << std::endl;
+
+        if ( checkpointInterval < 0 )
+        {
+            throw std::runtime_error( "ERROR: Checkpoint interval must be non-negative!" );
+        }
+    }
+
+    bool isResumed = false;
+    if ( config.HasMember( "resume" ) )
+    {
+        isResumed = find( config, "resume" )->value.GetBool( );
+        std::cout << "Resume                        " << isResumed << std::endl;
+    }
+
+    bool isIncremental = false;
+    if ( config.HasMember( "incremental" ) )
+    {
+        isIncremental = find( config, "incremental" )->value.GetBool( );
+        std::cout << "Incremental                   " << isIncremental << std::endl;
+    }
+
+    // An incremental update is committed in a single transaction, such that the database of the
+    // previous run is left intact if the update is interrupted.
+    if ( isIncremental && ( checkpointInterval > 0 || isResumed ) )
+    {
+        throw std::runtime_error( "ERROR: Incremental update cannot be combined with checkpoint "
+                                  "interval or resume!" );
+    }
+
+    bool isCompact = false;
+    if ( config.HasMember( "schema" ) )
+    {
+        const std::string schema = find( config, "schema" )->value.GetString( );
+        std::cout << "Schema                        " << schema << std::endl;
+
+        if ( schema == "compact" )
+        {
+            isCompact = true;
+        }
+
+        else if ( schema != "full" )
+        {
+            throw std::runtime_error( "ERROR: Schema must be \"full\" or \"compact\"!" );
+        }
+    }
+
+    int shardIndex = 0;
+    int numberOfShards = 1;
+    if ( config.HasMember( "shard" ) )
+    {
+        shardIndex = find( config, "shard" )->value[ 0 ].GetInt( );
+        numberOfShards = find( config, "shard" )->value[ 1 ].GetInt( );
+        std::cout << "Shard                         " << shardIndex << " of " << numberOfShards
+                  << std::endl;
+
+        if ( numberOfShards < 1 || shardIndex < 0 || shardIndex >= numberOfShards )
+        {
+            throw std::runtime_error(
+                "ERROR: Shard index must be in range [0, number of shards)!" );
+        }
+    }
+
+    std::string columnStorePath = "";
+    if ( config.HasMember( "column_store" ) )
+    {
+        columnStorePath = find( config, "column_store" )->value.GetString( );
+        std::cout << "Column store                  " << columnStorePath << std::endl;
+    }
+
+    const ResultSinkSettings resultSinkSettings = checkResultSinkSettings( config );
+
+    if ( !columnStorePath.empty( ) && !resultSinkSettings.isSQLite( ) )
+    {
+        throw std::runtime_error( "ERROR: Column store and result sink cannot both be set!" );
+    }
+
+    // Checkpoints rely on transfers being committed to the SQLite table; the column store is only
+    // valid once it is closed. Incremental updates delete transfers from the SQLite table.
+    if ( ( !columnStorePath.empty( ) || !resultSinkSettings.isSQLite( ) )
+         && ( checkpointInterval > 0 || isResumed || isIncremental ) )
+    {
+        throw std::runtime_error( "ERROR: Checkpoint interval, resume and incremental update are "
+                                  "only supported if transfers are stored in SQLite table!" );
+    }
+
+    const DatabaseSettings databaseSettings = checkDatabaseSettings( config );
+
+    std::string ephemerisCachePath = "";
+    if ( config.HasMember( "ephemeris_cache" ) )
+    {
+        ephemerisCachePath = find( config, "ephemeris_cache" )->value.GetString( );
+        std::cout << "Ephemeris cache               " << ephemerisCachePath << std::endl;
+    }
+
+    return LambertScannerInput( catalogPath,
+                                databasePath,
+                                departureEpoch,
+                                departureGridSteps,
+                                departureEpochRange/departureGridSteps,
+                                timeOfFlightMinimum,
+                                timeOfFlightMaximum,
+                                timeOfFlightSteps,
+                                ( timeOfFlightMaximum - timeOfFlightMinimum ) / timeOfFlightSteps,
+                                isPrograde,
+                                isBidirectional,
+                                revolutionsMaximum,
+                                isWarmStarted,
+                                transferDeltaVCutoff,
+                                transferPeriapsisRadiusMinimum,
+                                pairScreeningCutoff,
+                                departureEpochResolution,
+                                timeOfFlightResolution,
+                                shortlistLength,
+                                shortlistPath,
+                                threads,
+                                departureBlockSize,
+                                arrivalBlockSize,
+                                checkpointInterval,
+                                isResumed,
+                                isIncremental,
+                                shardIndex,
+                                numberOfShards,
+                                isCompact,
+                                columnStorePath,
+                                resultSinkSettings,
+                                databaseSettings,
+                                ephemerisCachePath );
+}
+
+//! Create lambert_scanner table.
+void createLambertScannerTable( SQLite::Database& database, const bool isCompact )
+{
+    // Drop table from database if it exists, as well as the reference to a column store written
+    // by a previous run.
+    database.exec( "DROP TABLE IF EXISTS lambert_scanner_results;" );
+    database.exec( "DROP TABLE IF EXISTS lambert_scanner_column_store;" );
+
+    // Set up SQL command to create table to store lambert_scanner results.
+    std::ostringstream lambertScannerTableCreate;
+    lambertScannerTableCreate
+        << "CREATE TABLE lambert_scanner_results ("
+        << "\"transfer_id\"                             INTEGER PRIMARY KEY AUTOINCREMENT,"
+        << "\"departure_object_id\"                     TEXT,"
+        << "\"arrival_object_id\"                       TEXT,"
+        << "\"departure_epoch\"                         REAL,"
+        << "\"time_of_flight\"                          REAL,"
+        << "\"revolutions\"                             INTEGER,"
+        // N.B.: SQLite doesn't support booleans so 0 = false, 1 = true for 'prograde'
+        << "\"prograde\"                                INTEGER,";
+
+    // State vectors and Keplerian elements are omitted in the compact schema.
+    if ( !isCompact )
+    {
+        lambertScannerTableCreate
+            << "\"departure_position_x\"                    REAL,"
+            << "\"departure_position_y\"                    REAL,"
+            << "\"departure_position_z\"                    REAL,"
+            << "\"departure_velocity_x\"                    REAL,"
+            << "\"departure_velocity_y\"                    REAL,"
+            << "\"departure_velocity_z\"                    REAL,"
+            << "\"departure_semi_major_axis\"               REAL,"
+            << "\"departure_eccentricity\"                  REAL,"
+            << "\"departure_inclination\"                   REAL,"
+            << "\"departure_argument_of_periapsis\"         REAL,"
+            << "\"departure_longitude_of_ascending_node\"   REAL,"
+            << "\"departure_true_anomaly\"                  REAL,"
+            << "\"arrival_position_x\"                      REAL,"
+            << "\"arrival_position_y\"                      REAL,"
+            << "\"arrival_position_z\"                      REAL,"
+            << "\"arrival_velocity_x\"                      REAL,"
+            << "\"arrival_velocity_y\"                      REAL,"
+            << "\"arrival_velocity_z\"                      REAL,"
+            << "\"arrival_semi_major_axis\"                 REAL,"
+            << "\"arrival_eccentricity\"                    REAL,"
+            << "\"arrival_inclination\"                     REAL,"
+            << "\"arrival_argument_of_periapsis\"           REAL,"
+            << "\"arrival_longitude_of_ascending_node\"     REAL,"
+            << "\"arrival_true_anomaly\"                    REAL,"
+            << "\"transfer_semi_major_axis\"                REAL,"
+            << "\"transfer_eccentricity\"                   REAL,"
+            << "\"transfer_inclination\"                    REAL,"
+            << "\"transfer_argument_of_periapsis\"          REAL,"
+            << "\"transfer_longitude_of_ascending_node\"    REAL,"
+            << "\"transfer_true_anomaly\"                   REAL,";
+    }
+
+    lambertScannerTableCreate
+        << "\"departure_delta_v_x\"                     REAL,"
+        << "\"departure_delta_v_y\"                     REAL,"
+        << "\"departure_delta_v_z\"                     REAL,"
+        << "\"arrival_delta_v_x\"                       REAL,"
+        << "\"arrival_delta_v_y\"                       REAL,"
+        << "\"arrival_delta_v_z\"                       REAL,"
+        << "\"transfer_delta_v\"                        REAL"
+        <<                                              ");";
+
+    // Execute command to create table.
+    database.exec( lambertScannerTableCreate.str( ).c_str( ) );
+
+    if ( !database.tableExists( "lambert_scanner_results" ) )
+    {
+        throw std::runtime_error( "ERROR: Creating table 'lambert_scanner_results' failed!" );
+    }
+}
+
+//! Create lambert_scanner table indices.
+void createLambertScannerTableIndices( SQLite::Database& database )
+{
+    // Execute command to create index on transfer Delta-V column.
+    std::ostringstream transferDeltaVIndexCreate;
+    transferDeltaVIndexCreate << "CREATE INDEX IF NOT EXISTS \"transfer_delta_v\" on "
+                              << "lambert_scanner_results (transfer_delta_v ASC);";
+    database.exec( transferDeltaVIndexCreate.str( ).c_str( ) );
+}
+
+//! Create lambert_scanner catalog table.
+void createLambertScannerCatalogTable( SQLite::Database& database )
+{
+    // Drop table from database if it exists.
+    database.exec( "DROP TABLE IF EXISTS lambert_scanner_catalog;" );
+
+    // Set up SQL command to create table to store TLE catalog used by lambert_scanner.
+    std::ostringstream lambertScannerCatalogTableCreate;
+    lambertScannerCatalogTableCreate
+        << "CREATE TABLE lambert_scanner_catalog ("
+        << "\"object_index\"                            INTEGER PRIMARY KEY,"
+        << "\"object_id\"                               TEXT,"
+        << "\"name\"                                    TEXT,"
+        << "\"line_1\"                                  TEXT,"
+        << "\"line_2\"                                  TEXT"
+        <<                                              ");";
+
+    // Execute command to create table.
+    database.exec( lambertScannerCatalogTableCreate.str( ).c_str( ) );
+
+    if ( !database.tableExists( "lambert_scanner_catalog" ) )
+    {
+        throw std::runtime_error( "ERROR: Creating table 'lambert_scanner_catalog' failed!" );
+    }
+}
+
+//! Check lambert_scanner catalog.
+void checkLambertScannerCatalog( const TleObjects& tleObjects )
+{
+    std::set< int > objectIds;
+    for ( unsigned int i = 0; i < tleObjects.size( ); i++ )
+    {
+        const int objectId = static_cast< int >( tleObjects[ i ].NoradNumber( ) );
+        if ( !objectIds.insert( objectId ).second )
+        {
+            std::ostringstream error;
+            error << "ERROR: NORAD ID " << objectId << " occurs more than once in TLE catalog!";
+            throw std::runtime_error( error.str( ) );
+        }
+    }
+}
+
+//! Store lambert_scanner catalog.
+void storeLambertScannerCatalog( SQLite::Database& database, const TleObjects& tleObjects )
+{
+    checkLambertScannerCatalog( tleObjects );
+
+    SQLite::Statement query(
+        database,
+        "INSERT INTO lambert_scanner_catalog VALUES "
+        "(:object_index, :object_id, :name, :line_1, :line_2);" );
+
+    for ( unsigned int i = 0; i < tleObjects.size( ); i++ )
+    {
+        query.bind( ":object_index", static_cast< int >( i ) );
+        query.bind( ":object_id",    static_cast< int >( tleObjects[ i ].NoradNumber( ) ) );
+        query.bind( ":name",         tleObjects[ i ].Name( ) );
+        query.bind( ":line_1",       tleObjects[ i ].Line1( ) );
+        query.bind( ":line_2",       tleObjects[ i ].Line2( ) );
+        query.executeStep( );
+        query.reset( );
+    }
+}
+
+//! Check if lambert_scanner table uses compact schema.
+bool isLambertScannerTableCompact( SQLite::Database& database )
+{
+    if ( database.tableExists( "lambert_scanner_column_store" ) )
+    {
+        const std::string columnStorePath
+            = database.execAndGet( "SELECT path FROM lambert_scanner_column_store;" );
+        const ColumnStore columnStore( columnStorePath );
+        return !columnStore.hasColumn( "departure_position_x" );
+    }
+
+    SQLite::Statement query( database, "PRAGMA table_info(lambert_scanner_results);" );
+    while ( query.executeStep( ) )
+    {
+        const std::string column = query.getColumn( 1 );
+        if ( column == "departure_position_x" )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//! Create lambert_scanner column store table.
+void createLambertScannerColumnStoreTable( SQLite::Database& database,
+                                           const std::string& columnStorePath )
+{
+    // Drop tables from database if they exist; transfers are not stored in the database.
+    database.exec( "DROP TABLE IF EXISTS lambert_scanner_results;" );
+    database.exec( "DROP TABLE IF EXISTS lambert_scanner_column_store;" );
+
+    database.exec( "CREATE TABLE lambert_scanner_column_store (\"path\" TEXT);" );
+
+    SQLite::Statement query( database, "INSERT INTO lambert_scanner_column_store VALUES (:path);" );
+    query.bind( ":path", columnStorePath );
+    query.exec( );
+
+    if ( !database.tableExists( "lambert_scanner_column_store" ) )
+    {
+        throw std::runtime_error( "ERROR: Creating table 'lambert_scanner_column_store' failed!" );
+    }
+}
+
+//! Get lambert_scanner column names.
+std::vector< std::string > getLambertScannerColumnNames( const bool isCompact )
+{
+    std::vector< std::string > columnNames;
+    columnNames.push_back( "departure_object_id" );
+    columnNames.push_back( "arrival_object_id" );
+    columnNames.push_back( "departure_epoch" );
+    columnNames.push_back( "time_of_flight" );
+    columnNames.push_back( "revolutions" );
+    columnNames.push_back( "prograde" );
+
+    // State vectors and Keplerian elements are omitted in the compact schema.
+    if ( !isCompact )
+    {
+        const std::string orbits[ ] = { "departure", "arrival" };
+        for ( int i = 0; i < 2; i++ )
+        {
+            columnNames.push_back( orbits[ i ] + "_position_x" );
+            columnNames.push_back( orbits[ i ] + "_position_y" );
+            columnNames.push_back( orbits[ i ] + "_position_z" );
+            columnNames.push_back( orbits[ i ] + "_velocity_x" );
+            columnNames.push_back( orbits[ i ] + "_velocity_y" );
+            columnNames.push_back( orbits[ i ] + "_velocity_z" );
+            columnNames.push_back( orbits[ i ] + "_semi_major_axis" );
+            columnNames.push_back( orbits[ i ] + "_eccentricity" );
+            columnNames.push_back( orbits[ i ] + "_inclination" );
+            columnNames.push_back( orbits[ i ] + "_argument_of_periapsis" );
+            columnNames.push_back( orbits[ i ] + "_longitude_of_ascending_node" );
+            columnNames.push_back( orbits[ i ] + "_true_anomaly" );
+        }
+
+        columnNames.push_back( "transfer_semi_major_axis" );
+        columnNames.push_back( "transfer_eccentricity" );
+        columnNames.push_back( "transfer_inclination" );
+        columnNames.push_back( "transfer_argument_of_periapsis" );
+        columnNames.push_back( "transfer_longitude_of_ascending_node" );
+        columnNames.push_back( "transfer_true_anomaly" );
+    }
+
+    columnNames.push_back( "departure_delta_v_x" );
+    columnNames.push_back( "departure_delta_v_y" );
+    columnNames.push_back( "departure_delta_v_z" );
+    columnNames.push_back( "arrival_delta_v_x" );
+    columnNames.push_back( "arrival_delta_v_y" );
+    columnNames.push_back( "arrival_delta_v_z" );
+    columnNames.push_back( "transfer_delta_v" );
+
+    return columnNames;
+}
+
+//! Get lambert_scanner result fields.
+ResultFields getLambertScannerResultFields( const bool isCompact )
+{
+    const std::vector< std::string > columnNames = getLambertScannerColumnNames( isCompact );
+
+    ResultFields fields;
+    for ( unsigned int i = 0; i < columnNames.size( ); i++ )
+    {
+        const bool isInteger = columnNames[ i ] == "departure_object_id"
+                               || columnNames[ i ] == "arrival_object_id"
+                               || columnNames[ i ] == "revolutions"
+                               || columnNames[ i ] == "prograde";
+        fields.push_back( ResultField( columnNames[ i ], isInteger ) );
+    }
+
+    return fields;
+}
+
+//! Create lambert_scanner progress table.
+void createLambertScannerProgressTable( SQLite::Database& database )
+{
+    // Drop table from database if it exists.
+    database.exec( "DROP TABLE IF EXISTS lambert_scanner_progress;" );
+
+    // Set up SQL command to create table to store lambert_scanner progress.
+    std::ostringstream lambertScannerProgressTableCreate;
+    lambertScannerProgressTableCreate
+        << "CREATE TABLE lambert_scanner_progress ("
+        << "\"departure_object_index\"                  INTEGER PRIMARY KEY,"
+        << "\"departure_object_id\"                     TEXT"
+        <<                                              ");";
+
+    // Execute command to create table.
+    database.exec( lambertScannerProgressTableCreate.str( ).c_str( ) );
+
+    if ( !database.tableExists( "lambert_scanner_progress" ) )
+    {
+        throw std::runtime_error( "ERROR: Creating table 'lambert_scanner_progress' failed!" );
+    }
+}
+
+//! Fetch lambert_scanner progress.
+std::vector< bool > fetchLambertScannerProgress( SQLite::Database& database,
+                                                 const TleObjects& tleObjects )
+{
+    if ( !database.tableExists( "lambert_scanner_results" )
+         || !database.tableExists( "lambert_scanner_progress" ) )
+    {
+        throw std::runtime_error(
+            "ERROR: No lambert_scanner run to resume found in database!" );
+    }
+
+    std::vector< bool > isDepartureObjectCompleted( tleObjects.size( ), false );
+
+    SQLite::Statement query( database, "SELECT * FROM lambert_scanner_progress;" );
+    while ( query.executeStep( ) )
+    {
+        const int departureObjectIndex = query.getColumn( 0 );
+        const int departureObjectId    = query.getColumn( 1 );
+
+        // Check that progress was recorded for the same catalog.
+        if ( departureObjectIndex < 0
+             || departureObjectIndex >= static_cast< int >( tleObjects.size( ) )
+             || static_cast< int >( tleObjects[ departureObjectIndex ].NoradNumber( ) )
+                 != departureObjectId )
+        {
+            throw std::runtime_error(
+                "ERROR: Progress in database does not match TLE catalog!" );
+        }
+
+        isDepartureObjectCompleted[ departureObjectIndex ] = true;
+    }
+
+    return isDepartureObjectCompleted;
+}
 
-    // Open database in read/write mode.
-    SQLite::Database database( input.databasePath.c_str( ),
-                               SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+//! Compare TLE catalog with lambert_scanner catalog.
+std::vector< bool > compareLambertScannerCatalog( SQLite::Database& database,
+                                                  const TleObjects& tleObjects,
+                                                  std::vector< int >& removedObjectIds )
+{
+    if ( !database.tableExists( "lambert_scanner_results" )
+         || !database.tableExists( "lambert_scanner_catalog" ) )
+    {
+        throw std::runtime_error(
+            "ERROR: No lambert_scanner run to update found in database!" );
+    }
 
-    // Create table for Lambert scanner results in SQLite database.
-    std::cout << "Creating SQLite database table if needed ... " << std::endl;
-    createLambertScannerTable( database );
-    std::cout << "SQLite database set up successfully!" << std::endl;
-
-    // Start SQL transaction.
-    SQLite::Transaction transaction( database );
-
-    // Setup insert query.
-    std::ostringstream lambertScannerTableInsert;
-    lambertScannerTableInsert
-        << "INSERT INTO lambert_scanner_results VALUES ("
-        << "NULL,"
-        << ":departure_object_id,"
-        << ":arrival_object_id,"
-        << ":departure_epoch,"
-        << ":time_of_flight,"
-        << ":revolutions,"
-        << ":prograde,"
-        << ":departure_position_x,"
-        << ":departure_position_y,"
-        << ":departure_position_z,"
-        << ":departure_velocity_x,"
-        << ":departure_velocity_y,"
-        << ":departure_velocity_z,"
-        << ":departure_semi_major_axis,"
-        << ":departure_eccentricity,"
-        << ":departure_inclination,"
-        << ":departure_argument_of_periapsis,"
-        << ":departure_longitude_of_ascending_node,"
-        << ":departure_true_anomaly,"
-        << ":arrival_position_x,"
-        << ":arrival_position_y,"
-        << ":arrival_position_z,"
-        << ":arrival_velocity_x,"
-        << ":arrival_velocity_y,"
-        << ":arrival_velocity_z,"
-        << ":arrival_semi_major_axis,"
-        << ":arrival_eccentricity,"
-        << ":arrival_inclination,"
-        << ":arrival_argument_of_periapsis,"
-        << ":arrival_longitude_of_ascending_node,"
-        << ":arrival_true_anomaly,"
-        << ":transfer_semi_major_axis,"
-        << ":transfer_eccentricity,"
-        << ":transfer_inclination,"
-        << ":transfer_argument_of_periapsis,"
-        << ":transfer_longitude_of_ascending_node,"
-        << ":transfer_true_anomaly,"
-        << ":departure_delta_v_x,"
-        << ":departure_delta_v_y,"
-        << ":departure_delta_v_z,"
-        << ":arrival_delta_v_x,"
-        << ":arrival_delta_v_y,"
-        << ":arrival_delta_v_z,"
-        << ":transfer_delta_v"
-        << ");";
-
-    SQLite::Statement query( database, lambertScannerTableInsert.str( ) );
+    checkLambertScannerCatalog( tleObjects );
 
-    std::cout << "Computing Lambert transfers and populating database ... " << std::endl;
+    // Fetch TLE lines of stored catalog, by NORAD ID.
+    typedef std::map< int, std::pair< std::string, std::string > > CatalogLines;
+    CatalogLines storedCatalogLines;
 
-    // Loop over TLE objects and compute transfers based on Lambert targeter across time-of-flight
-    // grid.
-    boost::progress_display showProgress( tleObjects.size( ) );
+    SQLite::Statement query(
+        database, "SELECT object_id, line_1, line_2 FROM lambert_scanner_catalog;" );
+    while ( query.executeStep( ) )
+    {
+        const int objectId = query.getColumn( 0 );
+        const std::string line1 = query.getColumn( 1 );
+        const std::string line2 = query.getColumn( 2 );
+        storedCatalogLines[ objectId ] = std::make_pair( line1, line2 );
+    }
 
-    // Loop over all departure objects.
+    // Objects are changed if they are new or if any of their TLE lines differ.
+    std::set< int > objectIds;
+    std::vector< bool > isObjectChanged( tleObjects.size( ), false );
     for ( unsigned int i = 0; i < tleObjects.size( ); i++ )
     {
-        // Compute departure state.
-        Tle departureObject = tleObjects[ i ];
-        SGP4 sgp4Departure( departureObject );
+        const int objectId = static_cast< int >( tleObjects[ i ].NoradNumber( ) );
+        objectIds.insert( objectId );
 
-        DateTime departureEpoch = input.departureEpochInitial;
-        if ( input.departureEpochInitial == DateTime( ) )
-        {
-            departureEpoch = departureObject.Epoch( );
-        }
+        const CatalogLines::const_iterator storedLines = storedCatalogLines.find( objectId );
+        isObjectChanged[ i ] = storedLines == storedCatalogLines.end( )
+                               || storedLines->second.first != tleObjects[ i ].Line1( )
+                               || storedLines->second.second != tleObjects[ i ].Line2( );
+    }
 
-        // Loop over arrival objects.
-        for ( unsigned int j = 0; j < tleObjects.size( ); j++ )
+    removedObjectIds.clear( );
+    for ( CatalogLines::const_iterator iterator = storedCatalogLines.begin( );
+          iterator != storedCatalogLines.end( );
+          iterator++ )
+    {
+        if ( objectIds.count( iterator->first ) == 0 )
         {
-            // Skip the case of the departure and arrival objects being the same.
-            if ( i == j )
-            {
-                continue;
-            }
+            removedObjectIds.push_back( iterator->first );
+        }
+    }
 
-            Tle arrivalObject = tleObjects[ j ];
-            SGP4 sgp4Arrival( arrivalObject );
-            const int arrivalObjectId = static_cast< int >( arrivalObject.NoradNumber( ) );
+    return isObjectChanged;
+}
 
-            // Loop over departure epoch grid.
-            for ( int m = 0; m < input.departureEpochSteps; ++m )
-            {
-                DateTime departureEpoch = input.departureEpochInitial;
-                departureEpoch = departureEpoch.AddSeconds( input.departureEpochStepSize * m );
+//! Delete lambert_scanner transfers.
+int deleteLambertScannerTransfers( SQLite::Database& database,
+                                   const std::vector< int >& objectIds )
+{
+    if ( objectIds.empty( ) )
+    {
+        return 0;
+    }
 
-                const Eci tleDepartureState = sgp4Departure.FindPosition( departureEpoch );
-                const Vector6 departureState = getStateVector( tleDepartureState );
+    // Object IDs are collected in a temporary table, such that all transfers are deleted in a
+    // single pass over the lambert_scanner table.
+    database.exec( "DROP TABLE IF EXISTS temp.lambert_scanner_deleted_objects;" );
+    database.exec( "CREATE TEMP TABLE lambert_scanner_deleted_objects (\"object_id\" TEXT);" );
 
-                Vector3 departurePosition;
-                std::copy( departureState.begin( ),
-                           departureState.begin( ) + 3,
-                           departurePosition.begin( ) );
+    SQLite::Statement query(
+        database, "INSERT INTO lambert_scanner_deleted_objects VALUES (:object_id);" );
+    for ( unsigned int i = 0; i < objectIds.size( ); i++ )
+    {
+        query.bind( ":object_id", objectIds[ i ] );
+        query.executeStep( );
+        query.reset( );
+    }
 
-                Vector3 departureVelocity;
-                std::copy( departureState.begin( ) + 3,
-                           departureState.end( ),
-                           departureVelocity.begin( ) );
+    const int numberOfDeletedTransfers = database.exec(
+        "DELETE FROM lambert_scanner_results WHERE "
+        "departure_object_id IN (SELECT object_id FROM lambert_scanner_deleted_objects) OR "
+        "arrival_object_id IN (SELECT object_id FROM lambert_scanner_deleted_objects);" );
 
-                const Vector6 departureStateKepler
-                    = astro::convertCartesianToKeplerianElements( departureState,
-                                                                  earthGravitationalParameter );
-                const int departureObjectId = static_cast< int >( departureObject.NoradNumber( ) );
+    database.exec( "DROP TABLE temp.lambert_scanner_deleted_objects;" );
 
-                // Loop over time-of-flight grid.
-                for ( int k = 0; k < input.timeOfFlightSteps; k++ )
-                {
-                    const double timeOfFlight
-                        = input.timeOfFlightMinimum + k * input.timeOfFlightStepSize;
-
-                    const DateTime arrivalEpoch = departureEpoch.AddSeconds( timeOfFlight );
-                    const Eci tleArrivalState   = sgp4Arrival.FindPosition( arrivalEpoch );
-                    const Vector6 arrivalState  = getStateVector( tleArrivalState );
-
-                    Vector3 arrivalPosition;
-                    std::copy( arrivalState.begin( ),
-                               arrivalState.begin( ) + 3,
-                               arrivalPosition.begin( ) );
-
-                    Vector3 arrivalVelocity;
-                    std::copy( arrivalState.begin( ) + 3,
-                               arrivalState.end( ),
-                               arrivalVelocity.begin( ) );
-                    const Vector6 arrivalStateKepler
-                        = astro::convertCartesianToKeplerianElements( arrivalState,
-                                                                      earthGravitationalParameter );
+    return numberOfDeletedTransfers;
+}
 
-                    kep_toolbox::lambert_problem targeter( departurePosition,
-                                                           arrivalPosition,
-                                                           timeOfFlight,
-                                                           earthGravitationalParameter,
-                                                           !input.isPrograde,
-                                                           input.revolutionsMaximum );
+//! Get lambert_scanner run parameters.
+std::map< std::string, double > getLambertScannerParameters( const LambertScannerInput& input )
+{
+    std::map< std::string, double > parameters;
+    parameters[ "departure_epoch_initial" ] = input.departureEpochInitial.ToJulian( );
+    parameters[ "departure_epoch_steps" ] = input.departureEpochSteps;
+    parameters[ "departure_epoch_step_size" ] = input.departureEpochStepSize;
+    parameters[ "time_of_flight_minimum" ] = input.timeOfFlightMinimum;
+    parameters[ "time_of_flight_maximum" ] = input.timeOfFlightMaximum;
+    parameters[ "time_of_flight_steps" ] = input.timeOfFlightSteps;
+    parameters[ "revolutions_maximum" ] = input.revolutionsMaximum;
+    parameters[ "prograde" ] = input.isPrograde ? 1.0 : 0.0;
+    parameters[ "bidirectional" ] = input.isBidirectional ? 1.0 : 0.0;
+    parameters[ "transfer_delta_v_cutoff" ] = input.transferDeltaVCutoff;
+    parameters[ "transfer_periapsis_radius_minimum" ] = input.transferPeriapsisRadiusMinimum;
+    parameters[ "pair_screening_cutoff" ] = input.pairScreeningCutoff;
+    parameters[ "departure_epoch_resolution" ] = input.departureEpochResolution;
+    parameters[ "time_of_flight_resolution" ] = input.timeOfFlightResolution;
+    parameters[ "shard_index" ] = input.shardIndex;
+    parameters[ "shards" ] = input.numberOfShards;
+    return parameters;
+}
 
-                    const int numberOfSolutions = targeter.get_v1( ).size( );
+//! Create lambert_scanner parameters table.
+void createLambertScannerParametersTable( SQLite::Database& database )
+{
+    // Drop table from database if it exists.
+    database.exec( "DROP TABLE IF EXISTS lambert_scanner_parameters;" );
+
+    // Set up SQL command to create table to store run parameters used by lambert_scanner.
+    std::ostringstream lambertScannerParametersTableCreate;
+    lambertScannerParametersTableCreate
+        << "CREATE TABLE lambert_scanner_parameters ("
+        << "\"name\"                                    TEXT PRIMARY KEY,"
+        << "\"value\"                                   REAL"
+        <<                                              ");";
 
-                    // Compute Delta-Vs for transfer and determine index of lowest.
-                    typedef std::vector< Vector3 > VelocityList;
-                    VelocityList departureDeltaVs( numberOfSolutions );
-                    VelocityList arrivalDeltaVs( numberOfSolutions );
+    // Execute command to create table.
+    database.exec( lambertScannerParametersTableCreate.str( ).c_str( ) );
 
-                    typedef std::vector< double > TransferDeltaVList;
-                    TransferDeltaVList transferDeltaVs( numberOfSolutions );
+    if ( !database.tableExists( "lambert_scanner_parameters" ) )
+    {
+        throw std::runtime_error( "ERROR: Creating table 'lambert_scanner_parameters' failed!" );
+    }
+}
 
-                    for ( int i = 0; i < numberOfSolutions; i++ )
-                    {
-                        // Compute Delta-V for transfer.
-                        const Vector3 transferDepartureVelocity = targeter.get_v1( )[ i ];
-                        const Vector3 transferArrivalVelocity = targeter.get_v2( )[ i ];
-
-                        departureDeltaVs[ i ] = sml::add( transferDepartureVelocity,
-                                                          sml::multiply( departureVelocity, -1.0 ) );
-                        arrivalDeltaVs[ i ]   = sml::add( arrivalVelocity,
-                                                          sml::multiply( transferArrivalVelocity, -1.0 ) );
-
-                        transferDeltaVs[ i ]
-                            = sml::norm< double >( departureDeltaVs[ i ] )
-                                + sml::norm< double >( arrivalDeltaVs[ i ] );
-                    }
+//! Store lambert_scanner run parameters.
+void storeLambertScannerParameters( SQLite::Database& database, const LambertScannerInput& input )
+{
+    createLambertScannerParametersTable( database );
 
-                    const TransferDeltaVList::iterator minimumDeltaVIterator
-                        = std::min_element( transferDeltaVs.begin( ), transferDeltaVs.end( ) );
-                    const int minimumDeltaVIndex
-                        = std::distance( transferDeltaVs.begin( ), minimumDeltaVIterator );
+    const std::map< std::string, double > parameters = getLambertScannerParameters( input );
 
-                    const int revolutions = std::floor( ( minimumDeltaVIndex + 1 ) / 2 );
+    SQLite::Statement query(
+        database, "INSERT INTO lambert_scanner_parameters VALUES (:name, :value);" );
+    for ( std::map< std::string, double >::const_iterator iterator = parameters.begin( );
+          iterator != parameters.end( );
+          iterator++ )
+    {
+        query.bind( ":name",  iterator->first );
+        query.bind( ":value", iterator->second );
+        query.executeStep( );
+        query.reset( );
+    }
+}
 
-                    Vector6 transferState;
-                    std::copy( departurePosition.begin( ),
-                               departurePosition.begin( ) + 3,
-                               transferState.begin( ) );
-                    std::copy( targeter.get_v1( )[ minimumDeltaVIndex ].begin( ),
-                               targeter.get_v1( )[ minimumDeltaVIndex ].begin( ) + 3,
-                               transferState.begin( ) + 3 );
+//! Check lambert_scanner run parameters.
+void checkLambertScannerParameters( SQLite::Database& database, const LambertScannerInput& input )
+{
+    if ( !database.tableExists( "lambert_scanner_parameters" ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Run parameters of previous run not found in database; "
+            "resume or incremental update requires a full rerun!" );
+    }
 
-                    const Vector6 transferStateKepler
-                        = astro::convertCartesianToKeplerianElements( transferState,
-                                                                      earthGravitationalParameter );
+    std::map< std::string, double > storedParameters;
+    SQLite::Statement query( database, "SELECT name, value FROM lambert_scanner_parameters;" );
+    while ( query.executeStep( ) )
+    {
+        const std::string name = query.getColumn( 0 );
+        const double value = query.getColumn( 1 );
+        storedParameters[ name ] = value;
+    }
 
-                    // Bind values to SQL insert query.
-                    query.bind( ":departure_object_id",  departureObjectId );
-                    query.bind( ":arrival_object_id",    arrivalObjectId );
-                    query.bind( ":departure_epoch",      departureEpoch.ToJulian( ) );
-                    query.bind( ":time_of_flight",       timeOfFlight );
-                    query.bind( ":revolutions",          revolutions );
-                    query.bind( ":prograde",             input.isPrograde );
-                    query.bind( ":departure_position_x", departureState[ astro::xPositionIndex ] );
-                    query.bind( ":departure_position_y", departureState[ astro::yPositionIndex ] );
-                    query.bind( ":departure_position_z", departureState[ astro::zPositionIndex ] );
-                    query.bind( ":departure_velocity_x", departureState[ astro::xVelocityIndex ] );
-                    query.bind( ":departure_velocity_y", departureState[ astro::yVelocityIndex ] );
-                    query.bind( ":departure_velocity_z", departureState[ astro::zVelocityIndex ] );
-                    query.bind( ":departure_semi_major_axis",
-                        departureStateKepler[ astro::semiMajorAxisIndex ] );
-                    query.bind( ":departure_eccentricity",
-                        departureStateKepler[ astro::eccentricityIndex ] );
-                    query.bind( ":departure_inclination",
-                        departureStateKepler[ astro::inclinationIndex ] );
-                    query.bind( ":departure_argument_of_periapsis",
-                        departureStateKepler[ astro::argumentOfPeriapsisIndex ] );
-                    query.bind( ":departure_longitude_of_ascending_node",
-                        departureStateKepler[ astro::longitudeOfAscendingNodeIndex ] );
-                    query.bind( ":departure_true_anomaly",
-                        departureStateKepler[ astro::trueAnomalyIndex ] );
-                    query.bind( ":arrival_position_x",  arrivalState[ astro::xPositionIndex ] );
-                    query.bind( ":arrival_position_y",  arrivalState[ astro::yPositionIndex ] );
-                    query.bind( ":arrival_position_z",  arrivalState[ astro::zPositionIndex ] );
-                    query.bind( ":arrival_velocity_x",  arrivalState[ astro::xVelocityIndex ] );
-                    query.bind( ":arrival_velocity_y",  arrivalState[ astro::yVelocityIndex ] );
-                    query.bind( ":arrival_velocity_z",  arrivalState[ astro::zVelocityIndex ] );
-                    query.bind( ":arrival_semi_major_axis",
-                        arrivalStateKepler[ astro::semiMajorAxisIndex ] );
-                    query.bind( ":arrival_eccentricity",
-                        arrivalStateKepler[ astro::eccentricityIndex ] );
-                    query.bind( ":arrival_inclination",
-                        arrivalStateKepler[ astro::inclinationIndex ] );
-                    query.bind( ":arrival_argument_of_periapsis",
-                        arrivalStateKepler[ astro::argumentOfPeriapsisIndex ] );
-                    query.bind( ":arrival_longitude_of_ascending_node",
-                        arrivalStateKepler[ astro::longitudeOfAscendingNodeIndex ] );
-                    query.bind( ":arrival_true_anomaly",
-                        arrivalStateKepler[ astro::trueAnomalyIndex ] );
-                    query.bind( ":transfer_semi_major_axis",
-                        transferStateKepler[ astro::semiMajorAxisIndex ] );
-                    query.bind( ":transfer_eccentricity",
-                        transferStateKepler[ astro::eccentricityIndex ] );
-                    query.bind( ":transfer_inclination",
-                        transferStateKepler[ astro::inclinationIndex ] );
-                    query.bind( ":transfer_argument_of_periapsis",
-                        transferStateKepler[ astro::argumentOfPeriapsisIndex ] );
-                    query.bind( ":transfer_longitude_of_ascending_node",
-                        transferStateKepler[ astro::longitudeOfAscendingNodeIndex ] );
-                    query.bind( ":transfer_true_anomaly",
-                        transferStateKepler[ astro::trueAnomalyIndex ] );
-                    query.bind( ":departure_delta_v_x", departureDeltaVs[ minimumDeltaVIndex ][ 0 ] );
-                    query.bind( ":departure_delta_v_y", departureDeltaVs[ minimumDeltaVIndex ][ 1 ] );
-                    query.bind( ":departure_delta_v_z", departureDeltaVs[ minimumDeltaVIndex ][ 2 ] );
-                    query.bind( ":arrival_delta_v_x",   arrivalDeltaVs[ minimumDeltaVIndex ][ 0 ] );
-                    query.bind( ":arrival_delta_v_y",   arrivalDeltaVs[ minimumDeltaVIndex ][ 1 ] );
-                    query.bind( ":arrival_delta_v_z",   arrivalDeltaVs[ minimumDeltaVIndex ][ 2 ] );
-                    query.bind( ":transfer_delta_v",    *minimumDeltaVIterator );
-
-                    // Execute insert query.
-                    query.executeStep( );
-
-                    // Reset SQL insert query.
-                    query.reset( );
-                }
-            }
+    // Parameters are stored as REAL values, which round-trip exactly, so that they are compared
+    // for equality.
+    const std::map< std::string, double > parameters = getLambertScannerParameters( input );
+    for ( std::map< std::string, double >::const_iterator iterator = parameters.begin( );
+          iterator != parameters.end( );
+          iterator++ )
+    {
+        const std::map< std::string, double >::const_iterator storedParameter
+            = storedParameters.find( iterator->first );
+        if ( storedParameter == storedParameters.end( )
+             || storedParameter->second != iterator->second )
+        {
+            std::ostringstream errorMessage;
+            errorMessage << "ERROR: Run parameter \"" << iterator->first
+                         << "\" does not match previous run; "
+                         << "resume or incremental update requires a full rerun!";
+            throw std::runtime_error( errorMessage.str( ) );
         }
-
-        ++showProgress;
     }
+}
 
-    // Commit transaction.
-    transaction.commit( );
+//! Check resume of lambert_scanner run.
+void checkLambertScannerResume( SQLite::Database& database,
+                                const LambertScannerInput& input,
+                                const TleObjects& tleObjects )
+{
+    if ( isLambertScannerTableCompact( database ) != input.isCompact )
+    {
+        throw std::runtime_error(
+            "ERROR: Schema of lambert_scanner table in database does not match input!" );
+    }
 
-    std::cout << std::endl;
-    std::cout << "Database populated successfully!" << std::endl;
-    std::cout << std::endl;
+    checkLambertScannerParameters( database, input );
 
-    // Check if shortlist file should be created; call function to write output.
-    if ( input.shortlistLength > 0 )
+    // Transfers computed for a refreshed catalog cannot be appended to the stored transfers, even
+    // if the objects are the same.
+    std::vector< int > removedObjectIds;
+    const std::vector< bool > isObjectChanged
+        = compareLambertScannerCatalog( database, tleObjects, removedObjectIds );
+    if ( std::find( isObjectChanged.begin( ), isObjectChanged.end( ), true )
+            != isObjectChanged.end( )
+         || !removedObjectIds.empty( ) )
     {
-        std::cout << "Writing shortlist to file ... " << std::endl;
-        writeTransferShortlist( database, input.shortlistLength, input.shortlistPath );
-        std::cout << "Shortlist file created successfully!" << std::endl;
+        throw std::runtime_error(
+            "ERROR: TLE catalog does not match catalog of interrupted run; "
+            "resume requires a full rerun!" );
     }
 }
 
-//! Check lambert_scanner input parameters.
-LambertScannerInput checkLambertScannerInput( const rapidjson::Document& config )
+//! Construct reader for lambert_scanner table.
+LambertScannerTransferReader::LambertScannerTransferReader( SQLite::Database& aDatabase )
+    : isColumnStore( aDatabase.tableExists( "lambert_scanner_column_store" ) ),
+      isCompact( isLambertScannerTableCompact( aDatabase ) ),
+      database( aDatabase )
 {
-    const std::string catalogPath = find( config, "catalog" )->value.GetString( );
-    std::cout << "Catalog                       " << catalogPath << std::endl;
+    if ( isColumnStore )
+    {
+        const std::string columnStorePath
+            = database.execAndGet( "SELECT path FROM lambert_scanner_column_store;" );
+        columnStore.reset( new ColumnStore( columnStorePath ) );
 
-    const std::string databasePath = find( config, "database" )->value.GetString( );
-    std::cout << "Database                      " << databasePath << std::endl;
+        const std::vector< std::string > columnNames = getLambertScannerColumnNames( isCompact );
+        for ( unsigned int i = 0; i < columnNames.size( ); i++ )
+        {
+            columns.push_back( columnStore->getColumn( columnNames[ i ] ) );
+        }
+    }
 
-    const ConfigIterator departureEpochIterator = find( config, "departure_epoch" );
-    std::map< std::string, int > departureEpochElements;
-    if ( departureEpochIterator->value.Size( ) == 0 )
+    if ( !isCompact )
     {
-        DateTime dummyEpoch;
-        departureEpochElements[ "year" ]    = dummyEpoch.Year( );
-        departureEpochElements[ "month" ]   = dummyEpoch.Month( );
-        departureEpochElements[ "day" ]     = dummyEpoch.Day( );
-        departureEpochElements[ "hours" ]   = dummyEpoch.Hour( );
-        departureEpochElements[ "minutes" ] = dummyEpoch.Minute( );
-        departureEpochElements[ "seconds" ] = dummyEpoch.Second( );
+        return;
     }
 
-    else
+    if ( !database.tableExists( "lambert_scanner_catalog" ) )
     {
-        departureEpochElements[ "year" ]    = departureEpochIterator->value[ 0 ].GetInt( );
-        departureEpochElements[ "month" ]   = departureEpochIterator->value[ 1 ].GetInt( );
-        departureEpochElements[ "day" ]     = departureEpochIterator->value[ 2 ].GetInt( );
+        throw std::runtime_error(
+            "ERROR: \"lambert_scanner_catalog\" must exist to read compact lambert_scanner "
+            "table!" );
+    }
 
-        if ( departureEpochIterator->value.Size( ) > 3 )
+    // Load TLE objects used by lambert_scanner and initialize their SGP4 propagators, to
+    // recompute fields omitted in compact schema.
+    SQLite::Statement query( database, "SELECT * FROM lambert_scanner_catalog;" );
+    while ( query.executeStep( ) )
+    {
+        const int objectId = query.getColumn( 1 );
+        const std::string name = query.getColumn( 2 );
+        const std::string line1 = query.getColumn( 3 );
+        const std::string line2 = query.getColumn( 4 );
+        if ( !propagators.insert(
+                std::make_pair( objectId, SGP4( Tle( name, line1, line2 ) ) ) ).second )
         {
-            departureEpochElements[ "hours" ] = departureEpochIterator->value[ 3 ].GetInt( );
-
-            if ( departureEpochIterator->value.Size( ) > 4 )
-            {
-                departureEpochElements[ "minutes" ] = departureEpochIterator->value[ 4 ].GetInt( );
-
-                if ( departureEpochIterator->value.Size( ) > 5 )
-                {
-                    departureEpochElements[ "seconds" ]
-                        = departureEpochIterator->value[ 5 ].GetInt( );
-                }
-            }
+            throw std::runtime_error(
+                "ERROR: NORAD ID occurs more than once in \"lambert_scanner_catalog\"; compact "
+                "lambert_scanner table cannot be read!" );
         }
     }
+}
 
-    const DateTime departureEpoch( departureEpochElements[ "year" ],
-                                   departureEpochElements[ "month" ],
-                                   departureEpochElements[ "day" ],
-                                   departureEpochElements[ "hours" ],
-                                   departureEpochElements[ "minutes" ],
-                                   departureEpochElements[ "seconds" ] );
+//! Read Lambert transfer from lambert_scanner table.
+LambertScannerTransfer LambertScannerTransferReader::read( SQLite::Statement& query,
+                                                           const int firstColumn ) const
+{
+    LambertScannerTransfer transfer;
+    transfer.departureObjectId      = query.getColumn( firstColumn + 1 );
+    transfer.arrivalObjectId        = query.getColumn( firstColumn + 2 );
+    transfer.departureEpoch         = query.getColumn( firstColumn + 3 );
+    transfer.timeOfFlight           = query.getColumn( firstColumn + 4 );
+    transfer.revolutions            = query.getColumn( firstColumn + 5 );
+    transfer.isPrograde             = query.getColumn( firstColumn + 6 ).getInt( ) != 0;
+
+    // Index of first Delta-V column; the 30 columns containing state vectors and Keplerian
+    // elements are omitted in the compact schema.
+    const int deltaVColumn = firstColumn + ( isCompact ? 7 : 37 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        transfer.departureDeltaV[ i ] = query.getColumn( deltaVColumn + i );
+        transfer.arrivalDeltaV[ i ]   = query.getColumn( deltaVColumn + 3 + i );
+    }
+    transfer.transferDeltaV         = query.getColumn( deltaVColumn + 6 );
 
-    if ( departureEpochIterator->value.Size( ) == 0 )
+    if ( isCompact )
     {
-        std::cout << "Departure epoch               TLE epoch" << std::endl;
+        recomputeTransfer( transfer );
+        return transfer;
     }
 
-    else
+    for ( int i = 0; i < 6; i++ )
     {
-        std::cout << "Departure epoch               " << departureEpoch << std::endl;
+        transfer.departureState[ i ]       = query.getColumn( firstColumn + 7 + i );
+        transfer.departureStateKepler[ i ] = query.getColumn( firstColumn + 13 + i );
+        transfer.arrivalState[ i ]         = query.getColumn( firstColumn + 19 + i );
+        transfer.arrivalStateKepler[ i ]   = query.getColumn( firstColumn + 25 + i );
+        transfer.transferStateKepler[ i ]  = query.getColumn( firstColumn + 31 + i );
     }
 
-    const double departureEpochRange
-        = find( config, "departure_epoch_grid" )->value[ 0 ].GetDouble( );
-    std::cout << "Departure epoch grid range    " << departureEpochRange << std::endl;
-    const double departureGridSteps
-        = find( config, "departure_epoch_grid" )->value[ 1 ].GetDouble( );
-    std::cout << "Departure epoch grid steps    " << departureGridSteps << std::endl;
+    return transfer;
+}
 
-    const double timeOfFlightMinimum
-        = find( config, "time_of_flight_grid" )->value[ 0 ].GetDouble( );
-    std::cout << "Minimum Time-of-Flight        " << timeOfFlightMinimum << std::endl;
-    const double timeOfFlightMaximum
-        = find( config, "time_of_flight_grid" )->value[ 1 ].GetDouble( );
-    std::cout << "Maximum Time-of-Flight        " << timeOfFlightMaximum << std::endl;
+//! Read Lambert transfer from column store.
+LambertScannerTransfer LambertScannerTransferReader::read( const long long transferId ) const
+{
+    if ( !isColumnStore )
+    {
+        throw std::runtime_error( "ERROR: lambert_scanner transfers are not stored in column "
+                                  "store!" );
+    }
 
-    if ( timeOfFlightMinimum > timeOfFlightMaximum )
+    if ( transferId < 1 || transferId > columnStore->getNumberOfRows( ) )
     {
-        throw std::runtime_error( "ERROR: Maximum time-of-flight must be larger than minimum!" );
+        throw std::runtime_error( "ERROR: Transfer ID not found in lambert_scanner column store!" );
     }
 
-    const double timeOfFlightSteps
-        = find( config, "time_of_flight_grid" )->value[ 2 ].GetDouble( );
-    std::cout << "# Time-of-Flight steps        " << timeOfFlightSteps << std::endl;
+    // Column indices follow those of the lambert_scanner table, without the transfer_id column.
+    const long long row = transferId - 1;
 
-    const bool isPrograde = find( config, "is_prograde" )->value.GetBool( );
-    if ( isPrograde )
+    LambertScannerTransfer transfer;
+    transfer.departureObjectId      = static_cast< int >( columns[ 0 ][ row ] );
+    transfer.arrivalObjectId        = static_cast< int >( columns[ 1 ][ row ] );
+    transfer.departureEpoch         = columns[ 2 ][ row ];
+    transfer.timeOfFlight           = columns[ 3 ][ row ];
+    transfer.revolutions            = static_cast< int >( columns[ 4 ][ row ] );
+    transfer.isPrograde             = columns[ 5 ][ row ] != 0.0;
+
+    const int deltaVColumn = isCompact ? 6 : 36;
+    for ( int i = 0; i < 3; i++ )
     {
-        std::cout << "Prograde transfer?            true" << std::endl;
+        transfer.departureDeltaV[ i ] = columns[ deltaVColumn + i ][ row ];
+        transfer.arrivalDeltaV[ i ]   = columns[ deltaVColumn + 3 + i ][ row ];
     }
-    else
+    transfer.transferDeltaV         = columns[ deltaVColumn + 6 ][ row ];
+
+    if ( isCompact )
     {
-        std::cout << "Prograde transfer?            false" << std::endl;
+        recomputeTransfer( transfer );
+        return transfer;
     }
 
-    const int revolutionsMaximum = find( config, "revolutions_maximum" )->value.GetInt( );
-    std::cout << "Maximum revolutions           " << revolutionsMaximum << std::endl;
+    for ( int i = 0; i < 6; i++ )
+    {
+        transfer.departureState[ i ]       = columns[ 6 + i ][ row ];
+        transfer.departureStateKepler[ i ] = columns[ 12 + i ][ row ];
+        transfer.arrivalState[ i ]         = columns[ 18 + i ][ row ];
+        transfer.arrivalStateKepler[ i ]   = columns[ 24 + i ][ row ];
+        transfer.transferStateKepler[ i ]  = columns[ 30 + i ][ row ];
+    }
 
-    const int shortlistLength = find( config, "shortlist" )->value[ 0 ].GetInt( );
-    std::cout << "# of shortlist transfers      " << shortlistLength << std::endl;
+    return transfer;
+}
 
-    std::string shortlistPath = "";
-    if ( shortlistLength > 0 )
+//! Get number of transfers stored by lambert_scanner.
+long long LambertScannerTransferReader::getNumberOfTransfers( ) const
+{
+    if ( isColumnStore )
     {
-        shortlistPath = find( config, "shortlist" )->value[ 1 ].GetString( );
-        std::cout << "Shortlist                     " << shortlistPath << std::endl;
+        return columnStore->getNumberOfRows( );
     }
 
-    return LambertScannerInput( catalogPath,
-                                databasePath,
-                                departureEpoch,
-                                departureGridSteps,
-                                departureEpochRange/departureGridSteps,
-                                timeOfFlightMinimum,
-                                timeOfFlightMaximum,
-                                timeOfFlightSteps,
-                                ( timeOfFlightMaximum - timeOfFlightMinimum ) / timeOfFlightSteps,
-                                isPrograde,
-                                revolutionsMaximum,
-                                shortlistLength,
-                                shortlistPath );
+    return database.execAndGet( "SELECT COUNT(*) FROM lambert_scanner_results;" ).getInt64( );
 }
 
-//! Create lambert_scanner table.
-void createLambertScannerTable( SQLite::Database& database )
+//! Get transfer Delta-V column from column store.
+const double* LambertScannerTransferReader::getTransferDeltaVs( ) const
 {
-    // Drop table from database if it exists.
-    database.exec( "DROP TABLE IF EXISTS lambert_scanner_results;" );
+    if ( !isColumnStore )
+    {
+        throw std::runtime_error( "ERROR: lambert_scanner transfers are not stored in column "
+                                  "store!" );
+    }
 
-    // Set up SQL command to create table to store lambert_scanner results.
-    std::ostringstream lambertScannerTableCreate;
-    lambertScannerTableCreate
-        << "CREATE TABLE lambert_scanner_results ("
-        << "\"transfer_id\"                             INTEGER PRIMARY KEY AUTOINCREMENT,"
-        << "\"departure_object_id\"                     TEXT,"
-        << "\"arrival_object_id\"                       TEXT,"
-        << "\"departure_epoch\"                         REAL,"
-        << "\"time_of_flight\"                          REAL,"
-        << "\"revolutions\"                             INTEGER,"
-        // N.B.: SQLite doesn't support booleans so 0 = false, 1 = true for 'prograde'
-        << "\"prograde\"                                INTEGER,"
-        << "\"departure_position_x\"                    REAL,"
-        << "\"departure_position_y\"                    REAL,"
-        << "\"departure_position_z\"                    REAL,"
-        << "\"departure_velocity_x\"                    REAL,"
-        << "\"departure_velocity_y\"                    REAL,"
-        << "\"departure_velocity_z\"                    REAL,"
-        << "\"departure_semi_major_axis\"               REAL,"
-        << "\"departure_eccentricity\"                  REAL,"
-        << "\"departure_inclination\"                   REAL,"
-        << "\"departure_argument_of_periapsis\"         REAL,"
-        << "\"departure_longitude_of_ascending_node\"   REAL,"
-        << "\"departure_true_anomaly\"                  REAL,"
-        << "\"arrival_position_x\"                      REAL,"
-        << "\"arrival_position_y\"                      REAL,"
-        << "\"arrival_position_z\"                      REAL,"
-        << "\"arrival_velocity_x\"                      REAL,"
-        << "\"arrival_velocity_y\"                      REAL,"
-        << "\"arrival_velocity_z\"                      REAL,"
-        << "\"arrival_semi_major_axis\"                 REAL,"
-        << "\"arrival_eccentricity\"                    REAL,"
-        << "\"arrival_inclination\"                     REAL,"
-        << "\"arrival_argument_of_periapsis\"           REAL,"
-        << "\"arrival_longitude_of_ascending_node\"     REAL,"
-        << "\"arrival_true_anomaly\"                    REAL,"
-        << "\"transfer_semi_major_axis\"                REAL,"
-        << "\"transfer_eccentricity\"                   REAL,"
-        << "\"transfer_inclination\"                    REAL,"
-        << "\"transfer_argument_of_periapsis\"          REAL,"
-        << "\"transfer_longitude_of_ascending_node\"    REAL,"
-        << "\"transfer_true_anomaly\"                   REAL,"
-        << "\"departure_delta_v_x\"                     REAL,"
-        << "\"departure_delta_v_y\"                     REAL,"
-        << "\"departure_delta_v_z\"                     REAL,"
-        << "\"arrival_delta_v_x\"                       REAL,"
-        << "\"arrival_delta_v_y\"                       REAL,"
-        << "\"arrival_delta_v_z\"                       REAL,"
-        << "\"transfer_delta_v\"                        REAL"
-        <<                                              ");";
+    return columns.back( );
+}
 
-    // Execute command to create table.
-    database.exec( lambertScannerTableCreate.str( ).c_str( ) );
+//! Recompute fields omitted in compact schema.
+void LambertScannerTransferReader::recomputeTransfer( LambertScannerTransfer& transfer ) const
+{
+    // Recompute states by propagating the departure and arrival objects to the departure and
+    // arrival epochs, as done by lambert_scanner.
+    const std::map< int, SGP4 >::const_iterator sgp4Departure
+        = propagators.find( transfer.departureObjectId );
+    const std::map< int, SGP4 >::const_iterator sgp4Arrival
+        = propagators.find( transfer.arrivalObjectId );
+    if ( sgp4Departure == propagators.end( ) || sgp4Arrival == propagators.end( ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Object in lambert_scanner table not found in lambert_scanner_catalog!" );
+    }
 
-    // Execute command to create index on transfer Delta-V column.
-    std::ostringstream transferDeltaVIndexCreate;
-    transferDeltaVIndexCreate << "CREATE INDEX IF NOT EXISTS \"transfer_delta_v\" on "
-                              << "lambert_scanner_results (transfer_delta_v ASC);";
-    database.exec( transferDeltaVIndexCreate.str( ).c_str( ) );
+    // Set up DateTime object for departure epoch using Julian date.
+    // Note: The transformation given in the following statement is based on how the DateTime
+    //       class internally handles date transformations.
+    const DateTime departureEpoch( ( transfer.departureEpoch
+                                     - astro::ASTRO_GREGORIAN_EPOCH_IN_JULIAN_DAYS )
+                                   * TicksPerDay );
+    const DateTime arrivalEpoch = departureEpoch.AddSeconds( transfer.timeOfFlight );
 
-    if ( !database.tableExists( "lambert_scanner_results" ) )
+    transfer.departureState
+        = getStateVector( sgp4Departure->second.FindPosition( departureEpoch ) );
+    transfer.arrivalState
+        = getStateVector( sgp4Arrival->second.FindPosition( arrivalEpoch ) );
+
+    // Recompute Keplerian elements of departure, arrival and transfer orbits.
+    const double earthGravitationalParameter = kMU;
+    transfer.departureStateKepler = astro::convertCartesianToKeplerianElements(
+        transfer.departureState, earthGravitationalParameter );
+    transfer.arrivalStateKepler = astro::convertCartesianToKeplerianElements(
+        transfer.arrivalState, earthGravitationalParameter );
+
+    Vector6 transferState = transfer.departureState;
+    for ( int i = 0; i < 3; i++ )
     {
-        throw std::runtime_error( "ERROR: Creating table 'lambert_scanner_results' failed!" );
+        transferState[ astro::xVelocityIndex + i ] += transfer.departureDeltaV[ i ];
     }
+    transfer.transferStateKepler = astro::convertCartesianToKeplerianElements(
+        transferState, earthGravitationalParameter );
 }
 
-//! Write transfer shortlist to file.
-void writeTransferShortlist( SQLite::Database& database,
-                             const int shortlistNumber,
-                             const std::string& shortlistPath )
+//! Fetch Lambert transfer shortlist from database.
+LambertScannerShortlistEntries fetchLambertScannerShortlist( SQLite::Database& database,
+                                                             const int shortlistLength )
 {
-    // Fetch transfers to include in shortlist.
-    // Database table is sorted by transfer_delta_v, in ascending order.
     std::ostringstream shortlistSelect;
-    shortlistSelect << "SELECT * FROM lambert_scanner_results ORDER BY transfer_delta_v ASC LIMIT "
-                    << shortlistNumber << ";";
+    shortlistSelect << "SELECT * FROM lambert_scanner_results "
+                    << "ORDER BY transfer_delta_v ASC, transfer_id ASC LIMIT "
+                    << shortlistLength << ";";
     SQLite::Statement query( database, shortlistSelect.str( ) );
 
-    // Write fetch data to file.
+    const LambertScannerTransferReader reader( database );
+
+    LambertScannerShortlistEntries shortlistEntries;
+    while ( query.executeStep( ) )
+    {
+        // Transfers stored by a previous run precede all transfers in the work queue.
+        LambertScannerShortlistEntry entry( reader.read( query ), 0, 0 );
+        entry.transferId = query.getColumn( 0 );
+        shortlistEntries.push_back( entry );
+    }
+
+    return shortlistEntries;
+}
+
+//! Write transfer shortlist to file.
+void writeTransferShortlist( const LambertScannerShortlistEntries& shortlistEntries,
+                             const std::string& shortlistPath )
+{
+    // Write shortlist entries to file.
     std::ofstream shortlistFile( shortlistPath.c_str( ) );
 
     // Print file header.
@@ -635,99 +2638,55 @@ void writeTransferShortlist( SQLite::Database& database,
                   << "transfer_delta_v"
                   << std::endl;
 
-    // Loop through data retrieved from database and write to file.
-    while( query.executeStep( ) )
-    {
-        const int    transferId                         = query.getColumn( 0 );
-        const int    departureObjectId                  = query.getColumn( 1 );
-        const int    arrivalObjectId                    = query.getColumn( 2 );
-        const double departureEpoch                     = query.getColumn( 3 );
-        const double timeOfFlight                       = query.getColumn( 4 );
-        const int    revolutions                        = query.getColumn( 5 );
-        const int    prograde                           = query.getColumn( 6 );
-        const double departurePositionX                 = query.getColumn( 7 );
-        const double departurePositionY                 = query.getColumn( 8 );
-        const double departurePositionZ                 = query.getColumn( 9 );
-        const double departureVelocityX                 = query.getColumn( 10 );
-        const double departureVelocityY                 = query.getColumn( 11 );
-        const double departureVelocityZ                 = query.getColumn( 12 );
-        const double departureSemiMajorAxis             = query.getColumn( 13 );
-        const double departureEccentricity              = query.getColumn( 14 );
-        const double departureInclination               = query.getColumn( 15 );
-        const double departureArgumentOfPeriapsis       = query.getColumn( 16 );
-        const double departureLongitudeOfAscendingNode  = query.getColumn( 17 );
-        const double departureTrueAnomaly               = query.getColumn( 18 );
-        const double arrivalPositionX                   = query.getColumn( 19 );
-        const double arrivalPositionY                   = query.getColumn( 20 );
-        const double arrivalPositionZ                   = query.getColumn( 21 );
-        const double arrivalVelocityX                   = query.getColumn( 22 );
-        const double arrivalVelocityY                   = query.getColumn( 23 );
-        const double arrivalVelocityZ                   = query.getColumn( 24 );
-        const double arrivalSemiMajorAxis               = query.getColumn( 25 );
-        const double arrivalEccentricity                = query.getColumn( 26 );
-        const double arrivalInclination                 = query.getColumn( 27 );
-        const double arrivalArgumentOfPeriapsis         = query.getColumn( 28 );
-        const double arrivalLongitudeOfAscendingNode    = query.getColumn( 29 );
-        const double arrivalTrueAnomaly                 = query.getColumn( 30 );
-        const double transferSemiMajorAxis              = query.getColumn( 31 );
-        const double transferEccentricity               = query.getColumn( 32 );
-        const double transferInclination                = query.getColumn( 33 );
-        const double transferArgumentOfPeriapsis        = query.getColumn( 34 );
-        const double transferLongitudeOfAscendingNode   = query.getColumn( 35 );
-        const double transferTrueAnomaly                = query.getColumn( 36 );
-        const double departureDeltaVX                   = query.getColumn( 37 );
-        const double departureDeltaVY                   = query.getColumn( 38 );
-        const double departureDeltaVZ                   = query.getColumn( 39 );
-        const double arrivalDeltaVX                     = query.getColumn( 40 );
-        const double arrivalDeltaVY                     = query.getColumn( 41 );
-        const double arrivalDeltaVZ                     = query.getColumn( 42 );
-        const double transferDeltaV                     = query.getColumn( 43 );
-
-        shortlistFile << transferId                         << ","
-                      << departureObjectId                  << ","
-                      << arrivalObjectId                    << ","
-                      << departureEpoch                     << ","
-                      << timeOfFlight                       << ","
-                      << revolutions                        << ","
-                      << prograde                           << ","
-                      << departurePositionX                 << ","
-                      << departurePositionY                 << ","
-                      << departurePositionZ                 << ","
-                      << departureVelocityX                 << ","
-                      << departureVelocityY                 << ","
-                      << departureVelocityZ                 << ","
-                      << departureSemiMajorAxis             << ","
-                      << departureEccentricity              << ","
-                      << departureInclination               << ","
-                      << departureArgumentOfPeriapsis       << ","
-                      << departureLongitudeOfAscendingNode  << ","
-                      << departureTrueAnomaly               << ","
-                      << arrivalPositionX                   << ","
-                      << arrivalPositionY                   << ","
-                      << arrivalPositionZ                   << ","
-                      << arrivalVelocityX                   << ","
-                      << arrivalVelocityY                   << ","
-                      << arrivalVelocityZ                   << ","
-                      << arrivalSemiMajorAxis               << ","
-                      << arrivalEccentricity                << ","
-                      << arrivalInclination                 << ","
-                      << arrivalArgumentOfPeriapsis         << ","
-                      << arrivalLongitudeOfAscendingNode    << ","
-                      << arrivalTrueAnomaly                 << ","
-                      << transferSemiMajorAxis              << ","
-                      << transferEccentricity               << ","
-                      << transferInclination                << ","
-                      << transferArgumentOfPeriapsis        << ","
-                      << transferLongitudeOfAscendingNode   << ","
-                      << transferTrueAnomaly                << ","
-                      << departureDeltaVX                   << ","
-                      << departureDeltaVY                   << ","
-                      << departureDeltaVZ                   << ","
-                      << arrivalDeltaVX                     << ","
-                      << arrivalDeltaVY                     << ","
-                      << arrivalDeltaVZ                     << ","
-                      << transferDeltaV
-                      << std::endl;
+    // Loop through shortlist entries and write to file.
+    for ( unsigned int i = 0; i < shortlistEntries.size( ); i++ )
+    {
+        const LambertScannerTransfer& transfer = shortlistEntries[ i ].transfer;
+
+        shortlistFile << shortlistEntries[ i ].transferId                   << ","
+                      << transfer.departureObjectId                         << ","
+                      << transfer.arrivalObjectId                           << ","
+                      << transfer.departureEpoch                            << ","
+                      << transfer.timeOfFlight                              << ","
+                      << transfer.revolutions                               << ","
+                      << static_cast< int >( transfer.isPrograde )          << ",";
+
+        for ( unsigned int j = 0; j < transfer.departureState.size( ); j++ )
+        {
+            shortlistFile << transfer.departureState[ j ] << ",";
+        }
+
+        for ( unsigned int j = 0; j < transfer.departureStateKepler.size( ); j++ )
+        {
+            shortlistFile << transfer.departureStateKepler[ j ] << ",";
+        }
+
+        for ( unsigned int j = 0; j < transfer.arrivalState.size( ); j++ )
+        {
+            shortlistFile << transfer.arrivalState[ j ] << ",";
+        }
+
+        for ( unsigned int j = 0; j < transfer.arrivalStateKepler.size( ); j++ )
+        {
+            shortlistFile << transfer.arrivalStateKepler[ j ] << ",";
+        }
+
+        for ( unsigned int j = 0; j < transfer.transferStateKepler.size( ); j++ )
+        {
+            shortlistFile << transfer.transferStateKepler[ j ] << ",";
+        }
+
+        for ( unsigned int j = 0; j < transfer.departureDeltaV.size( ); j++ )
+        {
+            shortlistFile << transfer.departureDeltaV[ j ] << ",";
+        }
+
+        for ( unsigned int j = 0; j < transfer.arrivalDeltaV.size( ); j++ )
+        {
+            shortlistFile << transfer.arrivalDeltaV[ j ] << ",";
+        }
+
+        shortlistFile << transfer.transferDeltaV << std::endl;
     }
 
     shortlistFile.close( );
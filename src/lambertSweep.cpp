@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <libsgp4/Globals.h>
+
+#include "D2D/ephemeris.hpp"
+#include "D2D/lambertSweep.hpp"
+#include "D2D/tleCatalog.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+
+//! Execute lambert_sweep.
+void executeLambertSweep( const rapidjson::Document& config )
+{
+    // Verify config parameters. Exception is thrown if any of the parameters are missing.
+    const std::vector< LambertScannerInput > inputs = checkLambertSweepInput( config );
+
+    // Set gravitational parameter used by Lambert targeter.
+    const double earthGravitationalParameter = kMU;
+    std::cout << "Earth gravitational parameter " << earthGravitationalParameter
+              << " kg m^3 s^-2" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << "                       Simulation & Output                        " << std::endl;
+    std::cout << "******************************************************************" << std::endl;
+    std::cout << std::endl;
+
+    // The catalog is parsed and propagated using as many threads as the variant that uses most.
+    int threads = 1;
+    for ( unsigned int i = 0; i < inputs.size( ); i++ )
+    {
+        threads = std::max( threads, inputs[ i ].threads );
+    }
+
+    // The catalog is common to all variants.
+    std::cout << "Parsing TLE catalog ... " << std::endl;
+    const TleCatalog catalog( inputs[ 0 ].catalogPath );
+    const TleObjects tleObjects = catalog.getTleObjects( threads );
+    std::cout << tleObjects.size( ) << " TLE objects parsed from catalog!" << std::endl;
+
+    // Propagate all objects once to all distinct epochs spanned by the grids of all variants.
+    std::cout << "Computing ephemerides ... " << std::endl;
+    const std::vector< LambertScannerEpochGrid > epochGrids
+        = computeLambertScannerEpochGrids( inputs );
+    const std::unique_ptr< const EphemerisTable > ephemerides
+        = computeEphemerisTable( tleObjects,
+                                 catalog.computeHash( ),
+                                 epochGrids[ 0 ].epochs,
+                                 earthGravitationalParameter,
+                                 threads,
+                                 inputs[ 0 ].ephemerisCachePath );
+    std::cout << "Ephemerides computed for " << epochGrids[ 0 ].epochs.size( ) << " epochs!"
+              << std::endl;
+
+    for ( unsigned int i = 0; i < inputs.size( ); i++ )
+    {
+        std::cout << std::endl;
+        std::cout << "Running variant " << i + 1 << " of " << inputs.size( ) << ": "
+                  << inputs[ i ].databasePath << std::endl;
+        runLambertScanner( inputs[ i ], tleObjects, epochGrids[ i ], *ephemerides );
+    }
+}
+
+//! Get lambert_sweep variant configuration.
+void getLambertSweepVariantConfig( const rapidjson::Document& config,
+                                   const rapidjson::Value& variant,
+                                   rapidjson::Document& variantConfig )
+{
+    if ( !variant.IsObject( ) )
+    {
+        throw std::runtime_error( "ERROR: Each lambert_sweep variant must be an object!" );
+    }
+
+    if ( variant.HasMember( "mode" )
+         || variant.HasMember( "catalog" )
+         || variant.HasMember( "ephemeris_cache" ) )
+    {
+        throw std::runtime_error( "ERROR: Mode, catalog and ephemeris cache cannot be overridden "
+                                  "by lambert_sweep variant!" );
+    }
+
+    overrideConfig( config, variant, variantConfig );
+    variantConfig.RemoveMember( "variants" );
+}
+
+//! Check lambert_sweep input parameters.
+std::vector< LambertScannerInput > checkLambertSweepInput( const rapidjson::Document& config )
+{
+    const rapidjson::Value& variants = find( config, "variants" )->value;
+    if ( !variants.IsArray( ) || variants.Size( ) == 0 )
+    {
+        throw std::runtime_error( "ERROR: At least one lambert_sweep variant must be specified!" );
+    }
+    std::cout << "# of variants                 " << variants.Size( ) << std::endl;
+
+    std::vector< LambertScannerInput > inputs;
+    for ( unsigned int i = 0; i < variants.Size( ); i++ )
+    {
+        if ( !variants[ i ].IsObject( ) || !variants[ i ].HasMember( "database" ) )
+        {
+            std::ostringstream error;
+            error << "ERROR: Database must be specified for lambert_sweep variant " << i + 1
+                  << "!";
+            throw std::runtime_error( error.str( ) );
+        }
+
+        std::cout << std::endl;
+        std::cout << "Variant                       " << i + 1 << std::endl;
+
+        rapidjson::Document variantConfig;
+        getLambertSweepVariantConfig( config, variants[ i ], variantConfig );
+        inputs.push_back( checkLambertScannerInput( variantConfig ) );
+
+        for ( unsigned int j = 0; j < i; j++ )
+        {
+            if ( inputs[ j ].databasePath == inputs[ i ].databasePath )
+            {
+                throw std::runtime_error(
+                    "ERROR: Each lambert_sweep variant must write to its own database!" );
+            }
+        }
+    }
+
+    return inputs;
+}
+
+} // namespace d2d
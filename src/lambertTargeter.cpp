@@ -0,0 +1,707 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "D2D/lambertTargeter.hpp"
+
+namespace d2d
+{
+
+//! Compute hypergeometric function 2F1(3, 1, 5/2, z) used in Battin's series.
+static double computeHypergeometricF( const double z, const double tolerance )
+{
+    double sum = 1.0;
+    double term = 1.0;
+    double error = 1.0;
+    int j = 0;
+    while ( error > tolerance )
+    {
+        term = term * ( 3.0 + j ) * ( 1.0 + j ) / ( 2.5 + j ) * z / ( j + 1 );
+        sum += term;
+        error = std::fabs( term );
+        ++j;
+    }
+
+    return sum;
+}
+
+//! Compute non-dimensional Lambert time-of-flight.
+double computeLambertTimeOfFlight( const double lambda, const double x, const int revolutions )
+{
+    const double battinThreshold = 0.01;
+    const double lagrangeThreshold = 0.2;
+    const double distance = std::fabs( x - 1.0 );
+    if ( distance < lagrangeThreshold && distance > battinThreshold )
+    {
+        return computeLambertTimeOfFlightLagrange( lambda, x, revolutions );
+    }
+
+    const double pi = boost::math::constants::pi< double >( );
+    const double lambdaSquared = lambda * lambda;
+    const double energy = x * x - 1.0;
+    const double rho = std::fabs( energy );
+    const double z = std::sqrt( 1.0 + lambdaSquared * energy );
+
+    if ( distance < battinThreshold )
+    {
+        // Use Battin's series.
+        const double eta = z - lambda * x;
+        const double s1 = 0.5 * ( 1.0 - lambda - x * eta );
+        const double q = 4.0 / 3.0 * computeHypergeometricF( s1, 1.0e-11 );
+        return ( eta * eta * eta * q + 4.0 * lambda * eta ) / 2.0
+               + revolutions * pi / std::pow( rho, 1.5 );
+    }
+
+    // Use Lancaster's expression.
+    const double y = std::sqrt( rho );
+    const double g = x * z - lambda * energy;
+    double d = 0.0;
+    if ( energy < 0.0 )
+    {
+        d = revolutions * pi + std::acos( g );
+    }
+
+    else
+    {
+        d = std::log( y * ( z - lambda * x ) + g );
+    }
+
+    return ( x - lambda * z - d / y ) / energy;
+}
+
+//! Compute non-dimensional Lambert time-of-flight using Lagrange's expression.
+double computeLambertTimeOfFlightLagrange( const double lambda,
+                                           const double x,
+                                           const int revolutions )
+{
+    const double pi = boost::math::constants::pi< double >( );
+    const double a = 1.0 / ( 1.0 - x * x );
+
+    if ( a > 0.0 )
+    {
+        // Elliptic transfer.
+        const double alpha = 2.0 * std::acos( x );
+        double beta = 2.0 * std::asin( std::sqrt( lambda * lambda / a ) );
+        if ( lambda < 0.0 )
+        {
+            beta = -beta;
+        }
+
+        return ( a * std::sqrt( a )
+                 * ( ( alpha - std::sin( alpha ) ) - ( beta - std::sin( beta ) )
+                     + 2.0 * pi * revolutions ) ) / 2.0;
+    }
+
+    // Hyperbolic transfer.
+    const double alpha = 2.0 * std::acosh( x );
+    double beta = 2.0 * std::asinh( std::sqrt( -lambda * lambda / a ) );
+    if ( lambda < 0.0 )
+    {
+        beta = -beta;
+    }
+
+    return ( -a * std::sqrt( -a )
+             * ( ( beta - std::sinh( beta ) ) - ( alpha - std::sinh( alpha ) ) ) ) / 2.0;
+}
+
+//! Compute derivatives of non-dimensional Lambert time-of-flight.
+void computeLambertTimeOfFlightDerivatives( const double lambda,
+                                            const double x,
+                                            const double timeOfFlight,
+                                            double& firstDerivative,
+                                            double& secondDerivative,
+                                            double& thirdDerivative )
+{
+    const double lambdaSquared = lambda * lambda;
+    const double lambdaCubed = lambdaSquared * lambda;
+    const double oneMinusXSquared = 1.0 - x * x;
+    const double y = std::sqrt( 1.0 - lambdaSquared * oneMinusXSquared );
+    const double yCubed = y * y * y;
+
+    firstDerivative = 1.0 / oneMinusXSquared
+                      * ( 3.0 * timeOfFlight * x - 2.0 + 2.0 * lambdaCubed * x / y );
+    secondDerivative = 1.0 / oneMinusXSquared
+                       * ( 3.0 * timeOfFlight + 5.0 * x * firstDerivative
+                           + 2.0 * ( 1.0 - lambdaSquared ) * lambdaCubed / yCubed );
+    thirdDerivative = 1.0 / oneMinusXSquared
+                      * ( 7.0 * x * secondDerivative + 8.0 * firstDerivative
+                          - 6.0 * ( 1.0 - lambdaSquared ) * lambdaSquared * lambdaCubed * x
+                            / yCubed / ( y * y ) );
+}
+
+//! Construct batched Lambert targeter.
+LambertBatchTargeter::LambertBatchTargeter( const int aBatchSizeMaximum,
+                                            const int aRevolutionsMaximum )
+    : batchSizeMaximum( std::max( aBatchSizeMaximum, 1 ) ),
+      revolutionsMaximum( std::max( aRevolutionsMaximum, 0 ) ),
+      numberOfProblems( 0 ),
+      numberOfIterations( 0 ),
+      lambdas( batchSizeMaximum ),
+      nonDimensionalTimesOfFlight( batchSizeMaximum ),
+      timesOfFlightZero( batchSizeMaximum ),
+      timesOfFlightParabolic( batchSizeMaximum ),
+      gammas( batchSizeMaximum ),
+      rhos( batchSizeMaximum ),
+      sigmas( batchSizeMaximum ),
+      departureRadii( batchSizeMaximum ),
+      arrivalRadii( batchSizeMaximum ),
+      revolutions( batchSizeMaximum ),
+      numberOfSolutions( batchSizeMaximum ),
+      iterationX( batchSizeMaximum ),
+      iterationTimesOfFlight( batchSizeMaximum ),
+      iterationXNew( batchSizeMaximum ),
+      isIterating( batchSizeMaximum ),
+      xSolutions( ( 2 * revolutionsMaximum + 1 ) * batchSizeMaximum )
+{
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureRadialUnitVectors[ i ].resize( batchSizeMaximum );
+        arrivalRadialUnitVectors[ i ].resize( batchSizeMaximum );
+        departureTangentialUnitVectors[ i ].resize( batchSizeMaximum );
+        arrivalTangentialUnitVectors[ i ].resize( batchSizeMaximum );
+        departureVelocities[ i ].resize( xSolutions.size( ) );
+        arrivalVelocities[ i ].resize( xSolutions.size( ) );
+    }
+}
+
+//! Solve batch of Lambert problems.
+void LambertBatchTargeter::solve( const std::vector< Vector3 >& departurePositions,
+                                  const std::vector< Vector3 >& arrivalPositions,
+                                  const std::vector< double >& timesOfFlight,
+                                  const double gravitationalParameter,
+                                  const bool isRetrograde,
+                                  const bool isWarmStarted )
+{
+    if ( departurePositions.size( ) != timesOfFlight.size( )
+         || arrivalPositions.size( ) != timesOfFlight.size( ) )
+    {
+        throw std::runtime_error( "ERROR: Lambert targeter batch lists must have equal size!" );
+    }
+
+    if ( timesOfFlight.size( ) > static_cast< unsigned int >( batchSizeMaximum ) )
+    {
+        throw std::runtime_error( "ERROR: Lambert targeter batch size exceeds maximum!" );
+    }
+
+    if ( !( gravitationalParameter > 0.0 ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Lambert targeter gravitational parameter must be positive!" );
+    }
+
+    numberOfProblems = timesOfFlight.size( );
+
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        computeGeometry( i,
+                         departurePositions[ i ],
+                         arrivalPositions[ i ],
+                         timesOfFlight[ i ],
+                         gravitationalParameter,
+                         isRetrograde );
+    }
+
+    computeRevolutions( );
+
+    // Solve for free parameter of zero-revolution solutions and of left and right branch
+    // solutions for each number of revolutions.
+    numberOfIterations = 0;
+    for ( int j = 0; j < 2 * revolutionsMaximum + 1; j++ )
+    {
+        const double tolerance = j == 0 ? 1.0e-5 : 1.0e-8;
+        if ( isWarmStarted )
+        {
+            solveHouseholderWarmStarted( j, tolerance, 15 );
+        }
+
+        else
+        {
+            solveHouseholder( j, tolerance, 15 );
+        }
+    }
+
+    // Reconstruct departure and arrival velocities from free parameter.
+    for ( int j = 0; j < 2 * revolutionsMaximum + 1; j++ )
+    {
+        for ( int i = 0; i < numberOfProblems; i++ )
+        {
+            if ( j >= numberOfSolutions[ i ] )
+            {
+                continue;
+            }
+
+            const int index = j * batchSizeMaximum + i;
+            const double lambda = lambdas[ i ];
+            const double lambdaSquared = lambda * lambda;
+            const double x = xSolutions[ index ];
+            const double y = std::sqrt( 1.0 - lambdaSquared + lambdaSquared * x * x );
+            const double departureRadialVelocity
+                = gammas[ i ] * ( ( lambda * y - x ) - rhos[ i ] * ( lambda * y + x ) )
+                  / departureRadii[ i ];
+            const double arrivalRadialVelocity
+                = -gammas[ i ] * ( ( lambda * y - x ) + rhos[ i ] * ( lambda * y + x ) )
+                  / arrivalRadii[ i ];
+            const double tangentialVelocity = gammas[ i ] * sigmas[ i ] * ( y + lambda * x );
+            const double departureTangentialVelocity = tangentialVelocity / departureRadii[ i ];
+            const double arrivalTangentialVelocity = tangentialVelocity / arrivalRadii[ i ];
+
+            for ( int k = 0; k < 3; k++ )
+            {
+                departureVelocities[ k ][ index ]
+                    = departureRadialVelocity * departureRadialUnitVectors[ k ][ i ]
+                      + departureTangentialVelocity * departureTangentialUnitVectors[ k ][ i ];
+                arrivalVelocities[ k ][ index ]
+                    = arrivalRadialVelocity * arrivalRadialUnitVectors[ k ][ i ]
+                      + arrivalTangentialVelocity * arrivalTangentialUnitVectors[ k ][ i ];
+            }
+        }
+    }
+}
+
+//! Compute transfer geometry.
+void LambertBatchTargeter::computeGeometry( const int problemIndex,
+                                            const Vector3& departurePosition,
+                                            const Vector3& arrivalPosition,
+                                            const double timeOfFlight,
+                                            const double gravitationalParameter,
+                                            const bool isRetrograde )
+{
+    if ( !( timeOfFlight > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Lambert targeter time-of-flight must be positive!" );
+    }
+
+    // Compute chord, radii and semi-perimeter of transfer triangle.
+    const double chord = std::sqrt(
+        ( arrivalPosition[ 0 ] - departurePosition[ 0 ] )
+            * ( arrivalPosition[ 0 ] - departurePosition[ 0 ] )
+        + ( arrivalPosition[ 1 ] - departurePosition[ 1 ] )
+            * ( arrivalPosition[ 1 ] - departurePosition[ 1 ] )
+        + ( arrivalPosition[ 2 ] - departurePosition[ 2 ] )
+            * ( arrivalPosition[ 2 ] - departurePosition[ 2 ] ) );
+    const double departureRadius = std::sqrt( departurePosition[ 0 ] * departurePosition[ 0 ]
+                                              + departurePosition[ 1 ] * departurePosition[ 1 ]
+                                              + departurePosition[ 2 ] * departurePosition[ 2 ] );
+    const double arrivalRadius = std::sqrt( arrivalPosition[ 0 ] * arrivalPosition[ 0 ]
+                                            + arrivalPosition[ 1 ] * arrivalPosition[ 1 ]
+                                            + arrivalPosition[ 2 ] * arrivalPosition[ 2 ] );
+    const double semiPerimeter = ( chord + departureRadius + arrivalRadius ) / 2.0;
+
+    // Compute radial, normal and tangential unit vectors at departure and arrival.
+    Vector3 departureRadialUnitVector;
+    Vector3 arrivalRadialUnitVector;
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureRadialUnitVector[ i ] = departurePosition[ i ] / departureRadius;
+        arrivalRadialUnitVector[ i ] = arrivalPosition[ i ] / arrivalRadius;
+    }
+
+    Vector3 normalUnitVector;
+    normalUnitVector[ 0 ] = departureRadialUnitVector[ 1 ] * arrivalRadialUnitVector[ 2 ]
+                            - departureRadialUnitVector[ 2 ] * arrivalRadialUnitVector[ 1 ];
+    normalUnitVector[ 1 ] = departureRadialUnitVector[ 2 ] * arrivalRadialUnitVector[ 0 ]
+                            - departureRadialUnitVector[ 0 ] * arrivalRadialUnitVector[ 2 ];
+    normalUnitVector[ 2 ] = departureRadialUnitVector[ 0 ] * arrivalRadialUnitVector[ 1 ]
+                            - departureRadialUnitVector[ 1 ] * arrivalRadialUnitVector[ 0 ];
+    const double normalNorm = std::sqrt( normalUnitVector[ 0 ] * normalUnitVector[ 0 ]
+                                         + normalUnitVector[ 1 ] * normalUnitVector[ 1 ]
+                                         + normalUnitVector[ 2 ] * normalUnitVector[ 2 ] );
+    for ( int i = 0; i < 3; i++ )
+    {
+        normalUnitVector[ i ] /= normalNorm;
+    }
+
+    if ( normalUnitVector[ 2 ] == 0.0 )
+    {
+        throw std::runtime_error( "ERROR: Lambert targeter angular momentum vector has no z "
+                                  "component; direction of motion cannot be determined!" );
+    }
+
+    const double lambdaSquared = 1.0 - chord / semiPerimeter;
+    double lambda = std::sqrt( lambdaSquared );
+
+    // The transfer angle is larger than 180 degrees if the angular momentum vector points in the
+    // negative z-direction.
+    const double normalSign = normalUnitVector[ 2 ] < 0.0 ? -1.0 : 1.0;
+    if ( normalUnitVector[ 2 ] < 0.0 )
+    {
+        lambda = -lambda;
+    }
+
+    Vector3 departureTangentialUnitVector;
+    Vector3 arrivalTangentialUnitVector;
+    departureTangentialUnitVector[ 0 ] = normalUnitVector[ 1 ] * departureRadialUnitVector[ 2 ]
+                                         - normalUnitVector[ 2 ] * departureRadialUnitVector[ 1 ];
+    departureTangentialUnitVector[ 1 ] = normalUnitVector[ 2 ] * departureRadialUnitVector[ 0 ]
+                                         - normalUnitVector[ 0 ] * departureRadialUnitVector[ 2 ];
+    departureTangentialUnitVector[ 2 ] = normalUnitVector[ 0 ] * departureRadialUnitVector[ 1 ]
+                                         - normalUnitVector[ 1 ] * departureRadialUnitVector[ 0 ];
+    arrivalTangentialUnitVector[ 0 ] = normalUnitVector[ 1 ] * arrivalRadialUnitVector[ 2 ]
+                                       - normalUnitVector[ 2 ] * arrivalRadialUnitVector[ 1 ];
+    arrivalTangentialUnitVector[ 1 ] = normalUnitVector[ 2 ] * arrivalRadialUnitVector[ 0 ]
+                                       - normalUnitVector[ 0 ] * arrivalRadialUnitVector[ 2 ];
+    arrivalTangentialUnitVector[ 2 ] = normalUnitVector[ 0 ] * arrivalRadialUnitVector[ 1 ]
+                                       - normalUnitVector[ 1 ] * arrivalRadialUnitVector[ 0 ];
+
+    // Tangential unit vectors are flipped for transfer angles larger than 180 degrees
+    // (normalSign) and for retrograde transfers.
+    const double tangentialSign = isRetrograde ? -normalSign : normalSign;
+    double departureTangentialNorm = 0.0;
+    double arrivalTangentialNorm = 0.0;
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureTangentialNorm
+            += departureTangentialUnitVector[ i ] * departureTangentialUnitVector[ i ];
+        arrivalTangentialNorm
+            += arrivalTangentialUnitVector[ i ] * arrivalTangentialUnitVector[ i ];
+    }
+    departureTangentialNorm = std::sqrt( departureTangentialNorm );
+    arrivalTangentialNorm = std::sqrt( arrivalTangentialNorm );
+
+    if ( isRetrograde )
+    {
+        lambda = -lambda;
+    }
+
+    const double lambdaCubed = lambda * lambdaSquared;
+    const double rho = ( departureRadius - arrivalRadius ) / chord;
+
+    lambdas[ problemIndex ] = lambda;
+    nonDimensionalTimesOfFlight[ problemIndex ]
+        = std::sqrt( 2.0 * gravitationalParameter
+                     / ( semiPerimeter * semiPerimeter * semiPerimeter ) ) * timeOfFlight;
+    timesOfFlightZero[ problemIndex ]
+        = std::acos( lambda ) + lambda * std::sqrt( 1.0 - lambdaSquared );
+    timesOfFlightParabolic[ problemIndex ] = 2.0 / 3.0 * ( 1.0 - lambdaCubed );
+    gammas[ problemIndex ] = std::sqrt( gravitationalParameter * semiPerimeter / 2.0 );
+    rhos[ problemIndex ] = rho;
+    sigmas[ problemIndex ] = std::sqrt( 1.0 - rho * rho );
+    departureRadii[ problemIndex ] = departureRadius;
+    arrivalRadii[ problemIndex ] = arrivalRadius;
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureRadialUnitVectors[ i ][ problemIndex ] = departureRadialUnitVector[ i ];
+        arrivalRadialUnitVectors[ i ][ problemIndex ] = arrivalRadialUnitVector[ i ];
+        departureTangentialUnitVectors[ i ][ problemIndex ]
+            = departureTangentialUnitVector[ i ] * tangentialSign / departureTangentialNorm;
+        arrivalTangentialUnitVectors[ i ][ problemIndex ]
+            = arrivalTangentialUnitVector[ i ] * tangentialSign / arrivalTangentialNorm;
+    }
+}
+
+//! Compute maximum number of revolutions.
+void LambertBatchTargeter::computeRevolutions( )
+{
+    const double pi = boost::math::constants::pi< double >( );
+
+    // Determine maximum number of revolutions for which a time-of-flight not exceeding the given
+    // time-of-flight may exist; the minimum time-of-flight for this number of revolutions is only
+    // computed if the given time-of-flight is shorter than the time-of-flight for x = 0.
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        revolutions[ i ] = static_cast< int >( nonDimensionalTimesOfFlight[ i ] / pi );
+        iterationTimesOfFlight[ i ] = timesOfFlightZero[ i ] + revolutions[ i ] * pi;
+        iterationX[ i ] = 0.0;
+        iterationXNew[ i ] = 0.0;
+        isIterating[ i ] = revolutions[ i ] > 0
+                           && nonDimensionalTimesOfFlight[ i ] < iterationTimesOfFlight[ i ];
+    }
+
+    // Find minimum time-of-flight for maximum number of revolutions using Halley iterations,
+    // executed in lock-step for all problems.
+    for ( int iteration = 0; iteration < 14; iteration++ )
+    {
+        for ( int i = 0; i < numberOfProblems; i++ )
+        {
+            if ( !isIterating[ i ] )
+            {
+                continue;
+            }
+
+            double firstDerivative = 0.0;
+            double secondDerivative = 0.0;
+            double thirdDerivative = 0.0;
+            computeLambertTimeOfFlightDerivatives( lambdas[ i ],
+                                                   iterationX[ i ],
+                                                   iterationTimesOfFlight[ i ],
+                                                   firstDerivative,
+                                                   secondDerivative,
+                                                   thirdDerivative );
+            double xNew = iterationXNew[ i ];
+            if ( firstDerivative != 0.0 )
+            {
+                xNew = iterationX[ i ] - firstDerivative * secondDerivative
+                                         / ( secondDerivative * secondDerivative
+                                             - firstDerivative * thirdDerivative / 2.0 );
+            }
+            iterationXNew[ i ] = xNew;
+
+            if ( std::fabs( iterationX[ i ] - xNew ) < 1.0e-13 || iteration > 12 )
+            {
+                isIterating[ i ] = 0;
+                if ( iterationTimesOfFlight[ i ] > nonDimensionalTimesOfFlight[ i ] )
+                {
+                    revolutions[ i ] -= 1;
+                }
+                continue;
+            }
+
+            iterationTimesOfFlight[ i ]
+                = computeLambertTimeOfFlight( lambdas[ i ], xNew, revolutions[ i ] );
+            iterationX[ i ] = xNew;
+        }
+    }
+
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        revolutions[ i ] = std::min( revolutions[ i ], revolutionsMaximum );
+        numberOfSolutions[ i ] = 2 * revolutions[ i ] + 1;
+    }
+}
+
+//! Compute initial guess for free parameter.
+double LambertBatchTargeter::computeInitialGuess( const int problemIndex,
+                                                  const int solutionIndex ) const
+{
+    const double pi = boost::math::constants::pi< double >( );
+    const double timeOfFlight = nonDimensionalTimesOfFlight[ problemIndex ];
+
+    // Initial guess for zero-revolution solution is based on time-of-flight regime.
+    if ( solutionIndex == 0 )
+    {
+        const double timeOfFlightZero = timesOfFlightZero[ problemIndex ];
+        const double timeOfFlightParabolic = timesOfFlightParabolic[ problemIndex ];
+        const double lambdaSquared = lambdas[ problemIndex ] * lambdas[ problemIndex ];
+        const double lambdaCubed = lambdas[ problemIndex ] * lambdaSquared;
+
+        if ( timeOfFlight >= timeOfFlightZero )
+        {
+            return -( timeOfFlight - timeOfFlightZero )
+                   / ( timeOfFlight - timeOfFlightZero + 4.0 );
+        }
+
+        else if ( timeOfFlight <= timeOfFlightParabolic )
+        {
+            return timeOfFlightParabolic * ( timeOfFlightParabolic - timeOfFlight )
+                   / ( 2.0 / 5.0 * ( 1.0 - lambdaSquared * lambdaCubed ) * timeOfFlight ) + 1.0;
+        }
+
+        return std::pow( timeOfFlight / timeOfFlightZero,
+                         std::log( 2.0 ) / std::log( timeOfFlightParabolic / timeOfFlightZero ) )
+               - 1.0;
+    }
+
+    // Initial guesses for left (odd index) and right (even index) branch solutions.
+    const int solutionRevolutions = ( solutionIndex + 1 ) / 2;
+    double guess = 0.0;
+    if ( solutionIndex % 2 == 1 )
+    {
+        guess = std::pow( ( solutionRevolutions * pi + pi ) / ( 8.0 * timeOfFlight ), 2.0 / 3.0 );
+    }
+
+    else
+    {
+        guess = std::pow( ( 8.0 * timeOfFlight ) / ( solutionRevolutions * pi ), 2.0 / 3.0 );
+    }
+
+    return ( guess - 1.0 ) / ( guess + 1.0 );
+}
+
+//! Compute Householder iteration step.
+double LambertBatchTargeter::computeHouseholderStep( const int problemIndex,
+                                                     const int solutionRevolutions,
+                                                     const double x ) const
+{
+    const double timeOfFlight
+        = computeLambertTimeOfFlight( lambdas[ problemIndex ], x, solutionRevolutions );
+    double firstDerivative = 0.0;
+    double secondDerivative = 0.0;
+    double thirdDerivative = 0.0;
+    computeLambertTimeOfFlightDerivatives( lambdas[ problemIndex ],
+                                           x,
+                                           timeOfFlight,
+                                           firstDerivative,
+                                           secondDerivative,
+                                           thirdDerivative );
+
+    const double delta = timeOfFlight - nonDimensionalTimesOfFlight[ problemIndex ];
+    const double firstDerivativeSquared = firstDerivative * firstDerivative;
+    return x - delta * ( firstDerivativeSquared - delta * secondDerivative / 2.0 )
+               / ( firstDerivative * ( firstDerivativeSquared - delta * secondDerivative )
+                   + thirdDerivative * delta * delta / 6.0 );
+}
+
+//! Solve for free parameter using Householder iterations.
+void LambertBatchTargeter::solveHouseholder( const int solutionIndex,
+                                             const double tolerance,
+                                             const int iterationsMaximum )
+{
+    const int solutionRevolutions = ( solutionIndex + 1 ) / 2;
+    double* x = &xSolutions[ solutionIndex * batchSizeMaximum ];
+
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        isIterating[ i ] = solutionIndex < numberOfSolutions[ i ];
+        if ( isIterating[ i ] )
+        {
+            x[ i ] = computeInitialGuess( i, solutionIndex );
+        }
+    }
+
+    // Iterations are executed in lock-step for all problems, until all have converged.
+    for ( int iteration = 0; iteration < iterationsMaximum; iteration++ )
+    {
+        bool isConverged = true;
+        for ( int i = 0; i < numberOfProblems; i++ )
+        {
+            if ( !isIterating[ i ] )
+            {
+                continue;
+            }
+
+            const double xNew = computeHouseholderStep( i, solutionRevolutions, x[ i ] );
+            isIterating[ i ] = std::fabs( x[ i ] - xNew ) > tolerance;
+            isConverged = isConverged && !isIterating[ i ];
+            x[ i ] = xNew;
+            ++numberOfIterations;
+        }
+
+        if ( isConverged )
+        {
+            break;
+        }
+    }
+}
+
+//! Solve for free parameter using warm-started Householder iterations.
+void LambertBatchTargeter::solveHouseholderWarmStarted( const int solutionIndex,
+                                                        const double tolerance,
+                                                        const int iterationsMaximum )
+{
+    const int solutionRevolutions = ( solutionIndex + 1 ) / 2;
+    double* x = &xSolutions[ solutionIndex * batchSizeMaximum ];
+
+    // Problems are solved in order, such that the converged solution of the previous problem is
+    // available as initial guess.
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        if ( solutionIndex >= numberOfSolutions[ i ] )
+        {
+            continue;
+        }
+
+        // The solution of the previous problem is only used if it has the same number of
+        // revolutions, i.e., if the previous problem has the solution.
+        bool isConverged = false;
+        if ( i > 0 && solutionIndex < numberOfSolutions[ i - 1 ] )
+        {
+            x[ i ] = x[ i - 1 ];
+
+            // If the two previous problems have the solution, the initial guess is extrapolated
+            // linearly from their solutions.
+            if ( i > 1 && solutionIndex < numberOfSolutions[ i - 2 ] )
+            {
+                x[ i ] += x[ i - 1 ] - x[ i - 2 ];
+            }
+
+            isConverged
+                = iterateHouseholder( i, solutionIndex, tolerance, iterationsMaximum, x[ i ] );
+
+            // For multi-revolution solutions, the time-of-flight decreases with x along the left
+            // branch and increases along the right branch; a warm-started solution on the wrong
+            // branch is rejected.
+            if ( isConverged && solutionRevolutions > 0 )
+            {
+                double firstDerivative = 0.0;
+                double secondDerivative = 0.0;
+                double thirdDerivative = 0.0;
+                computeLambertTimeOfFlightDerivatives(
+                    lambdas[ i ],
+                    x[ i ],
+                    computeLambertTimeOfFlight( lambdas[ i ], x[ i ], solutionRevolutions ),
+                    firstDerivative,
+                    secondDerivative,
+                    thirdDerivative );
+                isConverged = solutionIndex % 2 == 1 ? firstDerivative < 0.0
+                                                     : firstDerivative > 0.0;
+            }
+        }
+
+        // Fall back to default initial guess.
+        if ( !isConverged )
+        {
+            x[ i ] = computeInitialGuess( i, solutionIndex );
+            iterateHouseholder( i, solutionIndex, tolerance, iterationsMaximum, x[ i ] );
+        }
+    }
+}
+
+//! Execute Householder iterations for single problem.
+bool LambertBatchTargeter::iterateHouseholder( const int problemIndex,
+                                               const int solutionIndex,
+                                               const double tolerance,
+                                               const int iterationsMaximum,
+                                               double& x )
+{
+    const int solutionRevolutions = ( solutionIndex + 1 ) / 2;
+    double error = 1.0;
+    int iteration = 0;
+    while ( error > tolerance && iteration < iterationsMaximum )
+    {
+        const double xNew = computeHouseholderStep( problemIndex, solutionRevolutions, x );
+        error = std::fabs( x - xNew );
+        x = xNew;
+        ++iteration;
+        ++numberOfIterations;
+    }
+
+    // The free parameter is larger than -1 and, for multi-revolution solutions, smaller than 1.
+    return error <= tolerance && x > -1.0 && ( solutionIndex == 0 || x < 1.0 );
+}
+
+//! Construct Lambert targeter.
+LambertTargeter::LambertTargeter( const int aRevolutionsMaximum )
+    : batchTargeter( 1, aRevolutionsMaximum ),
+      departurePositions( 1 ),
+      arrivalPositions( 1 ),
+      timesOfFlight( 1 ),
+      numberOfSolutions( 0 ),
+      departureVelocities( 2 * std::max( aRevolutionsMaximum, 0 ) + 1 ),
+      arrivalVelocities( 2 * std::max( aRevolutionsMaximum, 0 ) + 1 )
+{ }
+
+//! Solve Lambert problem.
+int LambertTargeter::solve( const Vector3& departurePosition,
+                            const Vector3& arrivalPosition,
+                            const double timeOfFlight,
+                            const double gravitationalParameter,
+                            const bool isRetrograde )
+{
+    departurePositions[ 0 ] = departurePosition;
+    arrivalPositions[ 0 ] = arrivalPosition;
+    timesOfFlight[ 0 ] = timeOfFlight;
+    batchTargeter.solve( departurePositions,
+                         arrivalPositions,
+                         timesOfFlight,
+                         gravitationalParameter,
+                         isRetrograde );
+
+    numberOfSolutions = batchTargeter.getNumberOfSolutions( 0 );
+    for ( int i = 0; i < numberOfSolutions; i++ )
+    {
+        departureVelocities[ i ] = batchTargeter.getDepartureVelocity( 0, i );
+        arrivalVelocities[ i ] = batchTargeter.getArrivalVelocity( 0, i );
+    }
+
+    return numberOfSolutions;
+}
+
+} // namespace d2d
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "D2D/resultSink.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+
+//! Check result sink settings.
+ResultSinkSettings checkResultSinkSettings( const rapidjson::Document& config )
+{
+    std::string type = "sqlite";
+    std::string path = "";
+
+    if ( !config.HasMember( "sink" ) )
+    {
+        return ResultSinkSettings( type, path );
+    }
+
+    const rapidjson::Value& sink = find( config, "sink" )->value;
+
+    if ( sink.HasMember( "type" ) )
+    {
+        type = sink[ "type" ].GetString( );
+    }
+    std::cout << "Result sink                   " << type << std::endl;
+
+    if ( type != "sqlite" && type != "csv" && type != "null" )
+    {
+        throw std::runtime_error( "ERROR: Result sink must be \"sqlite\", \"csv\" or \"null\"!" );
+    }
+
+    if ( type == "csv" )
+    {
+        if ( !sink.HasMember( "path" ) )
+        {
+            throw std::runtime_error( "ERROR: Path must be specified for CSV result sink!" );
+        }
+
+        path = sink[ "path" ].GetString( );
+        std::cout << "Result sink path              " << path << std::endl;
+    }
+
+    return ResultSinkSettings( type, path );
+}
+
+//! Get names of result fields.
+std::vector< std::string > getResultFieldNames( const ResultFields& fields )
+{
+    std::vector< std::string > names;
+    for ( unsigned int i = 0; i < fields.size( ); i++ )
+    {
+        names.push_back( fields[ i ].name );
+    }
+
+    return names;
+}
+
+//! Get insert query for result sink table.
+std::string getResultSinkInsertQuery( const std::string& tableName, const ResultFields& fields )
+{
+    std::ostringstream insert;
+    std::ostringstream values;
+    insert << "INSERT INTO " << tableName << " (";
+    for ( unsigned int i = 0; i < fields.size( ); i++ )
+    {
+        insert << ( i == 0 ? "" : "," ) << "\"" << fields[ i ].name << "\"";
+        values << ( i == 0 ? "?" : ",?" );
+    }
+    insert << ") VALUES (" << values.str( ) << ");";
+
+    return insert.str( );
+}
+
+//! Construct SQLite result sink.
+SQLiteResultSink::SQLiteResultSink( SQLite::Database& aDatabase,
+                                    const std::string& tableName,
+                                    const ResultFields& someFields )
+    : database( aDatabase ),
+      fields( someFields ),
+      query( aDatabase, getResultSinkInsertQuery( tableName, someFields ) )
+{ }
+
+//! Write record to SQLite result sink.
+long long SQLiteResultSink::write( const ResultRecord& record )
+{
+    for ( unsigned int i = 0; i < fields.size( ); i++ )
+    {
+        // N.B.: SQLite bind indices start at 1.
+        if ( fields[ i ].isInteger )
+        {
+            query.bind( i + 1, static_cast< long long >( record[ i ] ) );
+        }
+
+        else
+        {
+            query.bind( i + 1, record[ i ] );
+        }
+    }
+
+    query.executeStep( );
+    query.reset( );
+    ++numberOfRecords;
+
+    return database.getLastInsertRowid( );
+}
+
+//! Close SQLite result sink.
+void SQLiteResultSink::close( )
+{ }
+
+//! Construct CSV result sink.
+CSVResultSink::CSVResultSink( const std::string& path, const ResultFields& someFields )
+    : fields( someFields ),
+      file( path.c_str( ) )
+{
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Creating CSV file " + path + " failed!" );
+    }
+
+    // Print file header.
+    for ( unsigned int i = 0; i < fields.size( ); i++ )
+    {
+        file << ( i == 0 ? "" : "," ) << fields[ i ].name;
+    }
+    file << std::endl;
+
+    file << std::setprecision( std::numeric_limits< double >::digits10 );
+}
+
+//! Write record to CSV result sink.
+long long CSVResultSink::write( const ResultRecord& record )
+{
+    for ( unsigned int i = 0; i < fields.size( ); i++ )
+    {
+        if ( i > 0 )
+        {
+            file << ",";
+        }
+
+        if ( fields[ i ].isInteger )
+        {
+            file << static_cast< long long >( record[ i ] );
+        }
+
+        else
+        {
+            file << record[ i ];
+        }
+    }
+    file << "\n";
+
+    return ++numberOfRecords;
+}
+
+//! Close CSV result sink.
+void CSVResultSink::close( )
+{
+    file.close( );
+
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Writing CSV file failed!" );
+    }
+}
+
+//! Write record to null result sink.
+long long NullResultSink::write( const ResultRecord& )
+{
+    return ++numberOfRecords;
+}
+
+//! Construct column store result sink.
+ColumnStoreResultSink::ColumnStoreResultSink(
+    const std::string& directory,
+    const ResultFields& someFields,
+    const std::map< std::string, double >& someMetadata )
+    : writer( directory, getResultFieldNames( someFields ) ),
+      metadata( someMetadata )
+{ }
+
+//! Write record to column store result sink.
+long long ColumnStoreResultSink::write( const ResultRecord& record )
+{
+    writer.appendRow( record );
+    return ++numberOfRecords;
+}
+
+//! Close column store result sink.
+void ColumnStoreResultSink::close( )
+{
+    writer.close( metadata );
+}
+
+//! Create result sink.
+std::unique_ptr< ResultSink > createResultSink( const ResultSinkSettings& settings,
+                                                SQLite::Database& database,
+                                                const std::string& tableName,
+                                                const ResultFields& fields )
+{
+    std::unique_ptr< ResultSink > sink;
+
+    if ( settings.type == "csv" )
+    {
+        sink.reset( new CSVResultSink( settings.path, fields ) );
+    }
+
+    else if ( settings.type == "null" )
+    {
+        sink.reset( new NullResultSink );
+    }
+
+    else
+    {
+        sink.reset( new SQLiteResultSink( database, tableName, fields ) );
+    }
+
+    return sink;
+}
+
+} // namespace d2d
@@ -13,6 +13,7 @@
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
@@ -34,6 +35,7 @@
 #include <Astro/astro.hpp>
 
 #include "D2D/sgp4Scanner.hpp"
+#include "D2D/lambertScanner.hpp"
 #include "D2D/tools.hpp"
 #include "D2D/typedefs.hpp"
 
@@ -65,97 +67,145 @@ void executeSGP4Scanner( const rapidjson::Document& config )
 
     // Open database in read/write mode.
     // N.B.: Database must already exist and contain a populated table called
-    //       "lambert_scanner_results".
+    //       "lambert_scanner_results", or refer to a lambert_scanner column store.
     SQLite::Database database( input.databasePath.c_str( ), SQLITE_OPEN_READWRITE );
 
-    // Create sgp4_scanner_results table in SQLite database.
-    std::cout << "Creating SQLite database table if needed ... " << std::endl;
-    createSGP4ScannerTable( database );
-    std::cout << "SQLite database set up successfully!" << std::endl;
+    // Apply bulk-load settings to database connection.
+    applyDatabaseSettings( database, input.databaseSettings );
+
+    // Create sgp4_scanner_results table in SQLite database, if results are stored in database.
+    if ( input.resultSinkSettings.isSQLite( ) )
+    {
+        std::cout << "Creating SQLite database table if needed ... " << std::endl;
+        createSGP4ScannerTable( database );
+        std::cout << "SQLite database set up successfully!" << std::endl;
+    }
 
     // Start SQL transaction.
     SQLite::Transaction transaction( database );
 
-    // Fetch number of rows in lambert_scanner_results table.
-    std::ostringstream lambertScannerTableSizeSelect;
-    lambertScannerTableSizeSelect << "SELECT COUNT(*) FROM lambert_scanner_results;";
-    const int lambertScannertTableSize
-        = database.execAndGet( lambertScannerTableSizeSelect.str( ) );
-
-    // Set up select query to fetch data from lambert_scanner_results table.
-    std::ostringstream lambertScannerTableSelect;
-    lambertScannerTableSelect << "SELECT * FROM lambert_scanner_results;";
-
-    SQLite::Statement lambertQuery( database, lambertScannerTableSelect.str( ) );
-
-    // Set up insert query to insert data into sgp4_scanner_results table.
-    std::ostringstream sgp4ScannerTableInsert;
-    sgp4ScannerTableInsert << "INSERT INTO sgp4_scanner_results VALUES ("
-        << "NULL,"
-        << ":lambert_transfer_id,"
-        << ":arrival_position_x,"
-        << ":arrival_position_y,"
-        << ":arrival_position_z,"
-        << ":arrival_velocity_x,"
-        << ":arrival_velocity_y,"
-        << ":arrival_velocity_z,"
-        << ":arrival_position_x_error,"
-        << ":arrival_position_y_error,"
-        << ":arrival_position_z_error,"
-        << ":arrival_position_error,"
-        << ":arrival_velocity_x_error,"
-        << ":arrival_velocity_y_error,"
-        << ":arrival_velocity_z_error,"
-        << ":arrival_velocity_error,"
-        << ":success"
-        << ");";
-
-    SQLite::Statement sgp4Query( database, sgp4ScannerTableInsert.str( ) );
+    // Set up reader for lambert_scanner_results table or column store (recomputes fields omitted
+    // in compact schema).
+    const LambertScannerTransferReader reader( database );
+
+    // Fetch number of rows in lambert_scanner_results table or column store.
+    const long long lambertScannertTableSize = reader.getNumberOfTransfers( );
+
+    // Set up select query to fetch data from lambert_scanner_results table. If the transfers are
+    // stored in a column store, they are read by transfer ID instead.
+    std::unique_ptr< SQLite::Statement > lambertQuery;
+    const double* transferDeltaVs = NULL;
+    if ( reader.isColumnStore )
+    {
+        transferDeltaVs = reader.getTransferDeltaVs( );
+    }
+
+    // Transfers that exceed the cut-off are not selected, such that they are not read (or
+    // recomputed, for the compact schema). Transfers are selected in table order.
+    else
+    {
+        std::ostringstream lambertScannerTableSelect;
+        lambertScannerTableSelect << "SELECT * FROM lambert_scanner_results "
+                                  << "WHERE transfer_delta_v <= :transfer_delta_v_cutoff "
+                                  << "ORDER BY transfer_id ASC;";
+        lambertQuery.reset( new SQLite::Statement( database, lambertScannerTableSelect.str( ) ) );
+        lambertQuery->bind( ":transfer_delta_v_cutoff", input.transferDeltaVCutoff );
+    }
+
+    // Fetch number of transfers within the cut-off.
+    long long totalLambertCasesConsidered = 0;
+    if ( transferDeltaVs != NULL )
+    {
+        // Count directly on the contiguous transfer deltaV column of the column store.
+        for ( long long i = 0; i < lambertScannertTableSize; i++ )
+        {
+            totalLambertCasesConsidered += transferDeltaVs[ i ] <= input.transferDeltaVCutoff;
+        }
+    }
+
+    else
+    {
+        SQLite::Statement totalLambertCasesConsideredQuery(
+            database,
+            "SELECT COUNT(*) FROM lambert_scanner_results "
+            "WHERE transfer_delta_v <= :transfer_delta_v_cutoff;" );
+        totalLambertCasesConsideredQuery.bind( ":transfer_delta_v_cutoff",
+                                               input.transferDeltaVCutoff );
+        totalLambertCasesConsideredQuery.executeStep( );
+        totalLambertCasesConsidered = totalLambertCasesConsideredQuery.getColumn( 0 ).getInt64( );
+    }
+
+    // Set up result sink that results are written to.
+    const ResultFields resultFields = getSGP4ScannerResultFields( );
+    std::unique_ptr< ResultSink > resultSink = createResultSink(
+        input.resultSinkSettings, database, "sgp4_scanner_results", resultFields );
+    ResultRecord record;
+
+    // Set up shortlist of records with lowest Lambert transfer deltaV, retained while the transfers
+    // are propagated.
+    SGP4ScannerShortlist shortlist( std::max( input.shortlistLength, 0 ) );
 
     std::cout << "Propagating Lambert transfers using SGP4 and populating database ... "
               << std::endl;
 
     // Loop over rows in lambert_scanner_results table and propagate Lambert transfers using SGP4.
-    boost::progress_display showProgress( lambertScannertTableSize );
+    boost::progress_display showProgress(
+        lambertQuery ? totalLambertCasesConsidered : lambertScannertTableSize );
 
     // Declare counters for different fail cases.
     int virtualTleFailCounter = 0;
     int arrivalEpochPropagationFailCounter = 0;
 
-    // Step through select query to fetch data from lambert_scanner_results.
-    while ( lambertQuery.executeStep( ) )
+    // Step through select query to fetch data from lambert_scanner_results, or through rows of
+    // column store.
+    long long lambertRow = 0;
+    while ( lambertQuery ? lambertQuery->executeStep( ) : lambertRow < lambertScannertTableSize )
     {
-        const int      lambertTransferId                    = lambertQuery.getColumn( 0 );
-        const int      departureObjectId                    = lambertQuery.getColumn( 1 );
-        const int      arrivalObjectId                      = lambertQuery.getColumn( 2 );
-
-        const double   departureEpochJulian                 = lambertQuery.getColumn( 3 );
-        const double   timeOfFlight                         = lambertQuery.getColumn( 4 );
-
-        const double   departurePositionX                   = lambertQuery.getColumn( 7 );
-        const double   departurePositionY                   = lambertQuery.getColumn( 8 );
-        const double   departurePositionZ                   = lambertQuery.getColumn( 9 );
-        const double   departureVelocityX                   = lambertQuery.getColumn( 10 );
-        const double   departureVelocityY                   = lambertQuery.getColumn( 11 );
-        const double   departureVelocityZ                   = lambertQuery.getColumn( 12 );
-        const double   departureDeltaVX                     = lambertQuery.getColumn( 37 );
-        const double   departureDeltaVY                     = lambertQuery.getColumn( 38 );
-        const double   departureDeltaVZ                     = lambertQuery.getColumn( 39 );
-
-        const double   lambertArrivalPositionX              = lambertQuery.getColumn( 19 );
-        const double   lambertArrivalPositionY              = lambertQuery.getColumn( 20 );
-        const double   lambertArrivalPositionZ              = lambertQuery.getColumn( 21 );
-        const double   lambertArrivalVelocityX              = lambertQuery.getColumn( 22 );
-        const double   lambertArrivalVelocityY              = lambertQuery.getColumn( 23 );
-        const double   lambertArrivalVelocityZ              = lambertQuery.getColumn( 24 );
-        const double   lambertArrivalDeltaVX                = lambertQuery.getColumn( 40 );
-        const double   lambertArrivalDeltaVY                = lambertQuery.getColumn( 41 );
-        const double   lambertArrivalDeltaVZ                = lambertQuery.getColumn( 42 );
-
-        const double   lambertTransferSemiMajorAxis         = lambertQuery.getColumn( 31 );
-        const double   lambertTransferEccentricity          = lambertQuery.getColumn( 32 );
-
-        const double   lambertTotalDeltaV                   = lambertQuery.getColumn( 43 );
+        ++lambertRow;
+
+        // Transfers in the column store that exceed the cut-off are skipped based on the
+        // contiguous transfer deltaV column, without reading (or recomputing) the transfer.
+        if ( transferDeltaVs != NULL
+             && transferDeltaVs[ lambertRow - 1 ] > input.transferDeltaVCutoff )
+        {
+            ++showProgress;
+            continue;
+        }
+
+        const LambertScannerTransfer transfer
+            = lambertQuery ? reader.read( *lambertQuery ) : reader.read( lambertRow );
+
+        const int      lambertTransferId
+            = lambertQuery ? lambertQuery->getColumn( 0 ).getInt( )
+                           : static_cast< int >( lambertRow );
+        const int      departureObjectId                    = transfer.departureObjectId;
+        const int      arrivalObjectId                      = transfer.arrivalObjectId;
+
+        const double   departureEpochJulian                 = transfer.departureEpoch;
+        const double   timeOfFlight                         = transfer.timeOfFlight;
+
+        const double   departurePositionX                   = transfer.departureState[ 0 ];
+        const double   departurePositionY                   = transfer.departureState[ 1 ];
+        const double   departurePositionZ                   = transfer.departureState[ 2 ];
+        const double   departureVelocityX                   = transfer.departureState[ 3 ];
+        const double   departureVelocityY                   = transfer.departureState[ 4 ];
+        const double   departureVelocityZ                   = transfer.departureState[ 5 ];
+        const double   departureDeltaVX                     = transfer.departureDeltaV[ 0 ];
+        const double   departureDeltaVY                     = transfer.departureDeltaV[ 1 ];
+        const double   departureDeltaVZ                     = transfer.departureDeltaV[ 2 ];
+
+        const double   lambertArrivalPositionX              = transfer.arrivalState[ 0 ];
+        const double   lambertArrivalPositionY              = transfer.arrivalState[ 1 ];
+        const double   lambertArrivalPositionZ              = transfer.arrivalState[ 2 ];
+        const double   lambertArrivalVelocityX              = transfer.arrivalState[ 3 ];
+        const double   lambertArrivalVelocityY              = transfer.arrivalState[ 4 ];
+        const double   lambertArrivalVelocityZ              = transfer.arrivalState[ 5 ];
+        const double   lambertArrivalDeltaVX                = transfer.arrivalDeltaV[ 0 ];
+        const double   lambertArrivalDeltaVY                = transfer.arrivalDeltaV[ 1 ];
+        const double   lambertArrivalDeltaVZ                = transfer.arrivalDeltaV[ 2 ];
+
+        const double   lambertTransferSemiMajorAxis         = transfer.transferStateKepler[ 0 ];
+        const double   lambertTransferEccentricity          = transfer.transferStateKepler[ 1 ];
 
         // Set up DateTime object for departure epoch using Julian date.
         // Note: The transformation given in the following statement is based on how the DateTime
@@ -180,13 +230,6 @@ void executeSGP4Scanner( const rapidjson::Document& config )
         }
         double transferDepartureVelocityNorm = sml::norm< double >( transferDepartureVelocity );
 
-        // Filter out cases using transfer deltaV cut off given through input file.
-        if ( lambertTotalDeltaV > input.transferDeltaVCutoff )
-        {
-            ++showProgress;
-            continue;
-        }
-
         // Filter out cases where the periapsis of the transfer orbit is less than the Earth's
         // mean radius.
         // This is necessary, since the SGP4 propagator only functions outside the Earth's mean
@@ -253,11 +296,18 @@ void executeSGP4Scanner( const rapidjson::Document& config )
 
         if ( testPassed == false )
         {
-            // Bind zeroes to sgp4Query.
-            std::string bindZeroes = bindZeroesSGP4ScannerTable( lambertTransferId );
-            SQLite::Statement zeroQuery( database, bindZeroes );
-            zeroQuery.executeStep( );
-            zeroQuery.reset( );
+            // Write zeroes to result sink.
+            record.assign( resultFields.size( ), 0.0 );
+            record[ 0 ] = lambertTransferId;
+            const long long transferId = resultSink->write( record );
+            if ( shortlist.isImprovedBy( transfer.transferDeltaV ) )
+            {
+                shortlist.insert( SGP4ScannerShortlistEntry( transferId,
+                                                             transfer.transferDeltaV,
+                                                             transfer.departureObjectId,
+                                                             transfer.arrivalObjectId,
+                                                             record ) );
+            }
 
             ++virtualTleFailCounter;
             ++showProgress;
@@ -276,11 +326,18 @@ void executeSGP4Scanner( const rapidjson::Document& config )
         }
         catch( std::exception& sgp4PropagationError )
         {
-            // Bind zeroes to sgp4Query.
-            std::string bindZeroes = bindZeroesSGP4ScannerTable( lambertTransferId );
-            SQLite::Statement zeroQuery( database, bindZeroes );
-            zeroQuery.executeStep( );
-            zeroQuery.reset( );
+            // Write zeroes to result sink.
+            record.assign( resultFields.size( ), 0.0 );
+            record[ 0 ] = lambertTransferId;
+            const long long transferId = resultSink->write( record );
+            if ( shortlist.isImprovedBy( transfer.transferDeltaV ) )
+            {
+                shortlist.insert( SGP4ScannerShortlistEntry( transferId,
+                                                             transfer.transferDeltaV,
+                                                             transfer.departureObjectId,
+                                                             transfer.arrivalObjectId,
+                                                             record ) );
+            }
 
             ++arrivalEpochPropagationFailCounter;
             ++showProgress;
@@ -321,42 +378,42 @@ void executeSGP4Scanner( const rapidjson::Document& config )
         velocityError[ 2 ] = arrivalVelocityErrorZ;
         double arrivalVelocityErrorNorm = sml::norm< double >( velocityError );
 
-        // Bind computed values to sgp4Query.
-        sgp4Query.bind( ":lambert_transfer_id",                   lambertTransferId );
-        sgp4Query.bind( ":arrival_position_x",                    sgp4ArrivalPositionX );
-        sgp4Query.bind( ":arrival_position_y",                    sgp4ArrivalPositionY );
-        sgp4Query.bind( ":arrival_position_z",                    sgp4ArrivalPositionZ );
-        sgp4Query.bind( ":arrival_velocity_x",                    sgp4ArrivalVelocityX );
-        sgp4Query.bind( ":arrival_velocity_y",                    sgp4ArrivalVelocityY );
-        sgp4Query.bind( ":arrival_velocity_z",                    sgp4ArrivalVelocityZ );
-        sgp4Query.bind( ":arrival_position_x_error",              arrivalPositionErrorX );
-        sgp4Query.bind( ":arrival_position_y_error",              arrivalPositionErrorY );
-        sgp4Query.bind( ":arrival_position_z_error",              arrivalPositionErrorZ );
-        sgp4Query.bind( ":arrival_position_error",                arrivalPositionErrorNorm );
-        sgp4Query.bind( ":arrival_velocity_x_error",              arrivalVelocityErrorX );
-        sgp4Query.bind( ":arrival_velocity_y_error",              arrivalVelocityErrorY );
-        sgp4Query.bind( ":arrival_velocity_z_error",              arrivalVelocityErrorZ );
-        sgp4Query.bind( ":arrival_velocity_error",                arrivalVelocityErrorNorm );
-        sgp4Query.bind( ":success",                               1 );
-
-        sgp4Query.executeStep( );
-        sgp4Query.reset( );
+        // Write computed values to result sink.
+        const double result[ ] = { static_cast< double >( lambertTransferId ),
+                                   sgp4ArrivalPositionX,
+                                   sgp4ArrivalPositionY,
+                                   sgp4ArrivalPositionZ,
+                                   sgp4ArrivalVelocityX,
+                                   sgp4ArrivalVelocityY,
+                                   sgp4ArrivalVelocityZ,
+                                   arrivalPositionErrorX,
+                                   arrivalPositionErrorY,
+                                   arrivalPositionErrorZ,
+                                   arrivalPositionErrorNorm,
+                                   arrivalVelocityErrorX,
+                                   arrivalVelocityErrorY,
+                                   arrivalVelocityErrorZ,
+                                   arrivalVelocityErrorNorm,
+                                   1.0 };
+        record.assign( result, result + resultFields.size( ) );
+        const long long transferId = resultSink->write( record );
+        if ( shortlist.isImprovedBy( transfer.transferDeltaV ) )
+        {
+            shortlist.insert( SGP4ScannerShortlistEntry( transferId,
+                                                         transfer.transferDeltaV,
+                                                         transfer.departureObjectId,
+                                                         transfer.arrivalObjectId,
+                                                         record ) );
+        }
 
         ++showProgress;
     }
 
-    // Fetch number of rows in sgp4_scanner_results table.
-    std::ostringstream sgp4ScannerTableSizeSelect;
-    sgp4ScannerTableSizeSelect << "SELECT COUNT(*) FROM sgp4_scanner_results;";
-    const int sgp4ScannertTableSize
-        = database.execAndGet( sgp4ScannerTableSizeSelect.str( ) );
+    // Flush records buffered by result sink.
+    resultSink->close( );
 
-    std::ostringstream totalLambertCasesConsideredSelect;
-    totalLambertCasesConsideredSelect
-        << "SELECT COUNT(*) FROM lambert_scanner_results WHERE transfer_delta_v <= "
-        << input.transferDeltaVCutoff << ";";
-    const int totalLambertCasesConsidered
-        = database.execAndGet( totalLambertCasesConsideredSelect.str( ) );
+    // Fetch number of records written to result sink.
+    const long long sgp4ScannertTableSize = resultSink->getNumberOfRecords( );
 
     std::cout << std::endl;
     std::cout << "Total Lambert cases = " << lambertScannertTableSize << std::endl;
@@ -376,11 +433,20 @@ void executeSGP4Scanner( const rapidjson::Document& config )
     std::cout << "Database populated successfully!" << std::endl;
     std::cout << std::endl;
 
+    // Create indices once all results have been inserted.
+    if ( input.resultSinkSettings.isSQLite( ) )
+    {
+        std::cout << "Creating SQLite database table indices ... " << std::endl;
+        createSGP4ScannerTableIndices( database );
+        std::cout << "SQLite database table indices created successfully!" << std::endl;
+        std::cout << std::endl;
+    }
+
     // Check if shortlist file should be created; call function to write output.
     if ( input.shortlistLength > 0 )
     {
         std::cout << "Writing shortlist to file ... " << std::endl;
-        writeSGP4TransferShortlist( database, input.shortlistLength, input.shortlistPath );
+        writeSGP4TransferShortlist( shortlist.getSortedEntries( ), input.shortlistPath );
         std::cout << "Shortlist file created successfully!" << std::endl;
     }
 }
@@ -411,19 +477,26 @@ sgp4ScannerInput checkSGP4ScannerInput( const rapidjson::Document& config )
         std::cout << "Shortlist                       " << shortlistPath << std::endl;
     }
 
+    const ResultSinkSettings resultSinkSettings = checkResultSinkSettings( config );
+
+    const DatabaseSettings databaseSettings = checkDatabaseSettings( config );
+
     return sgp4ScannerInput( transferDeltaVCutoff,
                              relativeTolerance,
                              absoluteTolerance,
                              databasePath,
                              shortlistLength,
-                             shortlistPath );
+                             shortlistPath,
+                             resultSinkSettings,
+                             databaseSettings );
 }
 
 //! Create sgp4_scanner table.
 void createSGP4ScannerTable( SQLite::Database& database )
 {
-    // Check that lambert_scanner_results table exists.
-    if ( !database.tableExists( "lambert_scanner_results" ) )
+    // Check that lambert_scanner_results table exists, or that a column store is used.
+    if ( !database.tableExists( "lambert_scanner_results" )
+         && !database.tableExists( "lambert_scanner_column_store" ) )
     {
         throw std::runtime_error(
             "ERROR: \"lambert_scanner_results\" must exist and be populated!" );
@@ -458,6 +531,17 @@ void createSGP4ScannerTable( SQLite::Database& database )
     // Execute command to create table.
     database.exec( sgp4ScannerTableCreate.str( ).c_str( ) );
 
+    if ( !database.tableExists( "sgp4_scanner_results" ) )
+    {
+        std::ostringstream errorMessage;
+        errorMessage << "ERROR: Creating table 'sgp4_scanner_results' failed in sgp4Scanner.cpp!";
+        throw std::runtime_error( errorMessage.str( ) );
+    }
+}
+
+//! Create sgp4_scanner_results table indices.
+void createSGP4ScannerTableIndices( SQLite::Database& database )
+{
     // Execute command to create index on transfer arrival_position_error column.
     std::ostringstream arrivalPositionErrorIndexCreate;
     arrivalPositionErrorIndexCreate << "CREATE INDEX IF NOT EXISTS \"arrival_position_error\" on "
@@ -469,80 +553,37 @@ void createSGP4ScannerTable( SQLite::Database& database )
     arrivalVelocityErrorIndexCreate << "CREATE INDEX IF NOT EXISTS \"arrival_velocity_error\" on "
                                     << "sgp4_scanner_results (arrival_velocity_error ASC);";
     database.exec( arrivalVelocityErrorIndexCreate.str( ).c_str( ) );
-
-    if ( !database.tableExists( "sgp4_scanner_results" ) )
-    {
-        std::ostringstream errorMessage;
-        errorMessage << "ERROR: Creating table 'sgp4_scanner_results' failed in sgp4Scanner.cpp!";
-        throw std::runtime_error( errorMessage.str( ) );
-    }
 }
 
-//! Bind zeroes into sgp4_scanner_results table.
-std::string bindZeroesSGP4ScannerTable( const int lambertTransferId )
+//! Get sgp4_scanner result fields.
+ResultFields getSGP4ScannerResultFields( )
 {
-    std::ostringstream zeroEntry;
-    zeroEntry << "INSERT INTO sgp4_scanner_results VALUES ("
-              << "NULL"                          << ","
-              << lambertTransferId               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0                               << ","
-              << 0
-              << ");";
-
-    return zeroEntry.str( );
+    ResultFields fields;
+    fields.push_back( ResultField( "lambert_transfer_id", true ) );
+    fields.push_back( ResultField( "arrival_position_x" ) );
+    fields.push_back( ResultField( "arrival_position_y" ) );
+    fields.push_back( ResultField( "arrival_position_z" ) );
+    fields.push_back( ResultField( "arrival_velocity_x" ) );
+    fields.push_back( ResultField( "arrival_velocity_y" ) );
+    fields.push_back( ResultField( "arrival_velocity_z" ) );
+    fields.push_back( ResultField( "arrival_position_x_error" ) );
+    fields.push_back( ResultField( "arrival_position_y_error" ) );
+    fields.push_back( ResultField( "arrival_position_z_error" ) );
+    fields.push_back( ResultField( "arrival_position_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_x_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_y_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_z_error" ) );
+    fields.push_back( ResultField( "arrival_velocity_error" ) );
+    fields.push_back( ResultField( "success", true ) );
+
+    return fields;
 }
 
 //! Write transfer shortlist to file.
-void writeSGP4TransferShortlist( SQLite::Database& database,
-                                 const int shortlistNumber,
+void writeSGP4TransferShortlist( const SGP4ScannerShortlistEntries& shortlistEntries,
                                  const std::string& shortlistPath )
 {
-    // Fetch transfers to include in shortlist.
-    // The sgp4_scanner_results table is sorted by transfer_delta_v from the lambert_scanner_results
-    // table in ascending order.
-    std::ostringstream shortlistSelect;
-    shortlistSelect << "SELECT      sgp4_scanner_results.transfer_id, "
-                    << "            sgp4_scanner_results.lambert_transfer_id, "
-                    << "            lambert_scanner_results.transfer_delta_v, "
-                    << "            lambert_scanner_results.departure_object_id, "
-                    << "            lambert_scanner_results.arrival_object_id, "
-                    << "            sgp4_scanner_results.arrival_position_x, "
-                    << "            sgp4_scanner_results.arrival_position_y, "
-                    << "            sgp4_scanner_results.arrival_position_z, "
-                    << "            sgp4_scanner_results.arrival_velocity_x, "
-                    << "            sgp4_scanner_results.arrival_velocity_y, "
-                    << "            sgp4_scanner_results.arrival_velocity_z, "
-                    << "            sgp4_scanner_results.arrival_position_x_error, "
-                    << "            sgp4_scanner_results.arrival_position_y_error, "
-                    << "            sgp4_scanner_results.arrival_position_z_error, "
-                    << "            sgp4_scanner_results.arrival_position_error, "
-                    << "            sgp4_scanner_results.arrival_velocity_x_error, "
-                    << "            sgp4_scanner_results.arrival_velocity_y_error, "
-                    << "            sgp4_scanner_results.arrival_velocity_z_error, "
-                    << "            sgp4_scanner_results.arrival_velocity_error "
-                    << "FROM        sgp4_scanner_results "
-                    << "INNER JOIN  lambert_scanner_results "
-                    << "ON          lambert_scanner_results.transfer_id = "
-                    << "            sgp4_scanner_results.lambert_transfer_id "
-                    << "ORDER BY    lambert_scanner_results.transfer_delta_v ASC LIMIT "
-                    << shortlistNumber << ";";
-
-    SQLite::Statement query( database, shortlistSelect.str( ) );
-
-    // Write fetch data to file.
+    // Write shortlist entries to file.
     std::ofstream shortlistFile( shortlistPath.c_str( ) );
 
     // Print file header.
@@ -567,30 +608,31 @@ void writeSGP4TransferShortlist( SQLite::Database& database,
                   << "arrival_velocity_error"
                   << std::endl;
 
-    // Loop through data retrieved from database and write to file.
-    while( query.executeStep( ) )
+    // Loop through shortlist entries and write to file.
+    for ( unsigned int i = 0; i < shortlistEntries.size( ); i++ )
     {
-        const int    transferId                         = query.getColumn( 0 );
-        const int    lambertTransferId                  = query.getColumn( 1 );
-        const double lambertTransferDeltaV              = query.getColumn( 2 );
-        const int    departureObjectId                  = query.getColumn( 3 );
-        const int    arrivalObjectId                    = query.getColumn( 4 );
-
-        const double arrivalPositionX                   = query.getColumn( 5 );
-        const double arrivalPositionY                   = query.getColumn( 6 );
-        const double arrivalPositionZ                   = query.getColumn( 7 );
-        const double arrivalVelocityX                   = query.getColumn( 8 );
-        const double arrivalVelocityY                   = query.getColumn( 9 );
-        const double arrivalVelocityZ                   = query.getColumn( 10 );
-
-        const double arrivalPositionErrorX              = query.getColumn( 11 );
-        const double arrivalPositionErrorY              = query.getColumn( 12 );
-        const double arrivalPositionErrorZ              = query.getColumn( 13 );
-        const double arrivalPositionError               = query.getColumn( 14 );
-        const double arrivalVelocityErrorX              = query.getColumn( 15 );
-        const double arrivalVelocityErrorY              = query.getColumn( 16 );
-        const double arrivalVelocityErrorZ              = query.getColumn( 17 );
-        const double arrivalVelocityError               = query.getColumn( 18 );
+        const SGP4ScannerShortlistEntry& entry          = shortlistEntries[ i ];
+        const long long transferId                      = entry.transferId;
+        const int    lambertTransferId                  = static_cast< int >( entry.record[ 0 ] );
+        const double lambertTransferDeltaV              = entry.lambertTransferDeltaV;
+        const int    departureObjectId                  = entry.departureObjectId;
+        const int    arrivalObjectId                    = entry.arrivalObjectId;
+
+        const double arrivalPositionX                   = entry.record[ 1 ];
+        const double arrivalPositionY                   = entry.record[ 2 ];
+        const double arrivalPositionZ                   = entry.record[ 3 ];
+        const double arrivalVelocityX                   = entry.record[ 4 ];
+        const double arrivalVelocityY                   = entry.record[ 5 ];
+        const double arrivalVelocityZ                   = entry.record[ 6 ];
+
+        const double arrivalPositionErrorX              = entry.record[ 7 ];
+        const double arrivalPositionErrorY              = entry.record[ 8 ];
+        const double arrivalPositionErrorZ              = entry.record[ 9 ];
+        const double arrivalPositionError               = entry.record[ 10 ];
+        const double arrivalVelocityErrorX              = entry.record[ 11 ];
+        const double arrivalVelocityErrorY              = entry.record[ 12 ];
+        const double arrivalVelocityErrorZ              = entry.record[ 13 ];
+        const double arrivalVelocityError               = entry.record[ 14 ];
 
         shortlistFile << transferId                         << ","
                       << lambertTransferId                  << ",";
@@ -0,0 +1,624 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef D2D_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef D2D_HAVE_LZMA
+#include <lzma.h>
+#endif
+
+#include "D2D/tleCatalog.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+
+namespace
+{
+
+//! Compression formats of TLE catalogs.
+enum CatalogCompression
+{
+    uncompressed,
+    gzip,
+    xz
+};
+
+//! Size of blocks produced by decompression thread [bytes].
+const std::size_t decompressionBlockSize = 1 << 20;
+
+//! Maximum number of decompressed blocks waiting to be split into lines.
+const std::size_t decompressionQueueSize = 4;
+
+} // namespace
+
+//! Queue of decompressed blocks.
+/*!
+ * Bounded queue that passes decompressed blocks from the decompression thread to the thread that
+ * splits them into lines. The decompression thread blocks if the queue is full; the queue can be
+ * cancelled by the reader, after which blocks are discarded.
+ */
+class DecompressionQueue
+{
+public:
+
+    //! Construct empty queue.
+    DecompressionQueue( )
+        : isClosed( false ),
+          isCancelled( false )
+    { }
+
+    //! Push block; returns false if queue was cancelled.
+    bool push( std::unique_ptr< std::string > block )
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        while ( blocks.size( ) >= decompressionQueueSize && !isCancelled )
+        {
+            condition.wait( lock );
+        }
+        if ( isCancelled )
+        {
+            return false;
+        }
+        blocks.push_back( std::move( block ) );
+        condition.notify_all( );
+        return true;
+    }
+
+    //! Pop block; returns null once queue is closed and empty.
+    std::unique_ptr< std::string > pop( )
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        while ( blocks.empty( ) && !isClosed )
+        {
+            condition.wait( lock );
+        }
+        std::unique_ptr< std::string > block;
+        if ( !blocks.empty( ) )
+        {
+            block = std::move( blocks.front( ) );
+            blocks.pop_front( );
+            condition.notify_all( );
+        }
+        return block;
+    }
+
+    //! Close queue once all blocks are pushed, storing error thrown during decompression if any.
+    void close( std::exception_ptr anError )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        error = anError;
+        isClosed = true;
+        condition.notify_all( );
+    }
+
+    //! Cancel queue, such that decompression thread stops.
+    void cancel( )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        isCancelled = true;
+        blocks.clear( );
+        condition.notify_all( );
+    }
+
+    //! Get error thrown during decompression (null if none).
+    std::exception_ptr getError( )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return error;
+    }
+
+protected:
+
+private:
+
+    //! Mutex guarding queue.
+    std::mutex mutex;
+
+    //! Condition signalled when blocks are pushed or popped, or queue is closed or cancelled.
+    std::condition_variable condition;
+
+    //! Decompressed blocks, in order.
+    std::deque< std::unique_ptr< std::string > > blocks;
+
+    //! Error thrown during decompression (null if none).
+    std::exception_ptr error;
+
+    //! Flag indicating if all blocks have been pushed.
+    bool isClosed;
+
+    //! Flag indicating if queue was cancelled by reader.
+    bool isCancelled;
+};
+
+namespace
+{
+
+//! Detect compression format of catalog.
+CatalogCompression detectCatalogCompression( const unsigned char* data, const std::size_t size )
+{
+    if ( size >= 2 && data[ 0 ] == 0x1f && data[ 1 ] == 0x8b )
+    {
+        return gzip;
+    }
+
+    const unsigned char xzMagic[ 6 ] = { 0xfd, '7', 'z', 'X', 'Z', 0x00 };
+    if ( size >= sizeof( xzMagic ) && std::memcmp( data, xzMagic, sizeof( xzMagic ) ) == 0 )
+    {
+        return xz;
+    }
+
+    return uncompressed;
+}
+
+#ifdef D2D_HAVE_ZLIB
+//! Decompress gzip catalog into blocks; concatenated gzip members are decompressed in sequence.
+void decompressGzip( const unsigned char* data,
+                     const std::size_t size,
+                     DecompressionQueue& queue )
+{
+    z_stream stream;
+    std::memset( &stream, 0, sizeof( stream ) );
+
+    // Window size of 15 bits; adding 32 enables detection of the gzip header.
+    if ( inflateInit2( &stream, 15 + 32 ) != Z_OK )
+    {
+        throw std::runtime_error( "ERROR: Initializing gzip decompression failed!" );
+    }
+
+    try
+    {
+        std::size_t position = 0;
+        bool isFinished = false;
+        while ( !isFinished )
+        {
+            std::unique_ptr< std::string > block( new std::string( decompressionBlockSize, '\0' ) );
+            stream.next_out = reinterpret_cast< Bytef* >( &( *block )[ 0 ] );
+            stream.avail_out = static_cast< uInt >( decompressionBlockSize );
+
+            while ( stream.avail_out > 0 && !isFinished )
+            {
+                // zlib takes input in chunks whose size fits in an unsigned int.
+                if ( stream.avail_in == 0 )
+                {
+                    if ( position == size )
+                    {
+                        throw std::runtime_error( "ERROR: Compressed catalog is truncated!" );
+                    }
+                    const std::size_t inputSize
+                        = std::min< std::size_t >( size - position, 1 << 30 );
+                    stream.next_in = const_cast< Bytef* >( data + position );
+                    stream.avail_in = static_cast< uInt >( inputSize );
+                    position += inputSize;
+                }
+
+                const int status = inflate( &stream, Z_NO_FLUSH );
+                if ( status == Z_STREAM_END )
+                {
+                    if ( stream.avail_in == 0 && position == size )
+                    {
+                        isFinished = true;
+                    }
+                    else
+                    {
+                        inflateReset( &stream );
+                    }
+                }
+                else if ( status != Z_OK )
+                {
+                    throw std::runtime_error( "ERROR: Decompressing gzip catalog failed!" );
+                }
+            }
+
+            block->resize( decompressionBlockSize - stream.avail_out );
+            if ( !queue.push( std::move( block ) ) )
+            {
+                break;
+            }
+        }
+    }
+    catch( ... )
+    {
+        inflateEnd( &stream );
+        throw;
+    }
+
+    inflateEnd( &stream );
+}
+#endif
+
+#ifdef D2D_HAVE_LZMA
+//! Decompress xz catalog into blocks; concatenated xz streams are decompressed in sequence.
+void decompressXz( const unsigned char* data,
+                   const std::size_t size,
+                   DecompressionQueue& queue )
+{
+    lzma_stream stream = LZMA_STREAM_INIT;
+    if ( lzma_stream_decoder( &stream, UINT64_MAX, LZMA_CONCATENATED ) != LZMA_OK )
+    {
+        throw std::runtime_error( "ERROR: Initializing xz decompression failed!" );
+    }
+
+    try
+    {
+        stream.next_in = data;
+        stream.avail_in = size;
+
+        lzma_ret status = LZMA_OK;
+        while ( status != LZMA_STREAM_END )
+        {
+            std::unique_ptr< std::string > block( new std::string( decompressionBlockSize, '\0' ) );
+            stream.next_out = reinterpret_cast< uint8_t* >( &( *block )[ 0 ] );
+            stream.avail_out = decompressionBlockSize;
+
+            // All input is available, such that truncated input is reported as an error.
+            while ( stream.avail_out > 0 && status != LZMA_STREAM_END )
+            {
+                status = lzma_code( &stream, LZMA_FINISH );
+                if ( status != LZMA_OK && status != LZMA_STREAM_END )
+                {
+                    throw std::runtime_error( "ERROR: Decompressing xz catalog failed!" );
+                }
+            }
+
+            block->resize( decompressionBlockSize - stream.avail_out );
+            if ( !queue.push( std::move( block ) ) )
+            {
+                break;
+            }
+        }
+    }
+    catch( ... )
+    {
+        lzma_end( &stream );
+        throw;
+    }
+
+    lzma_end( &stream );
+}
+#endif
+
+//! Decompress catalog into blocks; the queue is closed once decompression has completed.
+void decompressCatalog( const CatalogCompression compression,
+                        const unsigned char* data,
+                        const std::size_t size,
+                        DecompressionQueue& queue )
+{
+    try
+    {
+        if ( compression == gzip )
+        {
+#ifdef D2D_HAVE_ZLIB
+            decompressGzip( data, size, queue );
+#else
+            throw std::runtime_error(
+                "ERROR: Catalog is gzip-compressed, but D2D was built without zlib!" );
+#endif
+        }
+        else
+        {
+#ifdef D2D_HAVE_LZMA
+            decompressXz( data, size, queue );
+#else
+            throw std::runtime_error(
+                "ERROR: Catalog is xz-compressed, but D2D was built without liblzma!" );
+#endif
+        }
+        queue.close( std::exception_ptr( ) );
+    }
+    catch( ... )
+    {
+        queue.close( std::current_exception( ) );
+    }
+}
+
+//! Check if character is not a carriage return.
+bool isNotCarriageReturn( const char character )
+{
+    return character != '\r';
+}
+
+} // namespace
+
+//! Construct reader for TLE catalog.
+TleCatalog::TleCatalog( const std::string& catalogPath )
+    : mapping( NULL ),
+      mappingSize( 0 ),
+      linesPerTle( 0 ),
+      contentHash( computeHashFnv1a( NULL, 0 ) )
+{
+    // Memory-map catalog file.
+    const int fileDescriptor = open( catalogPath.c_str( ), O_RDONLY );
+    struct stat fileStatus;
+    if ( fileDescriptor < 0 || fstat( fileDescriptor, &fileStatus ) != 0 )
+    {
+        if ( fileDescriptor >= 0 )
+        {
+            ::close( fileDescriptor );
+        }
+        throw std::runtime_error( "ERROR: Opening catalog " + catalogPath + " failed!" );
+    }
+
+    mappingSize = static_cast< std::size_t >( fileStatus.st_size );
+
+    // Empty files cannot be mapped.
+    if ( mappingSize > 0 )
+    {
+        mapping = mmap( NULL, mappingSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+        if ( mapping == MAP_FAILED )
+        {
+            mapping = NULL;
+            ::close( fileDescriptor );
+            throw std::runtime_error( "ERROR: Memory-mapping catalog " + catalogPath
+                                      + " failed!" );
+        }
+
+        // The catalog is split (or decompressed) front to back.
+        madvise( mapping, mappingSize, MADV_SEQUENTIAL );
+    }
+    ::close( fileDescriptor );
+
+    try
+    {
+        const unsigned char* data = static_cast< const unsigned char* >( mapping );
+        const CatalogCompression compression = detectCatalogCompression( data, mappingSize );
+        if ( compression == uncompressed )
+        {
+            // Split catalog into lines in place.
+            const char* begin = static_cast< const char* >( mapping );
+            splitLines( begin, begin + mappingSize );
+        }
+        else
+        {
+            // Decompress catalog on a separate thread, while splitting decompressed blocks into
+            // lines. The mapping of the compressed file is released afterwards.
+            DecompressionQueue queue;
+            std::thread decompressor(
+                decompressCatalog, compression, data, mappingSize, std::ref( queue ) );
+            try
+            {
+                readDecompressedBlocks( queue );
+            }
+            catch( ... )
+            {
+                queue.cancel( );
+                decompressor.join( );
+                throw;
+            }
+            decompressor.join( );
+
+            if ( queue.getError( ) )
+            {
+                std::rethrow_exception( queue.getError( ) );
+            }
+
+            munmap( mapping, mappingSize );
+            mapping = NULL;
+            mappingSize = 0;
+        }
+
+        // Check if catalog is 2-line or 3-line version.
+        linesPerTle = getTleCatalogType(
+            lines.empty( ) ? std::string( ) : std::string( lines[ 0 ].first, lines[ 0 ].second ) );
+        if ( lines.size( ) % linesPerTle != 0 )
+        {
+            throw std::runtime_error( "ERROR: Catalog malformed!" );
+        }
+    }
+    catch( ... )
+    {
+        if ( mapping != NULL )
+        {
+            munmap( mapping, mappingSize );
+        }
+        throw;
+    }
+}
+
+//! Destruct reader for TLE catalog.
+TleCatalog::~TleCatalog( )
+{
+    if ( mapping != NULL )
+    {
+        munmap( mapping, mappingSize );
+    }
+}
+
+//! Get line of TLE.
+std::string TleCatalog::getLine( const unsigned int tleIndex, const int lineIndex ) const
+{
+    std::string line = getRawLine( tleIndex, lineIndex );
+    removeNewline( line );
+    return line;
+}
+
+//! Get raw line of TLE.
+std::string TleCatalog::getRawLine( const unsigned int tleIndex, const int lineIndex ) const
+{
+    const std::pair< const char*, std::size_t >& line = lines[ tleIndex * linesPerTle + lineIndex ];
+    return std::string( line.first, line.second );
+}
+
+//! Compute hash of catalog.
+unsigned long long TleCatalog::computeHash( ) const
+{
+    // The hash of decompressed catalogs is computed while they are read.
+    if ( mapping == NULL )
+    {
+        return contentHash;
+    }
+
+    return computeHashFnv1a( mapping, mappingSize );
+}
+
+//! Get TLE object.
+Tle TleCatalog::getTle( const unsigned int tleIndex ) const
+{
+    if ( linesPerTle == 3 )
+    {
+        return Tle( getLine( tleIndex, 0 ), getLine( tleIndex, 1 ), getLine( tleIndex, 2 ) );
+    }
+
+    return Tle( getLine( tleIndex, 0 ), getLine( tleIndex, 1 ) );
+}
+
+//! Get TLE objects.
+TleObjects TleCatalog::getTleObjects( const int numberOfThreads ) const
+{
+    const unsigned int numberOfTles = getNumberOfTles( );
+    const unsigned int threads
+        = std::max( 1u, std::min( static_cast< unsigned int >( std::max( numberOfThreads, 1 ) ),
+                                  numberOfTles ) );
+
+    TleObjects tleObjects( numberOfTles );
+    std::vector< std::exception_ptr > errors( threads );
+
+    // TLEs are split in contiguous chunks; each thread writes to disjoint entries.
+    std::vector< std::thread > workers;
+    for ( unsigned int i = 1; i < threads; i++ )
+    {
+        workers.push_back( std::thread( &TleCatalog::parseTles,
+                                        this,
+                                        numberOfTles * i / threads,
+                                        numberOfTles * ( i + 1 ) / threads,
+                                        std::ref( tleObjects ),
+                                        std::ref( errors[ i ] ) ) );
+    }
+    parseTles( 0, numberOfTles / threads, tleObjects, errors[ 0 ] );
+
+    for ( unsigned int i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+
+    for ( unsigned int i = 0; i < errors.size( ); i++ )
+    {
+        if ( errors[ i ] )
+        {
+            std::rethrow_exception( errors[ i ] );
+        }
+    }
+
+    return tleObjects;
+}
+
+//! Split text into lines.
+void TleCatalog::splitLines( const char* begin, const char* end )
+{
+    const char* data = begin;
+    while ( data < end )
+    {
+        const char* lineEnd = static_cast< const char* >( std::memchr( data, '\n', end - data ) );
+        if ( lineEnd == NULL )
+        {
+            lineEnd = end;
+        }
+
+        // Lines are stored including carriage returns, which are stripped when lines are copied.
+        if ( std::find_if( data, lineEnd, isNotCarriageReturn ) != lineEnd )
+        {
+            lines.push_back( std::make_pair( data, static_cast< std::size_t >( lineEnd - data ) ) );
+        }
+
+        data = lineEnd + 1;
+    }
+}
+
+//! Read decompressed blocks.
+void TleCatalog::readDecompressedBlocks( DecompressionQueue& queue )
+{
+    // Line that continues in the next block.
+    std::string partialLine;
+
+    std::unique_ptr< std::string > block;
+    while ( ( block = queue.pop( ) ) )
+    {
+        contentHash = computeHashFnv1a( block->data( ), block->size( ), contentHash );
+
+        const char* data = block->data( );
+        const char* end = data + block->size( );
+
+        // Complete line that started in a previous block; it is stored in a block of its own.
+        if ( !partialLine.empty( ) )
+        {
+            const char* lineEnd
+                = static_cast< const char* >( std::memchr( data, '\n', end - data ) );
+            if ( lineEnd == NULL )
+            {
+                partialLine.append( data, end );
+                continue;
+            }
+
+            partialLine.append( data, lineEnd );
+            decompressedBlocks.push_back(
+                std::unique_ptr< std::string >( new std::string( partialLine ) ) );
+            splitLines( decompressedBlocks.back( )->data( ),
+                        decompressedBlocks.back( )->data( ) + partialLine.size( ) );
+            partialLine.clear( );
+            data = lineEnd + 1;
+        }
+
+        // Lines that end in this block are stored in place; the block is kept alive by the reader.
+        const char* lastLineEnd = end;
+        while ( lastLineEnd > data && *( lastLineEnd - 1 ) != '\n' )
+        {
+            lastLineEnd--;
+        }
+        partialLine.assign( lastLineEnd, end );
+
+        if ( lastLineEnd > data )
+        {
+            splitLines( data, lastLineEnd );
+            decompressedBlocks.push_back( std::move( block ) );
+        }
+    }
+
+    if ( !partialLine.empty( ) )
+    {
+        decompressedBlocks.push_back(
+            std::unique_ptr< std::string >( new std::string( partialLine ) ) );
+        splitLines( decompressedBlocks.back( )->data( ),
+                    decompressedBlocks.back( )->data( ) + partialLine.size( ) );
+    }
+}
+
+//! Parse TLEs.
+void TleCatalog::parseTles( const unsigned int tleIndexBegin,
+                            const unsigned int tleIndexEnd,
+                            TleObjects& tleObjects,
+                            std::exception_ptr& error ) const
+{
+    try
+    {
+        for ( unsigned int i = tleIndexBegin; i < tleIndexEnd; i++ )
+        {
+            tleObjects[ i ] = getTle( i );
+        }
+    }
+    catch( ... )
+    {
+        error = std::current_exception( );
+    }
+}
+
+} // namespace d2d
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 
@@ -147,6 +148,123 @@ Vector6 getStateVector( const Eci state )
     return result;
 }
 
+//! Compute periapsis radius.
+double computePeriapsisRadius( const Vector3& position,
+                               const Vector3& velocity,
+                               const double gravitationalParameter )
+{
+    // Compute squared norm of specific angular momentum vector (h = r x v).
+    const double angularMomentumX = position[ 1 ] * velocity[ 2 ] - position[ 2 ] * velocity[ 1 ];
+    const double angularMomentumY = position[ 2 ] * velocity[ 0 ] - position[ 0 ] * velocity[ 2 ];
+    const double angularMomentumZ = position[ 0 ] * velocity[ 1 ] - position[ 1 ] * velocity[ 0 ];
+    const double angularMomentumSquared = angularMomentumX * angularMomentumX
+                                          + angularMomentumY * angularMomentumY
+                                          + angularMomentumZ * angularMomentumZ;
+
+    // Compute specific orbital energy.
+    const double radius = std::sqrt( position[ 0 ] * position[ 0 ]
+                                     + position[ 1 ] * position[ 1 ]
+                                     + position[ 2 ] * position[ 2 ] );
+    const double speedSquared = velocity[ 0 ] * velocity[ 0 ]
+                                + velocity[ 1 ] * velocity[ 1 ]
+                                + velocity[ 2 ] * velocity[ 2 ];
+    const double energy = 0.5 * speedSquared - gravitationalParameter / radius;
+
+    // Compute eccentricity; argument is clamped to avoid round-off for circular orbits.
+    const double eccentricity = std::sqrt( std::max(
+        0.0,
+        1.0 + 2.0 * energy * angularMomentumSquared
+            / ( gravitationalParameter * gravitationalParameter ) ) );
+
+    return angularMomentumSquared / ( gravitationalParameter * ( 1.0 + eccentricity ) );
+}
+
+//! Estimate transfer Delta V between two orbits.
+double estimateTransferDeltaV( const Vector6& departureState,
+                               const Vector6& arrivalState,
+                               const double gravitationalParameter )
+{
+    const Vector6* states[ 2 ] = { &departureState, &arrivalState };
+    double periapsisRadius[ 2 ];
+    double apoapsisRadius[ 2 ];
+    double horizontalSpeedMinimum[ 2 ];
+    double unitAngularMomentum[ 2 ][ 3 ];
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        const Vector6& state = *states[ i ];
+
+        const double radius = std::sqrt( state[ 0 ] * state[ 0 ]
+                                         + state[ 1 ] * state[ 1 ]
+                                         + state[ 2 ] * state[ 2 ] );
+        const double speedSquared = state[ 3 ] * state[ 3 ]
+                                    + state[ 4 ] * state[ 4 ]
+                                    + state[ 5 ] * state[ 5 ];
+
+        // Compute angular momentum vector (h = r x v).
+        const double angularMomentumX = state[ 1 ] * state[ 5 ] - state[ 2 ] * state[ 4 ];
+        const double angularMomentumY = state[ 2 ] * state[ 3 ] - state[ 0 ] * state[ 5 ];
+        const double angularMomentumZ = state[ 0 ] * state[ 4 ] - state[ 1 ] * state[ 3 ];
+        const double angularMomentum = std::sqrt( angularMomentumX * angularMomentumX
+                                                  + angularMomentumY * angularMomentumY
+                                                  + angularMomentumZ * angularMomentumZ );
+        unitAngularMomentum[ i ][ 0 ] = angularMomentumX / angularMomentum;
+        unitAngularMomentum[ i ][ 1 ] = angularMomentumY / angularMomentum;
+        unitAngularMomentum[ i ][ 2 ] = angularMomentumZ / angularMomentum;
+
+        // Compute apsides from semi-latus rectum and vis-viva equation. Unbound orbits have no
+        // apoapsis.
+        const double semiLatusRectum = angularMomentum * angularMomentum / gravitationalParameter;
+        const double inverseSemiMajorAxis
+            = 2.0 / radius - speedSquared / gravitationalParameter;
+        const double eccentricity
+            = std::sqrt( std::max( 1.0 - semiLatusRectum * inverseSemiMajorAxis, 0.0 ) );
+        periapsisRadius[ i ] = semiLatusRectum / ( 1.0 + eccentricity );
+
+        if ( inverseSemiMajorAxis > 0.0 && eccentricity < 1.0 )
+        {
+            apoapsisRadius[ i ] = semiLatusRectum / ( 1.0 - eccentricity );
+            horizontalSpeedMinimum[ i ] = angularMomentum / apoapsisRadius[ i ];
+        }
+
+        else
+        {
+            apoapsisRadius[ i ] = std::numeric_limits< double >::infinity( );
+            horizontalSpeedMinimum[ i ] = 0.0;
+        }
+    }
+
+    // In-plane term: Hohmann transfer between the facing apsides, if the radial ranges of the
+    // orbits do not overlap.
+    double inPlaneDeltaV = 0.0;
+    const int innerOrbit = apoapsisRadius[ 0 ] < periapsisRadius[ 1 ] ? 0 : 1;
+    const double innerRadius = apoapsisRadius[ innerOrbit ];
+    const double outerRadius = periapsisRadius[ 1 - innerOrbit ];
+    if ( innerRadius < outerRadius )
+    {
+        const double transferSemiMajorAxis = 0.5 * ( innerRadius + outerRadius );
+        inPlaneDeltaV
+            = std::sqrt( gravitationalParameter / innerRadius )
+                * ( std::sqrt( outerRadius / transferSemiMajorAxis ) - 1.0 )
+              + std::sqrt( gravitationalParameter / outerRadius )
+                * ( 1.0 - std::sqrt( innerRadius / transferSemiMajorAxis ) );
+    }
+
+    // Plane-change term: each impulse moves the horizontal velocity of the orbit into the plane
+    // of the transfer orbit, which costs at least the horizontal speed times the sine of the angle
+    // between the planes. Since the angles at departure and arrival add up to at least the angle
+    // between the orbits, the sum is bounded by the smallest horizontal speed times its sine.
+    const double cosinePlaneAngle = unitAngularMomentum[ 0 ][ 0 ] * unitAngularMomentum[ 1 ][ 0 ]
+                                    + unitAngularMomentum[ 0 ][ 1 ] * unitAngularMomentum[ 1 ][ 1 ]
+                                    + unitAngularMomentum[ 0 ][ 2 ] * unitAngularMomentum[ 1 ][ 2 ];
+    const double sinePlaneAngle
+        = std::sqrt( std::max( 1.0 - cosinePlaneAngle * cosinePlaneAngle, 0.0 ) );
+    const double planeChangeDeltaV
+        = std::min( horizontalSpeedMinimum[ 0 ], horizontalSpeedMinimum[ 1 ] ) * sinePlaneAngle;
+
+    return std::max( inPlaneDeltaV, planeChangeDeltaV );
+}
+
 //! Print state history to stream.
 void print( std::ostream& stream,
             const StateHistory stateHistory,
@@ -183,6 +301,46 @@ ConfigIterator find( const rapidjson::Document& config, const std::string& param
     return iterator;
 }
 
+//! Override members of JSON object, merging nested objects.
+static void overrideConfigMembers( rapidjson::Value& object,
+                                   const rapidjson::Value& overrides,
+                                   rapidjson::Document::AllocatorType& allocator )
+{
+    for ( ConfigIterator iterator = overrides.MemberBegin( );
+          iterator != overrides.MemberEnd( );
+          iterator++ )
+    {
+        rapidjson::Value::MemberIterator member = object.FindMember( iterator->name.GetString( ) );
+        if ( member != object.MemberEnd( )
+             && member->value.IsObject( )
+             && iterator->value.IsObject( ) )
+        {
+            overrideConfigMembers( member->value, iterator->value, allocator );
+        }
+
+        else if ( member != object.MemberEnd( ) )
+        {
+            member->value.CopyFrom( iterator->value, allocator );
+        }
+
+        else
+        {
+            object.AddMember( rapidjson::Value( iterator->name, allocator ),
+                              rapidjson::Value( iterator->value, allocator ),
+                              allocator );
+        }
+    }
+}
+
+//! Override config parameters.
+void overrideConfig( const rapidjson::Document& config,
+                     const rapidjson::Value& overrides,
+                     rapidjson::Document& overriddenConfig )
+{
+    overriddenConfig.CopyFrom( config, overriddenConfig.GetAllocator( ) );
+    overrideConfigMembers( overriddenConfig, overrides, overriddenConfig.GetAllocator( ) );
+}
+
 //! Remove newline characters from string.
 void removeNewline( std::string& string )
 {
@@ -210,4 +368,20 @@ int getTleCatalogType( const std::string& catalogFirstLine )
     return tleLines;
 }
 
+//! Compute FNV-1a hash.
+unsigned long long computeHashFnv1a( const void* data,
+                                     const std::size_t size,
+                                     const unsigned long long initialHash )
+{
+    const unsigned char* bytes = static_cast< const unsigned char* >( data );
+    unsigned long long hash = initialHash;
+    for ( std::size_t i = 0; i < size; i++ )
+    {
+        hash ^= bytes[ i ];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
 } // namespace d2d
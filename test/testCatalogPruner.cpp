@@ -9,9 +9,12 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <catch.hpp>
 
+#include <libsgp4/Globals.h>
+
 #include <rapidjson/document.h>
 
 #include "D2D/catalogPruner.hpp"
@@ -32,6 +35,20 @@ const static double        inclinationMaximum      = 100.0;
 const static std::string   nameRegex               = "(ARIANE)";
 const static int           catalogCutoff           = 0;
 const static std::string   prunedCatalogPath       = "catalog_pruner_tle_3line_pruned_catalog.txt";
+const static int           threads                 = 2;
+
+//! Read all lines of file.
+static std::vector< std::string > readFileLines( const std::string& filePath )
+{
+    std::ifstream file( filePath.c_str( ) );
+    std::vector< std::string > lines;
+    std::string line;
+    while ( std::getline( file, line ) )
+    {
+        lines.push_back( line );
+    }
+    return lines;
+}
 
 TEST_CASE( "Test execution of catalog_pruner application mode", "[catalog-pruner]" )
 {
@@ -148,6 +165,160 @@ TEST_CASE( "Test execution of catalog_pruner application mode", "[catalog-pruner
     std::cout.rdbuf( coutBuffer );
 }
 
+TEST_CASE( "Test execution of catalog_pruner with multiple filter sets", "[catalog-pruner]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    const std::string filePath = getRootPath( ) + "/test/catalog_pruner_3line_test.json";
+    std::ifstream file( filePath.c_str( ) );
+    std::ostringstream buffer;
+    buffer << file.rdbuf( );
+    rapidjson::Document config;
+    config.Parse( buffer.str( ).c_str( ) );
+    rapidjson::Document::AllocatorType& allocator = config.GetAllocator( );
+
+    // Change path to catalog file to absolute.
+    rapidjson::Value& catalogPathConfig = config[ "catalog" ];
+    const std::string catalogPathAbsolute
+        = getRootPath( ) + "/test/" + catalogPathConfig.GetString( );
+    catalogPathConfig.SetString( catalogPathAbsolute.c_str( ), catalogPathAbsolute.size( ) );
+
+    // Construct TLE objects from catalog in parallel.
+    rapidjson::Value threadsConfig( 3 );
+    config.AddMember( "threads", threadsConfig, allocator );
+
+    // Set up two filter sets: the filters of the JSON file and a filter set for debris with a
+    // cutoff, which overlap in the objects they select from the catalog.
+    const std::string prunedCatalogPathPrefix = getRootPath( ) + "/test/catalog_pruner_filter_set_";
+    const std::string prunedCatalogPaths[ ]
+        = { prunedCatalogPathPrefix + "0.txt", prunedCatalogPathPrefix + "1.txt" };
+
+    rapidjson::Value filterSets( rapidjson::kArrayType );
+
+    rapidjson::Value filterSet0( rapidjson::kObjectType );
+    rapidjson::Value prunedCatalogPath0(
+        prunedCatalogPaths[ 0 ].c_str( ), prunedCatalogPaths[ 0 ].size( ), allocator );
+    filterSet0.AddMember( "catalog_pruned", prunedCatalogPath0, allocator );
+    filterSets.PushBack( filterSet0, allocator );
+
+    rapidjson::Value filterSet1( rapidjson::kObjectType );
+    rapidjson::Value prunedCatalogPath1(
+        prunedCatalogPaths[ 1 ].c_str( ), prunedCatalogPaths[ 1 ].size( ), allocator );
+    filterSet1.AddMember( "catalog_pruned", prunedCatalogPath1, allocator );
+    rapidjson::Value inclinationFilter( rapidjson::kArrayType );
+    inclinationFilter.PushBack( 60.0, allocator );
+    inclinationFilter.PushBack( 90.0, allocator );
+    filterSet1.AddMember( "inclination_filter", inclinationFilter, allocator );
+    const std::string nameRegexDebris = "(DEB)";
+    rapidjson::Value nameRegexFilter(
+        nameRegexDebris.c_str( ), nameRegexDebris.size( ), allocator );
+    filterSet1.AddMember( "name_regex", nameRegexFilter, allocator );
+    rapidjson::Value catalogCutoffFilter( 25 );
+    filterSet1.AddMember( "catalog_cutoff", catalogCutoffFilter, allocator );
+    filterSets.PushBack( filterSet1, allocator );
+
+    config.AddMember( "filter_sets", filterSets, allocator );
+
+    executeCatalogPruner( config );
+
+    // Compare pruned catalog of each filter set with pruned catalog of a run with only that
+    // filter set.
+    const std::string singlePrunedCatalogPath
+        = getRootPath( ) + "/test/catalog_pruner_filter_set_single.txt";
+    const rapidjson::Value& filterSetsConfig = config[ "filter_sets" ];
+    for ( unsigned int k = 0; k < 2; k++ )
+    {
+        rapidjson::Document singleConfig;
+        getCatalogPrunerFilterSetConfig( config, filterSetsConfig[ k ], singleConfig );
+        singleConfig[ "catalog_pruned" ].SetString(
+            singlePrunedCatalogPath.c_str( ), singlePrunedCatalogPath.size( ) );
+
+        executeCatalogPruner( singleConfig );
+
+        const std::vector< std::string > prunedLines = readFileLines( prunedCatalogPaths[ k ] );
+        const std::vector< std::string > singlePrunedLines
+            = readFileLines( singlePrunedCatalogPath );
+
+        REQUIRE( !prunedLines.empty( ) );
+        REQUIRE( prunedLines == singlePrunedLines );
+
+        // Remove temporary pruned catalog files.
+        std::remove( prunedCatalogPaths[ k ].c_str( ) );
+        std::remove( singlePrunedCatalogPath.c_str( ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test computing catalog_pruner filter mask", "[catalog-pruner]" )
+{
+    const CatalogPrunerInput input( catalogPath,
+                                    semiMajorAxisMinimum,
+                                    semiMajorAxisMaximum,
+                                    eccentricityMinimum,
+                                    eccentricityMaximum,
+                                    inclinationMinimum,
+                                    inclinationMaximum,
+                                    nameRegex,
+                                    catalogCutoff,
+                                    prunedCatalogPath,
+                                    threads );
+
+    // The semi-major axis filter is specified as altitude, so the Earth radius is added to the
+    // bounds of the range.
+    const double semiMajorAxisLower = semiMajorAxisMinimum + kXKMPER;
+    const double semiMajorAxisUpper = semiMajorAxisMaximum + kXKMPER;
+    const double semiMajorAxisMiddle = 0.5 * ( semiMajorAxisLower + semiMajorAxisUpper );
+    const double eccentricityMiddle = 0.5 * ( eccentricityMinimum + eccentricityMaximum );
+    const double inclinationMiddle = 0.5 * ( inclinationMinimum + inclinationMaximum );
+    const double epsilon = 1.0e-9;
+
+    // Set up objects on, just inside and just outside the edges of each range.
+    const double semiMajorAxes[ ]
+        = { semiMajorAxisLower, semiMajorAxisUpper, semiMajorAxisMiddle,
+            semiMajorAxisLower - epsilon, semiMajorAxisUpper + epsilon, semiMajorAxisMinimum,
+            semiMajorAxisMiddle, semiMajorAxisMiddle, semiMajorAxisMiddle, semiMajorAxisMiddle };
+    const double eccentricities[ ]
+        = { eccentricityMinimum, eccentricityMaximum, eccentricityMiddle,
+            eccentricityMiddle, eccentricityMiddle, eccentricityMiddle,
+            eccentricityMaximum + epsilon, eccentricityMiddle, eccentricityMiddle,
+            eccentricityMaximum };
+    const double inclinations[ ]
+        = { inclinationMinimum, inclinationMaximum, inclinationMiddle,
+            inclinationMiddle, inclinationMiddle, inclinationMiddle,
+            inclinationMiddle, inclinationMinimum - epsilon, inclinationMaximum + epsilon,
+            inclinationMaximum };
+    const unsigned char expectedMask[ ] = { 1, 1, 1, 0, 0, 0, 0, 0, 0, 1 };
+    const unsigned int numberOfObjects = 10;
+
+    CatalogPrunerElements elements( numberOfObjects );
+    for ( unsigned int i = 0; i < numberOfObjects; i++ )
+    {
+        elements.semiMajorAxis[ i ] = semiMajorAxes[ i ];
+        elements.eccentricity[ i ] = eccentricities[ i ];
+        elements.inclination[ i ] = inclinations[ i ];
+    }
+
+    std::vector< unsigned char > mask( 3, 1 );
+    computeCatalogPrunerMask( input, elements, mask );
+
+    REQUIRE( mask.size( ) == numberOfObjects );
+    for ( unsigned int i = 0; i < numberOfObjects; i++ )
+    {
+        REQUIRE( mask[ i ] == expectedMask[ i ] );
+    }
+
+    // An empty catalog results in an empty mask.
+    computeCatalogPrunerMask( input, CatalogPrunerElements( 0 ), mask );
+    REQUIRE( mask.empty( ) );
+}
+
 TEST_CASE( "Test CatalogPrunerInput struct", "[catalog-pruner],[input-output]" )
 {
     const CatalogPrunerInput catalogPrunerInput( catalogPath,
@@ -159,7 +330,8 @@ TEST_CASE( "Test CatalogPrunerInput struct", "[catalog-pruner],[input-output]" )
                                                  inclinationMaximum,
                                                  nameRegex,
                                                  catalogCutoff,
-                                                 prunedCatalogPath );
+                                                 prunedCatalogPath,
+                                    threads );
 
     REQUIRE( catalogPrunerInput.catalogPath == catalogPath );
     REQUIRE( catalogPrunerInput.semiMajorAxisMinimum == semiMajorAxisMinimum );
@@ -171,6 +343,7 @@ TEST_CASE( "Test CatalogPrunerInput struct", "[catalog-pruner],[input-output]" )
     REQUIRE( catalogPrunerInput.nameRegex == nameRegex );
     REQUIRE( catalogPrunerInput.catalogCutoff == catalogCutoff );
     REQUIRE( catalogPrunerInput.prunedCatalogPath == prunedCatalogPath );
+    REQUIRE( catalogPrunerInput.threads == threads );
 }
 
 TEST_CASE( "Test function to check input to catalog pruner", "[catalog-pruner],[input-output]" )
@@ -203,6 +376,14 @@ TEST_CASE( "Test function to check input to catalog pruner", "[catalog-pruner],[
         REQUIRE( catalogPrunerInput.nameRegex == nameRegex );
         REQUIRE( catalogPrunerInput.catalogCutoff == catalogCutoff );
         REQUIRE( catalogPrunerInput.prunedCatalogPath == prunedCatalogPath );
+        REQUIRE( catalogPrunerInput.threads >= 1 );
+    }
+
+    SECTION( "Test invalid \"threads\" in JSON file" )
+    {
+        rapidjson::Value threadsConfig( 0 );
+        config.AddMember( "threads", threadsConfig, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkCatalogPrunerInput( config ) );
     }
 
     SECTION( "Test missing \"catalog\" in JSON file" )
@@ -251,5 +432,87 @@ TEST_CASE( "Test function to check input to catalog pruner", "[catalog-pruner],[
     std::cout.rdbuf( coutBuffer );
 }
 
+TEST_CASE( "Test function to check catalog pruner filter sets", "[catalog-pruner],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    const std::string filePath = getRootPath( ) + "/test/catalog_pruner_3line_test.json";
+    std::ifstream file( filePath.c_str( ) );
+    std::ostringstream buffer;
+    buffer << file.rdbuf( );
+    rapidjson::Document config;
+    config.Parse( buffer.str( ).c_str( ) );
+
+    SECTION( "Test config without filter sets" )
+    {
+        const std::vector< CatalogPrunerInput > inputs = checkCatalogPrunerFilterSets( config );
+
+        REQUIRE( inputs.size( ) == 1 );
+        REQUIRE( inputs[ 0 ].prunedCatalogPath == prunedCatalogPath );
+    }
+
+    SECTION( "Test config with filter sets" )
+    {
+        config.Parse( "{ \"catalog\": \"catalog.txt\","
+                      "  \"semi_major_axis_filter\": [200.0,2000.0],"
+                      "  \"eccentricity_filter\": [0.0,0.1],"
+                      "  \"inclination_filter\": [95.0,100.0],"
+                      "  \"name_regex\": \"\","
+                      "  \"catalog_cutoff\": 0,"
+                      "  \"filter_sets\": ["
+                      "    { \"catalog_pruned\": \"pruned_0.txt\" },"
+                      "    { \"catalog_pruned\": \"pruned_1.txt\","
+                      "      \"inclination_filter\": [0.0,90.0] } ] }" );
+
+        const std::vector< CatalogPrunerInput > inputs = checkCatalogPrunerFilterSets( config );
+
+        REQUIRE( inputs.size( ) == 2 );
+        REQUIRE( inputs[ 0 ].catalogPath == "catalog.txt" );
+        REQUIRE( inputs[ 1 ].catalogPath == "catalog.txt" );
+        REQUIRE( inputs[ 0 ].prunedCatalogPath == "pruned_0.txt" );
+        REQUIRE( inputs[ 1 ].prunedCatalogPath == "pruned_1.txt" );
+        REQUIRE( inputs[ 0 ].inclinationMaximum == 100.0 );
+        REQUIRE( inputs[ 1 ].inclinationMaximum == 90.0 );
+        REQUIRE( inputs[ 1 ].semiMajorAxisMaximum == 2000.0 );
+    }
+
+    SECTION( "Test filter set without own pruned catalog" )
+    {
+        config.Parse( "{ \"catalog\": \"catalog.txt\","
+                      "  \"semi_major_axis_filter\": [200.0,2000.0],"
+                      "  \"eccentricity_filter\": [0.0,0.1],"
+                      "  \"inclination_filter\": [95.0,100.0],"
+                      "  \"name_regex\": \"\","
+                      "  \"catalog_cutoff\": 0,"
+                      "  \"catalog_pruned\": \"pruned.txt\","
+                      "  \"filter_sets\": [ { \"catalog_cutoff\": 1 } ] }" );
+
+        REQUIRE_THROWS( checkCatalogPrunerFilterSets( config ) );
+    }
+
+    SECTION( "Test filter set overriding number of threads" )
+    {
+        config.Parse( "{ \"catalog\": \"catalog.txt\","
+                      "  \"semi_major_axis_filter\": [200.0,2000.0],"
+                      "  \"eccentricity_filter\": [0.0,0.1],"
+                      "  \"inclination_filter\": [95.0,100.0],"
+                      "  \"name_regex\": \"\","
+                      "  \"catalog_cutoff\": 0,"
+                      "  \"threads\": 2,"
+                      "  \"filter_sets\": ["
+                      "    { \"catalog_pruned\": \"pruned_0.txt\", \"threads\": 4 } ] }" );
+
+        REQUIRE_THROWS( checkCatalogPrunerFilterSets( config ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
 } // namespace tests
 } // namespace d2d
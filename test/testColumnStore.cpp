@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "D2D/columnStore.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+TEST_CASE( "Test writing and reading column store", "[column-store]" )
+{
+    const std::string directory = getRootPath( ) + "/test/column_store_test";
+    std::vector< std::string > columnNames;
+    columnNames.push_back( "transfer_id" );
+    columnNames.push_back( "transfer_delta_v" );
+
+    // Write more rows than are buffered by the writer, such that rows are appended in chunks.
+    const long long numberOfRows = 5000;
+    std::map< std::string, double > metadata;
+    metadata[ "departure_epoch_steps" ] = 2.0;
+    metadata[ "time_of_flight_min" ] = 36000.123456789;
+
+    {
+        ColumnStoreWriter writer( directory, columnNames );
+
+        // Rows with a number of values that does not match the number of columns are rejected.
+        REQUIRE_THROWS( writer.appendRow( std::vector< double >( 3, 0.0 ) ) );
+
+        std::vector< double > row( 2 );
+        for ( long long i = 0; i < numberOfRows; i++ )
+        {
+            row[ 0 ] = static_cast< double >( i );
+            row[ 1 ] = 0.1 * i;
+            writer.appendRow( row );
+        }
+        REQUIRE( writer.getNumberOfRows( ) == numberOfRows );
+        writer.close( metadata );
+    }
+
+    SECTION( "Test reopening column store" )
+    {
+        const ColumnStore columnStore( directory );
+
+        REQUIRE( columnStore.getNumberOfRows( ) == numberOfRows );
+        REQUIRE( columnStore.hasColumn( "transfer_id" ) );
+        REQUIRE( columnStore.hasColumn( "transfer_delta_v" ) );
+        REQUIRE( !columnStore.hasColumn( "arrival_object_id" ) );
+        REQUIRE_THROWS( columnStore.getColumn( "arrival_object_id" ) );
+
+        const double* transferIds = columnStore.getColumn( "transfer_id" );
+        const double* transferDeltaVs = columnStore.getColumn( "transfer_delta_v" );
+        for ( long long i = 0; i < numberOfRows; i++ )
+        {
+            REQUIRE( transferIds[ i ] == static_cast< double >( i ) );
+            REQUIRE( transferDeltaVs[ i ] == 0.1 * i );
+        }
+
+        // Metadata values round-trip exactly through the header.
+        REQUIRE( columnStore.getMetadata( "departure_epoch_steps" ) == 2.0 );
+        REQUIRE( columnStore.getMetadata( "time_of_flight_min" ) == 36000.123456789 );
+        REQUIRE_THROWS( columnStore.getMetadata( "time_of_flight_max" ) );
+    }
+
+    SECTION( "Test column file size that does not match header" )
+    {
+        // Overwrite column file with a single value.
+        const double value = 0.0;
+        std::ofstream columnFile( ( directory + "/transfer_delta_v.f64" ).c_str( ),
+                                  std::ios::binary );
+        columnFile.write( reinterpret_cast< const char* >( &value ), sizeof( double ) );
+        columnFile.close( );
+
+        REQUIRE_THROWS( ColumnStore( directory ).getNumberOfRows( ) );
+    }
+
+    SECTION( "Test reopening empty column store" )
+    {
+        {
+            ColumnStoreWriter writer( directory, columnNames );
+            writer.close( metadata );
+        }
+
+        const ColumnStore columnStore( directory );
+
+        REQUIRE( columnStore.getNumberOfRows( ) == 0 );
+        REQUIRE( columnStore.getColumn( "transfer_id" ) == NULL );
+    }
+
+    // Remove temporary column store.
+    std::remove( ( directory + "/transfer_id.f64" ).c_str( ) );
+    std::remove( ( directory + "/transfer_delta_v.f64" ).c_str( ) );
+    std::remove( ( directory + "/header.json" ).c_str( ) );
+    std::remove( directory.c_str( ) );
+}
+
+} // namespace tests
+} // namespace d2d
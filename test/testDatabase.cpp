@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "D2D/database.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+TEST_CASE( "Test checking bulk-load settings", "[database],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    rapidjson::Document config;
+
+    SECTION( "Test default settings" )
+    {
+        config.Parse( "{ \"mode\" : \"lambert_scanner\" }" );
+        const DatabaseSettings settings = checkDatabaseSettings( config );
+        REQUIRE( settings.journalMode.empty( ) );
+        REQUIRE( settings.synchronous.empty( ) );
+        REQUIRE( settings.pageSize == 0 );
+        REQUIRE( settings.cacheSize == 0 );
+        REQUIRE( settings.mmapSize == 0 );
+    }
+
+    SECTION( "Test valid settings" )
+    {
+        config.Parse( "{ \"bulk_load\" : { \"journal_mode\" : \"wal\","
+                      "                    \"synchronous\"  : \"off\","
+                      "                    \"page_size\"    : 4096,"
+                      "                    \"cache_size\"   : -2000,"
+                      "                    \"mmap_size\"    : 268435456 } }" );
+        const DatabaseSettings settings = checkDatabaseSettings( config );
+        REQUIRE( settings.journalMode == "WAL" );
+        REQUIRE( settings.synchronous == "OFF" );
+        REQUIRE( settings.pageSize == 4096 );
+        REQUIRE( settings.cacheSize == -2000 );
+        REQUIRE( settings.mmapSize == 268435456 );
+    }
+
+    SECTION( "Test invalid journal mode" )
+    {
+        config.Parse( "{ \"bulk_load\" : { \"journal_mode\" : \"FAST\" } }" );
+        REQUIRE_THROWS( checkDatabaseSettings( config ) );
+    }
+
+    SECTION( "Test invalid synchronous flag" )
+    {
+        config.Parse( "{ \"bulk_load\" : { \"synchronous\" : \"SOMETIMES\" } }" );
+        REQUIRE_THROWS( checkDatabaseSettings( config ) );
+    }
+
+    SECTION( "Test page size that is not a power of two" )
+    {
+        config.Parse( "{ \"bulk_load\" : { \"page_size\" : 1000 } }" );
+        REQUIRE_THROWS( checkDatabaseSettings( config ) );
+    }
+
+    SECTION( "Test cache size that is not an integer" )
+    {
+        config.Parse( "{ \"bulk_load\" : { \"cache_size\" : 1.5 } }" );
+        REQUIRE_THROWS( checkDatabaseSettings( config ) );
+
+        config.Parse( "{ \"bulk_load\" : { \"cache_size\" : \"2000\" } }" );
+        REQUIRE_THROWS( checkDatabaseSettings( config ) );
+    }
+
+    SECTION( "Test negative memory-mapped I/O size" )
+    {
+        config.Parse( "{ \"bulk_load\" : { \"mmap_size\" : -1 } }" );
+        REQUIRE_THROWS( checkDatabaseSettings( config ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test applying bulk-load settings", "[database],[input-output]" )
+{
+    // N.B.: The journal mode of an in-memory database can only be MEMORY or OFF.
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+    applyDatabaseSettings( database, DatabaseSettings( "OFF", "OFF", 0, -2000, 0 ) );
+
+    const std::string journalMode = database.execAndGet( "PRAGMA journal_mode;" );
+    REQUIRE( journalMode == "off" );
+    REQUIRE( database.execAndGet( "PRAGMA synchronous;" ).getInt( ) == 0 );
+    REQUIRE( database.execAndGet( "PRAGMA cache_size;" ).getInt( ) == -2000 );
+
+    // Settings that are not set leave the current values unchanged.
+    applyDatabaseSettings( database, DatabaseSettings( "", "", 0, 0, 0 ) );
+    REQUIRE( database.execAndGet( "PRAGMA synchronous;" ).getInt( ) == 0 );
+    REQUIRE( database.execAndGet( "PRAGMA cache_size;" ).getInt( ) == -2000 );
+}
+
+} // namespace tests
+} // namespace d2d
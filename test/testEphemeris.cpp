@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "D2D/ephemeris.hpp"
+#include "D2D/tleCatalog.hpp"
+#include "D2D/tools.hpp"
+
+#include "testLambertScannerFixtures.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+//! Hash of catalog that ephemeris tables are cached for.
+const static unsigned long long ephemerisCatalogHash = 0x0123456789abcdefULL;
+
+//! Get epochs that test objects are propagated to.
+static std::vector< DateTime > getEphemerisTestEpochs( const int numberOfEpochs )
+{
+    const DateTime initialEpoch( 2015, 3, 24, 16, 3, 30 );
+    std::vector< DateTime > epochs;
+    for ( int i = 0; i < numberOfEpochs; i++ )
+    {
+        epochs.push_back( initialEpoch.AddSeconds( 3600.0 * i ) );
+    }
+    return epochs;
+}
+
+//! Check that ephemeris tables contain bitwise identical states and Keplerian elements.
+static bool isEphemerisTableEqual( const EphemerisTable& table,
+                                   const EphemerisTable& expectedTable )
+{
+    if ( table.getNumberOfObjects( ) != expectedTable.getNumberOfObjects( )
+         || table.getEpochs( ).size( ) != expectedTable.getEpochs( ).size( ) )
+    {
+        return false;
+    }
+
+    for ( unsigned int i = 0; i < table.getNumberOfObjects( ); i++ )
+    {
+        for ( unsigned int j = 0; j < table.getEpochs( ).size( ); j++ )
+        {
+            const Vector6 state = table.getState( i, j );
+            const Vector6 expectedState = expectedTable.getState( i, j );
+            const Vector6 stateKepler = table.getStateKepler( i, j );
+            const Vector6 expectedStateKepler = expectedTable.getStateKepler( i, j );
+            if ( std::memcmp( state.data( ), expectedState.data( ), sizeof( state ) ) != 0
+                 || std::memcmp( stateKepler.data( ),
+                                 expectedStateKepler.data( ),
+                                 sizeof( stateKepler ) ) != 0 )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//! Resize file to given number of bytes, truncating or padding it with zeros.
+static void resizeFile( const std::string& path, const long long size )
+{
+    std::vector< char > contents;
+    {
+        std::ifstream file( path.c_str( ), std::ios::binary );
+        contents.assign( std::istreambuf_iterator< char >( file ),
+                         std::istreambuf_iterator< char >( ) );
+    }
+
+    const long long originalSize = contents.size( );
+    contents.resize( size, '\0' );
+    REQUIRE( originalSize != size );
+
+    std::ofstream file( path.c_str( ), std::ios::binary|std::ios::trunc );
+    file.write( contents.data( ), contents.size( ) );
+}
+
+//! Get size of file.
+static long long getFileSize( const std::string& path )
+{
+    std::ifstream file( path.c_str( ), std::ios::binary|std::ios::ate );
+    return file.tellg( );
+}
+
+TEST_CASE( "Test ephemeris cache", "[ephemeris],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    const TleObjects tleObjects = getLambertScannerTestObjects( );
+    const std::vector< DateTime > epochs = getEphemerisTestEpochs( 4 );
+    const EphemerisTable expectedTable( tleObjects, epochs, kMU );
+
+    const std::string cacheDirectory = getRootPath( ) + "/test/ephemeris_cache";
+    const std::string cachePath
+        = getEphemerisCachePath( cacheDirectory, ephemerisCatalogHash, epochs, kMU );
+    std::remove( cachePath.c_str( ) );
+
+    SECTION( "Test writing and reading cache" )
+    {
+        const std::unique_ptr< const EphemerisTable > table = computeEphemerisTable(
+            tleObjects, ephemerisCatalogHash, epochs, kMU, 2, cacheDirectory );
+        REQUIRE( isEphemerisTableEqual( *table, expectedTable ) );
+        REQUIRE( std::ifstream( cachePath.c_str( ) ).good( ) );
+
+        const EphemerisTable cachedTable(
+            cachePath, ephemerisCatalogHash, tleObjects.size( ), epochs, kMU );
+        REQUIRE( isEphemerisTableEqual( cachedTable, expectedTable ) );
+
+        const std::unique_ptr< const EphemerisTable > tableFromCache = computeEphemerisTable(
+            tleObjects, ephemerisCatalogHash, epochs, kMU, 1, cacheDirectory );
+        REQUIRE( isEphemerisTableEqual( *tableFromCache, expectedTable ) );
+        REQUIRE( outputBuffer.str( ).find( "Ephemerides read from cache" )
+                 != std::string::npos );
+    }
+
+    SECTION( "Test cache with mismatching header" )
+    {
+        computeEphemerisTable( tleObjects, ephemerisCatalogHash, epochs, kMU, 1, cacheDirectory );
+
+        SECTION( "Test mismatching catalog hash" )
+        {
+            expectedTable.writeCache( cachePath, ephemerisCatalogHash + 1 );
+        }
+
+        SECTION( "Test mismatching epochs" )
+        {
+            const std::vector< DateTime > otherEpochs = getEphemerisTestEpochs( 3 );
+            const EphemerisTable otherTable( tleObjects, otherEpochs, kMU );
+            otherTable.writeCache( cachePath, ephemerisCatalogHash );
+        }
+
+        SECTION( "Test mismatching gravitational parameter" )
+        {
+            const EphemerisTable otherTable( tleObjects, epochs, 1.01 * kMU );
+            otherTable.writeCache( cachePath, ephemerisCatalogHash );
+        }
+
+        REQUIRE_THROWS( EphemerisTable(
+            cachePath, ephemerisCatalogHash, tleObjects.size( ), epochs, kMU ) );
+
+        // The ephemerides are recomputed and the invalid cache file is overwritten.
+        const std::unique_ptr< const EphemerisTable > table = computeEphemerisTable(
+            tleObjects, ephemerisCatalogHash, epochs, kMU, 1, cacheDirectory );
+        REQUIRE( isEphemerisTableEqual( *table, expectedTable ) );
+        REQUIRE( outputBuffer.str( ).find( "is invalid and will be overwritten" )
+                 != std::string::npos );
+
+        const EphemerisTable cachedTable(
+            cachePath, ephemerisCatalogHash, tleObjects.size( ), epochs, kMU );
+        REQUIRE( isEphemerisTableEqual( cachedTable, expectedTable ) );
+    }
+
+    SECTION( "Test cache with wrong size" )
+    {
+        const std::string testCachePath = getRootPath( ) + "/test/ephemeris_cache_test.eph";
+        expectedTable.writeCache( testCachePath, ephemerisCatalogHash );
+        const long long cacheSize = getFileSize( testCachePath );
+
+        SECTION( "Test truncated cache" )
+        {
+            resizeFile( testCachePath, cacheSize - 1 );
+        }
+
+        SECTION( "Test cache with trailing bytes" )
+        {
+            resizeFile( testCachePath, cacheSize + 1 );
+        }
+
+        REQUIRE_THROWS( EphemerisTable(
+            testCachePath, ephemerisCatalogHash, tleObjects.size( ), epochs, kMU ) );
+
+        std::remove( testCachePath.c_str( ) );
+    }
+
+    SECTION( "Test cache directory that cannot be written" )
+    {
+        // A directory cannot be created inside a regular file.
+        const std::string invalidCacheDirectory
+            = getRootPath( ) + "/test/lambert_scanner_test.json/ephemeris_cache";
+
+        const std::unique_ptr< const EphemerisTable > table = computeEphemerisTable(
+            tleObjects, ephemerisCatalogHash, epochs, kMU, 1, invalidCacheDirectory );
+        REQUIRE( static_cast< bool >( table ) );
+        REQUIRE( isEphemerisTableEqual( *table, expectedTable ) );
+        REQUIRE( outputBuffer.str( ).find( "WARNING: Ephemerides are not cached!" )
+                 != std::string::npos );
+    }
+
+    // Remove temporary cache file and directory.
+    std::remove( cachePath.c_str( ) );
+    std::remove( cacheDirectory.c_str( ) );
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+} // namespace tests
+} // namespace d2d
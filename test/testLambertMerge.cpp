@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "D2D/lambertMerge.hpp"
+#include "D2D/lambertScanner.hpp"
+#include "D2D/tools.hpp"
+
+#include "testLambertScannerFixtures.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+//! Number of objects in catalog of test shard databases.
+const static int numberOfCatalogObjects = 5;
+
+//! Store lambert_scanner run parameters in shard database.
+static void storeLambertScannerShardParameters( const std::string& shardDatabasePath,
+                                                const LambertScannerInput& input )
+{
+    SQLite::Database database( shardDatabasePath.c_str( ), SQLITE_OPEN_READWRITE );
+    storeLambertScannerParameters( database, input );
+}
+
+//! Write lambert_scanner shard database with given progress and without transfers.
+static void writeLambertScannerShard( const std::string& shardDatabasePath,
+                                      const int progressBegin,
+                                      const int progressEnd )
+{
+    std::remove( shardDatabasePath.c_str( ) );
+    SQLite::Database database( shardDatabasePath.c_str( ),
+                               SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+
+    createLambertScannerTable( database, false );
+    createLambertScannerProgressTable( database );
+    createLambertScannerCatalogTable( database );
+
+    SQLite::Statement catalogQuery(
+        database,
+        "INSERT INTO lambert_scanner_catalog VALUES "
+        "(:object_index, :object_id, 'OBJECT', 'LINE 1', 'LINE 2');" );
+    for ( int i = 0; i < numberOfCatalogObjects; i++ )
+    {
+        catalogQuery.bind( ":object_index", i );
+        catalogQuery.bind( ":object_id", 10000 + i );
+        catalogQuery.executeStep( );
+        catalogQuery.reset( );
+    }
+
+    SQLite::Statement progressQuery(
+        database,
+        "INSERT INTO lambert_scanner_progress VALUES "
+        "(:departure_object_index, :departure_object_id);" );
+    for ( int i = progressBegin; i < progressEnd; i++ )
+    {
+        progressQuery.bind( ":departure_object_index", i );
+        progressQuery.bind( ":departure_object_id", 10000 + i );
+        progressQuery.executeStep( );
+        progressQuery.reset( );
+    }
+}
+
+TEST_CASE( "Test merging lambert_scanner shard databases", "[lambert_merge]" )
+{
+    // Set up two shards of a catalog of 5 objects: shard 0 contains departure objects 0 - 1 and
+    // shard 1 contains departure objects 2 - 4.
+    const std::string shardDatabasePaths[ ]
+        = { getRootPath( ) + "/test/lambert_merge_shard_0.db",
+            getRootPath( ) + "/test/lambert_merge_shard_1.db" };
+    writeLambertScannerShard( shardDatabasePaths[ 0 ], 0, 2 );
+    writeLambertScannerShard( shardDatabasePaths[ 1 ], 2, 5 );
+
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+    createLambertScannerTable( database, false );
+    createLambertScannerProgressTable( database );
+    createLambertScannerCatalogTable( database );
+
+    SECTION( "Test merging complete shards" )
+    {
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) == 0 );
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 1 ], 1, 2 ) == 0 );
+
+        const int numberOfMergedObjects
+            = database.execAndGet( "SELECT COUNT(*) FROM lambert_scanner_catalog;" );
+        const int numberOfCompletedObjects
+            = database.execAndGet( "SELECT COUNT(*) FROM lambert_scanner_progress;" );
+        REQUIRE( numberOfMergedObjects == numberOfCatalogObjects );
+        REQUIRE( numberOfCompletedObjects == numberOfCatalogObjects );
+    }
+
+    SECTION( "Test merging shards in wrong order" )
+    {
+        REQUIRE_THROWS( mergeLambertScannerShard( database, shardDatabasePaths[ 1 ], 0, 2 ) );
+    }
+
+    SECTION( "Test merging shard with different catalog" )
+    {
+        {
+            SQLite::Database shardDatabase( shardDatabasePaths[ 1 ].c_str( ),
+                                            SQLITE_OPEN_READWRITE );
+            shardDatabase.exec( "UPDATE lambert_scanner_catalog SET line_2 = 'CHANGED' "
+                                "WHERE object_index = 3;" );
+        }
+
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) == 0 );
+        REQUIRE_THROWS( mergeLambertScannerShard( database, shardDatabasePaths[ 1 ], 1, 2 ) );
+    }
+
+    SECTION( "Test merging shard that did not complete its departure objects" )
+    {
+        writeLambertScannerShard( shardDatabasePaths[ 1 ], 2, 4 );
+
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) == 0 );
+        REQUIRE_THROWS( mergeLambertScannerShard( database, shardDatabasePaths[ 1 ], 1, 2 ) );
+    }
+
+    SECTION( "Test merging shard with departure objects outside its slice" )
+    {
+        writeLambertScannerShard( shardDatabasePaths[ 0 ], 0, 3 );
+
+        REQUIRE_THROWS( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) );
+    }
+
+    SECTION( "Test merging shard with mismatching run parameters" )
+    {
+        createLambertScannerParametersTable( database );
+
+        {
+            SQLite::Database shardDatabase( shardDatabasePaths[ 0 ].c_str( ),
+                                            SQLITE_OPEN_READWRITE );
+            shardDatabase.exec( "CREATE TABLE lambert_scanner_parameters ("
+                                "\"name\" TEXT PRIMARY KEY, \"value\" REAL);" );
+            shardDatabase.exec( "INSERT INTO lambert_scanner_parameters VALUES "
+                                "('shard_index', 0.0), ('shards', 3.0);" );
+        }
+
+        REQUIRE_THROWS( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) );
+
+        {
+            SQLite::Database shardDatabase( shardDatabasePaths[ 0 ].c_str( ),
+                                            SQLITE_OPEN_READWRITE );
+            shardDatabase.exec( "UPDATE lambert_scanner_parameters SET value = 2.0 "
+                                "WHERE name = 'shards';" );
+        }
+
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) == 0 );
+    }
+
+    // Remove temporary shard databases.
+    std::remove( shardDatabasePaths[ 0 ].c_str( ) );
+    std::remove( shardDatabasePaths[ 1 ].c_str( ) );
+}
+
+TEST_CASE( "Test incremental update of merged lambert_scanner database", "[lambert_merge]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    // Set up two shards that store their run parameters.
+    const std::string shardDatabasePaths[ ]
+        = { getRootPath( ) + "/test/lambert_merge_shard_0.db",
+            getRootPath( ) + "/test/lambert_merge_shard_1.db" };
+    writeLambertScannerShard( shardDatabasePaths[ 0 ], 0, 2 );
+    writeLambertScannerShard( shardDatabasePaths[ 1 ], 2, 5 );
+    storeLambertScannerShardParameters( shardDatabasePaths[ 0 ],
+                                        getLambertScannerShardInput( 0, 2, 2 ) );
+
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+    createLambertScannerTable( database, false );
+    createLambertScannerProgressTable( database );
+    createLambertScannerCatalogTable( database );
+    createLambertScannerParametersTable( database );
+
+    SECTION( "Test incremental update of merged database" )
+    {
+        storeLambertScannerShardParameters( shardDatabasePaths[ 1 ],
+                                            getLambertScannerShardInput( 1, 2, 2 ) );
+
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) == 0 );
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 1 ], 1, 2 ) == 0 );
+
+        // The merged database is updated by a single, unsharded run.
+        rapidjson::Document config;
+        config.Parse( lambertScannerConfig.c_str( ) );
+        rapidjson::Value incremental( true );
+        config.AddMember( "incremental", incremental, config.GetAllocator( ) );
+        const LambertScannerInput input = checkLambertScannerInput( config );
+
+        REQUIRE( input.isIncremental );
+        REQUIRE_NOTHROW( checkLambertScannerParameters( database, input ) );
+        REQUIRE_THROWS( checkLambertScannerParameters(
+            database, getLambertScannerShardInput( 1, 2, 2 ) ) );
+    }
+
+    SECTION( "Test merging shards with different run parameters" )
+    {
+        storeLambertScannerShardParameters( shardDatabasePaths[ 1 ],
+                                            getLambertScannerShardInput( 1, 2, 1 ) );
+
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) == 0 );
+        REQUIRE_THROWS( mergeLambertScannerShard( database, shardDatabasePaths[ 1 ], 1, 2 ) );
+    }
+
+    SECTION( "Test merging shard without run parameters" )
+    {
+        REQUIRE( mergeLambertScannerShard( database, shardDatabasePaths[ 0 ], 0, 2 ) == 0 );
+        REQUIRE_THROWS( mergeLambertScannerShard( database, shardDatabasePaths[ 1 ], 1, 2 ) );
+    }
+
+    // Remove temporary shard databases.
+    std::remove( shardDatabasePaths[ 0 ].c_str( ) );
+    std::remove( shardDatabasePaths[ 1 ].c_str( ) );
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+} // namespace tests
+} // namespace d2d
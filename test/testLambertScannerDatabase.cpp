@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/Tle.h>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "D2D/lambertScanner.hpp"
+#include "D2D/tleCatalog.hpp"
+
+#include "testLambertScannerFixtures.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+TEST_CASE( "Test checking lambert_scanner run parameters", "[lambert_scanner],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+
+    SECTION( "Test missing parameters table" )
+    {
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    storeLambertScannerParameters( database, checkLambertScannerInput( config ) );
+    REQUIRE( database.tableExists( "lambert_scanner_parameters" ) );
+
+    SECTION( "Test matching parameters" )
+    {
+        REQUIRE_NOTHROW( checkLambertScannerParameters( database,
+                                                        checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test parameters that do not affect the stored transfers" )
+    {
+        rapidjson::Value threads( 4 );
+        config.AddMember( "threads", threads, config.GetAllocator( ) );
+        const std::string databasePath = "lambert_scanner_other.db";
+        config[ "database" ].SetString( databasePath.c_str( ), databasePath.size( ) );
+        REQUIRE_NOTHROW( checkLambertScannerParameters( database,
+                                                        checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test changed departure epoch grid" )
+    {
+        config[ "departure_epoch_grid" ][ 1 ].SetDouble( 3.0 );
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test changed time-of-flight grid" )
+    {
+        config[ "time_of_flight_grid" ][ 1 ].SetDouble( 108000.0 );
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test changed maximum number of revolutions" )
+    {
+        config[ "revolutions_maximum" ].SetInt( 1 );
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test changed transfer direction" )
+    {
+        rapidjson::Value direction( "both" );
+        config.AddMember( "direction", direction, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test changed transfer Delta V cut-off" )
+    {
+        rapidjson::Value transferDeltaVCutoff( 5.0 );
+        config.AddMember(
+            "transfer_deltav_cutoff", transferDeltaVCutoff, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test changed minimum transfer periapsis altitude" )
+    {
+        rapidjson::Value transferPeriapsisAltitudeMinimum( 200.0 );
+        config.AddMember( "transfer_periapsis_altitude_minimum",
+                          transferPeriapsisAltitudeMinimum,
+                          config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    SECTION( "Test changed grid refinement" )
+    {
+        rapidjson::Value gridRefinement( rapidjson::kArrayType );
+        gridRefinement.PushBack( 60.0, config.GetAllocator( ) );
+        gridRefinement.PushBack( 60.0, config.GetAllocator( ) );
+        config.AddMember( "grid_refinement", gridRefinement, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerParameters( database,
+                                                       checkLambertScannerInput( config ) ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test function to check incremental update input to lambert scanner",
+           "[lambert_scanner],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+
+    rapidjson::Value incremental( true );
+    config.AddMember( "incremental", incremental, config.GetAllocator( ) );
+
+    SECTION( "Test incremental update" )
+    {
+        REQUIRE( checkLambertScannerInput( config ).isIncremental );
+    }
+
+    SECTION( "Test incremental update combined with resume" )
+    {
+        rapidjson::Value resume( true );
+        config.AddMember( "resume", resume, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerInput( config ) );
+    }
+
+    SECTION( "Test incremental update combined with checkpoints" )
+    {
+        rapidjson::Value checkpointInterval( 10 );
+        config.AddMember( "checkpoint_interval", checkpointInterval, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerInput( config ) );
+    }
+
+    SECTION( "Test incremental update combined with column store" )
+    {
+        rapidjson::Value columnStore( "lambert_scanner_test_column_store" );
+        config.AddMember( "column_store", columnStore, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerInput( config ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test comparing TLE catalog with lambert_scanner catalog",
+           "[lambert_scanner],[input-output]" )
+{
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+
+    const TleObjects storedObjects = getLambertScannerTestObjects( );
+    std::vector< int > removedObjectIds;
+
+    SECTION( "Test missing tables of previous run" )
+    {
+        REQUIRE_THROWS(
+            compareLambertScannerCatalog( database, storedObjects, removedObjectIds ) );
+    }
+
+    createLambertScannerTable( database, true );
+    createLambertScannerCatalogTable( database );
+    storeLambertScannerCatalog( database, storedObjects );
+
+    SECTION( "Test unchanged catalog" )
+    {
+        const std::vector< bool > isObjectChanged
+            = compareLambertScannerCatalog( database, storedObjects, removedObjectIds );
+
+        REQUIRE( isObjectChanged.size( ) == 3 );
+        REQUIRE_FALSE( isObjectChanged[ 0 ] );
+        REQUIRE_FALSE( isObjectChanged[ 1 ] );
+        REQUIRE_FALSE( isObjectChanged[ 2 ] );
+        REQUIRE( removedObjectIds.empty( ) );
+    }
+
+    SECTION( "Test changed, added and removed objects" )
+    {
+        // Object 16616 has a new epoch, object 5 is added and object 17117 is removed.
+        TleObjects tleObjects;
+        tleObjects.push_back( storedObjects[ 0 ] );
+        tleObjects.push_back(
+            Tle( "ARIANE 1 DEB",
+                 "1 16616U 86019D   15057.25916885  .00000277  00000-0  12801-3 0  9997",
+                 "2 16616 098.7042 118.9780 0008713 157.7835 244.6378 14.28608381508537" ) );
+        tleObjects.push_back(
+            Tle( "VANGUARD 1",
+                 "1 00005U 58002B   15053.44138189  .00000391  00000-0  47710-3 0  9997",
+                 "2 00005 034.2588 089.7361 1844956 254.7565 084.2550 10.84507447994446" ) );
+
+        const std::vector< bool > isObjectChanged
+            = compareLambertScannerCatalog( database, tleObjects, removedObjectIds );
+
+        REQUIRE( isObjectChanged.size( ) == 3 );
+        REQUIRE_FALSE( isObjectChanged[ 0 ] );
+        REQUIRE( isObjectChanged[ 1 ] );
+        REQUIRE( isObjectChanged[ 2 ] );
+        REQUIRE( removedObjectIds.size( ) == 1 );
+        REQUIRE( removedObjectIds[ 0 ] == 17117 );
+    }
+
+    SECTION( "Test objects sharing NORAD ID" )
+    {
+        // Object 16616 occurs twice, with different epochs.
+        TleObjects tleObjects = storedObjects;
+        tleObjects.push_back(
+            Tle( "ARIANE 1 DEB",
+                 "1 16616U 86019D   15057.25916885  .00000277  00000-0  12801-3 0  9997",
+                 "2 16616 098.7042 118.9780 0008713 157.7835 244.6378 14.28608381508537" ) );
+
+        REQUIRE_THROWS( checkLambertScannerCatalog( tleObjects ) );
+        REQUIRE_THROWS(
+            compareLambertScannerCatalog( database, tleObjects, removedObjectIds ) );
+        REQUIRE_THROWS( storeLambertScannerCatalog( database, tleObjects ) );
+    }
+
+    SECTION( "Test reading compact table with catalog sharing NORAD ID" )
+    {
+        REQUIRE( LambertScannerTransferReader( database ).isCompact );
+
+        database.exec( "INSERT INTO lambert_scanner_catalog "
+                       "SELECT 3, object_id, name, line_1, line_2 FROM lambert_scanner_catalog "
+                       "WHERE object_index = 1;" );
+        REQUIRE_THROWS( LambertScannerTransferReader( database ).isCompact );
+    }
+}
+
+TEST_CASE( "Test checking resume of lambert_scanner run", "[lambert_scanner],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+    rapidjson::Value resume( true );
+    config.AddMember( "resume", resume, config.GetAllocator( ) );
+
+    const TleObjects storedObjects = getLambertScannerTestObjects( );
+
+    // Set up tables of interrupted run.
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+    const LambertScannerInput storedInput = checkLambertScannerInput( config );
+    createLambertScannerTable( database, storedInput.isCompact );
+    createLambertScannerProgressTable( database );
+    createLambertScannerCatalogTable( database );
+    storeLambertScannerCatalog( database, storedObjects );
+
+    SECTION( "Test missing parameters table" )
+    {
+        REQUIRE_THROWS( checkLambertScannerResume(
+            database, checkLambertScannerInput( config ), storedObjects ) );
+    }
+
+    storeLambertScannerParameters( database, storedInput );
+
+    SECTION( "Test resume with same catalog and input parameters" )
+    {
+        REQUIRE_NOTHROW( checkLambertScannerResume(
+            database, checkLambertScannerInput( config ), storedObjects ) );
+    }
+
+    SECTION( "Test resume with changed input parameters" )
+    {
+        config[ "revolutions_maximum" ].SetInt( 1 );
+        REQUIRE_THROWS( checkLambertScannerResume(
+            database, checkLambertScannerInput( config ), storedObjects ) );
+    }
+
+    SECTION( "Test resume with changed schema" )
+    {
+        rapidjson::Value schema( "compact" );
+        config.AddMember( "schema", schema, config.GetAllocator( ) );
+        REQUIRE_THROWS( checkLambertScannerResume(
+            database, checkLambertScannerInput( config ), storedObjects ) );
+    }
+
+    SECTION( "Test resume with refreshed catalog of same objects" )
+    {
+        // Object 16616 has a new epoch; the objects and their order are unchanged.
+        TleObjects tleObjects = storedObjects;
+        tleObjects[ 1 ]
+            = Tle( "ARIANE 1 DEB",
+                   "1 16616U 86019D   15057.25916885  .00000277  00000-0  12801-3 0  9997",
+                   "2 16616 098.7042 118.9780 0008713 157.7835 244.6378 14.28608381508537" );
+        REQUIRE_THROWS( checkLambertScannerResume(
+            database, checkLambertScannerInput( config ), tleObjects ) );
+    }
+
+    SECTION( "Test resume with catalog missing an object" )
+    {
+        TleObjects tleObjects = storedObjects;
+        tleObjects.pop_back( );
+        REQUIRE_THROWS( checkLambertScannerResume(
+            database, checkLambertScannerInput( config ), tleObjects ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test deleting lambert_scanner transfers", "[lambert_scanner],[input-output]" )
+{
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+    createLambertScannerTable( database, true );
+
+    // Store a transfer for each ordered pair of objects. Object IDs are bound as integers, as by
+    // lambert_scanner, and stored as text.
+    const int objectIds[ ] = { 16615, 16616, 17117 };
+    SQLite::Statement query(
+        database,
+        "INSERT INTO lambert_scanner_results (departure_object_id, arrival_object_id, "
+        "transfer_delta_v) VALUES (:departure_object_id, :arrival_object_id, 1.0);" );
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            if ( i != j )
+            {
+                query.bind( ":departure_object_id", objectIds[ i ] );
+                query.bind( ":arrival_object_id",   objectIds[ j ] );
+                query.executeStep( );
+                query.reset( );
+            }
+        }
+    }
+
+    SECTION( "Test deleting no objects" )
+    {
+        REQUIRE( deleteLambertScannerTransfers( database, std::vector< int >( ) ) == 0 );
+        REQUIRE( database.execAndGet(
+            "SELECT COUNT(*) FROM lambert_scanner_results;" ).getInt( ) == 6 );
+    }
+
+    SECTION( "Test deleting transfers of one object" )
+    {
+        REQUIRE( deleteLambertScannerTransfers( database, std::vector< int >( 1, 17117 ) ) == 4 );
+        REQUIRE( database.execAndGet(
+            "SELECT COUNT(*) FROM lambert_scanner_results;" ).getInt( ) == 2 );
+        REQUIRE( database.execAndGet(
+            "SELECT COUNT(*) FROM lambert_scanner_results WHERE departure_object_id = '17117' "
+            "OR arrival_object_id = '17117';" ).getInt( ) == 0 );
+    }
+
+    SECTION( "Test deleting transfers of several objects, including unknown object" )
+    {
+        std::vector< int > deletedObjectIds;
+        deletedObjectIds.push_back( 16615 );
+        deletedObjectIds.push_back( 16616 );
+        deletedObjectIds.push_back( 5 );
+        REQUIRE( deleteLambertScannerTransfers( database, deletedObjectIds ) == 6 );
+        REQUIRE( database.execAndGet(
+            "SELECT COUNT(*) FROM lambert_scanner_results;" ).getInt( ) == 0 );
+    }
+}
+
+} // namespace tests
+} // namespace d2d
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef D2D_TEST_LAMBERT_SCANNER_FIXTURES_HPP
+#define D2D_TEST_LAMBERT_SCANNER_FIXTURES_HPP
+
+#include <string>
+
+#include <libsgp4/Tle.h>
+
+#include <rapidjson/document.h>
+
+#include "D2D/lambertScanner.hpp"
+#include "D2D/tleCatalog.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+//! Config of lambert_scanner run on test catalog (lambert_scanner_tle_3line_catalog_test.txt).
+const static std::string lambertScannerConfig
+    = "{"
+      "\"mode\"                : \"lambert_scanner\","
+      "\"catalog\"             : \"lambert_scanner_tle_3line_catalog_test.txt\","
+      "\"database\"            : \"lambert_scanner_test.db\","
+      "\"departure_epoch\"     : [2015,3,24,16,3,30],"
+      "\"departure_epoch_grid\": [86400.0,2],"
+      "\"time_of_flight_grid\" : [36000.0,72000.0,2],"
+      "\"is_prograde\"         : true,"
+      "\"revolutions_maximum\" : 2,"
+      "\"shortlist\"           : [0]"
+      "}";
+
+//! Get TLE objects of lambert_scanner test catalog.
+inline TleObjects getLambertScannerTestObjects( )
+{
+    TleObjects tleObjects;
+    tleObjects.push_back(
+        Tle( "ARIANE 1 R/B",
+             "1 16615U 86019C   15056.74756344  .00000183  00000-0  85747-4 0  9997",
+             "2 16615 098.7218 114.5033 0011490 007.4719 100.7401 14.31425759518969" ) );
+    tleObjects.push_back(
+        Tle( "ARIANE 1 DEB",
+             "1 16616U 86019D   15056.25916885  .00000277  00000-0  12801-3 0  9996",
+             "2 16616 098.7042 118.9780 0008713 157.7835 244.6378 14.28608381508537" ) );
+    tleObjects.push_back(
+        Tle( "ARIANE 1 DEB",
+             "1 17117U 86019M   15056.14321689  .00002412  00000-0  78527-3 0  9993",
+             "2 17117 098.5197 097.5343 0091385 201.9294 191.1471 14.37298067464074" ) );
+    return tleObjects;
+}
+
+//! Add or replace member of lambert_scanner config.
+inline void setLambertScannerConfigMember( rapidjson::Document& config,
+                                           const char* name,
+                                           rapidjson::Value& value )
+{
+    if ( config.HasMember( name ) )
+    {
+        config.RemoveMember( name );
+    }
+
+    rapidjson::Value memberName( name, config.GetAllocator( ) );
+    config.AddMember( memberName, value, config.GetAllocator( ) );
+}
+
+//! Get lambert_scanner input for shard of departure objects.
+inline LambertScannerInput getLambertScannerShardInput( const int shardIndex,
+                                                        const int numberOfShards,
+                                                        const int revolutionsMaximum )
+{
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+    config[ "revolutions_maximum" ].SetInt( revolutionsMaximum );
+
+    rapidjson::Value shard( rapidjson::kArrayType );
+    shard.PushBack( shardIndex, config.GetAllocator( ) );
+    shard.PushBack( numberOfShards, config.GetAllocator( ) );
+    setLambertScannerConfigMember( config, "shard", shard );
+
+    return checkLambertScannerInput( config );
+}
+
+} // namespace tests
+} // namespace d2d
+
+#endif // D2D_TEST_LAMBERT_SCANNER_FIXTURES_HPP
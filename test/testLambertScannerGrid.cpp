@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/SGP4.h>
+#include <libsgp4/Tle.h>
+
+#include <rapidjson/document.h>
+
+#include "D2D/lambertScanner.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+//! Compute lowest transfer Delta V at a point of the departure epoch and time-of-flight grid.
+static double computeGridPointDeltaV( const LambertScannerInput& input,
+                                      const SGP4& departureSgp4,
+                                      const SGP4& arrivalSgp4,
+                                      const double departureEpochOffset,
+                                      const double timeOfFlight,
+                                      LambertScannerWorkspace& workspace,
+                                      LambertScannerStatistics& statistics )
+{
+    workspace.refinementDepartureEpochOffsets.assign( 1, departureEpochOffset );
+    workspace.refinementTimesOfFlight.assign( 1, timeOfFlight );
+    computeLambertScannerRefinementDeltaVs(
+        input, true, departureSgp4, arrivalSgp4, workspace, statistics );
+    return workspace.refinementDeltaVs[ 0 ];
+}
+
+TEST_CASE( "Test finding local minima of lambert_scanner grid", "[lambert_scanner]" )
+{
+    const double infinity = std::numeric_limits< double >::infinity( );
+
+    // Set up grid with 3 departure epochs and 5 times-of-flight, containing an isolated minimum
+    // (index 1), a plateau of equal minima (indices 8 and 9), an infinite Delta-V (index 14) and
+    // a minimum on the edge of the grid (index 10).
+    const double gridValues[ ] = { 3.0, 1.0, 2.0, 4.0, 5.0,
+                                   3.0, 3.5, 4.0, 0.5, 0.5,
+                                   2.5, 3.0, 3.0, 4.0, infinity };
+    const std::vector< double > gridDeltaVs( gridValues, gridValues + 15 );
+
+    std::vector< int > minimumIndices;
+    findLambertScannerGridMinima( gridDeltaVs, 3, 5, minimumIndices );
+
+    REQUIRE( minimumIndices.size( ) == 3 );
+    REQUIRE( minimumIndices[ 0 ] == 1 );
+    REQUIRE( minimumIndices[ 1 ] == 8 );
+    REQUIRE( minimumIndices[ 2 ] == 10 );
+
+    // A grid in which all transfers are rejected has no local minima.
+    findLambertScannerGridMinima( std::vector< double >( 15, infinity ), 3, 5, minimumIndices );
+    REQUIRE( minimumIndices.empty( ) );
+}
+
+TEST_CASE( "Test refining local minimum of lambert_scanner grid", "[lambert_scanner]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    // Set up coarse grid of 4 x 4 points with step sizes of 1800 s, refined to 450 s.
+    const std::string lambertScannerConfig
+        = "{"
+          "\"mode\"                : \"lambert_scanner\","
+          "\"catalog\"             : \"lambert_scanner_tle_3line_catalog_test.txt\","
+          "\"database\"            : \"lambert_scanner_test.db\","
+          "\"departure_epoch\"     : [2015,2,26],"
+          "\"departure_epoch_grid\": [7200.0,4],"
+          "\"time_of_flight_grid\" : [36000.0,43200.0,4],"
+          "\"is_prograde\"         : true,"
+          "\"revolutions_maximum\" : 2,"
+          "\"grid_refinement\"     : [450.0,450.0],"
+          "\"shortlist\"           : [0]"
+          "}";
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+    const LambertScannerInput input = checkLambertScannerInput( config );
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+
+    const SGP4 departureSgp4(
+        Tle( "ARIANE 1 R/B",
+             "1 16615U 86019C   15056.74756344  .00000183  00000-0  85747-4 0  9997",
+             "2 16615 098.7218 114.5033 0011490 007.4719 100.7401 14.31425759518969" ) );
+    const SGP4 arrivalSgp4(
+        Tle( "ARIANE 1 DEB",
+             "1 16616U 86019D   15056.25916885  .00000277  00000-0  12801-3 0  9996",
+             "2 16616 098.7042 118.9780 0008713 157.7835 244.6378 14.28608381508537" ) );
+
+    const int departureEpochSteps = static_cast< int >( input.departureEpochSteps );
+    const int timeOfFlightSteps = static_cast< int >( input.timeOfFlightSteps );
+    LambertScannerWorkspace workspace(
+        departureEpochSteps, timeOfFlightSteps, input.revolutionsMaximum );
+    LambertScannerStatistics statistics;
+
+    // Find minimum of coarse grid.
+    double coarseDepartureEpochOffset = 0.0;
+    double coarseTimeOfFlight = input.timeOfFlightMinimum;
+    double coarseDeltaV = std::numeric_limits< double >::infinity( );
+    for ( int m = 0; m < departureEpochSteps; m++ )
+    {
+        for ( int k = 0; k < timeOfFlightSteps; k++ )
+        {
+            const double departureEpochOffset = m * input.departureEpochStepSize;
+            const double timeOfFlight = input.timeOfFlightMinimum + k * input.timeOfFlightStepSize;
+            const double deltaV = computeGridPointDeltaV( input,
+                                                          departureSgp4,
+                                                          arrivalSgp4,
+                                                          departureEpochOffset,
+                                                          timeOfFlight,
+                                                          workspace,
+                                                          statistics );
+            if ( deltaV < coarseDeltaV )
+            {
+                coarseDeltaV = deltaV;
+                coarseDepartureEpochOffset = departureEpochOffset;
+                coarseTimeOfFlight = timeOfFlight;
+            }
+        }
+    }
+    REQUIRE( coarseDeltaV < std::numeric_limits< double >::infinity( ) );
+
+    double refinedDepartureEpochOffset = coarseDepartureEpochOffset;
+    double refinedTimeOfFlight = coarseTimeOfFlight;
+    double refinedDeltaV = coarseDeltaV;
+    refineLambertScannerGridMinimum( input,
+                                     true,
+                                     departureSgp4,
+                                     arrivalSgp4,
+                                     refinedDepartureEpochOffset,
+                                     refinedTimeOfFlight,
+                                     refinedDeltaV,
+                                     workspace,
+                                     statistics );
+
+    REQUIRE( refinedDeltaV <= coarseDeltaV );
+
+    // The refined optimum lies on the dense grid at the resolution.
+    REQUIRE( std::fmod( refinedDepartureEpochOffset, input.departureEpochResolution ) == 0.0 );
+    REQUIRE( std::fmod( refinedTimeOfFlight - input.timeOfFlightMinimum,
+                        input.timeOfFlightResolution ) == 0.0 );
+
+    // Evaluate dense grid at the resolution, over the points that the refinement of the coarse
+    // minimum can reach (900 s + 450 s on either side), within the range of the grid.
+    const double departureEpochRange = input.departureEpochSteps * input.departureEpochStepSize;
+    const double reach = 1350.0;
+    double denseDeltaV = std::numeric_limits< double >::infinity( );
+    for ( double departureEpochOffset = coarseDepartureEpochOffset - reach;
+          departureEpochOffset <= coarseDepartureEpochOffset + reach;
+          departureEpochOffset += input.departureEpochResolution )
+    {
+        for ( double timeOfFlight = coarseTimeOfFlight - reach;
+              timeOfFlight <= coarseTimeOfFlight + reach;
+              timeOfFlight += input.timeOfFlightResolution )
+        {
+            if ( departureEpochOffset < 0.0 || departureEpochOffset > departureEpochRange
+                 || timeOfFlight < input.timeOfFlightMinimum
+                 || timeOfFlight > input.timeOfFlightMaximum )
+            {
+                continue;
+            }
+
+            denseDeltaV = std::min( denseDeltaV, computeGridPointDeltaV( input,
+                                                                         departureSgp4,
+                                                                         arrivalSgp4,
+                                                                         departureEpochOffset,
+                                                                         timeOfFlight,
+                                                                         workspace,
+                                                                         statistics ) );
+        }
+    }
+
+    // The refinement finds the minimum of the dense grid, to within 1%.
+    REQUIRE( denseDeltaV <= refinedDeltaV );
+    REQUIRE( refinedDeltaV == Approx( denseDeltaV ).epsilon( 1.0e-2 ) );
+}
+
+} // namespace tests
+} // namespace d2d
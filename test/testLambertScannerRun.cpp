@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "D2D/lambertScanner.hpp"
+#include "D2D/tools.hpp"
+
+#include "testLambertScannerFixtures.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+//! Typedef for rows of lambert_scanner table, excluding the transfer_id column.
+typedef std::vector< std::vector< double > > LambertScannerRows;
+
+//! Run lambert_scanner on test catalog and fetch rows of lambert_scanner table.
+static LambertScannerRows runLambertScannerTest( rapidjson::Document& config )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    const std::string catalogPath
+        = getRootPath( ) + "/test/lambert_scanner_tle_3line_catalog_test.txt";
+    const std::string databasePath = getRootPath( ) + "/test/lambert_scanner_run_test.db";
+    std::remove( databasePath.c_str( ) );
+
+    rapidjson::Value catalog( catalogPath.c_str( ), catalogPath.size( ), config.GetAllocator( ) );
+    setLambertScannerConfigMember( config, "catalog", catalog );
+    rapidjson::Value database( databasePath.c_str( ), databasePath.size( ), config.GetAllocator( ) );
+    setLambertScannerConfigMember( config, "database", database );
+
+    executeLambertScanner( config );
+
+    LambertScannerRows rows;
+    {
+        SQLite::Database resultDatabase( databasePath.c_str( ), SQLITE_OPEN_READONLY );
+        SQLite::Statement query(
+            resultDatabase, "SELECT * FROM lambert_scanner_results ORDER BY transfer_id;" );
+        while ( query.executeStep( ) )
+        {
+            std::vector< double > row;
+            for ( int i = 1; i < query.getColumnCount( ); i++ )
+            {
+                row.push_back( query.getColumn( i ).getDouble( ) );
+            }
+            rows.push_back( row );
+        }
+    }
+
+    std::remove( databasePath.c_str( ) );
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+
+    return rows;
+}
+
+TEST_CASE( "Test tiling of lambert_scanner iteration space", "[lambert_scanner]" )
+{
+    const unsigned int numberOfObjects = 7;
+    const unsigned int blockSizes[ ][ 2 ] = { { 1, 1 }, { 2, 3 }, { 3, 2 }, { 4, 7 }, { 7, 1 },
+                                              { 10, 10 } };
+
+    std::vector< std::pair< unsigned int, unsigned int > > expectedWorkOrder;
+    for ( int t = 0; t < 6; t++ )
+    {
+        const LambertScannerTiling tiling( blockSizes[ t ][ 0 ], blockSizes[ t ][ 1 ] );
+
+        // Collect pairs per departure object in the order in which they are computed, and
+        // concatenate them in departure object order, as the lambert_scanner workers do.
+        std::vector< std::pair< unsigned int, unsigned int > > workOrder;
+        std::vector< std::vector< int > > pairCounts(
+            numberOfObjects, std::vector< int >( numberOfObjects, 0 ) );
+        for ( unsigned int b = 0; b * tiling.departureBlockSize < numberOfObjects; b++ )
+        {
+            std::vector< std::vector< std::pair< unsigned int, unsigned int > > >
+                departureObjectPairs( tiling.departureBlockSize );
+
+            const LambertScannerTiles tiles
+                = computeLambertScannerTiles( tiling, b, numberOfObjects );
+            REQUIRE( tiles.size( ) == ( numberOfObjects + tiling.arrivalBlockSize - 1 )
+                                      / tiling.arrivalBlockSize );
+
+            for ( unsigned int k = 0; k < tiles.size( ); k++ )
+            {
+                REQUIRE( tiles[ k ].departureObjectIndexBegin == b * tiling.departureBlockSize );
+                REQUIRE( tiles[ k ].arrivalObjectIndexEnd <= numberOfObjects );
+
+                for ( unsigned int i = tiles[ k ].departureObjectIndexBegin;
+                      i < tiles[ k ].departureObjectIndexEnd;
+                      i++ )
+                {
+                    for ( unsigned int j = tiles[ k ].arrivalObjectIndexBegin;
+                          j < tiles[ k ].arrivalObjectIndexEnd;
+                          j++ )
+                    {
+                        if ( i != j )
+                        {
+                            departureObjectPairs[ i - tiles[ k ].departureObjectIndexBegin ]
+                                .push_back( std::make_pair( i, j ) );
+                            ++pairCounts[ i ][ j ];
+                        }
+                    }
+                }
+            }
+
+            for ( unsigned int i = 0; i < departureObjectPairs.size( ); i++ )
+            {
+                workOrder.insert( workOrder.end( ),
+                                  departureObjectPairs[ i ].begin( ),
+                                  departureObjectPairs[ i ].end( ) );
+            }
+        }
+
+        // Every ordered pair of distinct objects is computed exactly once.
+        for ( unsigned int i = 0; i < numberOfObjects; i++ )
+        {
+            for ( unsigned int j = 0; j < numberOfObjects; j++ )
+            {
+                REQUIRE( pairCounts[ i ][ j ] == ( i == j ? 0 : 1 ) );
+            }
+        }
+
+        // The work order does not depend on the tile size.
+        if ( t == 0 )
+        {
+            expectedWorkOrder = workOrder;
+        }
+        REQUIRE( workOrder.size( ) == numberOfObjects * ( numberOfObjects - 1 ) );
+        REQUIRE( workOrder == expectedWorkOrder );
+    }
+}
+
+TEST_CASE( "Test computing tiling of lambert_scanner iteration space", "[lambert_scanner]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+
+    SECTION( "Test tile size set by user" )
+    {
+        rapidjson::Value tileSize( rapidjson::kArrayType );
+        tileSize.PushBack( 3, config.GetAllocator( ) );
+        tileSize.PushBack( 5, config.GetAllocator( ) );
+        config.AddMember( "tile_size", tileSize, config.GetAllocator( ) );
+
+        const LambertScannerTiling tiling
+            = computeLambertScannerTiling( checkLambertScannerInput( config ), 100, 6 );
+        REQUIRE( tiling.departureBlockSize == 3 );
+        REQUIRE( tiling.arrivalBlockSize == 5 );
+
+        // Arrival blocks do not exceed the number of objects.
+        const LambertScannerTiling smallTiling
+            = computeLambertScannerTiling( checkLambertScannerInput( config ), 4, 6 );
+        REQUIRE( smallTiling.arrivalBlockSize == 4 );
+    }
+
+    SECTION( "Test tile size set automatically" )
+    {
+        const LambertScannerTiling tiling
+            = computeLambertScannerTiling( checkLambertScannerInput( config ), 100, 6 );
+        REQUIRE( tiling.departureBlockSize >= 1 );
+        REQUIRE( tiling.departureBlockSize <= 4 );
+        REQUIRE( tiling.arrivalBlockSize >= 1 );
+        REQUIRE( tiling.arrivalBlockSize <= 100 );
+
+        // Tiles are at least one object in size for an empty catalog.
+        const LambertScannerTiling emptyTiling
+            = computeLambertScannerTiling( checkLambertScannerInput( config ), 0, 0 );
+        REQUIRE( emptyTiling.departureBlockSize >= 1 );
+        REQUIRE( emptyTiling.arrivalBlockSize >= 1 );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test lambert_scanner output for different tile sizes", "[lambert_scanner]" )
+{
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+    const LambertScannerRows expectedRows = runLambertScannerTest( config );
+
+    REQUIRE( !expectedRows.empty( ) );
+
+    const int blockSizes[ ][ 2 ] = { { 1, 1 }, { 1, 2 }, { 2, 1 }, { 3, 3 } };
+    for ( int t = 0; t < 4; t++ )
+    {
+        rapidjson::Value tileSize( rapidjson::kArrayType );
+        tileSize.PushBack( blockSizes[ t ][ 0 ], config.GetAllocator( ) );
+        tileSize.PushBack( blockSizes[ t ][ 1 ], config.GetAllocator( ) );
+        setLambertScannerConfigMember( config, "tile_size", tileSize );
+
+        REQUIRE( runLambertScannerTest( config ) == expectedRows );
+    }
+}
+
+TEST_CASE( "Test lambert_scanner output for different numbers of threads", "[lambert_scanner]" )
+{
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+
+    rapidjson::Value singleThread( 1 );
+    setLambertScannerConfigMember( config, "threads", singleThread );
+    const LambertScannerRows expectedRows = runLambertScannerTest( config );
+    REQUIRE( !expectedRows.empty( ) );
+
+    rapidjson::Value multipleThreads( 4 );
+    setLambertScannerConfigMember( config, "threads", multipleThreads );
+    REQUIRE( runLambertScannerTest( config ) == expectedRows );
+}
+
+TEST_CASE( "Test lambert_scanner output for both transfer directions", "[lambert_scanner]" )
+{
+    // Index of "prograde" column in rows of lambert_scanner table.
+    const int progradeIndex = 5;
+
+    rapidjson::Document config;
+    config.Parse( lambertScannerConfig.c_str( ) );
+
+    rapidjson::Value prograde( "prograde" );
+    setLambertScannerConfigMember( config, "direction", prograde );
+    const LambertScannerRows progradeRows = runLambertScannerTest( config );
+
+    rapidjson::Value retrograde( "retrograde" );
+    setLambertScannerConfigMember( config, "direction", retrograde );
+    const LambertScannerRows retrogradeRows = runLambertScannerTest( config );
+
+    rapidjson::Value both( "both" );
+    setLambertScannerConfigMember( config, "direction", both );
+    const LambertScannerRows rows = runLambertScannerTest( config );
+
+    REQUIRE( !progradeRows.empty( ) );
+    REQUIRE( !retrogradeRows.empty( ) );
+    REQUIRE( rows.size( ) == progradeRows.size( ) + retrogradeRows.size( ) );
+
+    // Each pair has transfers in both directions.
+    std::set< std::pair< double, double > > progradePairs;
+    std::set< std::pair< double, double > > retrogradePairs;
+    LambertScannerRows bothProgradeRows;
+    LambertScannerRows bothRetrogradeRows;
+    for ( unsigned int i = 0; i < rows.size( ); i++ )
+    {
+        const std::pair< double, double > pair = std::make_pair( rows[ i ][ 0 ], rows[ i ][ 1 ] );
+        if ( rows[ i ][ progradeIndex ] == 1.0 )
+        {
+            progradePairs.insert( pair );
+            bothProgradeRows.push_back( rows[ i ] );
+        }
+
+        else
+        {
+            retrogradePairs.insert( pair );
+            bothRetrogradeRows.push_back( rows[ i ] );
+        }
+    }
+    REQUIRE( !progradePairs.empty( ) );
+    REQUIRE( progradePairs == retrogradePairs );
+
+    // The transfers of each direction are identical to those of a single-direction run.
+    REQUIRE( bothProgradeRows == progradeRows );
+    REQUIRE( bothRetrogradeRows == retrogradeRows );
+}
+
+} // namespace tests
+} // namespace d2d
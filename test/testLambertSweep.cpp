@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/DateTime.h>
+
+#include <rapidjson/document.h>
+
+#include "D2D/lambertScanner.hpp"
+#include "D2D/lambertSweep.hpp"
+
+#include "testLambertScannerFixtures.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+//! Parse lambert_sweep config with given variants, sharing the lambert_scanner test config.
+static void parseLambertSweepConfig( const std::string& variants, rapidjson::Document& config )
+{
+    config.Parse( lambertScannerConfig.c_str( ) );
+    config.RemoveMember( "database" );
+    config[ "mode" ].SetString( "lambert_sweep" );
+
+    const std::string variantsJson = "[" + variants + "]";
+    rapidjson::Document variantsDocument;
+    variantsDocument.Parse( variantsJson.c_str( ) );
+    REQUIRE_FALSE( variantsDocument.HasParseError( ) );
+
+    rapidjson::Value variantsValue( variantsDocument, config.GetAllocator( ) );
+    setLambertScannerConfigMember( config, "variants", variantsValue );
+}
+
+TEST_CASE( "Test checking lambert_sweep input", "[lambert_sweep],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    rapidjson::Document config;
+
+    SECTION( "Test valid variants" )
+    {
+        parseLambertSweepConfig(
+            "{ \"database\" : \"sweep_0.db\", \"revolutions_maximum\" : 0 },"
+            "{ \"database\" : \"sweep_1.db\", \"time_of_flight_grid\" : [36000.0,108000.0,4] }",
+            config );
+
+        const std::vector< LambertScannerInput > inputs = checkLambertSweepInput( config );
+        REQUIRE( inputs.size( ) == 2 );
+        REQUIRE( inputs[ 0 ].databasePath == "sweep_0.db" );
+        REQUIRE( inputs[ 0 ].revolutionsMaximum == 0 );
+        REQUIRE( inputs[ 0 ].timeOfFlightSteps == 2 );
+        REQUIRE( inputs[ 1 ].databasePath == "sweep_1.db" );
+        REQUIRE( inputs[ 1 ].revolutionsMaximum == 2 );
+        REQUIRE( inputs[ 1 ].timeOfFlightMaximum == 108000.0 );
+        REQUIRE( inputs[ 1 ].timeOfFlightSteps == 4 );
+    }
+
+    SECTION( "Test missing variants" )
+    {
+        parseLambertSweepConfig( "", config );
+        config.RemoveMember( "variants" );
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test variants that are not an array" )
+    {
+        parseLambertSweepConfig( "", config );
+        config[ "variants" ].SetObject( );
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test empty list of variants" )
+    {
+        parseLambertSweepConfig( "", config );
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test variant that is not an object" )
+    {
+        parseLambertSweepConfig( "{ \"database\" : \"sweep_0.db\" }, [\"sweep_1.db\"]", config );
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test variant without database" )
+    {
+        parseLambertSweepConfig( "{ \"database\" : \"sweep_0.db\" }, { \"threads\" : 2 }",
+                                 config );
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test variants that share database" )
+    {
+        parseLambertSweepConfig( "{ \"database\" : \"sweep_0.db\" },"
+                                 "{ \"database\" : \"sweep_0.db\", \"revolutions_maximum\" : 0 }",
+                                 config );
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test variant that overrides common option" )
+    {
+        parseLambertSweepConfig(
+            "{ \"database\" : \"sweep_0.db\", \"catalog\" : \"other_catalog.txt\" }", config );
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test variant with malformed time-of-flight grid" )
+    {
+        SECTION( "Test missing number of steps" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\", \"time_of_flight_grid\" : [36000.0,72000.0] }",
+                config );
+        }
+
+        SECTION( "Test grid that is not an array" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\", \"time_of_flight_grid\" : 36000.0 }", config );
+        }
+
+        SECTION( "Test grid with non-numeric bound" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\","
+                "  \"time_of_flight_grid\" : [\"36000.0\",72000.0,2] }",
+                config );
+        }
+
+        SECTION( "Test grid without steps" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\", \"time_of_flight_grid\" : [36000.0,72000.0,0] }",
+                config );
+        }
+
+        SECTION( "Test grid with inverted bounds" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\", \"time_of_flight_grid\" : [72000.0,36000.0,2] }",
+                config );
+        }
+
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    SECTION( "Test variant with malformed departure epoch grid" )
+    {
+        SECTION( "Test missing number of steps" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\", \"departure_epoch_grid\" : [86400.0] }", config );
+        }
+
+        SECTION( "Test grid with non-numeric number of steps" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\", \"departure_epoch_grid\" : [86400.0,\"2\"] }",
+                config );
+        }
+
+        SECTION( "Test grid without steps" )
+        {
+            parseLambertSweepConfig(
+                "{ \"database\" : \"sweep_0.db\", \"departure_epoch_grid\" : [86400.0,0] }",
+                config );
+        }
+
+        REQUIRE_THROWS( checkLambertSweepInput( config ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test computing shared lambert_sweep epoch grids", "[lambert_sweep]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    // The first variant departs at 0 s and 43200 s and arrives after 36000 s and 54000 s; the
+    // second variant departs at 0 s and arrives after 36000 s and 72000 s. The departure at 0 s
+    // and the arrival at 36000 s are shared, so the union contains 7 distinct epochs.
+    rapidjson::Document config;
+    parseLambertSweepConfig(
+        "{ \"database\" : \"sweep_0.db\" },"
+        "{ \"database\" : \"sweep_1.db\","
+        "  \"departure_epoch_grid\" : [36000.0,1],"
+        "  \"time_of_flight_grid\"  : [36000.0,108000.0,2] },"
+        "{ \"database\" : \"sweep_2.db\" }",
+        config );
+    const std::vector< LambertScannerInput > inputs = checkLambertSweepInput( config );
+    const std::vector< LambertScannerEpochGrid > epochGrids
+        = computeLambertScannerEpochGrids( inputs );
+
+    REQUIRE( epochGrids.size( ) == inputs.size( ) );
+
+    const std::vector< DateTime >& epochs = epochGrids[ 0 ].epochs;
+    REQUIRE( epochs.size( ) == 7 );
+
+    // Epochs are distinct and in chronological order.
+    for ( unsigned int j = 1; j < epochs.size( ); j++ )
+    {
+        REQUIRE( epochs[ j - 1 ].Ticks( ) < epochs[ j ].Ticks( ) );
+    }
+
+    std::set< long long > gridEpochTicks;
+    for ( unsigned int i = 0; i < inputs.size( ); i++ )
+    {
+        const LambertScannerInput& input = inputs[ i ];
+        const LambertScannerEpochGrid& epochGrid = epochGrids[ i ];
+
+        // All grids share the same epochs.
+        REQUIRE( epochGrid.epochs.size( ) == epochs.size( ) );
+        for ( unsigned int j = 0; j < epochs.size( ); j++ )
+        {
+            REQUIRE( epochGrid.epochs[ j ].Ticks( ) == epochs[ j ].Ticks( ) );
+        }
+
+        // Each grid point indexes the epoch at which it occurs.
+        REQUIRE( epochGrid.departureEpochIndices.size( )
+                 == static_cast< unsigned int >( input.departureEpochSteps ) );
+        REQUIRE( epochGrid.arrivalEpochIndices.size( )
+                 == static_cast< unsigned int >( input.departureEpochSteps
+                                                 * input.timeOfFlightSteps ) );
+        for ( int m = 0; m < input.departureEpochSteps; ++m )
+        {
+            const DateTime departureEpoch
+                = input.departureEpochInitial.AddSeconds( input.departureEpochStepSize * m );
+            REQUIRE( epochs[ epochGrid.departureEpochIndices[ m ] ].Ticks( )
+                     == departureEpoch.Ticks( ) );
+            gridEpochTicks.insert( departureEpoch.Ticks( ) );
+
+            for ( int k = 0; k < input.timeOfFlightSteps; k++ )
+            {
+                const DateTime arrivalEpoch = departureEpoch.AddSeconds(
+                    input.timeOfFlightMinimum + k * input.timeOfFlightStepSize );
+                REQUIRE( epochs[ epochGrid.arrivalEpochIndices[ m * input.timeOfFlightSteps + k ] ]
+                         .Ticks( ) == arrivalEpoch.Ticks( ) );
+                gridEpochTicks.insert( arrivalEpoch.Ticks( ) );
+            }
+        }
+    }
+
+    // The union contains exactly the epochs of the grid points.
+    REQUIRE( gridEpochTicks.size( ) == epochs.size( ) );
+
+    // Identical variants have identical grids.
+    REQUIRE( epochGrids[ 2 ].departureEpochIndices == epochGrids[ 0 ].departureEpochIndices );
+    REQUIRE( epochGrids[ 2 ].arrivalEpochIndices == epochGrids[ 0 ].arrivalEpochIndices );
+
+    // A single grid only contains its own epochs.
+    const LambertScannerEpochGrid singleEpochGrid = computeLambertScannerEpochGrid( inputs[ 0 ] );
+    REQUIRE( singleEpochGrid.epochs.size( ) == 6 );
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+} // namespace tests
+} // namespace d2d
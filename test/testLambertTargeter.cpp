@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <keplerian_toolbox.h>
+
+#include "D2D/lambertTargeter.hpp"
+#include "D2D/typedefs.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+TEST_CASE( "Test reusable Lambert targeter", "[lambert]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    const int revolutionsMaximum = 2;
+
+    Vector3 departurePosition;
+    departurePosition[ 0 ] = 7000.0;
+    departurePosition[ 1 ] = 100.0;
+    departurePosition[ 2 ] = 200.0;
+
+    Vector3 arrivalPosition;
+    arrivalPosition[ 0 ] = -3000.0;
+    arrivalPosition[ 1 ] = 6800.0;
+    arrivalPosition[ 2 ] = 1500.0;
+
+    const double timesOfFlight[ ] = { 2000.0, 4000.0, 20000.0, 40000.0 };
+
+    // The same targeter is reused for all Lambert problems.
+    LambertTargeter targeter( revolutionsMaximum );
+    REQUIRE( targeter.getCapacity( ) == 2 * revolutionsMaximum + 1 );
+
+    for ( int isRetrograde = 0; isRetrograde < 2; isRetrograde++ )
+    {
+        for ( unsigned int i = 0; i < 4; i++ )
+        {
+            // Solutions are compared to those computed by the Lambert targeter in PyKEP.
+            const kep_toolbox::lambert_problem expectedTargeter( departurePosition,
+                                                                 arrivalPosition,
+                                                                 timesOfFlight[ i ],
+                                                                 gravitationalParameter,
+                                                                 isRetrograde,
+                                                                 revolutionsMaximum );
+
+            const int numberOfSolutions = targeter.solve( departurePosition,
+                                                          arrivalPosition,
+                                                          timesOfFlight[ i ],
+                                                          gravitationalParameter,
+                                                          isRetrograde == 1 );
+
+            REQUIRE( numberOfSolutions
+                     == static_cast< int >( expectedTargeter.get_v1( ).size( ) ) );
+            REQUIRE( targeter.getNumberOfSolutions( ) == numberOfSolutions );
+
+            for ( int j = 0; j < numberOfSolutions; j++ )
+            {
+                for ( int k = 0; k < 3; k++ )
+                {
+                    REQUIRE( targeter.getDepartureVelocity( j )[ k ]
+                             == Approx( expectedTargeter.get_v1( )[ j ][ k ] ).epsilon( 1.0e-10 ) );
+                    REQUIRE( targeter.getArrivalVelocity( j )[ k ]
+                             == Approx( expectedTargeter.get_v2( )[ j ][ k ] ).epsilon( 1.0e-10 ) );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "Test batched Lambert targeter", "[lambert]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    const int revolutionsMaximum = 2;
+    const int numberOfProblems = 40;
+
+    // Set up batch of Lambert problems with common departure position, along a time-of-flight
+    // grid, for an arrival object moving along a circular orbit.
+    std::vector< Vector3 > departurePositions( numberOfProblems );
+    std::vector< Vector3 > arrivalPositions( numberOfProblems );
+    std::vector< double > timesOfFlight( numberOfProblems );
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        departurePositions[ i ][ 0 ] = 7000.0;
+        departurePositions[ i ][ 1 ] = 100.0;
+        departurePositions[ i ][ 2 ] = 200.0;
+
+        timesOfFlight[ i ] = 1000.0 + i * 1000.0;
+
+        const double arrivalAngle = 1.0 + timesOfFlight[ i ] * 1.0e-3;
+        arrivalPositions[ i ][ 0 ] = 7200.0 * std::cos( arrivalAngle );
+        arrivalPositions[ i ][ 1 ] = 7200.0 * std::sin( arrivalAngle );
+        arrivalPositions[ i ][ 2 ] = 500.0;
+    }
+
+    LambertBatchTargeter targeter( numberOfProblems, revolutionsMaximum );
+
+    for ( int isRetrograde = 0; isRetrograde < 2; isRetrograde++ )
+    {
+        targeter.solve( departurePositions,
+                        arrivalPositions,
+                        timesOfFlight,
+                        gravitationalParameter,
+                        isRetrograde == 1 );
+        REQUIRE( targeter.getNumberOfProblems( ) == numberOfProblems );
+
+        for ( int i = 0; i < numberOfProblems; i++ )
+        {
+            const kep_toolbox::lambert_problem expectedTargeter( departurePositions[ i ],
+                                                                 arrivalPositions[ i ],
+                                                                 timesOfFlight[ i ],
+                                                                 gravitationalParameter,
+                                                                 isRetrograde,
+                                                                 revolutionsMaximum );
+
+            REQUIRE( targeter.getNumberOfSolutions( i )
+                     == static_cast< int >( expectedTargeter.get_v1( ).size( ) ) );
+
+            for ( int j = 0; j < targeter.getNumberOfSolutions( i ); j++ )
+            {
+                for ( int k = 0; k < 3; k++ )
+                {
+                    REQUIRE( targeter.getDepartureVelocity( i, j )[ k ]
+                             == Approx( expectedTargeter.get_v1( )[ j ][ k ] ).epsilon( 1.0e-10 ) );
+                    REQUIRE( targeter.getArrivalVelocity( i, j )[ k ]
+                             == Approx( expectedTargeter.get_v2( )[ j ][ k ] ).epsilon( 1.0e-10 ) );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "Test warm-started Lambert targeter", "[lambert]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    const int revolutionsMaximum = 2;
+    const int numberOfProblems = 100;
+
+    // Set up fine time-of-flight grid, for an arrival object moving along a circular orbit, such
+    // that the number of revolutions changes along the grid.
+    std::vector< Vector3 > departurePositions( numberOfProblems );
+    std::vector< Vector3 > arrivalPositions( numberOfProblems );
+    std::vector< double > timesOfFlight( numberOfProblems );
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        departurePositions[ i ][ 0 ] = 7000.0;
+        departurePositions[ i ][ 1 ] = 100.0;
+        departurePositions[ i ][ 2 ] = 200.0;
+
+        timesOfFlight[ i ] = 600.0 + i * 150.0;
+
+        const double arrivalAngle = 0.3 + timesOfFlight[ i ] * 7.4e-4;
+        arrivalPositions[ i ][ 0 ] = 7400.0 * std::cos( arrivalAngle );
+        arrivalPositions[ i ][ 1 ] = 7400.0 * std::sin( arrivalAngle );
+        arrivalPositions[ i ][ 2 ] = 300.0;
+    }
+
+    LambertBatchTargeter targeter( numberOfProblems, revolutionsMaximum );
+
+    for ( int isRetrograde = 0; isRetrograde < 2; isRetrograde++ )
+    {
+        targeter.solve( departurePositions,
+                        arrivalPositions,
+                        timesOfFlight,
+                        gravitationalParameter,
+                        isRetrograde == 1 );
+        const long long coldIterations = targeter.getNumberOfIterations( );
+
+        targeter.solve( departurePositions,
+                        arrivalPositions,
+                        timesOfFlight,
+                        gravitationalParameter,
+                        isRetrograde == 1,
+                        true );
+        REQUIRE( targeter.getNumberOfIterations( ) < coldIterations );
+
+        for ( int i = 0; i < numberOfProblems; i++ )
+        {
+            const kep_toolbox::lambert_problem expectedTargeter( departurePositions[ i ],
+                                                                 arrivalPositions[ i ],
+                                                                 timesOfFlight[ i ],
+                                                                 gravitationalParameter,
+                                                                 isRetrograde,
+                                                                 revolutionsMaximum );
+
+            REQUIRE( targeter.getNumberOfSolutions( i )
+                     == static_cast< int >( expectedTargeter.get_v1( ).size( ) ) );
+
+            for ( int j = 0; j < targeter.getNumberOfSolutions( i ); j++ )
+            {
+                for ( int k = 0; k < 3; k++ )
+                {
+                    REQUIRE( targeter.getDepartureVelocity( i, j )[ k ]
+                             == Approx( expectedTargeter.get_v1( )[ j ][ k ] ).epsilon( 1.0e-10 ) );
+                    REQUIRE( targeter.getArrivalVelocity( i, j )[ k ]
+                             == Approx( expectedTargeter.get_v2( )[ j ][ k ] ).epsilon( 1.0e-10 ) );
+                }
+            }
+        }
+    }
+}
+
+// Benchmark is hidden; run it explicitly using: test_D2D "[benchmark]".
+TEST_CASE( "Benchmark batched Lambert targeter", "[.][benchmark]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    const int revolutionsMaximum = 2;
+    const int numberOfProblems = 100;
+    const int numberOfRepetitions = 2000;
+
+    std::vector< Vector3 > departurePositions( numberOfProblems );
+    std::vector< Vector3 > arrivalPositions( numberOfProblems );
+    std::vector< double > timesOfFlight( numberOfProblems );
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        departurePositions[ i ][ 0 ] = 7000.0;
+        departurePositions[ i ][ 1 ] = 100.0;
+        departurePositions[ i ][ 2 ] = 200.0;
+
+        timesOfFlight[ i ] = 1000.0 + i * 300.0;
+
+        const double arrivalAngle = 1.0 + timesOfFlight[ i ] * 1.0e-3;
+        arrivalPositions[ i ][ 0 ] = 7200.0 * std::cos( arrivalAngle );
+        arrivalPositions[ i ][ 1 ] = 7200.0 * std::sin( arrivalAngle );
+        arrivalPositions[ i ][ 2 ] = 500.0;
+    }
+
+    // Accumulate a velocity component, such that the computations are not optimized away.
+    double checksum = 0.0;
+
+    const std::chrono::steady_clock::time_point lambertProblemStart
+        = std::chrono::steady_clock::now( );
+    for ( int n = 0; n < numberOfRepetitions; n++ )
+    {
+        for ( int i = 0; i < numberOfProblems; i++ )
+        {
+            const kep_toolbox::lambert_problem targeter( departurePositions[ i ],
+                                                         arrivalPositions[ i ],
+                                                         timesOfFlight[ i ],
+                                                         gravitationalParameter,
+                                                         false,
+                                                         revolutionsMaximum );
+            checksum += targeter.get_v1( )[ 0 ][ 0 ];
+        }
+    }
+    const std::chrono::duration< double > lambertProblemTime
+        = std::chrono::steady_clock::now( ) - lambertProblemStart;
+
+    LambertTargeter targeter( revolutionsMaximum );
+    const std::chrono::steady_clock::time_point targeterStart = std::chrono::steady_clock::now( );
+    for ( int n = 0; n < numberOfRepetitions; n++ )
+    {
+        for ( int i = 0; i < numberOfProblems; i++ )
+        {
+            targeter.solve( departurePositions[ i ],
+                            arrivalPositions[ i ],
+                            timesOfFlight[ i ],
+                            gravitationalParameter,
+                            false );
+            checksum += targeter.getDepartureVelocity( 0 )[ 0 ];
+        }
+    }
+    const std::chrono::duration< double > targeterTime
+        = std::chrono::steady_clock::now( ) - targeterStart;
+
+    LambertBatchTargeter batchTargeter( numberOfProblems, revolutionsMaximum );
+    const std::chrono::steady_clock::time_point batchTargeterStart
+        = std::chrono::steady_clock::now( );
+    for ( int n = 0; n < numberOfRepetitions; n++ )
+    {
+        batchTargeter.solve( departurePositions,
+                             arrivalPositions,
+                             timesOfFlight,
+                             gravitationalParameter,
+                             false );
+        checksum += batchTargeter.getDepartureVelocity( 0, 0 )[ 0 ];
+    }
+    const std::chrono::duration< double > batchTargeterTime
+        = std::chrono::steady_clock::now( ) - batchTargeterStart;
+    const long long batchIterations = batchTargeter.getNumberOfIterations( );
+
+    // Warm-started iterations, as used by lambert_scanner if "warm_start" is set.
+    const std::chrono::steady_clock::time_point warmStartedTargeterStart
+        = std::chrono::steady_clock::now( );
+    for ( int n = 0; n < numberOfRepetitions; n++ )
+    {
+        batchTargeter.solve( departurePositions,
+                             arrivalPositions,
+                             timesOfFlight,
+                             gravitationalParameter,
+                             false,
+                             true );
+        checksum += batchTargeter.getDepartureVelocity( 0, 0 )[ 0 ];
+    }
+    const std::chrono::duration< double > warmStartedTargeterTime
+        = std::chrono::steady_clock::now( ) - warmStartedTargeterStart;
+    const long long warmStartedIterations = batchTargeter.getNumberOfIterations( );
+
+    const double numberOfSolves = static_cast< double >( numberOfRepetitions ) * numberOfProblems;
+    std::cout << "Lambert problems solved       " << numberOfSolves << std::endl;
+    std::cout << "lambert_problem [us/problem]  "
+              << lambertProblemTime.count( ) / numberOfSolves * 1.0e6 << std::endl;
+    std::cout << "LambertTargeter [us/problem]  "
+              << targeterTime.count( ) / numberOfSolves * 1.0e6 << std::endl;
+    std::cout << "LambertBatchTargeter [us/pr.] "
+              << batchTargeterTime.count( ) / numberOfSolves * 1.0e6 << std::endl;
+    std::cout << "Warm-started batch [us/pr.]   "
+              << warmStartedTargeterTime.count( ) / numberOfSolves * 1.0e6 << std::endl;
+    std::cout << "Iterations per batch (cold)   " << batchIterations << std::endl;
+    std::cout << "Iterations per batch (warm)   " << warmStartedIterations << std::endl;
+    std::cout << "Checksum                      " << checksum << std::endl;
+
+    REQUIRE( checksum == checksum );
+}
+
+} // namespace tests
+} // namespace d2d
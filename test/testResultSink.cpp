@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <rapidjson/document.h>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "D2D/resultSink.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+//! Get result fields of test records.
+static ResultFields getResultSinkTestFields( )
+{
+    ResultFields fields;
+    fields.push_back( ResultField( "object_id", true ) );
+    fields.push_back( ResultField( "delta_v" ) );
+    return fields;
+}
+
+//! Get test records.
+static std::vector< ResultRecord > getResultSinkTestRecords( )
+{
+    const double values[ ][ 2 ] = { { 16615.0, 0.5 }, { 16616.0, 1.25 }, { 17117.0, -3.0 } };
+
+    std::vector< ResultRecord > records;
+    for ( int i = 0; i < 3; i++ )
+    {
+        records.push_back( ResultRecord( values[ i ], values[ i ] + 2 ) );
+    }
+    return records;
+}
+
+//! Create table for test records.
+static void createResultSinkTestTable( SQLite::Database& database )
+{
+    database.exec( "CREATE TABLE result_sink_test ("
+                   "\"record_id\" INTEGER PRIMARY KEY AUTOINCREMENT,"
+                   "\"object_id\" INTEGER,"
+                   "\"delta_v\"   REAL);" );
+}
+
+TEST_CASE( "Test checking result sink settings", "[result_sink],[input-output]" )
+{
+    // Redirect cout to buffer.
+    // http://www.cplusplus.com/reference/ios/ios/rdbuf/
+    std::streambuf* coutBuffer;
+    std::stringstream outputBuffer;
+    coutBuffer = std::cout.rdbuf( );
+    std::cout.rdbuf( outputBuffer.rdbuf( ) );
+
+    rapidjson::Document config;
+
+    SECTION( "Test default result sink" )
+    {
+        config.Parse( "{ \"mode\" : \"lambert_scanner\" }" );
+        const ResultSinkSettings settings = checkResultSinkSettings( config );
+        REQUIRE( settings.type == "sqlite" );
+        REQUIRE( settings.isSQLite( ) );
+    }
+
+    SECTION( "Test CSV result sink" )
+    {
+        config.Parse( "{ \"sink\" : { \"type\" : \"csv\", \"path\" : \"results.csv\" } }" );
+        const ResultSinkSettings settings = checkResultSinkSettings( config );
+        REQUIRE( settings.type == "csv" );
+        REQUIRE( settings.path == "results.csv" );
+        REQUIRE_FALSE( settings.isSQLite( ) );
+    }
+
+    SECTION( "Test null result sink" )
+    {
+        config.Parse( "{ \"sink\" : { \"type\" : \"null\" } }" );
+        const ResultSinkSettings settings = checkResultSinkSettings( config );
+        REQUIRE( settings.type == "null" );
+        REQUIRE_FALSE( settings.isSQLite( ) );
+    }
+
+    SECTION( "Test unknown result sink type" )
+    {
+        config.Parse( "{ \"sink\" : { \"type\" : \"parquet\" } }" );
+        REQUIRE_THROWS( checkResultSinkSettings( config ) );
+    }
+
+    SECTION( "Test CSV result sink without path" )
+    {
+        config.Parse( "{ \"sink\" : { \"type\" : \"csv\" } }" );
+        REQUIRE_THROWS( checkResultSinkSettings( config ) );
+    }
+
+    // Reset cout buffer.
+    std::cout.rdbuf( coutBuffer );
+}
+
+TEST_CASE( "Test result sinks", "[result_sink],[input-output]" )
+{
+    const ResultFields fields = getResultSinkTestFields( );
+    const std::vector< ResultRecord > records = getResultSinkTestRecords( );
+
+    SQLite::Database database( ":memory:", SQLITE_OPEN_READWRITE|SQLITE_OPEN_CREATE );
+    createResultSinkTestTable( database );
+
+    SECTION( "Test SQLite result sink" )
+    {
+        const std::unique_ptr< ResultSink > sink = createResultSink(
+            ResultSinkSettings( "sqlite", "" ), database, "result_sink_test", fields );
+
+        for ( unsigned int i = 0; i < records.size( ); i++ )
+        {
+            REQUIRE( sink->write( records[ i ] ) == i + 1 );
+        }
+        sink->close( );
+        REQUIRE( sink->getNumberOfRecords( ) == 3 );
+
+        SQLite::Statement query(
+            database, "SELECT object_id, delta_v FROM result_sink_test ORDER BY record_id;" );
+        for ( unsigned int i = 0; i < records.size( ); i++ )
+        {
+            REQUIRE( query.executeStep( ) );
+            REQUIRE( query.getColumn( 0 ).getInt( ) == static_cast< int >( records[ i ][ 0 ] ) );
+            REQUIRE( query.getColumn( 1 ).getDouble( ) == records[ i ][ 1 ] );
+        }
+        REQUIRE_FALSE( query.executeStep( ) );
+    }
+
+    SECTION( "Test SQLite result sink without table" )
+    {
+        REQUIRE_THROWS( createResultSink(
+            ResultSinkSettings( "sqlite", "" ), database, "result_sink_missing", fields ) );
+    }
+
+    SECTION( "Test CSV result sink" )
+    {
+        const std::string csvPath = getRootPath( ) + "/test/result_sink_test.csv";
+
+        {
+            const std::unique_ptr< ResultSink > sink = createResultSink(
+                ResultSinkSettings( "csv", csvPath ), database, "result_sink_test", fields );
+
+            for ( unsigned int i = 0; i < records.size( ); i++ )
+            {
+                REQUIRE( sink->write( records[ i ] ) == i + 1 );
+            }
+            sink->close( );
+            REQUIRE( sink->getNumberOfRecords( ) == 3 );
+        }
+
+        std::ifstream csvFile( csvPath.c_str( ) );
+        std::vector< std::string > lines;
+        std::string line;
+        while ( std::getline( csvFile, line ) )
+        {
+            lines.push_back( line );
+        }
+        csvFile.close( );
+
+        REQUIRE( lines.size( ) == 4 );
+        REQUIRE( lines[ 0 ] == "object_id,delta_v" );
+        REQUIRE( lines[ 1 ] == "16615,0.5" );
+        REQUIRE( lines[ 2 ] == "16616,1.25" );
+        REQUIRE( lines[ 3 ] == "17117,-3" );
+
+        // Records written to the CSV sink are not stored in the database.
+        REQUIRE( database.execAndGet(
+            "SELECT COUNT(*) FROM result_sink_test;" ).getInt( ) == 0 );
+
+        std::remove( csvPath.c_str( ) );
+    }
+
+    SECTION( "Test CSV result sink with invalid path" )
+    {
+        REQUIRE_THROWS( createResultSink(
+            ResultSinkSettings( "csv", getRootPath( ) + "/test/missing_directory/results.csv" ),
+            database,
+            "result_sink_test",
+            fields ) );
+    }
+
+    SECTION( "Test null result sink" )
+    {
+        const std::unique_ptr< ResultSink > sink = createResultSink(
+            ResultSinkSettings( "null", "" ), database, "result_sink_test", fields );
+
+        for ( unsigned int i = 0; i < records.size( ); i++ )
+        {
+            REQUIRE( sink->write( records[ i ] ) == i + 1 );
+        }
+        sink->close( );
+        REQUIRE( sink->getNumberOfRecords( ) == 3 );
+
+        // Records written to the null sink are discarded.
+        REQUIRE( database.execAndGet(
+            "SELECT COUNT(*) FROM result_sink_test;" ).getInt( ) == 0 );
+    }
+}
+
+} // namespace tests
+} // namespace d2d
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include "D2D/atomScanner.hpp"
+#include "D2D/lambertScanner.hpp"
+#include "D2D/resultSink.hpp"
+#include "D2D/sgp4Scanner.hpp"
+#include "D2D/shortlist.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+TEST_CASE( "Test bounded shortlist", "[shortlist]" )
+{
+    const double values[ ] = { 5.0, 3.0, 9.0, 1.0, 7.0, 2.0, 8.0 };
+
+    SECTION( "Retain best entries" )
+    {
+        Shortlist< double > shortlist( 3 );
+        for ( unsigned int i = 0; i < 7; i++ )
+        {
+            shortlist.insert( values[ i ] );
+        }
+
+        REQUIRE( shortlist.isFull( ) );
+        REQUIRE( shortlist.getWorst( ) == 3.0 );
+
+        const std::vector< double > entries = shortlist.getSortedEntries( );
+        REQUIRE( entries.size( ) == 3 );
+        REQUIRE( entries[ 0 ] == 1.0 );
+        REQUIRE( entries[ 1 ] == 2.0 );
+        REQUIRE( entries[ 2 ] == 3.0 );
+    }
+
+    SECTION( "Merge shortlists" )
+    {
+        Shortlist< double > firstShortlist( 3 );
+        Shortlist< double > secondShortlist( 3 );
+        for ( unsigned int i = 0; i < 7; i++ )
+        {
+            if ( i % 2 == 0 )
+            {
+                firstShortlist.insert( values[ i ] );
+            }
+            else
+            {
+                secondShortlist.insert( values[ i ] );
+            }
+        }
+
+        firstShortlist.merge( secondShortlist );
+
+        const std::vector< double > entries = firstShortlist.getSortedEntries( );
+        REQUIRE( entries.size( ) == 3 );
+        REQUIRE( entries[ 0 ] == 1.0 );
+        REQUIRE( entries[ 1 ] == 2.0 );
+        REQUIRE( entries[ 2 ] == 3.0 );
+    }
+
+    SECTION( "Fewer entries than capacity" )
+    {
+        Shortlist< double > shortlist( 10 );
+        shortlist.insert( 4.0 );
+        shortlist.insert( 2.0 );
+
+        REQUIRE( !shortlist.isFull( ) );
+
+        const std::vector< double > entries = shortlist.getSortedEntries( );
+        REQUIRE( entries.size( ) == 2 );
+        REQUIRE( entries[ 0 ] == 2.0 );
+        REQUIRE( entries[ 1 ] == 4.0 );
+    }
+
+    SECTION( "Zero capacity" )
+    {
+        Shortlist< double > shortlist( 0 );
+        REQUIRE_FALSE( shortlist.isImprovedBy( 1.0 ) );
+        shortlist.insert( 1.0 );
+
+        REQUIRE( shortlist.getSortedEntries( ).empty( ) );
+    }
+
+    SECTION( "Check if entry would be retained" )
+    {
+        Shortlist< double > shortlist( 2 );
+        REQUIRE( shortlist.isImprovedBy( 5.0 ) );
+
+        shortlist.insert( 5.0 );
+        REQUIRE( shortlist.isImprovedBy( 9.0 ) );
+
+        shortlist.insert( 3.0 );
+        REQUIRE( shortlist.isImprovedBy( 4.0 ) );
+        REQUIRE_FALSE( shortlist.isImprovedBy( 5.0 ) );
+        REQUIRE_FALSE( shortlist.isImprovedBy( 6.0 ) );
+    }
+}
+
+TEST_CASE( "Test shortlist of sgp4_scanner and atom_scanner records", "[shortlist]" )
+{
+    const ResultRecord record( 16, 0.0 );
+
+    SECTION( "Retain records with lowest Lambert transfer deltaV" )
+    {
+        // Records with equal Lambert transfer deltaV are ordered by transfer_id.
+        SGP4ScannerShortlist shortlist( 3 );
+        shortlist.insert( SGP4ScannerShortlistEntry( 1, 2.0, 10, 11, record ) );
+        shortlist.insert( SGP4ScannerShortlistEntry( 2, 1.0, 10, 12, record ) );
+        shortlist.insert( SGP4ScannerShortlistEntry( 3, 3.0, 11, 10, record ) );
+        shortlist.insert( SGP4ScannerShortlistEntry( 4, 2.0, 12, 10, record ) );
+        shortlist.insert( SGP4ScannerShortlistEntry( 5, 1.0, 12, 11, record ) );
+
+        const SGP4ScannerShortlistEntries entries = shortlist.getSortedEntries( );
+        REQUIRE( entries.size( ) == 3 );
+        REQUIRE( entries[ 0 ].transferId == 2 );
+        REQUIRE( entries[ 1 ].transferId == 5 );
+        REQUIRE( entries[ 2 ].transferId == 1 );
+        REQUIRE( entries[ 2 ].departureObjectId == 10 );
+        REQUIRE( entries[ 2 ].arrivalObjectId == 11 );
+    }
+
+    SECTION( "Retain records with lowest Atom transfer deltaV" )
+    {
+        AtomScannerShortlist shortlist( 2 );
+        shortlist.insert( AtomScannerShortlistEntry( 1, 3.0, record ) );
+        shortlist.insert( AtomScannerShortlistEntry( 2, 2.0, record ) );
+        shortlist.insert( AtomScannerShortlistEntry( 3, 2.0, record ) );
+
+        const AtomScannerShortlistEntries entries = shortlist.getSortedEntries( );
+        REQUIRE( entries.size( ) == 2 );
+        REQUIRE( entries[ 0 ].transferId == 2 );
+        REQUIRE( entries[ 1 ].transferId == 3 );
+
+        // A record with equal Atom transfer deltaV is written later, so it would not be retained.
+        REQUIRE_FALSE( shortlist.isImprovedBy( 2.0 ) );
+        REQUIRE( shortlist.isImprovedBy( 1.5 ) );
+    }
+}
+
+TEST_CASE( "Test shortlist of lambert_scanner transfers", "[shortlist]" )
+{
+    LambertScannerTransfer transfer;
+    transfer.transferDeltaV = 1.0;
+
+    // Entries for transfers stored by a previous run have a transfer_id, but no position in the
+    // work queue.
+    LambertScannerShortlistEntries storedEntries;
+    for ( long long i = 0; i < 3; i++ )
+    {
+        storedEntries.push_back( LambertScannerShortlistEntry( transfer, 0, 0 ) );
+        storedEntries.back( ).transferId = 7 - 2 * i;
+    }
+
+    SECTION( "Order transfers with equal deltaV by transfer_id and position in work queue" )
+    {
+        // Transfers in the work queue follow transfers stored by a previous run.
+        const LambertScannerShortlistEntry computedEntry( transfer, 0, 0 );
+        REQUIRE( storedEntries[ 0 ] < computedEntry );
+        REQUIRE_FALSE( computedEntry < storedEntries[ 0 ] );
+
+        REQUIRE( storedEntries[ 1 ] < storedEntries[ 0 ] );
+        REQUIRE_FALSE( storedEntries[ 0 ] < storedEntries[ 1 ] );
+        REQUIRE_FALSE( storedEntries[ 0 ] < storedEntries[ 0 ] );
+
+        REQUIRE( LambertScannerShortlistEntry( transfer, 0, 1 )
+                 < LambertScannerShortlistEntry( transfer, 1, 0 ) );
+
+        // Lower deltaV takes precedence.
+        LambertScannerTransfer betterTransfer = transfer;
+        betterTransfer.transferDeltaV = 0.5;
+        REQUIRE( LambertScannerShortlistEntry( betterTransfer, 3, 2 ) < storedEntries[ 2 ] );
+    }
+
+    SECTION( "Retain transfers independent of order of insertion" )
+    {
+        LambertScannerShortlistEntries entries = storedEntries;
+        entries.push_back( LambertScannerShortlistEntry( transfer, 0, 0 ) );
+        entries.push_back( LambertScannerShortlistEntry( transfer, 0, 1 ) );
+
+        for ( unsigned int n = 0; n < entries.size( ); n++ )
+        {
+            LambertScannerShortlist shortlist( 3 );
+            for ( unsigned int i = 0; i < entries.size( ); i++ )
+            {
+                shortlist.insert( entries[ ( n + i ) % entries.size( ) ] );
+            }
+
+            const LambertScannerShortlistEntries sortedEntries = shortlist.getSortedEntries( );
+            REQUIRE( sortedEntries.size( ) == 3 );
+            REQUIRE( sortedEntries[ 0 ].transferId == 3 );
+            REQUIRE( sortedEntries[ 1 ].transferId == 5 );
+            REQUIRE( sortedEntries[ 2 ].transferId == 7 );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace d2d
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2014-2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/Tle.h>
+
+#ifdef D2D_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef D2D_HAVE_LZMA
+#include <lzma.h>
+#endif
+
+#include "D2D/tleCatalog.hpp"
+#include "D2D/tools.hpp"
+
+namespace d2d
+{
+namespace tests
+{
+
+const static std::string tleCatalogLines[ ]
+    = { "0 ARIANE 1 R/B",
+        "1 16615U 86019C   15056.74756344  .00000183  00000-0  85747-4 0  9997",
+        "2 16615 098.7218 114.5033 0011490 007.4719 100.7401 14.31425759518969",
+        "0 ARIANE 1 DEB",
+        "1 16616U 86019D   15056.25916885  .00000277  00000-0  12801-3 0  9996",
+        "2 16616 098.7042 118.9780 0008713 157.7835 244.6378 14.28608381508537",
+        "0 ARIANE 1 DEB",
+        "1 17117U 86019M   15056.14321689  .00002412  00000-0  78527-3 0  9993",
+        "2 17117 098.5197 097.5343 0091385 201.9294 191.1471 14.37298067464074" };
+
+//! Write temporary catalog file with given contents.
+static std::string writeTleCatalog( const std::string& fileName, const std::string& contents )
+{
+    const std::string catalogPath = getRootPath( ) + "/test/" + fileName;
+    std::ofstream catalogFile( catalogPath.c_str( ), std::ios::binary );
+    catalogFile << contents;
+    catalogFile.close( );
+    return catalogPath;
+}
+
+TEST_CASE( "Test reading TLE catalog", "[tle_catalog],[input-output]" )
+{
+    SECTION( "Test reading 3-line TLE catalog" )
+    {
+        const TleCatalog catalog(
+            getRootPath( ) + "/test/lambert_scanner_tle_3line_catalog_test.txt" );
+
+        REQUIRE( catalog.getNumberOfLinesPerTle( ) == 3 );
+        REQUIRE( catalog.getNumberOfTles( ) == 3 );
+
+        for ( unsigned int i = 0; i < catalog.getNumberOfTles( ); i++ )
+        {
+            for ( int j = 0; j < 3; j++ )
+            {
+                REQUIRE( catalog.getLine( i, j ) == tleCatalogLines[ 3 * i + j ] );
+            }
+        }
+
+        const Tle tle = catalog.getTle( 1 );
+        REQUIRE( tle.Line1( ) == tleCatalogLines[ 4 ] );
+        REQUIRE( tle.Line2( ) == tleCatalogLines[ 5 ] );
+    }
+
+    SECTION( "Test reading 2-line TLE catalog" )
+    {
+        const TleCatalog catalog(
+            getRootPath( ) + "/test/lambert_scanner_tle_2line_catalog_test.txt" );
+
+        REQUIRE( catalog.getNumberOfLinesPerTle( ) == 2 );
+        REQUIRE( catalog.getNumberOfTles( ) == 3 );
+
+        for ( unsigned int i = 0; i < catalog.getNumberOfTles( ); i++ )
+        {
+            REQUIRE( catalog.getLine( i, 0 ) == tleCatalogLines[ 3 * i + 1 ] );
+            REQUIRE( catalog.getLine( i, 1 ) == tleCatalogLines[ 3 * i + 2 ] );
+        }
+
+        const Tle tle = catalog.getTle( 2 );
+        REQUIRE( tle.Line1( ) == tleCatalogLines[ 7 ] );
+        REQUIRE( tle.Line2( ) == tleCatalogLines[ 8 ] );
+    }
+
+    SECTION( "Test reading TLE catalog with CRLF line endings" )
+    {
+        std::string contents;
+        for ( int i = 0; i < 9; i++ )
+        {
+            contents += tleCatalogLines[ i ] + "\r\n";
+        }
+        const std::string catalogPath = writeTleCatalog( "tle_catalog_crlf_test.txt", contents );
+
+        {
+            const TleCatalog catalog( catalogPath );
+
+            REQUIRE( catalog.getNumberOfLinesPerTle( ) == 3 );
+            REQUIRE( catalog.getNumberOfTles( ) == 3 );
+
+            for ( unsigned int i = 0; i < catalog.getNumberOfTles( ); i++ )
+            {
+                for ( int j = 0; j < 3; j++ )
+                {
+                    REQUIRE( catalog.getLine( i, j ) == tleCatalogLines[ 3 * i + j ] );
+                    REQUIRE( catalog.getRawLine( i, j ) == tleCatalogLines[ 3 * i + j ] + "\r" );
+                }
+            }
+
+            const Tle tle = catalog.getTle( 0 );
+            REQUIRE( tle.Line1( ) == tleCatalogLines[ 1 ] );
+            REQUIRE( tle.Line2( ) == tleCatalogLines[ 2 ] );
+        }
+
+        std::remove( catalogPath.c_str( ) );
+    }
+
+    SECTION( "Test skipping blank lines" )
+    {
+        // Blank lines, including lines that only contain a carriage return, are skipped; the last
+        // line has no newline.
+        const std::string contents
+            = "\n\n" + tleCatalogLines[ 0 ] + "\n" + tleCatalogLines[ 1 ] + "\n\r\n"
+              + tleCatalogLines[ 2 ] + "\n\n\n" + tleCatalogLines[ 3 ] + "\n"
+              + tleCatalogLines[ 4 ] + "\n" + tleCatalogLines[ 5 ];
+        const std::string catalogPath = writeTleCatalog( "tle_catalog_blank_test.txt", contents );
+
+        {
+            const TleCatalog catalog( catalogPath );
+
+            REQUIRE( catalog.getNumberOfLinesPerTle( ) == 3 );
+            REQUIRE( catalog.getNumberOfTles( ) == 2 );
+
+            for ( unsigned int i = 0; i < catalog.getNumberOfTles( ); i++ )
+            {
+                for ( int j = 0; j < 3; j++ )
+                {
+                    REQUIRE( catalog.getLine( i, j ) == tleCatalogLines[ 3 * i + j ] );
+                }
+            }
+        }
+
+        std::remove( catalogPath.c_str( ) );
+    }
+
+    SECTION( "Test number of lines that is not a multiple of TLE size" )
+    {
+        std::string contents;
+        for ( int i = 0; i < 8; i++ )
+        {
+            contents += tleCatalogLines[ i ] + "\n";
+        }
+        const std::string catalogPath
+            = writeTleCatalog( "tle_catalog_malformed_test.txt", contents );
+
+        REQUIRE_THROWS( TleCatalog( catalogPath ) );
+
+        std::remove( catalogPath.c_str( ) );
+    }
+
+    SECTION( "Test 2-line catalog with odd number of lines" )
+    {
+        const std::string contents
+            = tleCatalogLines[ 1 ] + "\n" + tleCatalogLines[ 2 ] + "\n" + tleCatalogLines[ 4 ]
+              + "\n";
+        const std::string catalogPath
+            = writeTleCatalog( "tle_catalog_malformed_test.txt", contents );
+
+        REQUIRE_THROWS( TleCatalog( catalogPath ) );
+
+        std::remove( catalogPath.c_str( ) );
+    }
+
+    SECTION( "Test missing catalog" )
+    {
+        REQUIRE_THROWS( TleCatalog( getRootPath( ) + "/test/tle_catalog_missing_test.txt" ) );
+    }
+}
+
+TEST_CASE( "Test parsing TLE objects in parallel", "[tle_catalog]" )
+{
+    const TleCatalog catalog( getRootPath( ) + "/test/catalog_pruner_tle_3line_catalog_full.txt" );
+    const TleObjects expectedTleObjects = catalog.getTleObjects( 1 );
+
+    REQUIRE( expectedTleObjects.size( ) == catalog.getNumberOfTles( ) );
+
+    // The number of threads does not need to divide the number of TLEs, and can exceed it.
+    const int numbersOfThreads[ ] = { 2, 3, 7, 64 };
+    for ( int k = 0; k < 4; k++ )
+    {
+        const TleObjects tleObjects = catalog.getTleObjects( numbersOfThreads[ k ] );
+
+        REQUIRE( tleObjects.size( ) == expectedTleObjects.size( ) );
+        for ( unsigned int i = 0; i < tleObjects.size( ); i++ )
+        {
+            REQUIRE( tleObjects[ i ].Name( ) == expectedTleObjects[ i ].Name( ) );
+            REQUIRE( tleObjects[ i ].Line1( ) == expectedTleObjects[ i ].Line1( ) );
+            REQUIRE( tleObjects[ i ].Line2( ) == expectedTleObjects[ i ].Line2( ) );
+        }
+    }
+
+    // TLE objects are parsed from the catalog in catalog order.
+    for ( unsigned int i = 0; i < expectedTleObjects.size( ); i += 1000 )
+    {
+        REQUIRE( expectedTleObjects[ i ].Line1( ) == catalog.getLine( i, 1 ) );
+        REQUIRE( expectedTleObjects[ i ].Line2( ) == catalog.getLine( i, 2 ) );
+    }
+}
+
+#if defined( D2D_HAVE_ZLIB ) || defined( D2D_HAVE_LZMA )
+//! Check that compressed catalog contains the same lines as the uncompressed catalog.
+static void checkCompressedTleCatalog( const TleCatalog& catalog,
+                                       const TleCatalog& expectedCatalog )
+{
+    REQUIRE( catalog.getNumberOfLinesPerTle( ) == expectedCatalog.getNumberOfLinesPerTle( ) );
+    REQUIRE( catalog.getNumberOfTles( ) == expectedCatalog.getNumberOfTles( ) );
+
+    for ( unsigned int i = 0; i < catalog.getNumberOfTles( ); i++ )
+    {
+        for ( int j = 0; j < catalog.getNumberOfLinesPerTle( ); j++ )
+        {
+            REQUIRE( catalog.getRawLine( i, j ) == expectedCatalog.getRawLine( i, j ) );
+        }
+    }
+
+    REQUIRE( catalog.computeHash( ) == expectedCatalog.computeHash( ) );
+}
+
+TEST_CASE( "Test reading compressed TLE catalogs", "[tle_catalog],[input-output]" )
+{
+    // The catalog (with CRLF line endings) is larger than the 1 MiB blocks in which compressed
+    // catalogs are decompressed, and a line spans the boundary between the first two blocks.
+    const std::string catalogPath
+        = getRootPath( ) + "/test/catalog_pruner_tle_3line_catalog_full.txt";
+    std::ifstream catalogFile( catalogPath.c_str( ), std::ios::binary );
+    const std::string contents( ( std::istreambuf_iterator< char >( catalogFile ) ),
+                                std::istreambuf_iterator< char >( ) );
+    catalogFile.close( );
+
+    const std::size_t blockSize = 1 << 20;
+    REQUIRE( contents.size( ) > 2 * blockSize );
+    REQUIRE( contents[ blockSize - 1 ] != '\n' );
+    REQUIRE( contents[ blockSize ] != '\n' );
+
+    const TleCatalog expectedCatalog( catalogPath );
+
+#ifdef D2D_HAVE_ZLIB
+    SECTION( "Test reading gzip catalog" )
+    {
+        const std::string compressedPath = getRootPath( ) + "/test/tle_catalog_test.txt.gz";
+        gzFile compressedFile = gzopen( compressedPath.c_str( ), "wb" );
+        gzwrite( compressedFile, contents.data( ), contents.size( ) );
+        gzclose( compressedFile );
+
+        {
+            const TleCatalog catalog( compressedPath );
+            checkCompressedTleCatalog( catalog, expectedCatalog );
+        }
+
+        std::remove( compressedPath.c_str( ) );
+    }
+
+    SECTION( "Test reading gzip catalog with concatenated members" )
+    {
+        // The catalog is split in three gzip members, at boundaries that fall within lines.
+        const std::string compressedPath = getRootPath( ) + "/test/tle_catalog_test.txt.gz";
+        const std::size_t memberBoundaries[ ] = { 0, 1000, blockSize + 5, contents.size( ) };
+        for ( int i = 0; i < 3; i++ )
+        {
+            gzFile compressedFile = gzopen( compressedPath.c_str( ), i == 0 ? "wb" : "ab" );
+            gzwrite( compressedFile,
+                     contents.data( ) + memberBoundaries[ i ],
+                     memberBoundaries[ i + 1 ] - memberBoundaries[ i ] );
+            gzclose( compressedFile );
+        }
+
+        {
+            const TleCatalog catalog( compressedPath );
+            checkCompressedTleCatalog( catalog, expectedCatalog );
+        }
+
+        std::remove( compressedPath.c_str( ) );
+    }
+
+    SECTION( "Test reading truncated gzip catalog" )
+    {
+        const std::string compressedPath = getRootPath( ) + "/test/tle_catalog_test.txt.gz";
+        gzFile compressedFile = gzopen( compressedPath.c_str( ), "wb" );
+        gzwrite( compressedFile, contents.data( ), contents.size( ) );
+        gzclose( compressedFile );
+
+        std::ifstream compressedInput( compressedPath.c_str( ), std::ios::binary );
+        const std::string compressedContents(
+            ( std::istreambuf_iterator< char >( compressedInput ) ),
+            std::istreambuf_iterator< char >( ) );
+        compressedInput.close( );
+
+        std::ofstream truncatedOutput( compressedPath.c_str( ), std::ios::binary );
+        truncatedOutput << compressedContents.substr( 0, compressedContents.size( ) / 2 );
+        truncatedOutput.close( );
+
+        REQUIRE_THROWS( TleCatalog( compressedPath ) );
+
+        std::remove( compressedPath.c_str( ) );
+    }
+#endif
+
+#ifdef D2D_HAVE_LZMA
+    SECTION( "Test reading xz catalog" )
+    {
+        std::vector< uint8_t > compressedContents( lzma_stream_buffer_bound( contents.size( ) ) );
+        std::size_t compressedSize = 0;
+        REQUIRE( lzma_easy_buffer_encode( 6,
+                                          LZMA_CHECK_CRC64,
+                                          NULL,
+                                          reinterpret_cast< const uint8_t* >( contents.data( ) ),
+                                          contents.size( ),
+                                          &compressedContents[ 0 ],
+                                          &compressedSize,
+                                          compressedContents.size( ) ) == LZMA_OK );
+
+        const std::string compressedPath = getRootPath( ) + "/test/tle_catalog_test.txt.xz";
+        std::ofstream compressedOutput( compressedPath.c_str( ), std::ios::binary );
+        compressedOutput.write( reinterpret_cast< const char* >( &compressedContents[ 0 ] ),
+                                compressedSize );
+        compressedOutput.close( );
+
+        {
+            const TleCatalog catalog( compressedPath );
+            checkCompressedTleCatalog( catalog, expectedCatalog );
+        }
+
+        std::remove( compressedPath.c_str( ) );
+    }
+#endif
+}
+#endif
+
+} // namespace tests
+} // namespace d2d
@@ -13,10 +13,13 @@
 
 #include <boost/array.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/math/constants/constants.hpp>
 #include <boost/tokenizer.hpp>
 
 #include <catch.hpp>
 
+#include <keplerian_toolbox.h>
+
 #include <libsgp4/DateTime.h>
 #include <libsgp4/Eci.h>
 #include <libsgp4/Vector.h>
@@ -218,6 +221,215 @@ TEST_CASE( "Test conversion of Eci object in SGP4 library to Vector6", "[convers
     REQUIRE( state == expectedState );
 }
 
+TEST_CASE( "Test computation of periapsis radius", "[periapsis]" )
+{
+    const double gravitationalParameter = 398600.4418;
+
+    SECTION( "Test circular orbit" )
+    {
+        const double radius = 7000.0;
+
+        Vector3 position;
+        position[ 0 ] = 0.0;
+        position[ 1 ] = radius;
+        position[ 2 ] = 0.0;
+
+        Vector3 velocity;
+        velocity[ 0 ] = -std::sqrt( gravitationalParameter / radius );
+        velocity[ 1 ] = 0.0;
+        velocity[ 2 ] = 0.0;
+
+        REQUIRE( computePeriapsisRadius( position, velocity, gravitationalParameter )
+                 == Approx( radius ).epsilon( 1.0e-12 ) );
+    }
+
+    SECTION( "Test elliptical orbit at apoapsis" )
+    {
+        const double periapsisRadius = 6800.0;
+        const double apoapsisRadius = 42164.0;
+        const double semiMajorAxis = 0.5 * ( periapsisRadius + apoapsisRadius );
+
+        Vector3 position;
+        position[ 0 ] = -apoapsisRadius;
+        position[ 1 ] = 0.0;
+        position[ 2 ] = 0.0;
+
+        // Velocity at apoapsis from vis-viva equation.
+        Vector3 velocity;
+        velocity[ 0 ] = 0.0;
+        velocity[ 1 ] = -std::sqrt( gravitationalParameter
+                                    * ( 2.0 / apoapsisRadius - 1.0 / semiMajorAxis ) );
+        velocity[ 2 ] = 0.0;
+
+        REQUIRE( computePeriapsisRadius( position, velocity, gravitationalParameter )
+                 == Approx( periapsisRadius ).epsilon( 1.0e-12 ) );
+    }
+
+    SECTION( "Test hyperbolic orbit at periapsis" )
+    {
+        const double periapsisRadius = 7000.0;
+
+        Vector3 position;
+        position[ 0 ] = periapsisRadius;
+        position[ 1 ] = 0.0;
+        position[ 2 ] = 0.0;
+
+        Vector3 velocity;
+        velocity[ 0 ] = 0.0;
+        velocity[ 1 ] = 1.2 * std::sqrt( 2.0 * gravitationalParameter / periapsisRadius );
+        velocity[ 2 ] = 0.0;
+
+        REQUIRE( computePeriapsisRadius( position, velocity, gravitationalParameter )
+                 == Approx( periapsisRadius ).epsilon( 1.0e-12 ) );
+    }
+}
+
+TEST_CASE( "Test estimate of transfer Delta V", "[delta-v]" )
+{
+    const double gravitationalParameter = 398600.4418;
+
+    Vector6 departureState;
+    departureState[ 0 ] = 7000.0;
+    departureState[ 1 ] = 0.0;
+    departureState[ 2 ] = 0.0;
+    departureState[ 3 ] = 0.0;
+    departureState[ 4 ] = std::sqrt( gravitationalParameter / 7000.0 );
+    departureState[ 5 ] = 0.0;
+
+    SECTION( "Test coplanar circular orbits" )
+    {
+        Vector6 arrivalState;
+        arrivalState[ 0 ] = 0.0;
+        arrivalState[ 1 ] = 8000.0;
+        arrivalState[ 2 ] = 0.0;
+        arrivalState[ 3 ] = -std::sqrt( gravitationalParameter / 8000.0 );
+        arrivalState[ 4 ] = 0.0;
+        arrivalState[ 5 ] = 0.0;
+
+        const double transferSemiMajorAxis = 0.5 * ( 7000.0 + 8000.0 );
+        const double expectedDeltaV
+            = std::sqrt( gravitationalParameter / 7000.0 )
+                * ( std::sqrt( 8000.0 / transferSemiMajorAxis ) - 1.0 )
+              + std::sqrt( gravitationalParameter / 8000.0 )
+                * ( 1.0 - std::sqrt( 7000.0 / transferSemiMajorAxis ) );
+
+        REQUIRE( estimateTransferDeltaV( departureState, arrivalState, gravitationalParameter )
+                 == Approx( expectedDeltaV ).epsilon( 1.0e-12 ) );
+    }
+
+    SECTION( "Test plane change between circular orbits of equal radius" )
+    {
+        const double planeAngle = 0.1;
+        const double circularSpeed = std::sqrt( gravitationalParameter / 7000.0 );
+
+        Vector6 arrivalState;
+        arrivalState[ 0 ] = 7000.0;
+        arrivalState[ 1 ] = 0.0;
+        arrivalState[ 2 ] = 0.0;
+        arrivalState[ 3 ] = 0.0;
+        arrivalState[ 4 ] = circularSpeed * std::cos( planeAngle );
+        arrivalState[ 5 ] = circularSpeed * std::sin( planeAngle );
+
+        const double expectedDeltaV = circularSpeed * std::sin( planeAngle );
+
+        REQUIRE( estimateTransferDeltaV( departureState, arrivalState, gravitationalParameter )
+                 == Approx( expectedDeltaV ).epsilon( 1.0e-10 ) );
+    }
+}
+
+TEST_CASE( "Test lower bound on Lambert transfer Delta V", "[delta-v]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    const double pi = boost::math::constants::pi< double >( );
+
+    // LEO at 300 km altitude, inclined by 28.5 deg, and GEO.
+    const double departureRadius = 6678.0;
+    const double arrivalRadius = 42164.0;
+    const double inclination = 28.5 * pi / 180.0;
+    const double departureSpeed = std::sqrt( gravitationalParameter / departureRadius );
+    const double arrivalSpeed = std::sqrt( gravitationalParameter / arrivalRadius );
+
+    for ( int departurePhaseIndex = 0; departurePhaseIndex < 4; departurePhaseIndex++ )
+    {
+        for ( int arrivalPhaseIndex = 0; arrivalPhaseIndex < 4; arrivalPhaseIndex++ )
+        {
+            const double departurePhase = departurePhaseIndex * 0.5 * pi + 0.3;
+            const double arrivalPhase = arrivalPhaseIndex * 0.5 * pi + 0.7;
+
+            Vector6 departureState;
+            departureState[ 0 ] = departureRadius * std::cos( departurePhase );
+            departureState[ 1 ] = departureRadius * std::sin( departurePhase )
+                                  * std::cos( inclination );
+            departureState[ 2 ] = departureRadius * std::sin( departurePhase )
+                                  * std::sin( inclination );
+            departureState[ 3 ] = -departureSpeed * std::sin( departurePhase );
+            departureState[ 4 ] = departureSpeed * std::cos( departurePhase )
+                                  * std::cos( inclination );
+            departureState[ 5 ] = departureSpeed * std::cos( departurePhase )
+                                  * std::sin( inclination );
+
+            Vector6 arrivalState;
+            arrivalState[ 0 ] = arrivalRadius * std::cos( arrivalPhase );
+            arrivalState[ 1 ] = arrivalRadius * std::sin( arrivalPhase );
+            arrivalState[ 2 ] = 0.0;
+            arrivalState[ 3 ] = -arrivalSpeed * std::sin( arrivalPhase );
+            arrivalState[ 4 ] = arrivalSpeed * std::cos( arrivalPhase );
+            arrivalState[ 5 ] = 0.0;
+
+            const double transferDeltaVEstimate
+                = estimateTransferDeltaV( departureState, arrivalState, gravitationalParameter );
+
+            kep_toolbox::array3D departurePosition;
+            kep_toolbox::array3D arrivalPosition;
+            for ( int k = 0; k < 3; k++ )
+            {
+                departurePosition[ k ] = departureState[ k ];
+                arrivalPosition[ k ] = arrivalState[ k ];
+            }
+
+            for ( int timeOfFlightIndex = 1; timeOfFlightIndex <= 4; timeOfFlightIndex++ )
+            {
+                const double timeOfFlight = timeOfFlightIndex * 6.0 * 3600.0;
+
+                for ( int isRetrograde = 0; isRetrograde < 2; isRetrograde++ )
+                {
+                    kep_toolbox::lambert_problem targeter( departurePosition,
+                                                           arrivalPosition,
+                                                           timeOfFlight,
+                                                           gravitationalParameter,
+                                                           isRetrograde,
+                                                           2 );
+
+                    for ( unsigned int j = 0; j < targeter.get_v1( ).size( ); j++ )
+                    {
+                        const kep_toolbox::array3D& transferDepartureVelocity
+                            = targeter.get_v1( )[ j ];
+                        const kep_toolbox::array3D& transferArrivalVelocity
+                            = targeter.get_v2( )[ j ];
+
+                        double departureDeltaVSquared = 0.0;
+                        double arrivalDeltaVSquared = 0.0;
+                        for ( int k = 0; k < 3; k++ )
+                        {
+                            const double departureDeltaV
+                                = transferDepartureVelocity[ k ] - departureState[ k + 3 ];
+                            const double arrivalDeltaV
+                                = arrivalState[ k + 3 ] - transferArrivalVelocity[ k ];
+                            departureDeltaVSquared += departureDeltaV * departureDeltaV;
+                            arrivalDeltaVSquared += arrivalDeltaV * arrivalDeltaV;
+                        }
+
+                        const double transferDeltaV = std::sqrt( departureDeltaVSquared )
+                                                      + std::sqrt( arrivalDeltaVSquared );
+
+                        REQUIRE( transferDeltaVEstimate <= transferDeltaV );
+                    }
+                }
+            }
+        }
+    }
+}
+
 TEST_CASE( "Test print functions", "[print],[input-output]" )
 {
     SECTION( "Test printing a floating-point number to a formatted stream" )
@@ -320,6 +532,60 @@ TEST_CASE( "Test function to find parameter in JSON input file", "[JSON],[input-
     }
 }
 
+TEST_CASE( "Test function to override parameters in JSON input file", "[JSON],[input-output]" )
+{
+    rapidjson::Document config;
+    config.Parse( "{ \"database\"  : \"shared.db\","
+                  "  \"threads\"   : 2,"
+                  "  \"bulk_load\" : { \"journal_mode\" : \"WAL\", \"cache_size\" : -2000 },"
+                  "  \"shortlist\" : [10, \"shortlist.csv\"] }" );
+
+    rapidjson::Document overrides;
+    overrides.Parse( "{ \"database\"  : \"variant.db\","
+                     "  \"bulk_load\" : { \"cache_size\" : -4000, \"synchronous\" : \"OFF\" },"
+                     "  \"shortlist\" : [0],"
+                     "  \"direction\" : \"both\" }" );
+
+    rapidjson::Document overriddenConfig;
+    overrideConfig( config, overrides, overriddenConfig );
+
+    SECTION( "Test overriding top-level parameters" )
+    {
+        REQUIRE( std::string( overriddenConfig[ "database" ].GetString( ) ) == "variant.db" );
+        REQUIRE( overriddenConfig[ "threads" ].GetInt( ) == 2 );
+        REQUIRE( std::string( overriddenConfig[ "direction" ].GetString( ) ) == "both" );
+
+        // Arrays are replaced, not merged.
+        REQUIRE( overriddenConfig[ "shortlist" ].Size( ) == 1 );
+        REQUIRE( overriddenConfig[ "shortlist" ][ 0 ].GetInt( ) == 0 );
+    }
+
+    SECTION( "Test overriding nested parameters" )
+    {
+        const rapidjson::Value& bulkLoad = overriddenConfig[ "bulk_load" ];
+        REQUIRE( bulkLoad.MemberCount( ) == 3 );
+        REQUIRE( std::string( bulkLoad[ "journal_mode" ].GetString( ) ) == "WAL" );
+        REQUIRE( bulkLoad[ "cache_size" ].GetInt( ) == -4000 );
+        REQUIRE( std::string( bulkLoad[ "synchronous" ].GetString( ) ) == "OFF" );
+    }
+
+    SECTION( "Test that shared parameters are unchanged" )
+    {
+        REQUIRE( config.MemberCount( ) == 4 );
+        REQUIRE( std::string( config[ "database" ].GetString( ) ) == "shared.db" );
+        REQUIRE( config[ "bulk_load" ].MemberCount( ) == 2 );
+        REQUIRE( config[ "bulk_load" ][ "cache_size" ].GetInt( ) == -2000 );
+        REQUIRE( config[ "shortlist" ].Size( ) == 2 );
+    }
+
+    SECTION( "Test replacing nested object by other value" )
+    {
+        overrides.Parse( "{ \"bulk_load\" : 0 }" );
+        overrideConfig( config, overrides, overriddenConfig );
+        REQUIRE( overriddenConfig[ "bulk_load" ].IsInt( ) );
+    }
+}
+
 TEST_CASE( "Test parsing functions", "[parser][input-output]" )
 {
     SECTION( "Test removal of newline characters from string" )